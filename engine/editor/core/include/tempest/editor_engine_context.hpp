@@ -54,6 +54,11 @@ namespace tempest::editor
 
         ecs::entity load_entity(ecs::entity src) override;
 
+        auto mark_transform_dirty(ecs::entity entity) -> void override
+        {
+            _transforms.mark_dirty(entity);
+        }
+
         [[nodiscard]] auto get_logger() -> logger& override
         {
             return _logger;
@@ -64,6 +69,16 @@ namespace tempest::editor
             return _logger;
         }
 
+        [[nodiscard]] auto get_jobs() -> core::job_system& override
+        {
+            return _jobs;
+        }
+
+        [[nodiscard]] auto get_jobs() const -> const core::job_system& override
+        {
+            return _jobs;
+        }
+
         [[nodiscard]] auto get_simulation_state() const -> simulation_state
         {
             return _sim_state;
@@ -77,9 +92,11 @@ namespace tempest::editor
       private:
         vector<unique_ptr<log_sink>> _log_sinks;
         logger _logger;
+        core::job_system _jobs;
 
         event::event_registry _event_registry;
         ecs::archetype_registry _entity_registry;
+        ecs::transform_propagation_system _transforms;
         core::material_registry _material_reg;
         core::mesh_registry _mesh_reg;
         core::texture_registry _texture_reg;
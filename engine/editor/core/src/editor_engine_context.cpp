@@ -27,7 +27,8 @@ namespace tempest::editor
 
     editor_engine_context::editor_engine_context()
         : _log_sinks(make_default_log_sinks()), _logger(make_default_logger(_log_sinks)),
-          _entity_registry(_event_registry), _asset_database(&_asset_type_reg),
+          _entity_registry(_event_registry), _transforms(_entity_registry, _event_registry),
+          _asset_database(&_asset_type_reg),
           _render(graphics::renderer::builder()
                       .set_pbr_frame_graph_config({
                           .render_target_width = 1920,
@@ -59,6 +60,7 @@ namespace tempest::editor
                       })
                       .set_pbr_frame_graph_inputs({
                           .entity_registry = &_entity_registry,
+                          .jobs = &_jobs,
                       })
                       .build(_logger))
     {
@@ -354,6 +356,7 @@ namespace tempest::editor
             callback(*this);
         }
 
+        _transforms.update();
         _render.render();
     }
 } // namespace tempest::editor
\ No newline at end of file
@@ -13,7 +13,8 @@ namespace tempest::assets
     namespace
     {
         constexpr array<uint8_t, 4> db_magic = {'T', 'E', 'B', 'F'};
-        constexpr uint16_t db_version = 2;
+        // Version 3: persisted type hashes are computed with wyhash instead of FNV-1a
+        constexpr uint16_t db_version = 3;
     } // namespace
 
     asset_database::asset_database(asset_type_registry* type_reg) noexcept : _type_reg{type_reg}
@@ -233,7 +234,7 @@ namespace tempest::assets
     auto asset_database::load(string_view source_path, ecs::archetype_registry& registry) -> ecs::entity
     {
         // Check if source exists in the database
-        auto path_it = _source_path_to_index.find(string(source_path));
+        auto path_it = _source_path_to_index.find(source_path);
         if (path_it != _source_path_to_index.end())
         {
             return _load_from_blobs(source_path, registry);
@@ -256,7 +257,7 @@ namespace tempest::assets
     auto asset_database::find_by_path(string_view path) const -> const asset_entry*
     {
         // Find the source entry for this path
-        auto src_it = _source_path_to_index.find(string(path));
+        auto src_it = _source_path_to_index.find(path);
         if (src_it == _source_path_to_index.end())
         {
             return nullptr;
@@ -357,7 +358,7 @@ namespace tempest::assets
 
     auto asset_database::register_importer(unique_ptr<asset_importer> importer, string_view extension) -> void
     {
-        _importers[string(extension)] = move(importer);
+        _importers[extension] = move(importer);
     }
 
     auto asset_database::register_asset_metadata(asset_metadata meta) -> guid
@@ -383,7 +384,7 @@ namespace tempest::assets
 
     auto asset_database::_load_from_blobs(string_view source_path, ecs::archetype_registry& registry) -> ecs::entity
     {
-        auto src_it = _source_path_to_index.find(string(source_path));
+        auto src_it = _source_path_to_index.find(source_path);
         if (src_it == _source_path_to_index.end())
         {
             return ecs::tombstone;
@@ -524,7 +525,7 @@ namespace tempest::assets
             return ecs::tombstone;
         }
 
-        auto importer_it = _importers.find(string(extension_it, source_path.end()));
+        auto importer_it = _importers.find(string_view(extension_it, source_path.end()));
         if (importer_it == _importers.end())
         {
             return ecs::tombstone;
@@ -631,7 +632,7 @@ namespace tempest::assets
 
     source_entry& asset_database::_get_or_create_source(string_view source_path)
     {
-        auto iter = _source_path_to_index.find(string(source_path));
+        auto iter = _source_path_to_index.find(source_path);
         if (iter != _source_path_to_index.end())
         {
             return *_sources[iter->second];
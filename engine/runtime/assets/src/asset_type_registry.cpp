@@ -14,7 +14,7 @@ namespace tempest::assets
 
     auto asset_type_registry::find_by_name(string_view name) const -> const type_entry*
     {
-        auto iter = _name_to_index.find(string(name));
+        auto iter = _name_to_index.find(name);
         if (iter != _name_to_index.end())
         {
             return _entries[iter->second].get();
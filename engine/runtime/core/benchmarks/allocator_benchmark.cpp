@@ -0,0 +1,146 @@
+#include <tempest/benchmark.hpp>
+#include <tempest/memory.hpp>
+#include <tempest/vector.hpp>
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    constexpr size_t element_count = 10'000;
+
+    // Mix of sizes typical of small engine allocations: function spills, strings, small arrays
+    std::vector<size_t> allocation_sizes()
+    {
+        tempest::bench::rng gen(4);
+
+        std::vector<size_t> sizes(element_count);
+        for (auto& size : sizes)
+        {
+            size = 8 + gen.next(249);
+        }
+        return sizes;
+    }
+
+    template <typename Allocate, typename Deallocate>
+    void churn(const std::vector<size_t>& sizes, std::vector<void*>& ptrs, Allocate&& allocate,
+               Deallocate&& deallocate)
+    {
+        for (size_t i = 0; i < sizes.size(); ++i)
+        {
+            ptrs[i] = allocate(sizes[i]);
+        }
+
+        // Free every other allocation, then refill the holes
+        for (size_t i = 0; i < sizes.size(); i += 2)
+        {
+            deallocate(ptrs[i]);
+        }
+
+        for (size_t i = 0; i < sizes.size(); i += 2)
+        {
+            ptrs[i] = allocate(sizes[i]);
+        }
+
+        for (auto ptr : ptrs)
+        {
+            deallocate(ptr);
+        }
+
+        tempest::bench::clobber_memory();
+    }
+} // namespace
+
+TEMPEST_BENCHMARK_SUITE(allocator)
+{
+    const auto sizes = allocation_sizes();
+    std::vector<void*> ptrs(sizes.size());
+
+    constexpr size_t allocations_per_iteration = element_count + element_count / 2;
+
+    tempest::heap_allocator heap(64 * 1024 * 1024, 16 * 1024 * 1024);
+    runner.run("small_churn/heap_allocator", allocations_per_iteration, [&] {
+        churn(
+            sizes, ptrs, [&](size_t size) { return heap.allocate(size, 8); },
+            [&](void* ptr) { heap.deallocate(ptr); });
+    });
+
+    tempest::new_delete_allocator global;
+    runner.run("small_churn/new_delete_allocator", allocations_per_iteration, [&] {
+        churn(
+            sizes, ptrs, [&](size_t size) { return global.allocate(size, 8); },
+            [&](void* ptr) { global.deallocate(ptr); });
+    });
+
+    runner.run("small_churn/std_malloc", allocations_per_iteration, [&] {
+        churn(
+            sizes, ptrs, [](size_t size) { return std::malloc(size); }, [](void* ptr) { std::free(ptr); });
+    });
+
+    runner.run("aligned_64/heap_allocator", element_count, [&] {
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            ptrs[i] = heap.allocate(sizes[i], 64);
+        }
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            heap.deallocate(ptrs[i]);
+        }
+    });
+    runner.run("aligned_64/std_aligned_new", element_count, [&] {
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            ptrs[i] = ::operator new(sizes[i], std::align_val_t{64});
+        }
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            ::operator delete(ptrs[i], std::align_val_t{64});
+        }
+    });
+
+    tempest::stack_allocator stack(4 * 1024 * 1024);
+    runner.run("bump/stack_allocator", element_count, [&] {
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            tempest::bench::do_not_optimize(stack.allocate(sizes[i], 8));
+        }
+        stack.reset();
+    });
+
+    runner.run("typed/tempest_allocator", element_count, [&] {
+        tempest::allocator<uint64_t> alloc;
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            auto ptr = alloc.allocate(4);
+            tempest::bench::do_not_optimize(ptr);
+            alloc.deallocate(ptr, 4);
+        }
+    });
+    runner.run("typed/std_allocator", element_count, [&] {
+        std::allocator<uint64_t> alloc;
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            auto ptr = alloc.allocate(4);
+            tempest::bench::do_not_optimize(ptr);
+            alloc.deallocate(ptr, 4);
+        }
+    });
+
+    runner.run("pmr_vector/heap_allocator", element_count, [&] {
+        tempest::pmr::vector<uint32_t> values(&heap);
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            values.push_back(static_cast<uint32_t>(i));
+        }
+        tempest::bench::do_not_optimize(values.data());
+    });
+    runner.run("pmr_vector/default", element_count, [&] {
+        tempest::pmr::vector<uint32_t> values;
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            values.push_back(static_cast<uint32_t>(i));
+        }
+        tempest::bench::do_not_optimize(values.data());
+    });
+}
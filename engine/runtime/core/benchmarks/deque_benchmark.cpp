@@ -0,0 +1,85 @@
+#include <tempest/benchmark.hpp>
+#include <tempest/deque.hpp>
+
+#include <deque>
+
+namespace
+{
+    constexpr size_t element_count = 100'000;
+
+    template <typename Deque>
+    void push_back(Deque& values)
+    {
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            values.push_back(static_cast<uint32_t>(i));
+        }
+        tempest::bench::do_not_optimize(values.size());
+    }
+
+    template <typename Deque>
+    void push_front(Deque& values)
+    {
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            values.push_front(static_cast<uint32_t>(i));
+        }
+        tempest::bench::do_not_optimize(values.size());
+    }
+
+    // Steady state queue usage, as in the job and upload queues
+    template <typename Deque>
+    void fifo(Deque& values)
+    {
+        for (size_t i = 0; i < 64; ++i)
+        {
+            values.push_back(static_cast<uint32_t>(i));
+        }
+
+        uint64_t total = 0;
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            total += values.front();
+            values.pop_front();
+            values.push_back(static_cast<uint32_t>(i));
+        }
+        tempest::bench::do_not_optimize(total);
+    }
+
+    template <typename Deque>
+    void random_access(const Deque& values)
+    {
+        uint64_t total = 0;
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            total += values[i];
+        }
+        tempest::bench::do_not_optimize(total);
+    }
+} // namespace
+
+TEMPEST_BENCHMARK_SUITE(deque)
+{
+    runner.run("push_back/tempest", element_count, [] { return tempest::deque<uint32_t>{}; },
+               [](auto& values) { push_back(values); });
+    runner.run("push_back/std", element_count, [] { return std::deque<uint32_t>{}; },
+               [](auto& values) { push_back(values); });
+
+    runner.run("push_front/tempest", element_count, [] { return tempest::deque<uint32_t>{}; },
+               [](auto& values) { push_front(values); });
+    runner.run("push_front/std", element_count, [] { return std::deque<uint32_t>{}; },
+               [](auto& values) { push_front(values); });
+
+    runner.run("fifo/tempest", element_count, [] { return tempest::deque<uint32_t>{}; },
+               [](auto& values) { fifo(values); });
+    runner.run("fifo/std", element_count, [] { return std::deque<uint32_t>{}; },
+               [](auto& values) { fifo(values); });
+
+    tempest::deque<uint32_t> tempest_filled;
+    push_back(tempest_filled);
+    std::deque<uint32_t> std_filled;
+    push_back(std_filled);
+
+    runner.run("random_access/tempest", element_count, [&] { random_access(tempest_filled); });
+    runner.run("random_access/std", element_count, [&] { random_access(std_filled); });
+}
@@ -0,0 +1,84 @@
+#include <tempest/benchmark.hpp>
+#include <tempest/flat_map.hpp>
+
+#include <map>
+#include <vector>
+
+namespace
+{
+    // flat_map inserts are linear, keep the working set small enough to finish in reasonable time
+    constexpr size_t element_count = 10'000;
+
+    std::vector<uint64_t> random_keys(uint64_t seed)
+    {
+        tempest::bench::rng gen(seed);
+
+        std::vector<uint64_t> keys(element_count);
+        for (auto& key : keys)
+        {
+            key = gen.next();
+        }
+        return keys;
+    }
+
+    template <typename Map>
+    void insert(Map& map, const std::vector<uint64_t>& keys)
+    {
+        for (auto key : keys)
+        {
+            map.insert({key, key});
+        }
+        tempest::bench::do_not_optimize(map.size());
+    }
+
+    template <typename Map>
+    Map filled(const std::vector<uint64_t>& keys)
+    {
+        Map map;
+        insert(map, keys);
+        return map;
+    }
+
+    template <typename Map>
+    void find_all(const Map& map, const std::vector<uint64_t>& keys)
+    {
+        uint64_t found = 0;
+        for (auto key : keys)
+        {
+            found += map.find(key) != map.end();
+        }
+        tempest::bench::do_not_optimize(found);
+    }
+
+    template <typename Map>
+    void iterate(const Map& map)
+    {
+        uint64_t total = 0;
+        for (const auto& [key, value] : map)
+        {
+            total += value;
+        }
+        tempest::bench::do_not_optimize(total);
+    }
+} // namespace
+
+TEMPEST_BENCHMARK_SUITE(flat_map)
+{
+    using tempest_map = tempest::flat_map<uint64_t, uint64_t>;
+    using std_map = std::map<uint64_t, uint64_t>;
+
+    const auto keys = random_keys(3);
+
+    runner.run("insert_random/tempest", element_count, [] { return tempest_map{}; },
+               [&](auto& map) { insert(map, keys); });
+    runner.run("insert_random/std", element_count, [] { return std_map{}; }, [&](auto& map) { insert(map, keys); });
+
+    const auto tempest_filled = filled<tempest_map>(keys);
+    const auto std_filled = filled<std_map>(keys);
+
+    runner.run("find/tempest", element_count, [&] { find_all(tempest_filled, keys); });
+    runner.run("find/std", element_count, [&] { find_all(std_filled, keys); });
+
+    runner.run("iterate/tempest", element_count, [&] { iterate(tempest_filled); });
+    runner.run("iterate/std", element_count, [&] { iterate(std_filled); });
+}
@@ -0,0 +1,122 @@
+#include <tempest/benchmark.hpp>
+#include <tempest/flat_unordered_map.hpp>
+#include <tempest/string.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    constexpr size_t element_count = 100'000;
+
+    std::vector<uint64_t> random_keys(uint64_t seed)
+    {
+        tempest::bench::rng gen(seed);
+
+        std::vector<uint64_t> keys(element_count);
+        for (auto& key : keys)
+        {
+            key = gen.next();
+        }
+        return keys;
+    }
+
+    template <typename Map>
+    void insert(Map& map, const std::vector<uint64_t>& keys)
+    {
+        for (auto key : keys)
+        {
+            map.insert({key, key});
+        }
+        tempest::bench::do_not_optimize(map.size());
+    }
+
+    template <typename Map>
+    Map filled(const std::vector<uint64_t>& keys)
+    {
+        Map map;
+        insert(map, keys);
+        return map;
+    }
+
+    template <typename Map>
+    void find_all(const Map& map, const std::vector<uint64_t>& keys)
+    {
+        uint64_t found = 0;
+        for (auto key : keys)
+        {
+            found += map.find(key) != map.end();
+        }
+        tempest::bench::do_not_optimize(found);
+    }
+
+    template <typename Map>
+    void erase_all(Map& map, const std::vector<uint64_t>& keys)
+    {
+        for (auto key : keys)
+        {
+            map.erase(key);
+        }
+        tempest::bench::do_not_optimize(map.size());
+    }
+} // namespace
+
+TEMPEST_BENCHMARK_SUITE(flat_unordered_map)
+{
+    using tempest_map = tempest::flat_unordered_map<uint64_t, uint64_t>;
+    using std_map = std::unordered_map<uint64_t, uint64_t>;
+
+    const auto keys = random_keys(1);
+    const auto missing_keys = random_keys(2);
+
+    runner.run("insert/tempest", element_count, [] { return tempest_map{}; },
+               [&](auto& map) { insert(map, keys); });
+    runner.run("insert/std", element_count, [] { return std_map{}; }, [&](auto& map) { insert(map, keys); });
+
+    const auto tempest_filled = filled<tempest_map>(keys);
+    const auto std_filled = filled<std_map>(keys);
+
+    runner.run("find_hit/tempest", element_count, [&] { find_all(tempest_filled, keys); });
+    runner.run("find_hit/std", element_count, [&] { find_all(std_filled, keys); });
+
+    runner.run("find_miss/tempest", element_count, [&] { find_all(tempest_filled, missing_keys); });
+    runner.run("find_miss/std", element_count, [&] { find_all(std_filled, missing_keys); });
+
+    runner.run("erase/tempest", element_count, [&] { return tempest_filled; },
+               [&](auto& map) { erase_all(map, keys); });
+    runner.run("erase/std", element_count, [&] { return std_filled; }, [&](auto& map) { erase_all(map, keys); });
+
+    // String keys exercise hashing and the heterogeneous lookup path
+    std::vector<std::string> names;
+    names.reserve(element_count / 10);
+    for (size_t i = 0; i < element_count / 10; ++i)
+    {
+        names.push_back("resource/texture_" + std::to_string(i));
+    }
+
+    tempest::flat_unordered_map<tempest::string, uint32_t> tempest_names;
+    std::unordered_map<std::string, uint32_t> std_names;
+    for (uint32_t i = 0; i < names.size(); ++i)
+    {
+        tempest_names.insert({tempest::string(names[i].c_str()), i});
+        std_names.insert({names[i], i});
+    }
+
+    runner.run("find_string_view/tempest", names.size(), [&] {
+        uint64_t found = 0;
+        for (const auto& name : names)
+        {
+            found += tempest_names.find(tempest::string_view(name.data(), name.size())) != tempest_names.end();
+        }
+        tempest::bench::do_not_optimize(found);
+    });
+    runner.run("find_string/std", names.size(), [&] {
+        uint64_t found = 0;
+        for (const auto& name : names)
+        {
+            found += std_names.find(name) != std_names.end();
+        }
+        tempest::bench::do_not_optimize(found);
+    });
+}
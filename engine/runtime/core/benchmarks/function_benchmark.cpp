@@ -0,0 +1,63 @@
+#include <tempest/benchmark.hpp>
+#include <tempest/functional.hpp>
+
+#include <functional>
+
+namespace
+{
+    constexpr size_t element_count = 100'000;
+
+    struct large_capture
+    {
+        uint64_t values[16];
+    };
+
+    template <template <typename> typename Function>
+    void construct_small()
+    {
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            Function<uint64_t(uint64_t)> fn = [i](uint64_t x) { return x + i; };
+            tempest::bench::do_not_optimize(fn);
+        }
+    }
+
+    // Captures too large for the inline buffer spill to the heap
+    template <template <typename> typename Function>
+    void construct_large()
+    {
+        large_capture capture{};
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            capture.values[0] = i;
+            Function<uint64_t(uint64_t)> fn = [capture](uint64_t x) { return x + capture.values[0]; };
+            tempest::bench::do_not_optimize(fn);
+        }
+    }
+
+    template <typename Fn>
+    void invoke(Fn& fn)
+    {
+        uint64_t total = 0;
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            total = fn(total);
+        }
+        tempest::bench::do_not_optimize(total);
+    }
+} // namespace
+
+TEMPEST_BENCHMARK_SUITE(function)
+{
+    runner.run("construct_small/tempest", element_count, [] { construct_small<tempest::function>(); });
+    runner.run("construct_small/std", element_count, [] { construct_small<std::function>(); });
+
+    runner.run("construct_large/tempest", element_count, [] { construct_large<tempest::function>(); });
+    runner.run("construct_large/std", element_count, [] { construct_large<std::function>(); });
+
+    tempest::function<uint64_t(uint64_t)> tempest_fn = [](uint64_t x) { return x * 3 + 1; };
+    std::function<uint64_t(uint64_t)> std_fn = [](uint64_t x) { return x * 3 + 1; };
+
+    runner.run("invoke/tempest", element_count, [&] { invoke(tempest_fn); });
+    runner.run("invoke/std", element_count, [&] { invoke(std_fn); });
+}
@@ -0,0 +1,359 @@
+#ifndef tempest_benchmark_hpp
+#define tempest_benchmark_hpp
+
+// Minimal benchmark harness shared by the benchmark executables. Suites register themselves with
+// TEMPEST_BENCHMARK_SUITE and the executable's main forwards to tempest::bench::run_main.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace tempest::bench
+{
+    /// @brief Prevents the compiler from discarding a value computed by a benchmark.
+    template <typename T>
+    inline void do_not_optimize(const T& value)
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        const volatile void* sink = &value;
+        (void)sink;
+        _ReadWriteBarrier();
+#else
+        // Escaping the address together with the memory clobber forces the value to be materialized
+        asm volatile("" : : "g"(&value) : "memory");
+#endif
+    }
+
+    /// @brief Forces pending writes to memory to be considered observable.
+    inline void clobber_memory()
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : : "memory");
+#endif
+    }
+
+    /// @brief Deterministic generator so every run benchmarks the same data.
+    class rng
+    {
+      public:
+        explicit rng(uint64_t seed = 0x9e3779b97f4a7c15ull) : _state{seed}
+        {
+        }
+
+        uint64_t next() noexcept
+        {
+            // splitmix64
+            auto z = (_state += 0x9e3779b97f4a7c15ull);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            return z ^ (z >> 31);
+        }
+
+        uint64_t next(uint64_t bound) noexcept
+        {
+            return next() % bound;
+        }
+
+      private:
+        uint64_t _state;
+    };
+
+    struct options
+    {
+        size_t warmup_iterations = 5;
+        size_t iterations = 50;
+        size_t max_size = SIZE_MAX; // Upper bound on workload sizes for suites that scale their input
+        std::string filter;
+        std::string json_path;
+        bool list = false;
+    };
+
+    struct result
+    {
+        std::string name;
+        size_t iterations;
+        size_t items_per_iteration;
+        double min_ns;
+        double mean_ns;
+        double p50_ns;
+        double p90_ns;
+        double p99_ns;
+        double max_ns;
+    };
+
+    class runner
+    {
+      public:
+        explicit runner(options opts) : _options{std::move(opts)}
+        {
+        }
+
+        void begin_suite(std::string_view name)
+        {
+            _suite = name;
+        }
+
+        /// @brief Runs a benchmark. The setup callable is invoked before every iteration outside of the timed region
+        ///        and its result is handed to the body, which is timed. The fixture is destroyed outside of the timed
+        ///        region as well.
+        /// @param name Name of the benchmark, prefixed with the suite name.
+        /// @param items_per_iteration Number of operations performed by one invocation of the body, used to report the
+        ///        cost of a single operation.
+        template <typename Setup, typename Body>
+        void run(std::string_view name, size_t items_per_iteration, Setup&& setup, Body&& body)
+        {
+            auto full_name = _suite.empty() ? std::string(name) : _suite + "/" + std::string(name);
+            if (!_options.filter.empty() && full_name.find(_options.filter) == std::string::npos)
+            {
+                return;
+            }
+
+            if (_options.list)
+            {
+                std::printf("%s\n", full_name.c_str());
+                return;
+            }
+
+            for (size_t i = 0; i < _options.warmup_iterations; ++i)
+            {
+                auto fixture = setup();
+                body(fixture);
+                clobber_memory();
+            }
+
+            std::vector<double> samples;
+            samples.reserve(_options.iterations);
+
+            for (size_t i = 0; i < _options.iterations; ++i)
+            {
+                auto fixture = setup();
+
+                const auto start = std::chrono::steady_clock::now();
+                body(fixture);
+                clobber_memory();
+                const auto end = std::chrono::steady_clock::now();
+
+                samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+            }
+
+            _record(std::move(full_name), items_per_iteration, samples);
+        }
+
+        /// @brief Runs a benchmark without per-iteration setup.
+        template <typename Body>
+        void run(std::string_view name, size_t items_per_iteration, Body&& body)
+        {
+            run(name, items_per_iteration, [] { return 0; }, [&](int&) { body(); });
+        }
+
+        [[nodiscard]] const options& get_options() const noexcept
+        {
+            return _options;
+        }
+
+        [[nodiscard]] const std::vector<result>& results() const noexcept
+        {
+            return _results;
+        }
+
+        bool write_json(const std::string& path) const
+        {
+            auto file = std::fopen(path.c_str(), "w");
+            if (file == nullptr)
+            {
+                return false;
+            }
+
+#if defined(NDEBUG)
+            constexpr const char* build = "release";
+#else
+            constexpr const char* build = "debug";
+#endif
+
+            std::fprintf(file, "{\n  \"build\": \"%s\",\n  \"warmup_iterations\": %zu,\n  \"iterations\": %zu,\n", build,
+                         _options.warmup_iterations, _options.iterations);
+            std::fprintf(file, "  \"benchmarks\": [\n");
+
+            for (size_t i = 0; i < _results.size(); ++i)
+            {
+                const auto& r = _results[i];
+                std::fprintf(file,
+                             "    {\"name\": \"%s\", \"iterations\": %zu, \"items_per_iteration\": %zu, "
+                             "\"min_ns\": %.1f, \"mean_ns\": %.1f, \"p50_ns\": %.1f, \"p90_ns\": %.1f, "
+                             "\"p99_ns\": %.1f, \"max_ns\": %.1f, \"p50_ns_per_item\": %.3f}%s\n",
+                             r.name.c_str(), r.iterations, r.items_per_iteration, r.min_ns, r.mean_ns, r.p50_ns,
+                             r.p90_ns, r.p99_ns, r.max_ns, r.p50_ns / static_cast<double>(r.items_per_iteration),
+                             i + 1 < _results.size() ? "," : "");
+            }
+
+            std::fprintf(file, "  ]\n}\n");
+            std::fclose(file);
+
+            return true;
+        }
+
+      private:
+        options _options;
+        std::string _suite;
+        std::vector<result> _results;
+
+        static double _percentile(const std::vector<double>& sorted, double percentile)
+        {
+            // Nearest rank
+            const auto rank = static_cast<size_t>(percentile / 100.0 * static_cast<double>(sorted.size()) + 0.5);
+            return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+        }
+
+        void _record(std::string name, size_t items, std::vector<double>& samples)
+        {
+            if (samples.empty())
+            {
+                return;
+            }
+
+            std::sort(samples.begin(), samples.end());
+
+            double total = 0.0;
+            for (auto sample : samples)
+            {
+                total += sample;
+            }
+
+            auto r = result{
+                .name = std::move(name),
+                .iterations = samples.size(),
+                .items_per_iteration = items > 0 ? items : 1,
+                .min_ns = samples.front(),
+                .mean_ns = total / static_cast<double>(samples.size()),
+                .p50_ns = _percentile(samples, 50.0),
+                .p90_ns = _percentile(samples, 90.0),
+                .p99_ns = _percentile(samples, 99.0),
+                .max_ns = samples.back(),
+            };
+
+            std::printf("%-56s %12.1f %12.1f %12.1f %12.3f\n", r.name.c_str(), r.p50_ns / 1000.0, r.p90_ns / 1000.0,
+                        r.p99_ns / 1000.0, r.p50_ns / static_cast<double>(r.items_per_iteration));
+            std::fflush(stdout);
+
+            _results.push_back(std::move(r));
+        }
+    };
+
+    using suite_fn = void (*)(runner&);
+
+    struct suite
+    {
+        const char* name;
+        suite_fn fn;
+    };
+
+    inline std::vector<suite>& registered_suites()
+    {
+        static std::vector<suite> suites;
+        return suites;
+    }
+
+    struct suite_registration
+    {
+        suite_registration(const char* name, suite_fn fn)
+        {
+            registered_suites().push_back({name, fn});
+        }
+    };
+
+    inline options parse_options(int argc, char** argv)
+    {
+        options opts;
+
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view arg = argv[i];
+            const bool has_value = i + 1 < argc;
+
+            if (arg == "--iterations" && has_value)
+            {
+                opts.iterations = std::strtoull(argv[++i], nullptr, 10);
+            }
+            else if (arg == "--warmup" && has_value)
+            {
+                opts.warmup_iterations = std::strtoull(argv[++i], nullptr, 10);
+            }
+            else if (arg == "--max-size" && has_value)
+            {
+                opts.max_size = std::strtoull(argv[++i], nullptr, 10);
+            }
+            else if (arg == "--filter" && has_value)
+            {
+                opts.filter = argv[++i];
+            }
+            else if (arg == "--json" && has_value)
+            {
+                opts.json_path = argv[++i];
+            }
+            else if (arg == "--list")
+            {
+                opts.list = true;
+            }
+            else
+            {
+                std::fprintf(stderr,
+                             "usage: %s [--iterations N] [--warmup N] [--max-size N] [--filter SUBSTRING] [--json PATH] "
+                             "[--list]\n",
+                             argv[0]);
+                std::exit(1);
+            }
+        }
+
+        return opts;
+    }
+
+    /// @brief Runs every registered suite with the options given on the command line.
+    inline int run_main(int argc, char** argv)
+    {
+        runner r(parse_options(argc, argv));
+
+        if (!r.get_options().list)
+        {
+            std::printf("%-56s %12s %12s %12s %12s\n", "benchmark", "p50 (us)", "p90 (us)", "p99 (us)", "ns/item");
+        }
+
+        for (const auto& s : registered_suites())
+        {
+            r.begin_suite(s.name);
+            s.fn(r);
+        }
+
+        if (!r.get_options().json_path.empty() && !r.write_json(r.get_options().json_path))
+        {
+            std::fprintf(stderr, "failed to write %s\n", r.get_options().json_path.c_str());
+            return 1;
+        }
+
+        return 0;
+    }
+} // namespace tempest::bench
+
+#define TEMPEST_BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define TEMPEST_BENCHMARK_CONCAT(a, b) TEMPEST_BENCHMARK_CONCAT_IMPL(a, b)
+
+/// @brief Defines and registers a benchmark suite. The body receives a tempest::bench::runner& named runner.
+#define TEMPEST_BENCHMARK_SUITE(suite_name)                                                                            \
+    static void TEMPEST_BENCHMARK_CONCAT(suite_name, _benchmark_suite)(::tempest::bench::runner & runner);            \
+    static const ::tempest::bench::suite_registration TEMPEST_BENCHMARK_CONCAT(suite_name, _benchmark_registration){   \
+        #suite_name, &TEMPEST_BENCHMARK_CONCAT(suite_name, _benchmark_suite)};                                         \
+    static void TEMPEST_BENCHMARK_CONCAT(suite_name, _benchmark_suite)(::tempest::bench::runner & runner)
+
+#endif // tempest_benchmark_hpp
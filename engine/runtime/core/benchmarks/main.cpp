@@ -0,0 +1,6 @@
+#include <tempest/benchmark.hpp>
+
+int main(int argc, char** argv)
+{
+    return tempest::bench::run_main(argc, argv);
+}
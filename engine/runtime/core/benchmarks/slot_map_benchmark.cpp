@@ -0,0 +1,128 @@
+#include <tempest/benchmark.hpp>
+#include <tempest/slot_map.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    constexpr size_t element_count = 100'000;
+
+    struct payload
+    {
+        float position[3];
+        float velocity[3];
+        uint32_t flags;
+    };
+
+    // Closest std analog to a slot map: stable integer keys handed out by a counter
+    struct std_slot_map
+    {
+        std::unordered_map<uint64_t, payload> values;
+        uint64_t next_key = 0;
+
+        uint64_t insert(const payload& value)
+        {
+            values.emplace(next_key, value);
+            return next_key++;
+        }
+
+        bool erase(uint64_t key)
+        {
+            return values.erase(key) > 0;
+        }
+
+        payload& operator[](uint64_t key)
+        {
+            return values.find(key)->second;
+        }
+    };
+
+    template <typename Map, typename Keys>
+    void insert(Map& map, Keys& keys)
+    {
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            keys.push_back(map.insert(payload{.flags = static_cast<uint32_t>(i)}));
+        }
+        tempest::bench::do_not_optimize(keys.data());
+    }
+} // namespace
+
+TEMPEST_BENCHMARK_SUITE(slot_map)
+{
+    using tempest_key = tempest::slot_map<payload>::key_type;
+
+    struct tempest_fixture
+    {
+        tempest::slot_map<payload> map;
+        std::vector<tempest_key> keys;
+    };
+
+    struct std_fixture
+    {
+        std_slot_map map;
+        std::vector<uint64_t> keys;
+    };
+
+    runner.run("insert/tempest", element_count, [] { return tempest_fixture{}; },
+               [](auto& f) { insert(f.map, f.keys); });
+    runner.run("insert/std", element_count, [] { return std_fixture{}; }, [](auto& f) { insert(f.map, f.keys); });
+
+    tempest_fixture tempest_filled;
+    insert(tempest_filled.map, tempest_filled.keys);
+
+    std_fixture std_filled;
+    insert(std_filled.map, std_filled.keys);
+
+    runner.run("lookup/tempest", element_count, [&] {
+        uint64_t total = 0;
+        for (auto key : tempest_filled.keys)
+        {
+            total += tempest_filled.map[key].flags;
+        }
+        tempest::bench::do_not_optimize(total);
+    });
+    runner.run("lookup/std", element_count, [&] {
+        uint64_t total = 0;
+        for (auto key : std_filled.keys)
+        {
+            total += std_filled.map[key].flags;
+        }
+        tempest::bench::do_not_optimize(total);
+    });
+
+    runner.run("iterate/tempest", element_count, [&] {
+        uint64_t total = 0;
+        for (const auto& value : tempest_filled.map)
+        {
+            total += value.flags;
+        }
+        tempest::bench::do_not_optimize(total);
+    });
+    runner.run("iterate/std", element_count, [&] {
+        uint64_t total = 0;
+        for (const auto& [key, value] : std_filled.map.values)
+        {
+            total += value.flags;
+        }
+        tempest::bench::do_not_optimize(total);
+    });
+
+    runner.run("erase/tempest", element_count, [&] { return tempest_filled; },
+               [](auto& f) {
+                   for (auto key : f.keys)
+                   {
+                       (void)f.map.erase(key);
+                   }
+                   tempest::bench::do_not_optimize(f.map.size());
+               });
+    runner.run("erase/std", element_count, [&] { return std_filled; },
+               [](auto& f) {
+                   for (auto key : f.keys)
+                   {
+                       (void)f.map.erase(key);
+                   }
+                   tempest::bench::do_not_optimize(f.map.values.size());
+               });
+}
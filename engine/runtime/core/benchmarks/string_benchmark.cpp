@@ -0,0 +1,83 @@
+#include <tempest/benchmark.hpp>
+#include <tempest/string.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr size_t element_count = 10'000;
+
+    constexpr const char* short_text = "albedo";
+    constexpr const char* long_text = "assets/textures/environment/skybox_cubemap_radiance.ktx2";
+
+    template <typename String>
+    void construct(const char* text)
+    {
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            String str(text);
+            tempest::bench::do_not_optimize(str.data());
+        }
+    }
+
+    template <typename String>
+    void append(String& str)
+    {
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            str.append(short_text, 6);
+        }
+        tempest::bench::do_not_optimize(str.data());
+    }
+
+    template <typename String>
+    void compare(const std::vector<String>& strings)
+    {
+        uint64_t equal = 0;
+        for (size_t i = 1; i < strings.size(); ++i)
+        {
+            equal += strings[i] == strings[i - 1];
+        }
+        tempest::bench::do_not_optimize(equal);
+    }
+
+    template <typename String>
+    std::vector<String> make_strings()
+    {
+        std::vector<String> strings;
+        strings.reserve(element_count);
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            strings.emplace_back(i % 2 == 0 ? long_text : short_text);
+        }
+        return strings;
+    }
+} // namespace
+
+TEMPEST_BENCHMARK_SUITE(string)
+{
+    runner.run("construct_small/tempest", element_count, [] { construct<tempest::string>(short_text); });
+    runner.run("construct_small/std", element_count, [] { construct<std::string>(short_text); });
+
+    runner.run("construct_large/tempest", element_count, [] { construct<tempest::string>(long_text); });
+    runner.run("construct_large/std", element_count, [] { construct<std::string>(long_text); });
+
+    runner.run("append/tempest", element_count, [] { return tempest::string{}; }, [](auto& str) { append(str); });
+    runner.run("append/std", element_count, [] { return std::string{}; }, [](auto& str) { append(str); });
+
+    const auto tempest_strings = make_strings<tempest::string>();
+    const auto std_strings = make_strings<std::string>();
+
+    runner.run("compare/tempest", element_count, [&] { compare(tempest_strings); });
+    runner.run("compare/std", element_count, [&] { compare(std_strings); });
+
+    runner.run("copy/tempest", element_count, [&] {
+        auto copy = tempest_strings;
+        tempest::bench::do_not_optimize(copy.data());
+    });
+    runner.run("copy/std", element_count, [&] {
+        auto copy = std_strings;
+        tempest::bench::do_not_optimize(copy.data());
+    });
+}
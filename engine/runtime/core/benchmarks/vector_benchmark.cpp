@@ -0,0 +1,91 @@
+#include <tempest/benchmark.hpp>
+#include <tempest/vector.hpp>
+
+#include <vector>
+
+namespace
+{
+    constexpr size_t element_count = 100'000;
+
+    template <typename Vector>
+    void push_back(Vector& values)
+    {
+        for (size_t i = 0; i < element_count; ++i)
+        {
+            values.push_back(static_cast<uint32_t>(i));
+        }
+        tempest::bench::do_not_optimize(values.data());
+    }
+
+    template <typename Vector>
+    Vector filled()
+    {
+        Vector values;
+        push_back(values);
+        return values;
+    }
+
+    template <typename Vector>
+    void sum(const Vector& values)
+    {
+        uint64_t total = 0;
+        for (auto value : values)
+        {
+            total += value;
+        }
+        tempest::bench::do_not_optimize(total);
+    }
+
+    template <typename Vector>
+    void insert_front(Vector& values)
+    {
+        for (size_t i = 0; i < 1'000; ++i)
+        {
+            values.insert(values.begin(), static_cast<uint32_t>(i));
+        }
+        tempest::bench::do_not_optimize(values.data());
+    }
+} // namespace
+
+TEMPEST_BENCHMARK_SUITE(vector)
+{
+    runner.run("push_back/tempest", element_count, [] { return tempest::vector<uint32_t>{}; },
+               [](auto& values) { push_back(values); });
+    runner.run("push_back/std", element_count, [] { return std::vector<uint32_t>{}; },
+               [](auto& values) { push_back(values); });
+
+    runner.run("push_back_reserved/tempest", element_count,
+               [] {
+                   tempest::vector<uint32_t> values;
+                   values.reserve(element_count);
+                   return values;
+               },
+               [](auto& values) { push_back(values); });
+    runner.run("push_back_reserved/std", element_count,
+               [] {
+                   std::vector<uint32_t> values;
+                   values.reserve(element_count);
+                   return values;
+               },
+               [](auto& values) { push_back(values); });
+
+    const auto tempest_values = filled<tempest::vector<uint32_t>>();
+    const auto std_values = filled<std::vector<uint32_t>>();
+
+    runner.run("iterate/tempest", element_count, [&] { sum(tempest_values); });
+    runner.run("iterate/std", element_count, [&] { sum(std_values); });
+
+    runner.run("copy/tempest", element_count, [&] {
+        auto copy = tempest_values;
+        tempest::bench::do_not_optimize(copy.data());
+    });
+    runner.run("copy/std", element_count, [&] {
+        auto copy = std_values;
+        tempest::bench::do_not_optimize(copy.data());
+    });
+
+    runner.run("insert_front/tempest", 1'000, [] { return tempest::vector<uint32_t>{}; },
+               [](auto& values) { insert_front(values); });
+    runner.run("insert_front/std", 1'000, [] { return std::vector<uint32_t>{}; },
+               [](auto& values) { insert_front(values); });
+}
@@ -0,0 +1,135 @@
+#ifndef tempest_core_allocation_tracker_hpp
+#define tempest_core_allocation_tracker_hpp
+
+#include <tempest/api.hpp>
+#include <tempest/array.hpp>
+#include <tempest/int.hpp>
+#include <tempest/source_location.hpp>
+#include <tempest/vector.hpp>
+
+namespace tempest::core
+{
+    enum class allocation_tracking_mode
+    {
+        disabled,
+        full,    // Every allocation is recorded
+        sampled, // One in every sample_interval allocations is recorded, statistics are scaled to estimate totals
+    };
+
+    inline constexpr size_t allocation_callstack_depth = 8;
+
+    /// @brief Return addresses of an allocating call stack, innermost first. Unused entries are null.
+    using allocation_callstack = array<const void*, allocation_callstack_depth>;
+
+    /// @brief Statistics for a single call site. Call sites are keyed by source location and the subsystem that was
+    ///        active on the allocating thread. Allocations that reach the allocators without a source location, such
+    ///        as container growth through allocator_traits, are keyed by their call stack instead; the file is null
+    ///        and the call stack can be symbolized with a debugger or addr2line.
+    struct TEMPEST_API allocation_site_stats
+    {
+        const char* file = nullptr;
+        const char* function = nullptr;
+        uint32_t line = 0;
+        const char* subsystem = nullptr;
+        allocation_callstack callstack = {};
+
+        int64_t live_bytes = 0;
+        int64_t peak_bytes = 0;
+        uint64_t allocation_count = 0;
+        uint64_t deallocation_count = 0;
+        uint64_t allocated_bytes = 0;
+
+        // Allocations made during the last completed frame
+        uint64_t frame_allocation_count = 0;
+        uint64_t frame_allocated_bytes = 0;
+    };
+
+    /// @brief Statistics aggregated over every call site of a subsystem.
+    struct TEMPEST_API allocation_subsystem_stats
+    {
+        const char* subsystem = nullptr;
+
+        int64_t live_bytes = 0;
+        int64_t peak_bytes = 0; // Sum of per-site peaks, an upper bound on the subsystem peak
+        uint64_t allocation_count = 0;
+        uint64_t deallocation_count = 0;
+        uint64_t allocated_bytes = 0;
+        uint64_t frame_allocation_count = 0;
+        uint64_t frame_allocated_bytes = 0;
+    };
+
+    struct TEMPEST_API allocation_snapshot
+    {
+        uint64_t frame = 0;
+        vector<allocation_site_stats> sites;
+
+        /// @brief Aggregates the call sites of the snapshot by subsystem.
+        [[nodiscard]] vector<allocation_subsystem_stats> by_subsystem() const;
+    };
+
+    /// @brief Difference of a call site between two snapshots. Sites that keep gaining live bytes are leak candidates,
+    ///        sites with many allocations and deallocations but flat live bytes are churn.
+    struct TEMPEST_API allocation_site_delta
+    {
+        const char* file = nullptr;
+        const char* function = nullptr;
+        uint32_t line = 0;
+        const char* subsystem = nullptr;
+        allocation_callstack callstack = {};
+
+        int64_t live_bytes = 0;
+        int64_t allocation_count = 0;
+        int64_t deallocation_count = 0;
+        int64_t allocated_bytes = 0;
+    };
+
+    /// @brief Process wide tracker for allocations made through the tempest allocators. Tracking is disabled by default;
+    ///        while disabled, each allocation costs a single relaxed atomic load. Allocations made before tracking was
+    ///        enabled are not known to the tracker and their deallocations are ignored.
+    class TEMPEST_API allocation_tracker
+    {
+      public:
+        allocation_tracker() = delete;
+
+        /// @brief Enables tracking.
+        /// @param mode Tracking mode. Disabled turns tracking off.
+        /// @param sample_interval Number of allocations per recorded allocation in sampled mode.
+        static void enable(allocation_tracking_mode mode, uint32_t sample_interval = 64);
+        static void disable();
+
+        [[nodiscard]] static allocation_tracking_mode mode() noexcept;
+
+        /// @brief Closes the current frame. Per-frame allocation counts of the closed frame are reported by
+        ///        subsequent snapshots.
+        static void end_frame();
+
+        /// @brief Clears every recorded statistic and live allocation.
+        static void reset();
+
+        [[nodiscard]] static allocation_snapshot snapshot();
+
+        /// @brief Computes the change of every call site between two snapshots. Sites with no change are omitted.
+        [[nodiscard]] static vector<allocation_site_delta> diff(const allocation_snapshot& before,
+                                                                const allocation_snapshot& after);
+    };
+
+    /// @brief Tags every tracked allocation made on the calling thread with a subsystem name while in scope. Scopes
+    ///        nest; the innermost scope wins. The name must outlive the tracker's use of it, a string literal is
+    ///        expected.
+    class TEMPEST_API allocation_scope
+    {
+      public:
+        explicit allocation_scope(const char* subsystem) noexcept;
+        allocation_scope(const allocation_scope&) = delete;
+        allocation_scope(allocation_scope&&) noexcept = delete;
+        ~allocation_scope();
+
+        allocation_scope& operator=(const allocation_scope&) = delete;
+        allocation_scope& operator=(allocation_scope&&) noexcept = delete;
+
+      private:
+        const char* _previous;
+    };
+} // namespace tempest::core
+
+#endif // tempest_core_allocation_tracker_hpp
@@ -29,6 +29,7 @@
 #elif defined(TEMPEST_PLATFORM_LINUX)
 #include <linux/futex.h>
 #include <sys/syscall.h>
+#include <unistd.h>
 #else
 #error "Unsupported platform"
 #endif
@@ -260,7 +260,7 @@ namespace tempest
     {
         auto operator()(const basic_cstring_view<CharT, Traits>& view) const noexcept -> size_t
         {
-            return detail::fnv1a_auto(view.data(), view.size());
+            return detail::hash_chars(view.data(), view.size());
         }
     };
 
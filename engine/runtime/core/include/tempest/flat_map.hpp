@@ -215,9 +215,14 @@ namespace tempest
         {
             return {{p.first, p.second}};
         }
+
+        /// @brief Satisfied if the comparator of a map accepts keys of any compatible type, so lookups do not need to
+        /// construct a key.
+        template <typename Compare>
+        concept transparent_key_compare = requires { typename Compare::is_transparent; };
     } // namespace detail
 
-    template <typename K, typename V, typename Compare = tempest::less<K>, typename KeyContainer = tempest::vector<K>,
+    template <typename K, typename V, typename Compare = tempest::less<>, typename KeyContainer = tempest::vector<K>,
               typename ValueContainer = tempest::vector<V>>
     class flat_map
     {
@@ -303,6 +308,11 @@ namespace tempest
         iterator erase(const_iterator first, const_iterator last);
         size_type erase(const key_type& key);
 
+        template <typename Q>
+            requires(detail::transparent_key_compare<Compare> && !is_convertible_v<const Q&, iterator> &&
+                     !is_convertible_v<const Q&, const_iterator>)
+        size_type erase(const Q& key);
+
         void swap(flat_map& other) noexcept;
 
         void clear();
@@ -310,11 +320,31 @@ namespace tempest
         iterator find(const key_type& key);
         const_iterator find(const key_type& key) const;
 
+        template <typename Q>
+            requires detail::transparent_key_compare<Compare>
+        iterator find(const Q& key);
+
+        template <typename Q>
+            requires detail::transparent_key_compare<Compare>
+        const_iterator find(const Q& key) const;
+
         mapped_type& operator[](const key_type& key);
 
+        template <typename Q>
+            requires(detail::transparent_key_compare<Compare> && is_constructible_v<K, const Q&>)
+        mapped_type& operator[](const Q& key);
+
         size_type count(const key_type& key) const;
         bool contains(const key_type& key) const;
 
+        template <typename Q>
+            requires detail::transparent_key_compare<Compare>
+        size_type count(const Q& key) const;
+
+        template <typename Q>
+            requires detail::transparent_key_compare<Compare>
+        bool contains(const Q& key) const;
+
         iterator lower_bound(const key_type& key);
         const_iterator lower_bound(const key_type& key) const;
 
@@ -698,6 +728,24 @@ namespace tempest
         return 1;
     }
 
+    template <typename K, typename V, typename Compare, typename KeyContainer, typename ValueContainer>
+    template <typename Q>
+        requires(detail::transparent_key_compare<Compare> && !is_convertible_v<const Q&, iterator> &&
+                 !is_convertible_v<const Q&, const_iterator>)
+    inline typename flat_map<K, V, Compare, KeyContainer, ValueContainer>::size_type flat_map<
+        K, V, Compare, KeyContainer, ValueContainer>::erase(const Q& key)
+    {
+        auto it = find(key);
+        if (it == end())
+        {
+            return 0;
+        }
+
+        erase(it);
+
+        return 1;
+    }
+
     template <typename K, typename V, typename Compare, typename KeyContainer, typename ValueContainer>
     inline void flat_map<K, V, Compare, KeyContainer, ValueContainer>::swap(flat_map& other) noexcept
     {
@@ -740,6 +788,36 @@ namespace tempest
         return end();
     }
 
+    template <typename K, typename V, typename Compare, typename KeyContainer, typename ValueContainer>
+    template <typename Q>
+        requires detail::transparent_key_compare<Compare>
+    inline typename flat_map<K, V, Compare, KeyContainer, ValueContainer>::iterator flat_map<
+        K, V, Compare, KeyContainer, ValueContainer>::find(const Q& key)
+    {
+        auto it = tempest::lower_bound(tempest::begin(_keys), tempest::end(_keys), key, key_compare{});
+        if (it != tempest::end(_keys) && !key_compare{}(key, *it))
+        {
+            return {{&*it, &*tempest::next(tempest::begin(_values), tempest::distance(tempest::begin(_keys), it))}};
+        }
+
+        return end();
+    }
+
+    template <typename K, typename V, typename Compare, typename KeyContainer, typename ValueContainer>
+    template <typename Q>
+        requires detail::transparent_key_compare<Compare>
+    inline typename flat_map<K, V, Compare, KeyContainer, ValueContainer>::const_iterator flat_map<
+        K, V, Compare, KeyContainer, ValueContainer>::find(const Q& key) const
+    {
+        auto it = tempest::lower_bound(tempest::begin(_keys), tempest::end(_keys), key, key_compare{});
+        if (it != tempest::end(_keys) && !key_compare{}(key, *it))
+        {
+            return {{&*it, &*tempest::next(tempest::begin(_values), tempest::distance(tempest::begin(_keys), it))}};
+        }
+
+        return end();
+    }
+
     template <typename K, typename V, typename Compare, typename KeyContainer, typename ValueContainer>
     inline flat_map<K, V, Compare, KeyContainer, ValueContainer>::mapped_type& flat_map<
         K, V, Compare, KeyContainer, ValueContainer>::operator[](const key_type& key)
@@ -759,6 +837,28 @@ namespace tempest
         return *value_it;
     }
 
+    template <typename K, typename V, typename Compare, typename KeyContainer, typename ValueContainer>
+    template <typename Q>
+        requires(detail::transparent_key_compare<Compare> && is_constructible_v<K, const Q&>)
+    inline flat_map<K, V, Compare, KeyContainer, ValueContainer>::mapped_type& flat_map<
+        K, V, Compare, KeyContainer, ValueContainer>::operator[](const Q& key)
+    {
+        auto it = tempest::lower_bound(tempest::begin(_keys), tempest::end(_keys), key, key_compare{});
+        if (it != tempest::end(_keys) && !key_compare{}(key, *it))
+        {
+            return *tempest::next(tempest::begin(_values), tempest::distance(tempest::begin(_keys), it));
+        }
+
+        auto key_it = tempest::next(tempest::begin(_keys), tempest::distance(tempest::begin(_keys), it));
+        auto value_it = tempest::next(tempest::begin(_values), tempest::distance(tempest::begin(_keys), it));
+
+        // The key is only materialized when it is inserted
+        _keys.insert(key_it, K(key));
+        value_it = _values.insert(value_it, mapped_type{});
+
+        return *value_it;
+    }
+
     template <typename K, typename V, typename Compare, typename KeyContainer, typename ValueContainer>
     inline typename flat_map<K, V, Compare, KeyContainer, ValueContainer>::size_type flat_map<
         K, V, Compare, KeyContainer, ValueContainer>::count(const key_type& key) const
@@ -772,6 +872,23 @@ namespace tempest
         return find(key) != end();
     }
 
+    template <typename K, typename V, typename Compare, typename KeyContainer, typename ValueContainer>
+    template <typename Q>
+        requires detail::transparent_key_compare<Compare>
+    inline typename flat_map<K, V, Compare, KeyContainer, ValueContainer>::size_type flat_map<
+        K, V, Compare, KeyContainer, ValueContainer>::count(const Q& key) const
+    {
+        return find(key) != end() ? 1 : 0;
+    }
+
+    template <typename K, typename V, typename Compare, typename KeyContainer, typename ValueContainer>
+    template <typename Q>
+        requires detail::transparent_key_compare<Compare>
+    inline bool flat_map<K, V, Compare, KeyContainer, ValueContainer>::contains(const Q& key) const
+    {
+        return find(key) != end();
+    }
+
     template <typename K, typename V, typename Compare, typename KeyContainer, typename ValueContainer>
     inline typename flat_map<K, V, Compare, KeyContainer, ValueContainer>::iterator flat_map<
         K, V, Compare, KeyContainer, ValueContainer>::lower_bound(const key_type& key)
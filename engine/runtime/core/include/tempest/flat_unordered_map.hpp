@@ -13,6 +13,14 @@
 
 #include <compare>
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define TEMPEST_FLAT_UNORDERED_MAP_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define TEMPEST_FLAT_UNORDERED_MAP_NEON
+#endif
+
 namespace tempest
 {
     template <typename K, typename V, typename Hash, typename KeyEqual, typename Allocator>
@@ -44,19 +52,112 @@ namespace tempest
             bool is_deleted(metadata_entry e) const noexcept;
         };
 
+        /// @brief Group of metadata entries probed together. Matching a group produces a bit mask with bit i set if
+        /// entry i matches, computed with a single 16 byte comparison where SSE2 or NEON is available.
         struct TEMPEST_API metadata_group
         {
             static constexpr size_t group_size = 16;
 
-            metadata_entry entries[group_size]{};
+            alignas(group_size) metadata_entry entries[group_size]{};
 
             bool any_empty() const noexcept;
-            uint16_t match_byte(uint8_t h2) const noexcept;
             bool any_empty_or_deleted() const noexcept;
+
+            uint16_t match_byte(uint8_t h2) const noexcept;
+            uint16_t match_empty() const noexcept;
+            uint16_t match_empty_or_deleted() const noexcept;
+            uint16_t match_full() const noexcept;
         };
 
+        static_assert(sizeof(metadata_group) == metadata_group::group_size, "metadata_group must be 16 bytes");
+
+#if defined(TEMPEST_FLAT_UNORDERED_MAP_NEON)
+        inline uint16_t neon_movemask(uint8x16_t lanes) noexcept
+        {
+            // Keep one distinct bit per lane, then sum each half into a byte of the mask
+            alignas(16) static constexpr uint8_t lane_bits[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                                                  1, 2, 4, 8, 16, 32, 64, 128};
+            const auto masked = vandq_u8(lanes, vld1q_u8(lane_bits));
+            return static_cast<uint16_t>(vaddv_u8(vget_low_u8(masked)) | (vaddv_u8(vget_high_u8(masked)) << 8));
+        }
+#endif
+
+        inline bool metadata_group::any_empty() const noexcept
+        {
+            return match_empty() != 0;
+        }
+
+        inline bool metadata_group::any_empty_or_deleted() const noexcept
+        {
+            return match_empty_or_deleted() != 0;
+        }
+
+        inline uint16_t metadata_group::match_byte(uint8_t h2) const noexcept
+        {
+#if defined(TEMPEST_FLAT_UNORDERED_MAP_SSE2)
+            const auto group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(entries));
+            const auto matches = _mm_cmpeq_epi8(group, _mm_set1_epi8(static_cast<char>(h2)));
+            return static_cast<uint16_t>(_mm_movemask_epi8(matches));
+#elif defined(TEMPEST_FLAT_UNORDERED_MAP_NEON)
+            return neon_movemask(vceqq_u8(vld1q_u8(entries), vdupq_n_u8(h2)));
+#else
+            uint16_t result = 0;
+
+            for (size_t i = 0; i < group_size; ++i)
+            {
+                if (entries[i] == h2)
+                {
+                    result |= static_cast<uint16_t>(1 << i);
+                }
+            }
+
+            return result;
+#endif
+        }
+
+        inline uint16_t metadata_group::match_empty() const noexcept
+        {
+            return match_byte(empty_entry);
+        }
+
+        inline uint16_t metadata_group::match_empty_or_deleted() const noexcept
+        {
+            // Empty and deleted entries are the only ones with the high bit set
+#if defined(TEMPEST_FLAT_UNORDERED_MAP_SSE2)
+            const auto group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(entries));
+            return static_cast<uint16_t>(_mm_movemask_epi8(group));
+#elif defined(TEMPEST_FLAT_UNORDERED_MAP_NEON)
+            return neon_movemask(vcltzq_s8(vreinterpretq_s8_u8(vld1q_u8(entries))));
+#else
+            uint16_t result = 0;
+
+            for (size_t i = 0; i < group_size; ++i)
+            {
+                if ((entries[i] & 0x80) != 0)
+                {
+                    result |= static_cast<uint16_t>(1 << i);
+                }
+            }
+
+            return result;
+#endif
+        }
+
+        inline uint16_t metadata_group::match_full() const noexcept
+        {
+            return static_cast<uint16_t>(~match_empty_or_deleted());
+        }
+
         static_assert(sizeof(metadata_entry) == 1, "metadata_entry must be 1 byte");
 
+        /// @brief Satisfied if the hash and key equality functions of a map accept keys of any compatible type, so
+        /// lookups do not need to construct a key.
+        template <typename Hash, typename KeyEqual>
+        concept transparent_key_functions = requires {
+            typename Hash::is_transparent;
+            typename KeyEqual::is_transparent;
+        };
+
         template <typename K, typename V, typename Hash, typename KeyEqual, typename Allocator, bool Const>
         struct TEMPEST_API flat_unordered_map_iterator
         {
@@ -150,7 +251,7 @@ namespace tempest
     ///             the hash function should distribute bits uniformly across the size_t range.
     /// @tparam KeyEqual Key equality function. The key equality function must match the signature of std::equal_to.
     /// @tparam Allocator Allocator type conforming to the C++17 Allocator concept.
-    template <typename K, typename V, typename Hash = tempest::hash<K>, typename KeyEqual = tempest::equal_to<K>,
+    template <typename K, typename V, typename Hash = tempest::hash<K>, typename KeyEqual = tempest::equal_to<>,
               typename Allocator = allocator<tempest::pair<const K, V>>>
     class TEMPEST_API flat_unordered_map
     {
@@ -171,6 +272,7 @@ namespace tempest
         using const_iterator = detail::flat_unordered_map_iterator<K, V, Hash, KeyEqual, Allocator, true>;
 
         flat_unordered_map() noexcept = default;
+        explicit flat_unordered_map(const Allocator& alloc) noexcept;
         flat_unordered_map(const flat_unordered_map& other);
         flat_unordered_map(flat_unordered_map&& other) noexcept;
         ~flat_unordered_map();
@@ -195,8 +297,20 @@ namespace tempest
         iterator find(const K& key) noexcept;
         const_iterator find(const K& key) const noexcept;
 
+        template <typename Q>
+            requires detail::transparent_key_functions<Hash, KeyEqual>
+        iterator find(const Q& key) noexcept;
+
+        template <typename Q>
+            requires detail::transparent_key_functions<Hash, KeyEqual>
+        const_iterator find(const Q& key) const noexcept;
+
         [[nodiscard]] bool contains(const K& key) const noexcept;
 
+        template <typename Q>
+            requires detail::transparent_key_functions<Hash, KeyEqual>
+        [[nodiscard]] bool contains(const Q& key) const noexcept;
+
         detail::flat_unordered_map_insert_result<iterator> insert(const value_type& value);
         detail::flat_unordered_map_insert_result<iterator> insert(value_type&& value);
 
@@ -205,10 +319,20 @@ namespace tempest
 
         iterator erase(iterator pos);
         iterator erase(const K& key);
+
+        template <typename Q>
+            requires(detail::transparent_key_functions<Hash, KeyEqual> && !is_convertible_v<const Q&, iterator> &&
+                     !is_convertible_v<const Q&, const_iterator>)
+        iterator erase(const Q& key);
+
         void clear() noexcept;
 
         V& operator[](const K& key);
 
+        template <typename Q>
+            requires(detail::transparent_key_functions<Hash, KeyEqual> && is_constructible_v<K, const Q&>)
+        V& operator[](const Q& key);
+
         bool operator==(const flat_unordered_map& other) const noexcept;
         bool operator!=(const flat_unordered_map& other) const noexcept;
 
@@ -240,6 +364,9 @@ namespace tempest
         size_t _compute_default_growth(size_t requested) const noexcept;
         size_t _first_occupied_index() const noexcept;
 
+        template <typename Q>
+        size_t _find_index(const Q& key) const noexcept;
+
         uint64_t _get_h1(size_t hc) const noexcept;
         uint8_t _get_h2(size_t hc) const noexcept;
 
@@ -256,6 +383,12 @@ namespace tempest
         friend struct detail::flat_unordered_map_iterator<K, V, Hash, KeyEqual, Allocator, true>;
     };
 
+    template <typename K, typename V, typename Hash, typename KeyEqual, typename Allocator>
+    inline flat_unordered_map<K, V, Hash, KeyEqual, Allocator>::flat_unordered_map(const Allocator& alloc) noexcept
+        : _metadata_alloc{alloc}, _alloc{alloc}
+    {
+    }
+
     template <typename K, typename V, typename Hash, typename KeyEqual, typename Allocator>
     inline flat_unordered_map<K, V, Hash, KeyEqual, Allocator>::flat_unordered_map(const flat_unordered_map& other)
         : _page_count(other._page_count),
@@ -457,38 +590,25 @@ namespace tempest
     inline typename flat_unordered_map<K, V, Hash, KeyEqual, Allocator>::const_iterator flat_unordered_map<
         K, V, Hash, KeyEqual, Allocator>::find(const K& key) const noexcept
     {
-        auto hash = _hash(key);
-        auto h1 = _get_h1(hash);
-
-        // start probing
-        for (size_t i = 0; i < _page_count; ++i)
-        {
-            auto current_page = (h1 + i) % _page_count;
-            auto matches = _get_hash_match(_get_h2(hash), current_page);
-
-            for (size_t j = 0; j < _page_size; ++j)
-            {
-                if ((matches & (1 << j)) != 0)
-                {
-                    auto idx = current_page * _page_size + j;
-                    if (key_equal{}(_data_pages[current_page][j].first, key))
-                    {
-                        return const_iterator{idx, this};
-                    }
-                }
-            }
-
-            // If any of entries in the metadata page are empty, that means that there
-            // are no elements in the page beyond this, and thus the key was never inserted.
-            if (_match_empty(current_page))
-            {
-                break;
-            }
+        return const_iterator{_find_index(key), this};
+    }
 
-            TEMPEST_ASSERT(i < _page_count);
-        }
+    template <typename K, typename V, typename Hash, typename KeyEqual, typename Allocator>
+    template <typename Q>
+        requires detail::transparent_key_functions<Hash, KeyEqual>
+    inline typename flat_unordered_map<K, V, Hash, KeyEqual, Allocator>::iterator flat_unordered_map<
+        K, V, Hash, KeyEqual, Allocator>::find(const Q& key) noexcept
+    {
+        return iterator{_find_index(key), this};
+    }
 
-        return cend();
+    template <typename K, typename V, typename Hash, typename KeyEqual, typename Allocator>
+    template <typename Q>
+        requires detail::transparent_key_functions<Hash, KeyEqual>
+    inline typename flat_unordered_map<K, V, Hash, KeyEqual, Allocator>::const_iterator flat_unordered_map<
+        K, V, Hash, KeyEqual, Allocator>::find(const Q& key) const noexcept
+    {
+        return const_iterator{_find_index(key), this};
     }
 
     template <typename K, typename V, typename Hash, typename KeyEquals, typename Allocator>
@@ -497,6 +617,14 @@ namespace tempest
         return find(key) != cend();
     }
 
+    template <typename K, typename V, typename Hash, typename KeyEqual, typename Allocator>
+    template <typename Q>
+        requires detail::transparent_key_functions<Hash, KeyEqual>
+    inline bool flat_unordered_map<K, V, Hash, KeyEqual, Allocator>::contains(const Q& key) const noexcept
+    {
+        return find(key) != cend();
+    }
+
     template <typename K, typename V, typename Hash, typename KeyEqual, typename Allocator>
     inline detail::flat_unordered_map_insert_result<
         typename flat_unordered_map<K, V, Hash, KeyEqual, Allocator>::iterator>
@@ -512,7 +640,8 @@ namespace tempest
         auto h1 = _get_h1(hash);
         auto h2 = _get_h2(hash);
 
-        tempest::pair<uint32_t, uint32_t> next_empty{};
+        tempest::pair<size_t, size_t> next_empty{};
+        bool found_empty = false;
 
         // Find the slot in the map, check for the key already existing
         for (size_t i = 0; i < _page_count; ++i)
@@ -520,19 +649,22 @@ namespace tempest
             auto current_page = (h1 + i) % _page_count;
             auto matches = _get_hash_match(h2, current_page);
 
-            for (size_t j = 0; j < _page_size; ++j)
+            for (; matches != 0; matches &= static_cast<uint16_t>(matches - 1))
             {
-                if ((matches & (1 << j)) != 0)
+                auto j = static_cast<size_t>(countr_zero(matches));
+                if (key_equal{}(_data_pages[current_page][j].first, value.first))
                 {
-                    auto idx = current_page * _page_size + j;
-                    if (key_equal{}(_data_pages[current_page][j].first, value.first))
-                    {
-                        return {iterator{idx, this}, false};
-                    }
+                    return {iterator{current_page * _page_size + j, this}, false};
                 }
-                else if (!_metadata_strategy.is_full(_metadata_pages[current_page].entries[j]))
+            }
+
+            if (!found_empty)
+            {
+                auto available = _metadata_pages[current_page].match_empty_or_deleted();
+                if (available != 0)
                 {
-                    next_empty = {current_page, j};
+                    next_empty = {current_page, countr_zero(available)};
+                    found_empty = true;
                 }
             }
 
@@ -570,6 +702,7 @@ namespace tempest
         auto h2 = _get_h2(hash);
 
         tempest::pair<size_t, size_t> next_empty{};
+        bool found_empty = false;
 
         // Find the slot in the map, check for the key already existing
         for (size_t i = 0; i < _page_count; ++i)
@@ -577,19 +710,22 @@ namespace tempest
             auto current_page = (h1 + i) % _page_count;
             auto matches = _get_hash_match(h2, current_page);
 
-            for (size_t j = 0; j < _page_size; ++j)
+            for (; matches != 0; matches &= static_cast<uint16_t>(matches - 1))
             {
-                if ((matches & (1 << j)) != 0)
+                auto j = static_cast<size_t>(countr_zero(matches));
+                if (key_equal{}(_data_pages[current_page][j].first, value.first))
                 {
-                    auto idx = current_page * _page_size + j;
-                    if (key_equal{}(_data_pages[current_page][j].first, value.first))
-                    {
-                        return {iterator{idx, this}, false};
-                    }
+                    return {iterator{current_page * _page_size + j, this}, false};
                 }
-                else if (!_metadata_strategy.is_full(_metadata_pages[current_page].entries[j]))
+            }
+
+            if (!found_empty)
+            {
+                auto available = _metadata_pages[current_page].match_empty_or_deleted();
+                if (available != 0)
                 {
-                    next_empty = {current_page, j};
+                    next_empty = {current_page, countr_zero(available)};
+                    found_empty = true;
                 }
             }
 
@@ -645,6 +781,24 @@ namespace tempest
         return end();
     }
 
+    template <typename K, typename V, typename Hash, typename KeyEqual, typename Allocator>
+    template <typename Q>
+        requires(detail::transparent_key_functions<Hash, KeyEqual> && !is_convertible_v<const Q&, iterator> &&
+                 !is_convertible_v<const Q&, const_iterator>)
+    inline typename flat_unordered_map<K, V, Hash, KeyEqual, Allocator>::iterator flat_unordered_map<
+        K, V, Hash, KeyEqual, Allocator>::erase(const Q& key)
+    {
+        auto it = find(key);
+        if (it != end())
+        {
+            auto next = it;
+            ++next;
+            erase(it);
+            return next;
+        }
+        return end();
+    }
+
     template <typename K, typename V, typename Hash, typename KeyEqual, typename Allocator>
     inline void flat_unordered_map<K, V, Hash, KeyEqual, Allocator>::clear() noexcept
     {
@@ -678,6 +832,24 @@ namespace tempest
         return result.position->second;
     }
 
+    template <typename K, typename V, typename Hash, typename KeyEqual, typename Allocator>
+    template <typename Q>
+        requires(detail::transparent_key_functions<Hash, KeyEqual> && is_constructible_v<K, const Q&>)
+    inline V& flat_unordered_map<K, V, Hash, KeyEqual, Allocator>::operator[](const Q& key)
+    {
+        static_assert(is_default_constructible_v<V>, "Value type must be default constructible");
+
+        auto it = find(key);
+        if (it != end())
+        {
+            return it->second;
+        }
+
+        // The key is only materialized when it is inserted
+        auto result = insert({K(key), V{}});
+        return result.position->second;
+    }
+
     template <typename K, typename V, typename Hash, typename KeyEqual, typename Allocator>
     template <typename InputIt>
     inline void flat_unordered_map<K, V, Hash, KeyEqual, Allocator>::insert(InputIt first, InputIt last)
@@ -783,19 +955,42 @@ namespace tempest
     inline size_t flat_unordered_map<K, V, Hash, KeyEqual, Allocator>::_first_occupied_index() const noexcept
     {
         // TODO: Evaluate computing this value during insertions
+        return _next_occupied_index(0);
+    }
+
+    template <typename K, typename V, typename Hash, typename KeyEqual, typename Allocator>
+    template <typename Q>
+    inline size_t flat_unordered_map<K, V, Hash, KeyEqual, Allocator>::_find_index(const Q& key) const noexcept
+    {
+        auto hash = _hash(key);
+        auto h1 = _get_h1(hash);
+
+        // start probing
         for (size_t i = 0; i < _page_count; ++i)
         {
-            for (size_t j = 0; j < _page_size; ++j)
+            auto current_page = (h1 + i) % _page_count;
+            auto matches = _get_hash_match(_get_h2(hash), current_page);
+
+            for (; matches != 0; matches &= static_cast<uint16_t>(matches - 1))
             {
-                if (_metadata_strategy.is_full(_metadata_pages[i].entries[j]))
+                auto j = static_cast<size_t>(countr_zero(matches));
+                if (key_equal{}(_data_pages[current_page][j].first, key))
                 {
-                    return i * _page_size + j;
+                    return current_page * _page_size + j;
                 }
             }
+
+            // If any of entries in the metadata page are empty, that means that there
+            // are no elements in the page beyond this, and thus the key was never inserted.
+            if (_match_empty(current_page))
+            {
+                break;
+            }
+
+            TEMPEST_ASSERT(i < _page_count);
         }
 
-        // Table is empty
-        return 0;
+        return _page_count * _page_size;
     }
 
     template <typename K, typename V, typename Hash, typename KeyEqual, typename Allocator>
@@ -816,54 +1011,20 @@ namespace tempest
     inline uint16_t flat_unordered_map<K, V, Hash, KeyEqual, Allocator>::_get_hash_match(uint8_t h2,
                                                                                          size_t page) const noexcept
     {
-        // TODO: SIMD implementation
-
-        uint32_t result{0};
-
-        // For each entry in the metadata page, check if the hash matches the h2 value in the metadata. If it does,
-        // set the nth bit of the result to 1.
-        for (size_t i = 0; i < _page_size; ++i)
-        {
-            auto entry = _metadata_pages[page].entries[i];
-            auto match = _metadata_strategy.is_full(entry);
-            if (match && entry == h2)
-            {
-                result |= (1 << i);
-            }
-        }
-
-        return static_cast<uint16_t>(result);
+        // Entries holding h2 are always full, since h2 never has the high bit set
+        return _metadata_pages[page].match_byte(h2);
     }
 
     template <typename K, typename V, typename Hash, typename KeyEqual, typename Allocator>
     inline bool flat_unordered_map<K, V, Hash, KeyEqual, Allocator>::_match_empty(size_t page) const noexcept
     {
-        for (size_t i = 0; i < _page_size; ++i)
-        {
-            bool empty = _metadata_pages[page].entries[i] == detail::empty_entry;
-            if (empty)
-            {
-                return true;
-            }
-        }
-
-        return false;
+        return _metadata_pages[page].any_empty();
     }
 
     template <typename K, typename V, typename Hash, typename KeyEqual, typename Allocator>
     inline bool flat_unordered_map<K, V, Hash, KeyEqual, Allocator>::_match_empty_or_deleted(size_t page) const noexcept
     {
-        for (size_t i = 0; i < _page_size; ++i)
-        {
-            bool empty = _metadata_pages[page].entries[i] == detail::empty_entry;
-            bool deleted = _metadata_pages[page].entries[i] == detail::deleted_entry;
-            if (empty || deleted)
-            {
-                return true;
-            }
-        }
-
-        return false;
+        return _metadata_pages[page].any_empty_or_deleted();
     }
 
     template <typename K, typename V, typename Hash, typename KeyEqual, typename Allocator>
@@ -873,12 +1034,10 @@ namespace tempest
         for (size_t i = 0; i < page_count; ++i)
         {
             auto current_page = (h1 + i) % page_count;
-            for (size_t j = 0; j < _page_size; ++j)
+            auto available = pages[current_page].match_empty_or_deleted();
+            if (available != 0)
             {
-                if (!_metadata_strategy.is_full(pages[current_page].entries[j]))
-                {
-                    return tempest::pair<size_t, size_t>{current_page, j};
-                }
+                return tempest::pair<size_t, size_t>{current_page, countr_zero(available)};
             }
         }
 
@@ -894,12 +1053,11 @@ namespace tempest
 
         for (size_t i = current_page; i < _page_count; ++i)
         {
-            for (size_t j = current_slot; j < _page_size; ++j)
+            // Drop the slots before the search start in the first page
+            auto occupied = static_cast<uint16_t>(_metadata_pages[i].match_full() & (0xFFFFu << current_slot));
+            if (occupied != 0)
             {
-                if (_metadata_strategy.is_full(_metadata_pages[i].entries[j]))
-                {
-                    return i * _page_size + j;
-                }
+                return i * _page_size + countr_zero(occupied);
             }
 
             current_slot = 0;
@@ -1004,6 +1162,13 @@ namespace tempest
         }
         return old_size - c.size();
     }
+
+    namespace pmr
+    {
+        template <typename K, typename V, typename Hash = tempest::hash<K>, typename KeyEqual = tempest::equal_to<>>
+        using flat_unordered_map =
+            tempest::flat_unordered_map<K, V, Hash, KeyEqual, polymorphic_allocator<tempest::pair<const K, V>>>;
+    } // namespace pmr
 } // namespace tempest
 
 #endif // tempest_core_flat_unordered_map_hpp
\ No newline at end of file
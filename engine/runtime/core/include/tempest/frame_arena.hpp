@@ -0,0 +1,123 @@
+#ifndef tempest_core_frame_arena_hpp
+#define tempest_core_frame_arena_hpp
+
+#include <tempest/api.hpp>
+#include <tempest/atomic.hpp>
+#include <tempest/int.hpp>
+#include <tempest/memory.hpp>
+#include <tempest/mutex.hpp>
+#include <tempest/span.hpp>
+#include <tempest/type_traits.hpp>
+#include <tempest/vector.hpp>
+
+namespace tempest::core
+{
+    /// @brief Per-thread bump allocators for memory that lives until the frame that allocated it retires. Every thread
+    ///        that allocates from the arena is given its own region with one stack per frame in flight, so allocation
+    ///        never takes a lock once the thread has been registered. Allocations that do not fit in a region spill to
+    ///        the global heap and are released with the frame.
+    class TEMPEST_API frame_arena
+    {
+      public:
+        /// @brief Creates a frame arena.
+        /// @param bytes_per_frame Size of the bump region each thread is given for each frame in flight.
+        /// @param frames_in_flight Number of frames that may be in flight at once.
+        frame_arena(size_t bytes_per_frame, uint32_t frames_in_flight);
+        frame_arena(const frame_arena&) = delete;
+        frame_arena(frame_arena&&) noexcept = delete;
+        ~frame_arena();
+
+        frame_arena& operator=(const frame_arena&) = delete;
+        frame_arena& operator=(frame_arena&&) noexcept = delete;
+
+        /// @brief Retires the frame previously recorded into the given frame in flight slot and makes it the current
+        ///        frame. Every allocation made into the slot, from any thread, is released. Must only be called once
+        ///        the GPU work of the retiring frame has completed and no thread is allocating into the slot.
+        /// @param frame_in_flight Index of the frame in flight slot to begin, in [0, frames_in_flight()).
+        void begin_frame(uint32_t frame_in_flight);
+
+        /// @brief Allocates uninitialized memory from the calling thread's region for the current frame.
+        /// @param size Number of bytes to allocate.
+        /// @param alignment Alignment of the allocation.
+        /// @return Pointer to the memory, valid until the current frame retires. Null if size is zero.
+        [[nodiscard]] void* allocate(size_t size, size_t alignment, source_location loc = source_location::current());
+
+        /// @brief Allocates and value initializes an array from the calling thread's region for the current frame.
+        ///        Destructors are never run, so only trivially destructible types may be allocated.
+        /// @tparam T Type of the array elements
+        /// @param count Number of elements to allocate.
+        /// @return Array valid until the current frame retires.
+        template <typename T>
+        [[nodiscard]] span<T> allocate_array(size_t count, source_location loc = source_location::current());
+
+        /// @brief Fetches an allocator bound to the calling thread's region. Memory handed out by the allocator is
+        ///        valid until the frame current at the time of allocation retires, and deallocation is a no-op. The
+        ///        allocator may be used with the tempest::pmr containers for per-frame scratch data.
+        /// @return Allocator for the calling thread. Owned by the arena.
+        [[nodiscard]] abstract_allocator* thread_allocator();
+
+        [[nodiscard]] uint32_t frames_in_flight() const noexcept;
+        [[nodiscard]] uint32_t current_frame() const noexcept;
+
+        /// @brief Fetches the number of threads that have allocated from the arena.
+        [[nodiscard]] size_t thread_count() const noexcept;
+
+        /// @brief Fetches the number of bytes allocated into a frame in flight slot by every thread, including
+        ///        allocations that spilled to the heap.
+        [[nodiscard]] size_t bytes_allocated(uint32_t frame_in_flight) const noexcept;
+
+      private:
+        struct frame_region
+        {
+            stack_allocator stack;
+            vector<void*> overflow;
+            size_t overflow_bytes = 0;
+
+            explicit frame_region(size_t bytes);
+        };
+
+        class thread_region final : public abstract_allocator
+        {
+          public:
+            thread_region(frame_arena* owner, size_t bytes_per_frame, uint32_t frames_in_flight);
+            ~thread_region() override;
+
+            [[nodiscard]] void* allocate(size_t size, size_t alignment,
+                                         source_location loc = source_location::current()) override;
+            void deallocate(void* ptr) override;
+
+            void reset(uint32_t frame_in_flight);
+            [[nodiscard]] size_t bytes_allocated(uint32_t frame_in_flight) const noexcept;
+
+          private:
+            frame_arena* _owner;
+            vector<frame_region> _frames;
+        };
+
+        uint64_t _id;
+        size_t _bytes_per_frame;
+        uint32_t _frames_in_flight;
+        atomic<uint32_t> _current_frame{0};
+
+        mutable mutex _registration_lock;
+        vector<unique_ptr<thread_region>> _threads;
+
+        [[nodiscard]] thread_region& _this_thread_region();
+    };
+
+    template <typename T>
+    inline span<T> frame_arena::allocate_array(size_t count, source_location loc)
+    {
+        static_assert(is_trivially_destructible_v<T>, "frame_arena never runs destructors");
+
+        auto data = static_cast<T*>(allocate(sizeof(T) * count, alignof(T), loc));
+        for (size_t i = 0; i < count; ++i)
+        {
+            (void)tempest::construct_at(data + i);
+        }
+
+        return span<T>(data, count);
+    }
+} // namespace tempest::core
+
+#endif // tempest_core_frame_arena_hpp
@@ -709,6 +709,36 @@ namespace tempest
         return lhs <= rhs;
     }
 
+    /// @brief Transparent equality comparison, deducing the argument types. Enables heterogeneous lookup in
+    /// containers.
+    template <>
+    struct equal_to<void>
+    {
+        using is_transparent = void;
+
+        template <typename T, typename U>
+        constexpr auto operator()(T&& lhs, U&& rhs) const
+            -> decltype(tempest::forward<T>(lhs) == tempest::forward<U>(rhs))
+        {
+            return tempest::forward<T>(lhs) == tempest::forward<U>(rhs);
+        }
+    };
+
+    /// @brief Transparent less than comparison, deducing the argument types. Enables heterogeneous lookup in
+    /// containers.
+    template <>
+    struct less<void>
+    {
+        using is_transparent = void;
+
+        template <typename T, typename U>
+        constexpr auto operator()(T&& lhs, U&& rhs) const
+            -> decltype(tempest::forward<T>(lhs) < tempest::forward<U>(rhs))
+        {
+            return tempest::forward<T>(lhs) < tempest::forward<U>(rhs);
+        }
+    };
+
     template <typename T = void>
     struct plus;
 
@@ -34,9 +34,7 @@ namespace tempest
     {
         [[nodiscard]] size_t operator()(const guid& g) const noexcept
         {
-            uint64_t data_qwords[2];
-            tempest::detail::copy_bytes(g.data.data(), data_qwords, sizeof(data_qwords));
-            return detail::fnv1a64(data_qwords, 2);
+            return hash_bytes(g.data.data(), g.data.size());
         }
     };
 
@@ -79,6 +79,158 @@ namespace tempest
             return u64_hash(v);
         }
 
+        /// @brief Secret constants of the wyhash algorithm.
+        inline constexpr uint64_t wyhash_secret[4] = {
+            0x2d358dccaa6c78a5ull,
+            0x8bb84b93962eacc9ull,
+            0x4b33a62ed433d4a3ull,
+            0x4d5a2da51de1aa47ull,
+        };
+
+        /// @brief Computes the full 128 bit product of two 64 bit values, storing the low half in a and the high half
+        ///        in b.
+        inline constexpr void wyhash_multiply(uint64_t& a, uint64_t& b) noexcept
+        {
+#if defined(__SIZEOF_INT128__)
+            const auto product = static_cast<unsigned __int128>(a) * b;
+            a = static_cast<uint64_t>(product);
+            b = static_cast<uint64_t>(product >> 64);
+#else
+#if defined(_MSC_VER) && defined(_M_X64)
+            if (!is_constant_evaluated())
+            {
+                a = _umul128(a, b, &b);
+                return;
+            }
+#endif
+
+            const uint64_t a_high = a >> 32;
+            const uint64_t b_high = b >> 32;
+            const uint64_t a_low = static_cast<uint32_t>(a);
+            const uint64_t b_low = static_cast<uint32_t>(b);
+
+            const uint64_t high = a_high * b_high;
+            const uint64_t mid0 = a_high * b_low;
+            const uint64_t mid1 = b_high * a_low;
+            const uint64_t low = a_low * b_low;
+
+            const uint64_t t = low + (mid0 << 32);
+            uint64_t carry = t < low ? 1 : 0;
+            const uint64_t lo = t + (mid1 << 32);
+            carry += lo < t ? 1 : 0;
+
+            a = lo;
+            b = high + (mid0 >> 32) + (mid1 >> 32) + carry;
+#endif
+        }
+
+        inline constexpr uint64_t wyhash_mix(uint64_t a, uint64_t b) noexcept
+        {
+            wyhash_multiply(a, b);
+            return a ^ b;
+        }
+
+        // Loads are assembled from individual bytes in little endian order so they are usable in constant
+        // expressions. Compilers fold the pattern into a single unaligned load.
+
+        template <typename C>
+        inline constexpr uint64_t wyhash_read8(const C* p) noexcept
+        {
+            uint64_t v = 0;
+            for (size_t i = 0; i < 8; ++i)
+            {
+                v |= static_cast<uint64_t>(static_cast<uint8_t>(p[i])) << (i * 8);
+            }
+            return v;
+        }
+
+        template <typename C>
+        inline constexpr uint64_t wyhash_read4(const C* p) noexcept
+        {
+            uint64_t v = 0;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                v |= static_cast<uint64_t>(static_cast<uint8_t>(p[i])) << (i * 8);
+            }
+            return v;
+        }
+
+        template <typename C>
+        inline constexpr uint64_t wyhash_read3(const C* p, size_t k) noexcept
+        {
+            return (static_cast<uint64_t>(static_cast<uint8_t>(p[0])) << 16) |
+                   (static_cast<uint64_t>(static_cast<uint8_t>(p[k >> 1])) << 8) |
+                   static_cast<uint64_t>(static_cast<uint8_t>(p[k - 1]));
+        }
+
+        /// @brief Hashes a range of bytes with wyhash (final version 4). Input is consumed 48 bytes per iteration
+        ///        through three independent multiply-mix lanes, and every output bit, including the upper 7 bits used
+        ///        by flat_unordered_map metadata, depends on every input byte. Usable in constant expressions.
+        /// @tparam C Byte sized character type
+        /// @param data Bytes to hash
+        /// @param len Number of bytes
+        /// @param seed Seed of the hash
+        /// @return Hashed value
+        template <typename C>
+            requires(sizeof(C) == 1)
+        inline constexpr uint64_t wyhash(const C* data, size_t len, uint64_t seed = 0) noexcept
+        {
+            const C* p = data;
+            seed ^= wyhash_mix(seed ^ wyhash_secret[0], wyhash_secret[1]);
+
+            uint64_t a = 0;
+            uint64_t b = 0;
+
+            if (len <= 16)
+            {
+                if (len >= 4)
+                {
+                    const auto offset = (len >> 3) << 2;
+                    a = (wyhash_read4(p) << 32) | wyhash_read4(p + offset);
+                    b = (wyhash_read4(p + len - 4) << 32) | wyhash_read4(p + len - 4 - offset);
+                }
+                else if (len > 0)
+                {
+                    a = wyhash_read3(p, len);
+                }
+            }
+            else
+            {
+                size_t i = len;
+                if (i > 48)
+                {
+                    uint64_t seed1 = seed;
+                    uint64_t seed2 = seed;
+                    do
+                    {
+                        seed = wyhash_mix(wyhash_read8(p) ^ wyhash_secret[1], wyhash_read8(p + 8) ^ seed);
+                        seed1 = wyhash_mix(wyhash_read8(p + 16) ^ wyhash_secret[2], wyhash_read8(p + 24) ^ seed1);
+                        seed2 = wyhash_mix(wyhash_read8(p + 32) ^ wyhash_secret[3], wyhash_read8(p + 40) ^ seed2);
+                        p += 48;
+                        i -= 48;
+                    } while (i > 48);
+
+                    seed ^= seed1 ^ seed2;
+                }
+
+                while (i > 16)
+                {
+                    seed = wyhash_mix(wyhash_read8(p) ^ wyhash_secret[1], wyhash_read8(p + 8) ^ seed);
+                    i -= 16;
+                    p += 16;
+                }
+
+                a = wyhash_read8(p + i - 16);
+                b = wyhash_read8(p + i - 8);
+            }
+
+            a ^= wyhash_secret[1];
+            b ^= seed;
+            wyhash_multiply(a, b);
+
+            return wyhash_mix(a ^ wyhash_secret[0] ^ len, b ^ wyhash_secret[1]);
+        }
+
         template <typename T>
         inline uint32_t fnv1a32(const T* data, size_t sz) noexcept
         {
@@ -125,6 +277,51 @@ namespace tempest
         }
     } // namespace detail
 
+    /// @brief Hashes an arbitrary range of bytes.
+    /// @param data Bytes to hash
+    /// @param size Number of bytes
+    /// @param seed Seed of the hash
+    /// @return Hashed value
+    inline size_t hash_bytes(const void* data, size_t size, uint64_t seed = 0) noexcept
+    {
+        return static_cast<size_t>(detail::wyhash(static_cast<const unsigned char*>(data), size, seed));
+    }
+
+    namespace detail
+    {
+        /// @brief Hashes a sequence of characters. Wider characters are hashed through their object representation,
+        ///        which is rebuilt byte by byte in constant expressions. Assumes a little endian target.
+        template <typename C>
+        inline constexpr size_t hash_chars(const C* data, size_t len) noexcept
+        {
+            if constexpr (sizeof(C) == 1)
+            {
+                return static_cast<size_t>(wyhash(data, len));
+            }
+            else
+            {
+                if (is_constant_evaluated())
+                {
+                    auto bytes = new unsigned char[len * sizeof(C)];
+                    for (size_t i = 0; i < len; ++i)
+                    {
+                        for (size_t b = 0; b < sizeof(C); ++b)
+                        {
+                            bytes[i * sizeof(C) + b] =
+                                static_cast<unsigned char>(static_cast<uint64_t>(data[i]) >> (b * 8));
+                        }
+                    }
+
+                    const auto result = static_cast<size_t>(wyhash(bytes, len * sizeof(C)));
+                    delete[] bytes;
+                    return result;
+                }
+
+                return hash_bytes(data, len * sizeof(C));
+            }
+        }
+    } // namespace detail
+
     /// @brief Templated hash function.
     /// @tparam T type of the key to hash.
     ///
@@ -0,0 +1,343 @@
+#ifndef tempest_core_job_system_hpp
+#define tempest_core_job_system_hpp
+
+#include <tempest/algorithm.hpp>
+#include <tempest/api.hpp>
+#include <tempest/atomic.hpp>
+#include <tempest/concepts.hpp>
+#include <tempest/deque.hpp>
+#include <tempest/functional.hpp>
+#include <tempest/int.hpp>
+#include <tempest/memory.hpp>
+#include <tempest/mutex.hpp>
+#include <tempest/span.hpp>
+#include <tempest/thread.hpp>
+#include <tempest/vector.hpp>
+
+namespace tempest::core
+{
+    class job_system;
+
+    /// @brief Tracks the number of outstanding jobs in a group. A counter must outlive every job submitted against it.
+    class TEMPEST_API job_counter
+    {
+      public:
+        job_counter() noexcept = default;
+        job_counter(const job_counter&) = delete;
+        job_counter(job_counter&&) noexcept = delete;
+        ~job_counter() = default;
+
+        job_counter& operator=(const job_counter&) = delete;
+        job_counter& operator=(job_counter&&) noexcept = delete;
+
+        /// @brief Fetches the number of jobs that have been submitted against the counter but have not finished.
+        /// @return Number of pending jobs.
+        [[nodiscard]] uint32_t pending() const noexcept;
+
+        /// @brief Checks if every job submitted against the counter has finished.
+        /// @return True if no jobs are pending, false otherwise.
+        [[nodiscard]] bool is_complete() const noexcept;
+
+      private:
+        atomic<uint32_t> _pending{0};
+
+        void _add(uint32_t count) noexcept;
+
+        // Returns true if the released job was the last one pending. The counter may be destroyed by a waiter as soon
+        // as it reaches zero, so it must not be touched afterwards.
+        [[nodiscard]] bool _release() noexcept;
+
+        friend class job_system;
+    };
+
+    namespace detail
+    {
+        struct job_state
+        {
+            job_counter counter;
+            atomic<uint32_t> references{0};
+        };
+
+        struct job
+        {
+            function<void()> fn;
+
+            void (*range_fn)(const void*, size_t, size_t) = nullptr;
+            const void* range_ctx = nullptr;
+            size_t first = 0;
+            size_t last = 0;
+
+            job_counter* counter = nullptr;
+            job_state* state = nullptr;
+        };
+
+        /// @brief Fixed capacity Chase-Lev work stealing deque. The owning worker pushes and pops from the bottom, any
+        ///        other thread may steal from the top.
+        class TEMPEST_API work_stealing_deque
+        {
+          public:
+            static constexpr int64_t capacity = 4096;
+
+            work_stealing_deque() noexcept = default;
+            work_stealing_deque(const work_stealing_deque&) = delete;
+            work_stealing_deque(work_stealing_deque&&) noexcept = delete;
+            ~work_stealing_deque() = default;
+
+            work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+            work_stealing_deque& operator=(work_stealing_deque&&) noexcept = delete;
+
+            /// @brief Pushes a job onto the bottom of the deque. Only the owning thread may push.
+            /// @param j Job to push.
+            /// @return True if the job was pushed, false if the deque is full.
+            [[nodiscard]] bool push(job* j) noexcept;
+
+            /// @brief Pops the most recently pushed job. Only the owning thread may pop.
+            /// @return Popped job, or nullptr if the deque is empty.
+            [[nodiscard]] job* pop() noexcept;
+
+            /// @brief Steals the oldest job in the deque. May be called from any thread.
+            /// @return Stolen job, or nullptr if the deque is empty or the steal lost a race.
+            [[nodiscard]] job* steal() noexcept;
+
+            [[nodiscard]] bool empty() const noexcept;
+
+          private:
+            static constexpr int64_t _mask = capacity - 1;
+
+            alignas(64) atomic<int64_t> _top{0};
+            alignas(64) atomic<int64_t> _bottom{0};
+            alignas(64) atomic<job*> _slots[capacity]{};
+        };
+
+        static_assert((work_stealing_deque::capacity & (work_stealing_deque::capacity - 1)) == 0,
+                      "work_stealing_deque capacity must be a power of two");
+    } // namespace detail
+
+    /// @brief Handle to a single submitted job. Dropping the handle does not cancel the job.
+    class TEMPEST_API job_handle
+    {
+      public:
+        job_handle() noexcept = default;
+        job_handle(const job_handle& other) noexcept;
+        job_handle(job_handle&& other) noexcept;
+        ~job_handle();
+
+        job_handle& operator=(const job_handle& rhs) noexcept;
+        job_handle& operator=(job_handle&& rhs) noexcept;
+
+        /// @brief Checks if the handle refers to a submitted job.
+        [[nodiscard]] bool valid() const noexcept;
+
+        /// @brief Checks if the job referred to by the handle has finished. Invalid handles are always complete.
+        [[nodiscard]] bool is_complete() const noexcept;
+
+      private:
+        detail::job_state* _state{nullptr};
+
+        explicit job_handle(detail::job_state* state) noexcept;
+
+        friend class job_system;
+    };
+
+    /// @brief Pool of worker threads executing jobs. Each worker owns a work stealing deque; jobs submitted from a
+    ///        worker are pushed onto its own deque, jobs submitted from any other thread are pushed onto a shared
+    ///        injection queue. Idle workers steal from their peers before going to sleep.
+    class TEMPEST_API job_system
+    {
+      public:
+        /// @brief Creates a job system.
+        /// @param worker_count Number of worker threads to spawn. If zero, one worker is spawned for every hardware
+        ///                     thread except the calling thread.
+        explicit job_system(uint32_t worker_count = 0);
+        job_system(const job_system&) = delete;
+        job_system(job_system&&) noexcept = delete;
+        ~job_system();
+
+        job_system& operator=(const job_system&) = delete;
+        job_system& operator=(job_system&&) noexcept = delete;
+
+        /// @brief Submits a job.
+        /// @param fn Job to execute.
+        /// @return Handle that can be waited on.
+        job_handle submit(function<void()> fn);
+
+        /// @brief Submits a job, incrementing the counter until the job completes.
+        /// @param fn Job to execute.
+        /// @param counter Counter to track the job with. Must outlive the job.
+        void submit(function<void()> fn, job_counter& counter);
+
+        /// @brief Blocks until every job tracked by the counter has finished. The calling thread executes pending jobs
+        ///        while it waits.
+        /// @param counter Counter to wait on.
+        void wait(const job_counter& counter);
+
+        /// @brief Blocks until the job referred to by the handle has finished. The calling thread executes pending
+        ///        jobs while it waits.
+        /// @param handle Handle to wait on.
+        void wait(const job_handle& handle);
+
+        /// @brief Splits [first, last) into chunks of at most grain_size indices and executes them across the workers.
+        ///        Blocks until every chunk has finished, executing chunks on the calling thread as well.
+        /// @param first First index in the range.
+        /// @param last One past the last index in the range.
+        /// @param grain_size Maximum number of indices per chunk. If zero, a grain size is picked from the worker
+        ///                   count.
+        /// @param fn Callable invoked either as fn(first, last) per chunk or as fn(index) per index.
+        template <typename Fn>
+        void parallel_for(size_t first, size_t last, size_t grain_size, Fn&& fn);
+
+        /// @brief Splits [first, last) into chunks and submits them without blocking. The callable is copied into the
+        ///        job system and lives until the last chunk completes.
+        /// @param first First index in the range.
+        /// @param last One past the last index in the range.
+        /// @param grain_size Maximum number of indices per chunk. If zero, a grain size is picked from the worker
+        ///                   count.
+        /// @param fn Callable invoked either as fn(first, last) per chunk or as fn(index) per index.
+        /// @param counter Counter incremented once per chunk. Must outlive the submitted chunks.
+        template <typename Fn>
+        void parallel_for(size_t first, size_t last, size_t grain_size, Fn&& fn, job_counter& counter);
+
+        /// @brief Fetches the number of worker threads owned by the job system.
+        [[nodiscard]] uint32_t worker_count() const noexcept;
+
+        /// @brief Fetches the index of the calling worker thread.
+        /// @return Index of the worker in [0, worker_count()), or worker_count() if the caller is not a worker of this
+        ///         job system.
+        [[nodiscard]] uint32_t current_worker_index() const noexcept;
+
+      private:
+        struct worker
+        {
+            detail::work_stealing_deque queue;
+            thread handle;
+        };
+
+        vector<unique_ptr<worker>> _workers;
+
+        mutex _injection_lock;
+        deque<detail::job*> _injection_queue;
+        atomic<uint32_t> _injection_count{0};
+
+        atomic<uint32_t> _work_epoch{0};
+        atomic<uint32_t> _sleeping_workers{0};
+        atomic<uint32_t> _stopping{0};
+
+        // Bumped whenever a counter reaches zero. Blocked waiters sleep on the epoch rather than on the counter, which
+        // the waiter may destroy as soon as it observes zero.
+        atomic<uint32_t> _completion_epoch{0};
+        atomic<uint32_t> _blocked_waiters{0};
+
+        void _worker_main(uint32_t index);
+        void _enqueue(span<detail::job*> jobs);
+        [[nodiscard]] detail::job* _find_job(uint32_t index);
+        void _execute(detail::job* j);
+        void _wake_workers(uint32_t count);
+        [[nodiscard]] size_t _chunk_size(size_t count, size_t grain_size) const noexcept;
+
+        template <typename Fn>
+        static void _invoke_range(const void* ctx, size_t first, size_t last);
+
+        template <typename Fn>
+        void _dispatch_range(size_t first, size_t last, size_t chunk, const Fn* fn, job_counter& counter);
+    };
+
+    template <typename Fn>
+    inline void job_system::_invoke_range(const void* ctx, size_t first, size_t last)
+    {
+        auto& fn = *static_cast<Fn*>(const_cast<void*>(ctx));
+
+        if constexpr (invocable<Fn&, size_t, size_t>)
+        {
+            fn(first, last);
+        }
+        else
+        {
+            static_assert(invocable<Fn&, size_t>, "parallel_for callable must accept (size_t) or (size_t, size_t)");
+
+            for (size_t i = first; i < last; ++i)
+            {
+                fn(i);
+            }
+        }
+    }
+
+    template <typename Fn>
+    inline void job_system::_dispatch_range(size_t first, size_t last, size_t chunk, const Fn* fn,
+                                            job_counter& counter)
+    {
+        const auto chunk_count = (last - first + chunk - 1) / chunk;
+
+        vector<detail::job*> jobs;
+        jobs.reserve(chunk_count);
+
+        for (size_t begin = first; begin < last; begin += chunk)
+        {
+            auto j = new detail::job{};
+            j->range_fn = &_invoke_range<Fn>;
+            j->range_ctx = fn;
+            j->first = begin;
+            j->last = tempest::min(begin + chunk, last);
+            j->counter = &counter;
+            jobs.push_back(j);
+        }
+
+        counter._add(static_cast<uint32_t>(jobs.size()));
+        _enqueue(jobs);
+    }
+
+    template <typename Fn>
+    inline void job_system::parallel_for(size_t first, size_t last, size_t grain_size, Fn&& fn)
+    {
+        if (first >= last)
+        {
+            return;
+        }
+
+        using fn_type = remove_reference_t<Fn>;
+
+        const auto chunk = _chunk_size(last - first, grain_size);
+
+        // Run the first chunk on the calling thread, the rest are dispatched to the workers
+        const auto inline_last = tempest::min(first + chunk, last);
+        if (inline_last == last)
+        {
+            _invoke_range<fn_type>(addressof(fn), first, last);
+            return;
+        }
+
+        job_counter counter;
+        _dispatch_range(inline_last, last, chunk, addressof(fn), counter);
+        _invoke_range<fn_type>(addressof(fn), first, inline_last);
+        wait(counter);
+    }
+
+    template <typename Fn>
+    inline void job_system::parallel_for(size_t first, size_t last, size_t grain_size, Fn&& fn, job_counter& counter)
+    {
+        if (first >= last)
+        {
+            return;
+        }
+
+        const auto chunk = _chunk_size(last - first, grain_size);
+
+        // The callable is shared between all chunks and released by a trailing job tracked by an internal counter
+        struct shared_range
+        {
+            decay_t<Fn> fn;
+            job_counter chunks;
+        };
+
+        auto shared = new shared_range{tempest::forward<Fn>(fn), {}};
+        _dispatch_range(first, last, chunk, addressof(shared->fn), shared->chunks);
+
+        submit(
+            [this, shared]() {
+                wait(shared->chunks);
+                delete shared;
+            },
+            counter);
+    }
+} // namespace tempest::core
+
+#endif // tempest_core_job_system_hpp
@@ -196,6 +196,14 @@ namespace tempest
     {
     };
 
+    namespace detail
+    {
+        // Hooks reporting to core::allocation_tracker. They return immediately unless tracking is enabled.
+        TEMPEST_API void track_allocation(const void* ptr, size_t size, source_location loc) noexcept;
+        TEMPEST_API void track_transient_allocation(size_t size, source_location loc) noexcept;
+        TEMPEST_API void track_deallocation(const void* ptr) noexcept;
+    } // namespace detail
+
     class TEMPEST_API abstract_allocator
     {
       public:
@@ -204,6 +212,8 @@ namespace tempest
         virtual void deallocate(void* ptr) = 0;
     };
 
+    /// @brief Bump allocator over a fixed size buffer. Deallocating the most recent allocation returns its memory to
+    /// the stack; deallocating any other allocation is deferred until the stack is reset or rewound to a marker.
     class TEMPEST_API stack_allocator final : public abstract_allocator
     {
       public:
@@ -223,6 +233,8 @@ namespace tempest
         size_t get_marker() const noexcept;
         void free_marker(size_t marker);
 
+        size_t capacity() const noexcept;
+
         void release();
         void reset();
 
@@ -237,12 +249,26 @@ namespace tempest
         byte* _buffer{0};
         size_t _capacity{0};
         size_t _allocated_bytes{0};
+        size_t _last_allocation{0};
     };
 
+    /// @brief General purpose allocator over a fixed size block of memory. Allocations of at most
+    /// small_object_max_size bytes with at most small_object_alignment alignment are served from per-thread caches of
+    /// fixed size classes, carved out of an optional region reserved for small objects. Everything else, and small
+    /// objects once the small object region is exhausted, goes through a TLSF heap guarded by a lock. The small object
+    /// region is never returned to the TLSF heap, so it is not available to larger allocations. The allocator may be
+    /// used from multiple threads at once.
     class TEMPEST_API heap_allocator final : public abstract_allocator
     {
       public:
-        explicit heap_allocator(size_t bytes);
+        static constexpr size_t small_object_max_size = 256;
+        static constexpr size_t small_object_alignment = 16;
+
+        /// @brief Creates a heap allocator.
+        /// @param bytes Total number of bytes managed by the allocator, including the small object region.
+        /// @param small_object_region_bytes Number of bytes reserved for small objects, rounded down to a whole number
+        /// of 16 KiB slabs. Defaults to none, leaving every allocation to the TLSF heap.
+        explicit heap_allocator(size_t bytes, size_t small_object_region_bytes = 0);
         heap_allocator(const heap_allocator&) = delete;
         heap_allocator(heap_allocator&& other) noexcept;
         ~heap_allocator() override;
@@ -255,14 +281,38 @@ namespace tempest
         void deallocate(void* ptr) override;
 
       private:
+        struct shared_state;
+
         void* _tlsf_handle{nullptr};
         byte* _memory{nullptr};
         size_t _allocated_size{0};
         size_t _max_size{0};
+        shared_state* _state{nullptr};
 
+        void* _allocate_large(size_t size, size_t alignment);
         void _release();
     };
 
+    /// @brief Allocator forwarding to the global aligned heap. Used as the default allocator for polymorphic
+    /// allocators that are not given an allocator explicitly.
+    class TEMPEST_API new_delete_allocator final : public abstract_allocator
+    {
+      public:
+        [[nodiscard]] void* allocate(size_t size, size_t alignment,
+                                     source_location loc = source_location::current()) override;
+        void deallocate(void* ptr) override;
+    };
+
+    /// @brief Gets the allocator used by default constructed polymorphic allocators.
+    /// @return Default allocator. Never null.
+    TEMPEST_API abstract_allocator* get_default_allocator() noexcept;
+
+    /// @brief Sets the allocator used by default constructed polymorphic allocators. Containers that already hold a
+    /// polymorphic allocator are not affected.
+    /// @param alloc New default allocator. If null, the global heap allocator is restored.
+    /// @return Previous default allocator.
+    TEMPEST_API abstract_allocator* set_default_allocator(abstract_allocator* alloc) noexcept;
+
     template <typename T, size_t N>
     struct aligned_storage
     {
@@ -297,14 +347,16 @@ namespace tempest
         allocator& operator=(const allocator&) noexcept = default;
         allocator& operator=(allocator&&) noexcept = default;
 
-        [[nodiscard]] constexpr T* allocate(size_t n)
+        [[nodiscard]] constexpr T* allocate(size_t n, source_location loc = source_location::current())
         {
             void* data = ::operator new[](sizeof(T) * n, std::align_val_t(alignof(T)), std::nothrow);
+            detail::track_allocation(data, sizeof(T) * n, loc);
             return static_cast<T*>(data);
         }
 
         void deallocate(T* ptr, [[maybe_unused]] size_t n)
         {
+            detail::track_deallocation(ptr);
             ::operator delete[](ptr, std::align_val_t(alignof(T)), std::nothrow);
         }
     };
@@ -315,6 +367,67 @@ namespace tempest
         return true;
     }
 
+    /// @brief Allocator that forwards all requests to a non-owning abstract_allocator, so stack, heap or user defined
+    /// allocators can back the standard containers. Two polymorphic allocators are equal if they forward to the same
+    /// allocator. Containers take the source's allocator on copy construction, move construction and move assignment,
+    /// and vector::swap exchanges allocators along with the storage, so memory is always released through the allocator
+    /// that provided it. Copy assignment of a vector keeps the destination's allocator, copy assignment of a
+    /// flat_unordered_map takes the source's.
+    /// @tparam T Type of the elements to allocate
+    template <typename T>
+    class TEMPEST_API polymorphic_allocator
+    {
+      public:
+        using value_type = T;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+
+        polymorphic_allocator() noexcept : _alloc{get_default_allocator()}
+        {
+        }
+
+        polymorphic_allocator(abstract_allocator* alloc) noexcept : _alloc{alloc}
+        {
+        }
+
+        polymorphic_allocator(const polymorphic_allocator&) noexcept = default;
+
+        template <typename U>
+        polymorphic_allocator(const polymorphic_allocator<U>& other) noexcept : _alloc{other.resource()}
+        {
+        }
+
+        polymorphic_allocator& operator=(const polymorphic_allocator&) noexcept = default;
+
+        [[nodiscard]] T* allocate(size_t n, source_location loc = source_location::current())
+        {
+            return static_cast<T*>(_alloc->allocate(sizeof(T) * n, alignof(T), loc));
+        }
+
+        void deallocate(T* ptr, [[maybe_unused]] size_t n)
+        {
+            if (ptr != nullptr)
+            {
+                _alloc->deallocate(ptr);
+            }
+        }
+
+        [[nodiscard]] abstract_allocator* resource() const noexcept
+        {
+            return _alloc;
+        }
+
+      private:
+        abstract_allocator* _alloc; // non-owning
+    };
+
+    template <typename T, typename U>
+    [[nodiscard]] inline bool operator==(const polymorphic_allocator<T>& lhs,
+                                         const polymorphic_allocator<U>& rhs) noexcept
+    {
+        return lhs.resource() == rhs.resource();
+    }
+
     template <typename T>
     concept propagate_on_container_copy_assignment =
         requires(T t) { typename T::propagate_on_container_copy_assignment; };
@@ -394,6 +507,18 @@ namespace tempest
         {
             using type = typename Alloc::select_on_container_copy_construction;
         };
+
+        template <typename Alloc, typename U>
+        struct rebind_alloc
+        {
+            using type = allocator<U>;
+        };
+
+        template <typename U, template <typename, typename...> typename Alloc, typename T, typename... Args>
+        struct rebind_alloc<Alloc<T, Args...>, U>
+        {
+            using type = Alloc<U, Args...>;
+        };
     } // namespace detail
 
     template <typename Alloc>
@@ -418,7 +543,7 @@ namespace tempest
         using is_always_equal = typename detail::is_always_equal<Alloc>::type;
 
         template <typename T>
-        using rebind_alloc = allocator<T>;
+        using rebind_alloc = typename detail::rebind_alloc<Alloc, T>::type;
 
         template <typename T>
         using rebind_traits = allocator_traits<rebind_alloc<T>>;
@@ -441,7 +566,16 @@ namespace tempest
     inline constexpr allocator_traits<Alloc>::pointer allocator_traits<Alloc>::allocate(allocator_type& alloc,
                                                                                         size_type n)
     {
-        return alloc.allocate(n);
+        // The allocator's defaulted source location would name this line for every container, an empty location
+        // makes the allocation tracker attribute the allocation by call stack instead
+        if constexpr (requires { alloc.allocate(n, source_location{}); })
+        {
+            return alloc.allocate(n, source_location{});
+        }
+        else
+        {
+            return alloc.allocate(n);
+        }
     }
 
     template <typename Alloc>
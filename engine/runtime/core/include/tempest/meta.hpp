@@ -266,26 +266,6 @@ namespace tempest::core
             }
         };
 
-        // FN1VA Hash - https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function
-        template <typename>
-        struct fnv1a_traits;
-
-        template <>
-        struct fnv1a_traits<uint32_t>
-        {
-            using type = uint32_t;
-            static constexpr uint32_t offset = 2166136261;
-            static constexpr uint32_t prime = 16777619;
-        };
-
-        template <>
-        struct fnv1a_traits<uint64_t>
-        {
-            using type = uint64_t;
-            static constexpr uint64_t offset = 14695981039346656037ull;
-            static constexpr uint64_t prime = 1099511628211ull;
-        };
-
         template <typename C>
         struct hash_string_base
         {
@@ -302,7 +282,6 @@ namespace tempest::core
         class basic_hash_string : hash_string_base<C>
         {
             using base_type = hash_string_base<C>;
-            using hash_traits_type = fnv1a_traits<typename base_type::hash_type>;
 
             struct const_str_wrapper
             {
@@ -315,31 +294,21 @@ namespace tempest::core
 
             [[nodiscard]] static constexpr auto hash(const C* str) noexcept
             {
-                hash_string_base<C> base{str, 0, hash_traits_type::offset};
+                hash_string_base<C> base{str, 0, 0};
 
                 while (str[base.length] != 0)
                 {
-                    base.hash =
-                        (base.hash ^ static_cast<hash_traits_type::type>(str[base.length])) * hash_traits_type::prime;
-
                     base.length++;
                 }
 
+                base.hash = tempest::detail::hash_chars(str, base.length);
+
                 return base;
             }
 
             [[nodiscard]] static constexpr auto hash(const C* str, size_t len) noexcept
             {
-                hash_string_base<C> base{str, 0, hash_traits_type::offset};
-
-                for (size_type pos{}; pos < len; ++pos)
-                {
-                    base.hash = (base.hash ^ static_cast<hash_traits_type::type>(str[pos])) * hash_traits_type::prime;
-
-                    base.length++;
-                }
-
-                return base;
+                return hash_string_base<C>{str, len, tempest::detail::hash_chars(str, len)};
             }
 
           public:
@@ -2,9 +2,12 @@
 #define tempest_core_object_pool_hpp
 
 #include <tempest/api.hpp>
+#include <tempest/atomic.hpp>
 #include <tempest/compare.hpp>
 #include <tempest/int.hpp>
 #include <tempest/memory.hpp>
+#include <tempest/mutex.hpp>
+#include <tempest/vector.hpp>
 
 namespace tempest::core
 {
@@ -84,6 +87,81 @@ namespace tempest::core
         uint32_t _free_index_head;
         uint32_t _used_index_count;
     };
+
+    /// @brief Fixed capacity pool that may be shared between threads. Resources are acquired and released without
+    ///        taking a lock, and keys follow the same index and generation semantics as generational_object_pool, so
+    ///        stale keys are rejected by access and release. Unlike generational_object_pool, resources are never
+    ///        moved, so pointers returned by access stay valid until the resource is released.
+    class TEMPEST_API concurrent_object_pool
+    {
+      public:
+        using key = generational_object_pool::key;
+
+        inline static constexpr key invalid_key = generational_object_pool::invalid_key;
+
+        /// @brief Creates a concurrent object pool.
+        /// @param alloc Allocator backing the pool. Non-owning.
+        /// @param pool_size Number of resources in the pool.
+        /// @param resource_size Size of a single resource in bytes.
+        /// @param thread_cache_size Number of free slots each thread may keep to itself, avoiding contention on the
+        ///        shared free list. Zero disables thread caches. Slots cached by a thread are not visible to other
+        ///        threads, so acquisition may fail before every slot is in use.
+        concurrent_object_pool(abstract_allocator* alloc, uint32_t pool_size, uint32_t resource_size,
+                               uint32_t thread_cache_size = 0);
+        concurrent_object_pool(const concurrent_object_pool&) = delete;
+        concurrent_object_pool(concurrent_object_pool&&) noexcept = delete;
+        ~concurrent_object_pool();
+
+        concurrent_object_pool& operator=(const concurrent_object_pool&) = delete;
+        concurrent_object_pool& operator=(concurrent_object_pool&&) noexcept = delete;
+
+        /// @brief Acquires a resource. Safe to call from any thread.
+        /// @return Key of the resource, or invalid_key if the pool is exhausted.
+        [[nodiscard]] key acquire_resource();
+
+        /// @brief Releases a resource. Safe to call from any thread. Releasing a stale key is a no-op.
+        void release_resource(key index);
+
+        /// @brief Releases every resource and invalidates every key. Must not be called concurrently with any other
+        ///        member function.
+        void release_all_resources();
+
+        [[nodiscard]] void* access(key index);
+        [[nodiscard]] const void* access(key index) const;
+
+        [[nodiscard]] size_t size() const noexcept;
+
+      private:
+        struct slot
+        {
+            atomic<uint32_t> generation{0};
+            atomic<uint32_t> next{~0u};
+        };
+
+        struct thread_cache
+        {
+            vector<uint32_t> free_indices;
+        };
+
+        abstract_allocator* _alloc; // non-owning
+        slot* _slots{nullptr};
+        byte* _payload{nullptr};
+
+        uint32_t _pool_size;
+        uint32_t _resource_size;
+        uint32_t _thread_cache_size;
+        uint64_t _id;
+
+        // Index of the first free slot in the low bits, a tag bumped by every update in the high bits to rule out ABA
+        alignas(64) atomic<uint64_t> _free_head{~0ull};
+
+        mutable mutex _registration_lock;
+        vector<unique_ptr<thread_cache>> _caches;
+
+        [[nodiscard]] uint32_t _pop_free() noexcept;
+        void _push_free(uint32_t index) noexcept;
+        [[nodiscard]] thread_cache& _this_thread_cache();
+    };
 } // namespace tempest::core
 
 #endif // tempest_core_object_pool_hpp
@@ -112,6 +112,7 @@ namespace tempest
         using key_type = conditional_t<sizeof(size_t) >= sizeof(uint64_t), uint64_t, uint32_t>;
 
         slot_map() noexcept = default;
+        explicit slot_map(const Allocator& alloc) noexcept;
         slot_map(const slot_map& other);
         slot_map(slot_map&& other) noexcept;
         ~slot_map();
@@ -208,7 +209,12 @@ namespace tempest
     };
 
     template <typename T, typename Allocator>
-    slot_map<T, Allocator>::slot_map(const slot_map& other)
+    slot_map<T, Allocator>::slot_map(const Allocator& alloc) noexcept : _elements(key_block_allocator(alloc))
+    {
+    }
+
+    template <typename T, typename Allocator>
+    slot_map<T, Allocator>::slot_map(const slot_map& other) : _elements(other._elements.get_allocator())
     {
         _grow_to(other._elements.capacity());
 
@@ -822,6 +828,12 @@ namespace tempest
     {
         lhs.swap(rhs);
     }
+
+    namespace pmr
+    {
+        template <typename T>
+        using slot_map = tempest::slot_map<T, polymorphic_allocator<T>>;
+    } // namespace pmr
 } // namespace tempest
 
 #endif // tempest_core_slot_map_hpp
\ No newline at end of file
@@ -2026,6 +2026,26 @@ namespace tempest
         }
     }
 
+    template <typename CharT, typename Traits, typename Allocator>
+    inline constexpr auto operator<=>(const basic_string<CharT, Traits, Allocator>& lhs,
+                                      basic_string_view<CharT, Traits> rhs) noexcept -> tempest::strong_ordering
+    {
+        auto cmp = Traits::compare(lhs.data(), rhs.data(), tempest::min(lhs.size(), rhs.size()));
+
+        if (cmp == 0)
+        {
+            return tempest::compare_three_way{}(lhs.size(), rhs.size());
+        }
+        else if (cmp < 0)
+        {
+            return tempest::strong_ordering::less;
+        }
+        else
+        {
+            return tempest::strong_ordering::greater;
+        }
+    }
+
     template <typename CharT, typename Traits, typename Allocator>
     inline constexpr auto operator<=>(const CharT* lhs, const basic_string<CharT, Traits, Allocator>& rhs)
         -> tempest::strong_ordering
@@ -2071,6 +2091,15 @@ namespace tempest
     using string = basic_string<char>;
     using wstring = basic_string<wchar_t>;
 
+    namespace pmr
+    {
+        template <typename CharT, typename Traits = char_traits<CharT>>
+        using basic_string = tempest::basic_string<CharT, Traits, polymorphic_allocator<CharT>>;
+
+        using string = basic_string<char>;
+        using wstring = basic_string<wchar_t>;
+    } // namespace pmr
+
     template <typename CharT, typename Traits, typename Allocator>
     constexpr typename basic_string<CharT, Traits, Allocator>::size_type copy(
         const basic_string<CharT, Traits, Allocator>& src,
@@ -2581,10 +2610,24 @@ namespace tempest
     template <typename CharT, typename Traits, typename Allocator>
     struct hash<basic_string<CharT, Traits, Allocator>>
     {
+        // Strings, views and C strings with the same characters hash equally, so they can be used to look up string
+        // keys without allocating
+        using is_transparent = void;
+
         tempest::size_t operator()(const basic_string<CharT, Traits, Allocator>& str) const noexcept
         {
             return hash<basic_string_view<CharT, Traits>>{}(str);
         }
+
+        tempest::size_t operator()(basic_string_view<CharT, Traits> str) const noexcept
+        {
+            return hash<basic_string_view<CharT, Traits>>{}(str);
+        }
+
+        tempest::size_t operator()(const CharT* str) const noexcept
+        {
+            return hash<basic_string_view<CharT, Traits>>{}(basic_string_view<CharT, Traits>(str));
+        }
     };
 } // namespace tempest
 
@@ -513,9 +513,11 @@ namespace tempest
     template <typename CharT, typename Traits>
     struct hash<basic_string_view<CharT, Traits>>
     {
+        using is_transparent = void;
+
         size_t operator()(const basic_string_view<CharT, Traits>& sv) const noexcept
         {
-            return detail::fnv1a_auto(sv.data(), sv.size());
+            return detail::hash_chars(sv.data(), sv.size());
         }
     };
 } // namespace tempest
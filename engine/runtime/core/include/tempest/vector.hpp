@@ -1016,6 +1016,12 @@ namespace tempest
     // Deduction guides
     template <typename... Ts>
     vector(init_list_t, Ts&&...) -> vector<common_type_t<Ts...>>;
+
+    namespace pmr
+    {
+        template <typename T>
+        using vector = tempest::vector<T, polymorphic_allocator<T>>;
+    } // namespace pmr
 } // namespace tempest
 
 #endif // tempest_core_vector_hpp
\ No newline at end of file
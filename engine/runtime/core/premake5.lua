@@ -128,3 +128,30 @@ scoped.group('Tests', function()
         warnings 'Extra'
     end)
 end)
+
+scoped.group('Benchmarks', function()
+    scoped.project('core-benchmarks', function()
+        kind 'ConsoleApp'
+        language 'C++'
+        cppdialect 'C++20'
+
+        targetdir '%{binaries}'
+        objdir '%{intermediates}'
+
+        files {
+            'benchmarks/**.cpp',
+            'benchmarks/**.hpp',
+        }
+
+        includedirs {
+            'benchmarks/harness',
+        }
+
+        uses {
+            'tempest',
+        }
+
+        externalwarnings 'Off'
+        warnings 'Extra'
+    end)
+end)
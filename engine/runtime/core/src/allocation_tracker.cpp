@@ -0,0 +1,504 @@
+#include <tempest/allocation_tracker.hpp>
+
+#include <tempest/algorithm.hpp>
+#include <tempest/array.hpp>
+#include <tempest/atomic.hpp>
+#include <tempest/flat_unordered_map.hpp>
+#include <tempest/hash.hpp>
+#include <tempest/mutex.hpp>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <execinfo.h>
+#endif
+
+namespace tempest::core
+{
+    namespace
+    {
+        struct site_key
+        {
+            const char* file;
+            const char* function;
+            uint32_t line;
+            const char* subsystem;
+            allocation_callstack callstack;
+
+            bool operator==(const site_key& other) const noexcept = default;
+        };
+
+        struct site_key_hash
+        {
+            size_t operator()(const site_key& key) const noexcept
+            {
+                auto hv = hash_combine(key.file, key.function, key.line, key.subsystem);
+                for (auto frame : key.callstack)
+                {
+                    hv = hash_combine(hv, frame);
+                }
+                return hv;
+            }
+        };
+
+        struct site_record
+        {
+            allocation_site_stats stats;
+
+            // Allocations made during the frame in progress
+            uint64_t pending_frame_allocation_count = 0;
+            uint64_t pending_frame_allocated_bytes = 0;
+        };
+
+        struct live_allocation
+        {
+            uint64_t bytes;
+            uint32_t site;
+            uint32_t weight;
+        };
+
+        struct live_shard
+        {
+            mutex lock;
+            flat_unordered_map<uintptr_t, live_allocation> allocations;
+        };
+
+        constexpr size_t live_shard_count = 16;
+        constexpr size_t live_filter_size = 4096;
+
+        struct tracker_state
+        {
+            mutex sites_lock;
+            flat_unordered_map<site_key, uint32_t, site_key_hash> site_indices;
+            vector<site_record> sites;
+            uint64_t frame = 0;
+
+            array<live_shard, live_shard_count> shards;
+
+            // Number of recorded live allocations per address bucket. A free whose bucket is empty cannot have been
+            // recorded and skips the shard lock, which keeps unsampled frees cheap in sampled mode.
+            array<atomic<uint32_t>, live_filter_size> live_filter{};
+        };
+
+        atomic<uint32_t> active_mode{static_cast<uint32_t>(allocation_tracking_mode::disabled)};
+        atomic<uint32_t> active_sample_interval{64};
+
+        thread_local const char* current_subsystem = nullptr;
+        thread_local uint32_t sample_countdown = 0;
+
+        // Set while the tracker itself is running on this thread, so allocations made by the tracker's own containers
+        // are not recorded
+        thread_local bool inside_tracker = false;
+
+        class tracker_guard
+        {
+          public:
+            tracker_guard() noexcept : _previous{inside_tracker}
+            {
+                inside_tracker = true;
+            }
+
+            tracker_guard(const tracker_guard&) = delete;
+            tracker_guard& operator=(const tracker_guard&) = delete;
+
+            ~tracker_guard()
+            {
+                inside_tracker = _previous;
+            }
+
+          private:
+            bool _previous;
+        };
+
+        tracker_state& state()
+        {
+            // Intentionally leaked, allocations may be released by static destructors after this translation unit's
+            // statics have been torn down
+            static auto instance = new tracker_state{};
+            return *instance;
+        }
+
+        live_shard& shard_for(uintptr_t address)
+        {
+            // Drop the low bits, they are mostly alignment
+            return state().shards[(address >> 4) % live_shard_count];
+        }
+
+        atomic<uint32_t>& live_filter_for(uintptr_t address)
+        {
+            return state().live_filter[hash<uintptr_t>()(address) % live_filter_size];
+        }
+
+        allocation_tracking_mode current_mode() noexcept
+        {
+            return static_cast<allocation_tracking_mode>(active_mode.load(memory_order::relaxed));
+        }
+
+        // Returns the weight of the allocation, or zero if it should not be recorded
+        uint32_t sample_weight() noexcept
+        {
+            const auto mode = current_mode();
+            if (mode == allocation_tracking_mode::disabled || inside_tracker)
+            {
+                return 0;
+            }
+
+            if (mode == allocation_tracking_mode::full)
+            {
+                return 1;
+            }
+
+            const auto interval = active_sample_interval.load(memory_order::relaxed);
+            if (sample_countdown > 1)
+            {
+                --sample_countdown;
+                return 0;
+            }
+
+            sample_countdown = interval;
+            return interval;
+        }
+
+        // Allocations made through allocator_traits carry no source location, the return addresses of the calling
+        // frames identify the site instead
+        allocation_callstack capture_callstack() noexcept
+        {
+            // Skips this function and the tracking hook
+            constexpr size_t skipped_frames = 2;
+
+            void* frames[allocation_callstack_depth + skipped_frames] = {};
+#ifdef _WIN32
+            const auto count = static_cast<size_t>(
+                RtlCaptureStackBackTrace(0, static_cast<DWORD>(allocation_callstack_depth + skipped_frames), frames,
+                                         nullptr));
+#else
+            const auto count =
+                static_cast<size_t>(backtrace(frames, static_cast<int>(allocation_callstack_depth + skipped_frames)));
+#endif
+
+            allocation_callstack result = {};
+            for (size_t i = skipped_frames; i < count; ++i)
+            {
+                result[i - skipped_frames] = frames[i];
+            }
+
+            return result;
+        }
+
+        uint32_t find_or_create_site(tracker_state& st, const source_location& loc,
+                                     const allocation_callstack& callstack)
+        {
+            const auto key = site_key{
+                .file = loc.file_name(),
+                .function = loc.function_name(),
+                .line = static_cast<uint32_t>(loc.line()),
+                .subsystem = current_subsystem,
+                .callstack = callstack,
+            };
+
+            if (auto it = st.site_indices.find(key); it != st.site_indices.end())
+            {
+                return it->second;
+            }
+
+            const auto index = static_cast<uint32_t>(st.sites.size());
+
+            auto& record = st.sites.emplace_back();
+            record.stats.file = key.file;
+            record.stats.function = key.function;
+            record.stats.line = key.line;
+            record.stats.subsystem = key.subsystem;
+            record.stats.callstack = key.callstack;
+
+            st.site_indices.insert({key, index});
+
+            return index;
+        }
+
+        uint32_t record_allocation(uint64_t bytes, uint32_t weight, const source_location& loc,
+                                   const allocation_callstack& callstack, bool live)
+        {
+            auto& st = state();
+            lock_guard lock{st.sites_lock};
+
+            const auto site = find_or_create_site(st, loc, callstack);
+            auto& record = st.sites[site];
+            auto& stats = record.stats;
+
+            stats.allocation_count += weight;
+            stats.allocated_bytes += bytes;
+            record.pending_frame_allocation_count += weight;
+            record.pending_frame_allocated_bytes += bytes;
+
+            if (live)
+            {
+                stats.live_bytes += static_cast<int64_t>(bytes);
+                stats.peak_bytes = tempest::max(stats.peak_bytes, stats.live_bytes);
+            }
+
+            return site;
+        }
+
+        bool same_site(const allocation_site_stats& lhs, const allocation_site_stats& rhs) noexcept
+        {
+            return lhs.file == rhs.file && lhs.function == rhs.function && lhs.line == rhs.line &&
+                   lhs.subsystem == rhs.subsystem && lhs.callstack == rhs.callstack;
+        }
+    } // namespace
+
+    vector<allocation_subsystem_stats> allocation_snapshot::by_subsystem() const
+    {
+        vector<allocation_subsystem_stats> result;
+
+        for (const auto& site : sites)
+        {
+            auto it = tempest::find_if(result.begin(), result.end(),
+                                       [&](const auto& subsystem) { return subsystem.subsystem == site.subsystem; });
+            if (it == result.end())
+            {
+                result.push_back({.subsystem = site.subsystem});
+                it = result.end() - 1;
+            }
+
+            it->live_bytes += site.live_bytes;
+            it->peak_bytes += site.peak_bytes;
+            it->allocation_count += site.allocation_count;
+            it->deallocation_count += site.deallocation_count;
+            it->allocated_bytes += site.allocated_bytes;
+            it->frame_allocation_count += site.frame_allocation_count;
+            it->frame_allocated_bytes += site.frame_allocated_bytes;
+        }
+
+        return result;
+    }
+
+    void allocation_tracker::enable(allocation_tracking_mode mode, uint32_t sample_interval)
+    {
+        {
+            tracker_guard guard;
+            (void)state();
+        }
+
+        active_sample_interval.store(sample_interval > 0 ? sample_interval : 1, memory_order::relaxed);
+        active_mode.store(static_cast<uint32_t>(mode), memory_order::release);
+    }
+
+    void allocation_tracker::disable()
+    {
+        active_mode.store(static_cast<uint32_t>(allocation_tracking_mode::disabled), memory_order::release);
+    }
+
+    allocation_tracking_mode allocation_tracker::mode() noexcept
+    {
+        return current_mode();
+    }
+
+    void allocation_tracker::end_frame()
+    {
+        if (current_mode() == allocation_tracking_mode::disabled)
+        {
+            return;
+        }
+
+        tracker_guard guard;
+
+        auto& st = state();
+        lock_guard lock{st.sites_lock};
+
+        for (auto& record : st.sites)
+        {
+            record.stats.frame_allocation_count = record.pending_frame_allocation_count;
+            record.stats.frame_allocated_bytes = record.pending_frame_allocated_bytes;
+            record.pending_frame_allocation_count = 0;
+            record.pending_frame_allocated_bytes = 0;
+        }
+
+        ++st.frame;
+    }
+
+    void allocation_tracker::reset()
+    {
+        tracker_guard guard;
+
+        auto& st = state();
+
+        for (auto& shard : st.shards)
+        {
+            lock_guard lock{shard.lock};
+            shard.allocations.clear();
+        }
+
+        for (auto& bucket : st.live_filter)
+        {
+            bucket.store(0, memory_order::relaxed);
+        }
+
+        lock_guard lock{st.sites_lock};
+        st.site_indices.clear();
+        st.sites.clear();
+        st.frame = 0;
+    }
+
+    allocation_snapshot allocation_tracker::snapshot()
+    {
+        allocation_snapshot result;
+
+        {
+            tracker_guard guard;
+
+            auto& st = state();
+            lock_guard lock{st.sites_lock};
+
+            result.frame = st.frame;
+            result.sites.reserve(st.sites.size());
+            for (const auto& record : st.sites)
+            {
+                result.sites.push_back(record.stats);
+            }
+        }
+
+        return result;
+    }
+
+    vector<allocation_site_delta> allocation_tracker::diff(const allocation_snapshot& before,
+                                                          const allocation_snapshot& after)
+    {
+        vector<allocation_site_delta> result;
+
+        for (const auto& site : after.sites)
+        {
+            const auto prior = tempest::find_if(before.sites.begin(), before.sites.end(),
+                                                [&](const auto& other) { return same_site(site, other); });
+
+            auto delta = allocation_site_delta{
+                .file = site.file,
+                .function = site.function,
+                .line = site.line,
+                .subsystem = site.subsystem,
+                .callstack = site.callstack,
+                .live_bytes = site.live_bytes,
+                .allocation_count = static_cast<int64_t>(site.allocation_count),
+                .deallocation_count = static_cast<int64_t>(site.deallocation_count),
+                .allocated_bytes = static_cast<int64_t>(site.allocated_bytes),
+            };
+
+            if (prior != before.sites.end())
+            {
+                delta.live_bytes -= prior->live_bytes;
+                delta.allocation_count -= static_cast<int64_t>(prior->allocation_count);
+                delta.deallocation_count -= static_cast<int64_t>(prior->deallocation_count);
+                delta.allocated_bytes -= static_cast<int64_t>(prior->allocated_bytes);
+            }
+
+            if (delta.live_bytes != 0 || delta.allocation_count != 0 || delta.deallocation_count != 0)
+            {
+                result.push_back(delta);
+            }
+        }
+
+        return result;
+    }
+
+    allocation_scope::allocation_scope(const char* subsystem) noexcept : _previous{current_subsystem}
+    {
+        current_subsystem = subsystem;
+    }
+
+    allocation_scope::~allocation_scope()
+    {
+        current_subsystem = _previous;
+    }
+} // namespace tempest::core
+
+namespace tempest::detail
+{
+    void track_allocation(const void* ptr, size_t size, source_location loc) noexcept
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+
+        const auto weight = core::sample_weight();
+        if (weight == 0)
+        {
+            return;
+        }
+
+        core::tracker_guard guard;
+
+        const auto callstack = loc.file_name() == nullptr ? core::capture_callstack() : core::allocation_callstack{};
+        const auto bytes = static_cast<uint64_t>(size) * weight;
+        const auto site = core::record_allocation(bytes, weight, loc, callstack, true);
+
+        const auto address = reinterpret_cast<uintptr_t>(ptr);
+        auto& shard = core::shard_for(address);
+
+        lock_guard lock{shard.lock};
+        shard.allocations.insert({address, core::live_allocation{bytes, site, weight}});
+        (void)core::live_filter_for(address).fetch_add(1, memory_order::relaxed);
+    }
+
+    void track_transient_allocation(size_t size, source_location loc) noexcept
+    {
+        const auto weight = core::sample_weight();
+        if (weight == 0)
+        {
+            return;
+        }
+
+        core::tracker_guard guard;
+
+        const auto callstack = loc.file_name() == nullptr ? core::capture_callstack() : core::allocation_callstack{};
+        (void)core::record_allocation(static_cast<uint64_t>(size) * weight, weight, loc, callstack, false);
+    }
+
+    void track_deallocation(const void* ptr) noexcept
+    {
+        if (ptr == nullptr || core::inside_tracker ||
+            core::current_mode() == core::allocation_tracking_mode::disabled)
+        {
+            return;
+        }
+
+        const auto address = reinterpret_cast<uintptr_t>(ptr);
+        auto& filter = core::live_filter_for(address);
+        if (filter.load(memory_order::relaxed) == 0)
+        {
+            // Not sampled, or allocated before tracking was enabled
+            return;
+        }
+
+        core::tracker_guard guard;
+
+        auto& shard = core::shard_for(address);
+
+        core::live_allocation allocation{};
+        {
+            lock_guard lock{shard.lock};
+            auto it = shard.allocations.find(address);
+            if (it == shard.allocations.end())
+            {
+                // Shares a filter bucket with a recorded allocation
+                return;
+            }
+
+            allocation = it->second;
+            shard.allocations.erase(it);
+            (void)filter.fetch_sub(1, memory_order::relaxed);
+        }
+
+        auto& st = core::state();
+        lock_guard lock{st.sites_lock};
+
+        // The site table may have been reset since the allocation was recorded
+        if (allocation.site < st.sites.size())
+        {
+            auto& stats = st.sites[allocation.site].stats;
+            stats.live_bytes -= static_cast<int64_t>(allocation.bytes);
+            stats.deallocation_count += allocation.weight;
+        }
+    }
+} // namespace tempest::detail
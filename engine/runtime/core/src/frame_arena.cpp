@@ -0,0 +1,181 @@
+#include <tempest/frame_arena.hpp>
+
+#include "thread_binding.hpp"
+
+#include <cassert>
+#include <cstddef>
+
+namespace tempest::core
+{
+    namespace
+    {
+        // Regions the calling thread has been given
+        thread_local thread_binding_list this_thread_regions{};
+
+        size_t align_up(size_t value, size_t alignment)
+        {
+            const auto mask = alignment - 1;
+            return (value + mask) & ~mask;
+        }
+    } // namespace
+
+    frame_arena::frame_region::frame_region(size_t bytes) : stack{bytes}
+    {
+    }
+
+    frame_arena::thread_region::thread_region(frame_arena* owner, size_t bytes_per_frame, uint32_t frames_in_flight)
+        : _owner{owner}
+    {
+        _frames.reserve(frames_in_flight);
+        for (uint32_t i = 0; i < frames_in_flight; ++i)
+        {
+            _frames.emplace_back(bytes_per_frame);
+        }
+    }
+
+    frame_arena::thread_region::~thread_region()
+    {
+        for (uint32_t i = 0; i < _frames.size(); ++i)
+        {
+            reset(i);
+        }
+    }
+
+    void* frame_arena::thread_region::allocate(size_t size, size_t alignment, source_location loc)
+    {
+        if (size == 0)
+        {
+            return nullptr;
+        }
+
+        auto& frame = _frames[_owner->current_frame()];
+
+        // Worst case padding, the stack aligns the address rather than the offset
+        if (frame.stack.get_marker() + (alignment - 1) + size <= frame.stack.capacity())
+        {
+            return frame.stack.allocate(size, alignment, loc);
+        }
+
+        // The region is exhausted, spill to the heap until the frame retires
+        const auto heap_alignment = alignment < alignof(std::max_align_t) ? alignof(std::max_align_t) : alignment;
+        auto ptr = tempest::aligned_alloc(align_up(size, heap_alignment), heap_alignment);
+        frame.overflow.push_back(ptr);
+        frame.overflow_bytes += size;
+
+        tempest::detail::track_transient_allocation(size, loc);
+
+        return ptr;
+    }
+
+    void frame_arena::thread_region::deallocate([[maybe_unused]] void* ptr)
+    {
+        // Memory is reclaimed when the frame retires. Containers may be released on a thread other than the one that
+        // allocated them, so individual frees cannot safely touch the region.
+    }
+
+    void frame_arena::thread_region::reset(uint32_t frame_in_flight)
+    {
+        auto& frame = _frames[frame_in_flight];
+        frame.stack.reset();
+
+        for (auto ptr : frame.overflow)
+        {
+            tempest::aligned_free(ptr);
+        }
+
+        frame.overflow.clear();
+        frame.overflow_bytes = 0;
+    }
+
+    size_t frame_arena::thread_region::bytes_allocated(uint32_t frame_in_flight) const noexcept
+    {
+        const auto& frame = _frames[frame_in_flight];
+        return frame.stack.get_marker() + frame.overflow_bytes;
+    }
+
+    frame_arena::frame_arena(size_t bytes_per_frame, uint32_t frames_in_flight)
+        : _id{acquire_binding_owner_id()}, _bytes_per_frame{bytes_per_frame}, _frames_in_flight{frames_in_flight}
+    {
+        assert(frames_in_flight > 0);
+    }
+
+    frame_arena::~frame_arena()
+    {
+        retire_binding_owner_id(_id);
+    }
+
+    void frame_arena::begin_frame(uint32_t frame_in_flight)
+    {
+        assert(frame_in_flight < _frames_in_flight);
+
+        {
+            lock_guard lock{_registration_lock};
+            for (auto& region : _threads)
+            {
+                region->reset(frame_in_flight);
+            }
+        }
+
+        _current_frame.store(frame_in_flight, memory_order::release);
+    }
+
+    void* frame_arena::allocate(size_t size, size_t alignment, source_location loc)
+    {
+        return _this_thread_region().allocate(size, alignment, loc);
+    }
+
+    abstract_allocator* frame_arena::thread_allocator()
+    {
+        return &_this_thread_region();
+    }
+
+    uint32_t frame_arena::frames_in_flight() const noexcept
+    {
+        return _frames_in_flight;
+    }
+
+    uint32_t frame_arena::current_frame() const noexcept
+    {
+        return _current_frame.load(memory_order::acquire);
+    }
+
+    size_t frame_arena::thread_count() const noexcept
+    {
+        lock_guard lock{_registration_lock};
+        return _threads.size();
+    }
+
+    size_t frame_arena::bytes_allocated(uint32_t frame_in_flight) const noexcept
+    {
+        lock_guard lock{_registration_lock};
+
+        size_t total = 0;
+        for (const auto& region : _threads)
+        {
+            total += region->bytes_allocated(frame_in_flight);
+        }
+
+        return total;
+    }
+
+    frame_arena::thread_region& frame_arena::_this_thread_region()
+    {
+        if (auto bound = this_thread_regions.find(_id)) [[likely]]
+        {
+            return *static_cast<thread_region*>(bound);
+        }
+
+        // First allocation from this thread, register a new region
+        auto region = make_unique<thread_region>(this, _bytes_per_frame, _frames_in_flight);
+        auto result = region.get();
+
+        {
+            lock_guard lock{_registration_lock};
+            _threads.push_back(tempest::move(region));
+        }
+
+        this_thread_regions.bind(_id, result);
+
+        return *result;
+    }
+} // namespace tempest::core
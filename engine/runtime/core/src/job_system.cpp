@@ -0,0 +1,461 @@
+#include <tempest/job_system.hpp>
+
+namespace tempest::core
+{
+    namespace
+    {
+        // Number of failed attempts to find work before a waiting thread sleeps
+        constexpr uint32_t wait_spin_count = 64;
+
+        struct worker_binding
+        {
+            const job_system* owner = nullptr;
+            uint32_t index = 0;
+        };
+
+        thread_local worker_binding this_worker{};
+
+        void release_state(detail::job_state* state) noexcept
+        {
+            if (state != nullptr && state->references.fetch_sub(1, memory_order::acq_rel) == 1)
+            {
+                delete state;
+            }
+        }
+    } // namespace
+
+    uint32_t job_counter::pending() const noexcept
+    {
+        return _pending.load(memory_order::acquire);
+    }
+
+    bool job_counter::is_complete() const noexcept
+    {
+        return pending() == 0;
+    }
+
+    void job_counter::_add(uint32_t count) noexcept
+    {
+        _pending.fetch_add(count, memory_order::acq_rel);
+    }
+
+    bool job_counter::_release() noexcept
+    {
+        return _pending.fetch_sub(1, memory_order::seq_cst) == 1;
+    }
+
+    namespace detail
+    {
+        bool work_stealing_deque::push(job* j) noexcept
+        {
+            const auto b = _bottom.load(memory_order::relaxed);
+            const auto t = _top.load(memory_order::acquire);
+
+            if (b - t >= capacity)
+            {
+                return false;
+            }
+
+            _slots[b & _mask].store(j, memory_order::relaxed);
+            _bottom.store(b + 1, memory_order::seq_cst);
+
+            return true;
+        }
+
+        job* work_stealing_deque::pop() noexcept
+        {
+            const auto b = _bottom.load(memory_order::relaxed) - 1;
+            _bottom.store(b, memory_order::seq_cst);
+            auto t = _top.load(memory_order::seq_cst);
+
+            if (t > b)
+            {
+                // Deque was empty, restore the bottom
+                _bottom.store(b + 1, memory_order::relaxed);
+                return nullptr;
+            }
+
+            auto j = _slots[b & _mask].load(memory_order::relaxed);
+            if (t == b)
+            {
+                // Last element, race against thieves for it
+                if (!_top.compare_exchange_strong(t, t + 1, memory_order::seq_cst))
+                {
+                    j = nullptr;
+                }
+                _bottom.store(b + 1, memory_order::relaxed);
+            }
+
+            return j;
+        }
+
+        job* work_stealing_deque::steal() noexcept
+        {
+            auto t = _top.load(memory_order::seq_cst);
+            const auto b = _bottom.load(memory_order::seq_cst);
+
+            if (t >= b)
+            {
+                return nullptr;
+            }
+
+            auto j = _slots[t & _mask].load(memory_order::relaxed);
+            if (!_top.compare_exchange_strong(t, t + 1, memory_order::seq_cst))
+            {
+                return nullptr;
+            }
+
+            return j;
+        }
+
+        bool work_stealing_deque::empty() const noexcept
+        {
+            return _top.load(memory_order::acquire) >= _bottom.load(memory_order::acquire);
+        }
+    } // namespace detail
+
+    job_handle::job_handle(detail::job_state* state) noexcept : _state{state}
+    {
+        if (_state != nullptr)
+        {
+            _state->references.fetch_add(1, memory_order::relaxed);
+        }
+    }
+
+    job_handle::job_handle(const job_handle& other) noexcept : job_handle(other._state)
+    {
+    }
+
+    job_handle::job_handle(job_handle&& other) noexcept : _state{exchange(other._state, nullptr)}
+    {
+    }
+
+    job_handle::~job_handle()
+    {
+        release_state(_state);
+    }
+
+    job_handle& job_handle::operator=(const job_handle& rhs) noexcept
+    {
+        if (&rhs == this) [[unlikely]]
+        {
+            return *this;
+        }
+
+        if (rhs._state != nullptr)
+        {
+            rhs._state->references.fetch_add(1, memory_order::relaxed);
+        }
+
+        release_state(_state);
+        _state = rhs._state;
+
+        return *this;
+    }
+
+    job_handle& job_handle::operator=(job_handle&& rhs) noexcept
+    {
+        if (&rhs == this) [[unlikely]]
+        {
+            return *this;
+        }
+
+        release_state(_state);
+        _state = exchange(rhs._state, nullptr);
+
+        return *this;
+    }
+
+    bool job_handle::valid() const noexcept
+    {
+        return _state != nullptr;
+    }
+
+    bool job_handle::is_complete() const noexcept
+    {
+        return _state == nullptr || _state->counter.is_complete();
+    }
+
+    job_system::job_system(uint32_t worker_count)
+    {
+        if (worker_count == 0)
+        {
+            const auto hardware_threads = thread::hardware_concurrency();
+            worker_count = hardware_threads > 1 ? hardware_threads - 1 : 1;
+        }
+
+        _workers.reserve(worker_count);
+        for (uint32_t i = 0; i < worker_count; ++i)
+        {
+            _workers.push_back(make_unique<worker>());
+        }
+
+        // Workers are started after every queue exists, since any worker may steal from any other
+        for (uint32_t i = 0; i < worker_count; ++i)
+        {
+            _workers[i]->handle = thread([this, i]() { _worker_main(i); });
+        }
+    }
+
+    job_system::~job_system()
+    {
+        _stopping.store(1, memory_order::release);
+        _wake_workers(static_cast<uint32_t>(_workers.size()));
+
+        for (auto& w : _workers)
+        {
+            if (w->handle.joinable())
+            {
+                w->handle.join();
+            }
+        }
+    }
+
+    job_handle job_system::submit(function<void()> fn)
+    {
+        auto state = new detail::job_state{};
+        state->references.store(1, memory_order::relaxed); // Reference held by the job
+        state->counter._add(1);
+
+        auto j = new detail::job{};
+        j->fn = tempest::move(fn);
+        j->counter = &state->counter;
+        j->state = state;
+
+        auto handle = job_handle(state);
+        _enqueue(span<detail::job*>(&j, 1));
+
+        return handle;
+    }
+
+    void job_system::submit(function<void()> fn, job_counter& counter)
+    {
+        auto j = new detail::job{};
+        j->fn = tempest::move(fn);
+        j->counter = &counter;
+
+        counter._add(1);
+        _enqueue(span<detail::job*>(&j, 1));
+    }
+
+    void job_system::wait(const job_counter& counter)
+    {
+        const auto index = current_worker_index();
+        uint32_t failed_attempts = 0;
+
+        while (true)
+        {
+            // Read the epoch before the counter so a completion racing with the check is never missed
+            const auto epoch = _completion_epoch.load(memory_order::seq_cst);
+            if (counter._pending.load(memory_order::seq_cst) == 0)
+            {
+                return;
+            }
+
+            if (auto j = _find_job(index))
+            {
+                _execute(j);
+                failed_attempts = 0;
+                continue;
+            }
+
+            if (++failed_attempts < wait_spin_count)
+            {
+                this_thread::yield();
+                continue;
+            }
+
+            // Nothing left to help with, the remaining jobs are executing on other threads
+            _blocked_waiters.fetch_add(1, memory_order::seq_cst);
+            _completion_epoch.wait(epoch, memory_order::acquire);
+            _blocked_waiters.fetch_sub(1, memory_order::seq_cst);
+            failed_attempts = 0;
+        }
+    }
+
+    void job_system::wait(const job_handle& handle)
+    {
+        if (handle._state != nullptr)
+        {
+            wait(handle._state->counter);
+        }
+    }
+
+    uint32_t job_system::worker_count() const noexcept
+    {
+        return static_cast<uint32_t>(_workers.size());
+    }
+
+    uint32_t job_system::current_worker_index() const noexcept
+    {
+        if (this_worker.owner == this)
+        {
+            return this_worker.index;
+        }
+        return worker_count();
+    }
+
+    void job_system::_worker_main(uint32_t index)
+    {
+        this_worker = {
+            .owner = this,
+            .index = index,
+        };
+
+        while (true)
+        {
+            // Read the epoch before searching so a submission racing with the search is never missed
+            const auto epoch = _work_epoch.load(memory_order::acquire);
+
+            if (auto j = _find_job(index))
+            {
+                _execute(j);
+                continue;
+            }
+
+            if (_stopping.load(memory_order::acquire) != 0)
+            {
+                break;
+            }
+
+            _sleeping_workers.fetch_add(1, memory_order::seq_cst);
+            _work_epoch.wait(epoch, memory_order::acquire);
+            _sleeping_workers.fetch_sub(1, memory_order::seq_cst);
+        }
+
+        this_worker = {};
+    }
+
+    void job_system::_enqueue(span<detail::job*> jobs)
+    {
+        if (jobs.empty())
+        {
+            return;
+        }
+
+        const auto index = current_worker_index();
+        size_t pushed = 0;
+
+        if (index < worker_count())
+        {
+            auto& queue = _workers[index]->queue;
+            while (pushed < jobs.size() && queue.push(jobs[pushed]))
+            {
+                ++pushed;
+            }
+        }
+
+        // Jobs from external threads and overflow from a full worker deque go through the injection queue
+        if (pushed < jobs.size())
+        {
+            lock_guard lock(_injection_lock);
+            for (size_t i = pushed; i < jobs.size(); ++i)
+            {
+                _injection_queue.push_back(jobs[i]);
+            }
+            _injection_count.fetch_add(static_cast<uint32_t>(jobs.size() - pushed), memory_order::release);
+        }
+
+        _wake_workers(static_cast<uint32_t>(jobs.size()));
+    }
+
+    detail::job* job_system::_find_job(uint32_t index)
+    {
+        const auto count = worker_count();
+
+        if (index < count)
+        {
+            if (auto j = _workers[index]->queue.pop())
+            {
+                return j;
+            }
+        }
+
+        if (_injection_count.load(memory_order::acquire) > 0)
+        {
+            lock_guard lock(_injection_lock);
+            if (!_injection_queue.empty())
+            {
+                auto j = _injection_queue.front();
+                _injection_queue.pop_front();
+                _injection_count.fetch_sub(1, memory_order::release);
+                return j;
+            }
+        }
+
+        // Start stealing from the neighbor to avoid every thief hammering worker 0
+        for (uint32_t offset = 1; offset <= count; ++offset)
+        {
+            const auto victim = (index + offset) % count;
+            if (victim == index)
+            {
+                continue;
+            }
+
+            if (auto j = _workers[victim]->queue.steal())
+            {
+                return j;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void job_system::_execute(detail::job* j)
+    {
+        if (j->range_fn != nullptr)
+        {
+            j->range_fn(j->range_ctx, j->first, j->last);
+        }
+        else if (j->fn)
+        {
+            j->fn();
+        }
+
+        if (j->counter != nullptr && j->counter->_release())
+        {
+            _completion_epoch.fetch_add(1, memory_order::seq_cst);
+            if (_blocked_waiters.load(memory_order::seq_cst) > 0)
+            {
+                _completion_epoch.notify_all();
+            }
+        }
+
+        release_state(j->state);
+
+        delete j;
+    }
+
+    void job_system::_wake_workers(uint32_t count)
+    {
+        _work_epoch.fetch_add(1, memory_order::seq_cst);
+
+        const auto sleeping = _sleeping_workers.load(memory_order::seq_cst);
+        if (sleeping == 0)
+        {
+            return;
+        }
+
+        if (count == 1)
+        {
+            _work_epoch.notify_one();
+        }
+        else
+        {
+            _work_epoch.notify_all();
+        }
+    }
+
+    size_t job_system::_chunk_size(size_t count, size_t grain_size) const noexcept
+    {
+        if (grain_size != 0)
+        {
+            return grain_size;
+        }
+
+        // Aim for a few chunks per thread so stealing can balance uneven work
+        const auto threads = static_cast<size_t>(worker_count()) + 1;
+        const auto target_chunks = threads * 4;
+        return tempest::max<size_t>((count + target_chunks - 1) / target_chunks, 1);
+    }
+} // namespace tempest::core
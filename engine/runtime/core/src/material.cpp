@@ -9,37 +9,37 @@ namespace tempest::core
 
     void material::set_texture(string_view name, guid id)
     {
-        _textures[string(name)] = id;
+        _textures[name] = id;
     }
 
     void material::set_scalar(string_view name, float scalar)
     {
-        _scalars[string(name)] = scalar;
+        _scalars[name] = scalar;
     }
 
     void material::set_bool(string_view name, bool value)
     {
-        _bools[string(name)] = value;
+        _bools[name] = value;
     }
 
     void material::set_vec2(string_view name, math::vec2<float> vec)
     {
-        _vec2s[string(name)] = vec;
+        _vec2s[name] = vec;
     }
 
     void material::set_vec3(string_view name, math::vec3<float> vec)
     {
-        _vec3s[string(name)] = vec;
+        _vec3s[name] = vec;
     }
 
     void material::set_vec4(string_view name, math::vec4<float> vec)
     {
-        _vec4s[string(name)] = vec;
+        _vec4s[name] = vec;
     }
 
     void material::set_string(string_view name, string value)
     {
-        _strings[string(name)] = move(value);
+        _strings[name] = move(value);
     }
 
     string_view material::get_name() const noexcept
@@ -49,7 +49,7 @@ namespace tempest::core
 
     optional<guid> material::get_texture(string_view name) const
     {
-        if (auto it = _textures.find(string(name)); it != _textures.end())
+        if (auto it = _textures.find(name); it != _textures.end())
         {
             return it->second;
         }
@@ -58,7 +58,7 @@ namespace tempest::core
 
     optional<float> material::get_scalar(string_view name) const
     {
-        if (auto it = _scalars.find(string(name)); it != _scalars.end())
+        if (auto it = _scalars.find(name); it != _scalars.end())
         {
             return it->second;
         }
@@ -67,7 +67,7 @@ namespace tempest::core
 
     optional<bool> material::get_bool(string_view name) const
     {
-        if (auto it = _bools.find(string(name)); it != _bools.end())
+        if (auto it = _bools.find(name); it != _bools.end())
         {
             return it->second;
         }
@@ -76,7 +76,7 @@ namespace tempest::core
 
     optional<math::vec2<float>> material::get_vec2(string_view name) const
     {
-        if (auto it = _vec2s.find(string(name)); it != _vec2s.end())
+        if (auto it = _vec2s.find(name); it != _vec2s.end())
         {
             return it->second;
         }
@@ -85,7 +85,7 @@ namespace tempest::core
 
     optional<math::vec3<float>> material::get_vec3(string_view name) const
     {
-        if (auto it = _vec3s.find(string(name)); it != _vec3s.end())
+        if (auto it = _vec3s.find(name); it != _vec3s.end())
         {
             return it->second;
         }
@@ -94,7 +94,7 @@ namespace tempest::core
 
     optional<math::vec4<float>> material::get_vec4(string_view name) const
     {
-        if (auto it = _vec4s.find(string(name)); it != _vec4s.end())
+        if (auto it = _vec4s.find(name); it != _vec4s.end())
         {
             return it->second;
         }
@@ -103,7 +103,7 @@ namespace tempest::core
 
     optional<string_view> material::get_string(string_view name) const
     {
-        if (auto it = _strings.find(string(name)); it != _strings.end())
+        if (auto it = _strings.find(name); it != _strings.end())
         {
             return it->second;
         }
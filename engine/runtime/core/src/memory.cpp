@@ -1,8 +1,17 @@
 #include <tempest/memory.hpp>
 
+#include "thread_binding.hpp"
+
+#include <tempest/algorithm.hpp>
+#include <tempest/array.hpp>
+#include <tempest/mutex.hpp>
+#include <tempest/vector.hpp>
+
 #include <tlsf/tlsf.h>
 
+#include <atomic>
 #include <cassert>
+#include <cstddef>
 #include <cstdlib>
 #include <utility>
 
@@ -23,11 +32,13 @@ namespace tempest
     }
 
     stack_allocator::stack_allocator(stack_allocator&& other) noexcept
-        : _buffer{other._buffer}, _capacity{other._capacity}, _allocated_bytes{other._allocated_bytes}
+        : _buffer{other._buffer}, _capacity{other._capacity}, _allocated_bytes{other._allocated_bytes},
+          _last_allocation{other._last_allocation}
     {
         other._buffer = nullptr;
         other._allocated_bytes = 0;
         other._capacity = 0;
+        other._last_allocation = 0;
     }
 
     stack_allocator::~stack_allocator()
@@ -47,36 +58,54 @@ namespace tempest
         std::swap(_buffer, rhs._buffer);
         std::swap(_capacity, rhs._capacity);
         std::swap(_allocated_bytes, rhs._allocated_bytes);
+        std::swap(_last_allocation, rhs._last_allocation);
 
         return *this;
     }
 
     // TODO: Investigate bump down allocation instead of bump up
-    void* stack_allocator::allocate(size_t size, size_t alignment, [[maybe_unused]] source_location loc)
+    void* stack_allocator::allocate(size_t size, size_t alignment, source_location loc)
     {
         if (size == 0)
         {
             return nullptr;
         }
-        const auto start = align_memory(_allocated_bytes, alignment);
+        // Align the address rather than the offset, the buffer itself is only aligned to max_align_t
+        const auto base = reinterpret_cast<uintptr_t>(_buffer);
+        const auto start = align_memory(base + _allocated_bytes, alignment) - base;
         assert(start < _capacity && "tempest::core::stack_allocator out of memory.");
         const auto new_allocated_byte_count = start + size;
         if (new_allocated_byte_count > _capacity)
         {
             return nullptr;
         }
+        _last_allocation = start;
         _allocated_bytes = new_allocated_byte_count;
+
+        // Stack memory is released in bulk, so it only counts towards allocation rates, not live bytes
+        detail::track_transient_allocation(size, loc);
+
         return _buffer + start;
     }
 
     void stack_allocator::deallocate(void* ptr)
     {
-        assert(ptr > _buffer);                    // Tried to release memory from before allocated region
-        assert(ptr < _buffer + _capacity);        // Tried to release memory from past allocated region
-        assert(ptr < _buffer + _allocated_bytes); // Tried to release unallocated memory inside the allocated region
+        if (ptr == nullptr)
+        {
+            return;
+        }
+
+        assert(ptr >= _buffer);                    // Tried to release memory from before allocated region
+        assert(ptr < _buffer + _capacity);         // Tried to release memory from past allocated region
+        assert(ptr < _buffer + _allocated_bytes);  // Tried to release unallocated memory inside the allocated region
 
-        const auto size_at_ptr = reinterpret_cast<byte*>(ptr) - _buffer;
-        _allocated_bytes = size_at_ptr;
+        // Only the most recent allocation can be popped off the stack. Anything below it is still referenced by
+        // later allocations (e.g. a container that grew into a new buffer) and is reclaimed by reset or free_marker.
+        const auto offset = static_cast<size_t>(reinterpret_cast<byte*>(ptr) - _buffer);
+        if (offset == _last_allocation)
+        {
+            _allocated_bytes = offset;
+        }
     }
 
     size_t stack_allocator::get_marker() const noexcept
@@ -90,9 +119,15 @@ namespace tempest
         if (diff > 0)
         {
             _allocated_bytes = marker;
+            _last_allocation = marker;
         }
     }
 
+    size_t stack_allocator::capacity() const noexcept
+    {
+        return _capacity;
+    }
+
     void stack_allocator::release()
     {
         if (_buffer)
@@ -101,26 +136,219 @@ namespace tempest
             _buffer = nullptr;
             _capacity = 0;
             _allocated_bytes = 0;
+            _last_allocation = 0;
         }
     }
 
     void stack_allocator::reset()
     {
         _allocated_bytes = 0;
+        _last_allocation = 0;
     }
 
-    heap_allocator::heap_allocator(size_t bytes)
+    namespace
+    {
+        constexpr size_t small_object_class_count =
+            heap_allocator::small_object_max_size / heap_allocator::small_object_alignment;
+        constexpr size_t small_object_slab_size = 16 * 1024;
+
+        struct free_block
+        {
+            free_block* next;
+        };
+
+        // Thread caches the calling thread has been given
+        thread_local core::thread_binding_list this_thread_heap_caches{};
+
+        size_t size_class_of(size_t size) noexcept
+        {
+            return (size - 1) / heap_allocator::small_object_alignment;
+        }
+
+        size_t block_size_of(size_t size_class) noexcept
+        {
+            return (size_class + 1) * heap_allocator::small_object_alignment;
+        }
+
+        // Number of blocks moved between a thread cache and the central list at once
+        uint32_t batch_size_of(size_t size_class) noexcept
+        {
+            const auto batch = 2048 / block_size_of(size_class);
+            return static_cast<uint32_t>(batch < 8 ? 8 : (batch > 64 ? 64 : batch));
+        }
+    } // namespace
+
+    struct heap_allocator::shared_state
+    {
+        struct central_list
+        {
+            mutex lock;
+            free_block* head = nullptr;
+        };
+
+        struct thread_cache
+        {
+            array<free_block*, small_object_class_count> heads{};
+            array<uint32_t, small_object_class_count> counts{};
+        };
+
+        uint64_t id;
+
+        mutex tlsf_lock;
+
+        byte* small_begin;
+        size_t slab_count;
+        std::atomic<size_t> next_slab{0};
+        vector<uint8_t> slab_classes;
+        array<central_list, small_object_class_count> central;
+
+        mutex registration_lock;
+        vector<unique_ptr<thread_cache>> caches;
+
+        shared_state(byte* small_region, size_t slabs)
+            : id{core::acquire_binding_owner_id()}, small_begin{small_region}, slab_count{slabs}, slab_classes(slabs)
+        {
+        }
+
+        ~shared_state()
+        {
+            core::retire_binding_owner_id(id);
+        }
+
+        bool owns_small(const void* ptr) const noexcept
+        {
+            const auto address = reinterpret_cast<const byte*>(ptr);
+            return address >= small_begin && address < small_begin + slab_count * small_object_slab_size;
+        }
+
+        size_t size_class_of_block(const void* ptr) const noexcept
+        {
+            const auto slab = static_cast<size_t>(reinterpret_cast<const byte*>(ptr) - small_begin) /
+                              small_object_slab_size;
+            return slab_classes[slab];
+        }
+
+        thread_cache& this_thread_cache()
+        {
+            if (auto bound = this_thread_heap_caches.find(id)) [[likely]]
+            {
+                return *static_cast<thread_cache*>(bound);
+            }
+
+            // First small allocation from this thread. The cache stays owned by the heap, blocks left in it when the
+            // thread exits are reclaimed with the heap.
+            auto cache = make_unique<thread_cache>();
+            auto result = cache.get();
+
+            {
+                lock_guard lock{registration_lock};
+                caches.push_back(tempest::move(cache));
+            }
+
+            this_thread_heap_caches.bind(id, result);
+
+            return *result;
+        }
+
+        // Carves a fresh slab into a list of blocks of the given class. Must be called with the class lock held.
+        free_block* carve_slab(size_t size_class) noexcept
+        {
+            const auto slab = next_slab.fetch_add(1, std::memory_order_relaxed);
+            if (slab >= slab_count)
+            {
+                return nullptr;
+            }
+
+            slab_classes[slab] = static_cast<uint8_t>(size_class);
+
+            const auto block_size = block_size_of(size_class);
+            const auto block_count = small_object_slab_size / block_size;
+            auto base = small_begin + slab * small_object_slab_size;
+
+            for (size_t i = 0; i < block_count; ++i)
+            {
+                auto block = reinterpret_cast<free_block*>(base + i * block_size);
+                block->next =
+                    i + 1 < block_count ? reinterpret_cast<free_block*>(base + (i + 1) * block_size) : nullptr;
+            }
+
+            return reinterpret_cast<free_block*>(base);
+        }
+
+        bool refill(thread_cache& cache, size_t size_class) noexcept
+        {
+            auto& list = central[size_class];
+            lock_guard lock{list.lock};
+
+            if (list.head == nullptr)
+            {
+                list.head = carve_slab(size_class);
+                if (list.head == nullptr)
+                {
+                    return false;
+                }
+            }
+
+            const auto batch = batch_size_of(size_class);
+
+            auto first = list.head;
+            auto last = first;
+            uint32_t taken = 1;
+            while (taken < batch && last->next != nullptr)
+            {
+                last = last->next;
+                ++taken;
+            }
+
+            list.head = last->next;
+            last->next = cache.heads[size_class];
+            cache.heads[size_class] = first;
+            cache.counts[size_class] += taken;
+
+            return true;
+        }
+
+        void flush(thread_cache& cache, size_t size_class) noexcept
+        {
+            const auto batch = batch_size_of(size_class);
+
+            auto first = cache.heads[size_class];
+            auto last = first;
+            for (uint32_t i = 1; i < batch; ++i)
+            {
+                last = last->next;
+            }
+
+            cache.heads[size_class] = last->next;
+            cache.counts[size_class] -= batch;
+
+            auto& list = central[size_class];
+            lock_guard lock{list.lock};
+
+            last->next = list.head;
+            list.head = first;
+        }
+    };
+
+    heap_allocator::heap_allocator(size_t bytes, size_t small_object_region_bytes)
         : _memory{reinterpret_cast<byte*>(std::malloc(bytes))}, _allocated_size{0}, _max_size{bytes}
     {
-        _tlsf_handle = tlsf_create_with_pool(_memory, _max_size);
+        // Small object slabs sit at the front of the block so they keep the alignment of the block
+        const auto slab_count = tempest::min(small_object_region_bytes, bytes) / small_object_slab_size;
+        const auto small_region_size = slab_count * small_object_slab_size;
+
+        _tlsf_handle = tlsf_create_with_pool(_memory + small_region_size, _max_size - small_region_size);
+        _state = new shared_state(_memory, slab_count);
     }
 
     heap_allocator::heap_allocator(heap_allocator&& other) noexcept
         : _tlsf_handle{std::move(other._tlsf_handle)}, _memory{std::move(other._memory)},
-          _allocated_size{std::move(other._allocated_size)}, _max_size{std::move(other._max_size)}
+          _allocated_size{std::move(other._allocated_size)}, _max_size{std::move(other._max_size)},
+          _state{std::move(other._state)}
     {
-        _tlsf_handle = nullptr;
-        _memory = nullptr;
+        other._tlsf_handle = nullptr;
+        other._memory = nullptr;
+        other._state = nullptr;
     }
 
     heap_allocator::~heap_allocator()
@@ -141,18 +369,86 @@ namespace tempest
         std::swap(_memory, rhs._memory);
         std::swap(_allocated_size, rhs._allocated_size);
         std::swap(_max_size, rhs._max_size);
+        std::swap(_state, rhs._state);
 
         return *this;
     }
 
-    void* heap_allocator::allocate(size_t size, [[maybe_unused]] size_t alignment, [[maybe_unused]] source_location loc)
+    void* heap_allocator::allocate(size_t size, size_t alignment, source_location loc)
     {
-        return tlsf_malloc(_tlsf_handle, size);
+        if (size == 0)
+        {
+            return nullptr;
+        }
+
+        void* ptr = nullptr;
+
+        if (size <= small_object_max_size && alignment <= small_object_alignment)
+        {
+            const auto size_class = size_class_of(size);
+            auto& cache = _state->this_thread_cache();
+
+            if (cache.heads[size_class] != nullptr || _state->refill(cache, size_class))
+            {
+                auto block = cache.heads[size_class];
+                cache.heads[size_class] = block->next;
+                --cache.counts[size_class];
+                ptr = block;
+            }
+        }
+
+        // Large or over-aligned allocation, or the small object region is exhausted
+        if (ptr == nullptr)
+        {
+            ptr = _allocate_large(size, alignment);
+        }
+
+        detail::track_allocation(ptr, size, loc);
+        return ptr;
     }
 
     void heap_allocator::deallocate(void* ptr)
     {
-        return tlsf_free(_tlsf_handle, ptr);
+        if (ptr == nullptr)
+        {
+            return;
+        }
+
+        detail::track_deallocation(ptr);
+
+        if (_state->owns_small(ptr))
+        {
+            // Blocks go to the freeing thread's cache, regardless of which thread allocated them
+            const auto size_class = _state->size_class_of_block(ptr);
+            auto& cache = _state->this_thread_cache();
+
+            auto block = static_cast<free_block*>(ptr);
+            block->next = cache.heads[size_class];
+            cache.heads[size_class] = block;
+
+            if (++cache.counts[size_class] > 2 * batch_size_of(size_class))
+            {
+                _state->flush(cache, size_class);
+            }
+
+            return;
+        }
+
+        lock_guard lock{_state->tlsf_lock};
+        tlsf_free(_tlsf_handle, ptr);
+    }
+
+    void* heap_allocator::_allocate_large(size_t size, size_t alignment)
+    {
+        lock_guard lock{_state->tlsf_lock};
+
+        // TLSF only guarantees its own block alignment from the malloc path
+        if (alignment <= tlsf_align_size())
+        {
+            return tlsf_malloc(_tlsf_handle, size);
+        }
+
+        return tlsf_memalign(_tlsf_handle, alignment, size);
     }
 
     void heap_allocator::_release()
@@ -161,10 +457,49 @@ namespace tempest
         {
             tlsf_destroy(_tlsf_handle);
             std::free(_memory);
+            delete _state;
 
             _tlsf_handle = nullptr;
             _memory = nullptr;
+            _state = nullptr;
+        }
+    }
+
+    void* new_delete_allocator::allocate(size_t size, size_t alignment, source_location loc)
+    {
+        if (size == 0)
+        {
+            return nullptr;
         }
+
+        // aligned_alloc requires the size to be a multiple of the alignment
+        const auto align = alignment < alignof(std::max_align_t) ? alignof(std::max_align_t) : alignment;
+        auto ptr = tempest::aligned_alloc(align_memory(size, align), align);
+        detail::track_allocation(ptr, size, loc);
+        return ptr;
+    }
+
+    void new_delete_allocator::deallocate(void* ptr)
+    {
+        detail::track_deallocation(ptr);
+        tempest::aligned_free(ptr);
+    }
+
+    namespace
+    {
+        new_delete_allocator global_heap_allocator;
+        std::atomic<abstract_allocator*> default_allocator{&global_heap_allocator};
+    } // namespace
+
+    abstract_allocator* get_default_allocator() noexcept
+    {
+        return default_allocator.load(std::memory_order_acquire);
+    }
+
+    abstract_allocator* set_default_allocator(abstract_allocator* alloc) noexcept
+    {
+        return default_allocator.exchange(alloc != nullptr ? alloc : &global_heap_allocator,
+                                          std::memory_order_acq_rel);
     }
 
     void* aligned_alloc(size_t n, size_t alignment)
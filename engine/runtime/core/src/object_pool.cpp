@@ -1,11 +1,39 @@
 #include <tempest/object_pool.hpp>
 
+#include "thread_binding.hpp"
+
 #include <tempest/algorithm.hpp>
 #include <tempest/assert.hpp>
 #include <tempest/limits.hpp>
 
 namespace tempest::core
 {
+    namespace
+    {
+        constexpr uint32_t no_free_slot = ~0u;
+
+        // Thread caches the calling thread has been given
+        thread_local thread_binding_list this_thread_pool_caches{};
+
+        constexpr uint32_t free_head_index(uint64_t head) noexcept
+        {
+            return static_cast<uint32_t>(head);
+        }
+
+        constexpr uint64_t make_free_head(uint64_t previous, uint32_t index) noexcept
+        {
+            const auto tag = (previous >> 32) + 1;
+            return (tag << 32) | index;
+        }
+
+        constexpr uint32_t next_generation(uint32_t generation) noexcept
+        {
+            // ~0u is reserved for invalid keys
+            const auto next = generation + 1;
+            return next == ~0u ? 0 : next;
+        }
+    } // namespace
+
     object_pool::object_pool(abstract_allocator* _alloc, uint32_t pool_size, uint32_t resource_size)
         : _alloc{_alloc}, _pool_size{pool_size}, _resource_size{resource_size}
     {
@@ -200,4 +228,215 @@ namespace tempest::core
     {
         return _pool_size;
     }
-} // namespace tempest::core
\ No newline at end of file
+
+    concurrent_object_pool::concurrent_object_pool(abstract_allocator* alloc, uint32_t pool_size,
+                                                   uint32_t resource_size, uint32_t thread_cache_size)
+        : _alloc{alloc}, _pool_size{pool_size}, _resource_size{resource_size}, _thread_cache_size{thread_cache_size},
+          _id{acquire_binding_owner_id()}
+    {
+        _slots = static_cast<slot*>(_alloc->allocate(sizeof(slot) * _pool_size, alignof(slot)));
+        for (uint32_t i = 0; i < _pool_size; ++i)
+        {
+            auto s = tempest::construct_at(_slots + i);
+            s->next.store(i + 1 < _pool_size ? i + 1 : no_free_slot, memory_order::relaxed);
+        }
+
+        const auto payload_size = static_cast<size_t>(_pool_size) * _resource_size;
+        _payload = reinterpret_cast<byte*>(_alloc->allocate(payload_size, 16));
+        fill_n(_payload, payload_size, byte(0));
+
+        _free_head.store(make_free_head(0, _pool_size > 0 ? 0 : no_free_slot), memory_order::release);
+    }
+
+    concurrent_object_pool::~concurrent_object_pool()
+    {
+        retire_binding_owner_id(_id);
+
+        _alloc->deallocate(_payload);
+        _alloc->deallocate(_slots);
+        _payload = nullptr;
+        _slots = nullptr;
+    }
+
+    concurrent_object_pool::key concurrent_object_pool::acquire_resource()
+    {
+        uint32_t index = no_free_slot;
+
+        if (_thread_cache_size > 0)
+        {
+            auto& cache = _this_thread_cache();
+            if (cache.free_indices.empty())
+            {
+                // Take half a cache worth of slots at once so the shared list is touched less often
+                const auto batch = _thread_cache_size / 2 > 0 ? _thread_cache_size / 2 : 1;
+                for (uint32_t i = 0; i < batch; ++i)
+                {
+                    const auto free_index = _pop_free();
+                    if (free_index == no_free_slot)
+                    {
+                        break;
+                    }
+                    cache.free_indices.push_back(free_index);
+                }
+            }
+
+            if (!cache.free_indices.empty())
+            {
+                index = cache.free_indices.back();
+                cache.free_indices.pop_back();
+            }
+        }
+        else
+        {
+            index = _pop_free();
+        }
+
+        if (index == no_free_slot)
+        {
+            return invalid_key;
+        }
+
+        return key{
+            .index = index,
+            .generation = _slots[index].generation.load(memory_order::acquire),
+        };
+    }
+
+    void concurrent_object_pool::release_resource(key index)
+    {
+        if (index.index >= _pool_size)
+        {
+            return;
+        }
+
+        // Bumping the generation claims the release, a racing release of the same key fails here
+        auto expected = index.generation;
+        if (!_slots[index.index].generation.compare_exchange_strong(expected, next_generation(expected),
+                                                                    memory_order::acq_rel, memory_order::relaxed))
+        {
+            return;
+        }
+
+        if (_thread_cache_size > 0)
+        {
+            auto& cache = _this_thread_cache();
+            if (cache.free_indices.size() == _thread_cache_size)
+            {
+                // Hand half of the cache back so other threads can use it
+                const auto batch = _thread_cache_size / 2 > 0 ? _thread_cache_size / 2 : 1;
+                for (uint32_t i = 0; i < batch; ++i)
+                {
+                    _push_free(cache.free_indices.back());
+                    cache.free_indices.pop_back();
+                }
+            }
+
+            cache.free_indices.push_back(index.index);
+            return;
+        }
+
+        _push_free(index.index);
+    }
+
+    void concurrent_object_pool::release_all_resources()
+    {
+        {
+            lock_guard lock{_registration_lock};
+            for (auto& cache : _caches)
+            {
+                cache->free_indices.clear();
+            }
+        }
+
+        for (uint32_t i = 0; i < _pool_size; ++i)
+        {
+            auto& s = _slots[i];
+            s.generation.store(next_generation(s.generation.load(memory_order::relaxed)), memory_order::relaxed);
+            s.next.store(i + 1 < _pool_size ? i + 1 : no_free_slot, memory_order::relaxed);
+        }
+
+        const auto head = _free_head.load(memory_order::relaxed);
+        _free_head.store(make_free_head(head, _pool_size > 0 ? 0 : no_free_slot), memory_order::release);
+    }
+
+    void* concurrent_object_pool::access(key index)
+    {
+        if (index.index < _pool_size && _slots[index.index].generation.load(memory_order::acquire) == index.generation)
+        {
+            return _payload + static_cast<size_t>(_resource_size) * index.index;
+        }
+        return nullptr;
+    }
+
+    const void* concurrent_object_pool::access(key index) const
+    {
+        if (index.index < _pool_size && _slots[index.index].generation.load(memory_order::acquire) == index.generation)
+        {
+            return _payload + static_cast<size_t>(_resource_size) * index.index;
+        }
+        return nullptr;
+    }
+
+    size_t concurrent_object_pool::size() const noexcept
+    {
+        return _pool_size;
+    }
+
+    uint32_t concurrent_object_pool::_pop_free() noexcept
+    {
+        auto head = _free_head.load(memory_order::acquire);
+        while (true)
+        {
+            const auto index = free_head_index(head);
+            if (index == no_free_slot)
+            {
+                return no_free_slot;
+            }
+
+            // The slot may be popped and pushed again by another thread before the exchange; the tag makes the
+            // exchange fail in that case, so a stale next is never published
+            const auto next = _slots[index].next.load(memory_order::relaxed);
+            if (_free_head.compare_exchange_weak(head, make_free_head(head, next), memory_order::acquire,
+                                                 memory_order::acquire))
+            {
+                return index;
+            }
+        }
+    }
+
+    void concurrent_object_pool::_push_free(uint32_t index) noexcept
+    {
+        auto head = _free_head.load(memory_order::relaxed);
+        while (true)
+        {
+            _slots[index].next.store(free_head_index(head), memory_order::relaxed);
+            if (_free_head.compare_exchange_weak(head, make_free_head(head, index), memory_order::release,
+                                                 memory_order::relaxed))
+            {
+                return;
+            }
+        }
+    }
+
+    concurrent_object_pool::thread_cache& concurrent_object_pool::_this_thread_cache()
+    {
+        if (auto bound = this_thread_pool_caches.find(_id)) [[likely]]
+        {
+            return *static_cast<thread_cache*>(bound);
+        }
+
+        // First use of the pool from this thread, register a new cache
+        auto cache = make_unique<thread_cache>();
+        cache->free_indices.reserve(_thread_cache_size);
+        auto result = cache.get();
+
+        {
+            lock_guard lock{_registration_lock};
+            _caches.push_back(tempest::move(cache));
+        }
+
+        this_thread_pool_caches.bind(_id, result);
+
+        return *result;
+    }
+} // namespace tempest::core
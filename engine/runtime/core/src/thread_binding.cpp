@@ -0,0 +1,88 @@
+#include "thread_binding.hpp"
+
+#include <tempest/algorithm.hpp>
+#include <tempest/atomic.hpp>
+#include <tempest/mutex.hpp>
+#include <tempest/utility.hpp>
+
+namespace tempest::core
+{
+    namespace
+    {
+        struct owner_registry
+        {
+            mutex lock;
+            uint64_t next_id = 1;
+            vector<uint64_t> live_ids; // Sorted, ids are handed out in increasing order
+            atomic<uint64_t> retirements{0};
+        };
+
+        owner_registry& registry()
+        {
+            // Intentionally leaked, owners with static storage duration may be destroyed after this translation unit's
+            // statics have been torn down
+            static auto instance = new owner_registry{};
+            return *instance;
+        }
+
+        bool is_live(const owner_registry& reg, uint64_t owner_id) noexcept
+        {
+            const auto it = tempest::lower_bound(reg.live_ids.begin(), reg.live_ids.end(), owner_id);
+            return it != reg.live_ids.end() && *it == owner_id;
+        }
+    } // namespace
+
+    uint64_t acquire_binding_owner_id()
+    {
+        auto& reg = registry();
+        lock_guard lock{reg.lock};
+
+        const auto id = reg.next_id++;
+        reg.live_ids.push_back(id);
+
+        return id;
+    }
+
+    void retire_binding_owner_id(uint64_t owner_id)
+    {
+        auto& reg = registry();
+        lock_guard lock{reg.lock};
+
+        const auto it = tempest::lower_bound(reg.live_ids.begin(), reg.live_ids.end(), owner_id);
+        if (it != reg.live_ids.end() && *it == owner_id)
+        {
+            reg.live_ids.erase(it);
+            reg.retirements.fetch_add(1, memory_order::release);
+        }
+    }
+
+    void* thread_binding_list::_find_slow(uint64_t owner_id) noexcept
+    {
+        for (size_t i = 1; i < _bindings.size(); ++i)
+        {
+            if (_bindings[i].owner_id == owner_id)
+            {
+                tempest::swap(_bindings[0], _bindings[i]);
+                return _bindings.front().state;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void thread_binding_list::bind(uint64_t owner_id, void* state)
+    {
+        auto& reg = registry();
+
+        // Ids are never reused, so stale entries are never matched, but they would accumulate on threads that outlive
+        // many owners
+        if (reg.retirements.load(memory_order::acquire) != _observed_retirements)
+        {
+            lock_guard lock{reg.lock};
+            erase_if(_bindings, [&](const binding& b) { return !is_live(reg, b.owner_id); });
+            _observed_retirements = reg.retirements.load(memory_order::relaxed);
+        }
+
+        _bindings.insert(_bindings.begin(), binding{owner_id, state});
+    }
+} // namespace tempest::core
@@ -0,0 +1,53 @@
+#ifndef tempest_core_thread_binding_hpp
+#define tempest_core_thread_binding_hpp
+
+#include <tempest/int.hpp>
+#include <tempest/vector.hpp>
+
+namespace tempest::core
+{
+    /// @brief Allocates an id for an owner of per-thread state, such as a heap, pool or arena. Ids are never reused.
+    [[nodiscard]] uint64_t acquire_binding_owner_id();
+
+    /// @brief Retires an owner id. Bindings to the owner are pruned from each thread's list the next time that thread
+    ///        binds new state.
+    void retire_binding_owner_id(uint64_t owner_id);
+
+    /// @brief Per-thread list of the state a thread has been given by each owner, most recently used first. Expected
+    ///        to be declared thread_local, one list per kind of owner so each keeps its own most recent entry.
+    class thread_binding_list
+    {
+      public:
+        /// @brief Finds the state bound to an owner and moves it to the front of the list.
+        /// @return Bound state, or nullptr if the thread has no state for the owner.
+        [[nodiscard]] void* find(uint64_t owner_id) noexcept;
+
+        /// @brief Binds state to an owner at the front of the list, pruning entries of retired owners first.
+        void bind(uint64_t owner_id, void* state);
+
+      private:
+        struct binding
+        {
+            uint64_t owner_id;
+            void* state;
+        };
+
+        vector<binding> _bindings;
+        uint64_t _observed_retirements = 0;
+
+        [[nodiscard]] void* _find_slow(uint64_t owner_id) noexcept;
+    };
+
+    inline void* thread_binding_list::find(uint64_t owner_id) noexcept
+    {
+        // Fast path, the thread keeps using the same owner
+        if (!_bindings.empty() && _bindings.front().owner_id == owner_id) [[likely]]
+        {
+            return _bindings.front().state;
+        }
+
+        return _find_slow(owner_id);
+    }
+} // namespace tempest::core
+
+#endif // tempest_core_thread_binding_hpp
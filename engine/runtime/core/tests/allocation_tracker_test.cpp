@@ -0,0 +1,243 @@
+#include <tempest/allocation_tracker.hpp>
+
+#include <tempest/memory.hpp>
+#include <tempest/vector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+namespace
+{
+    class allocation_tracker_fixture : public ::testing::Test
+    {
+      protected:
+        void SetUp() override
+        {
+            tempest::core::allocation_tracker::reset();
+        }
+
+        void TearDown() override
+        {
+            tempest::core::allocation_tracker::disable();
+            tempest::core::allocation_tracker::reset();
+        }
+    };
+
+    tempest::core::allocation_subsystem_stats find_subsystem(const tempest::core::allocation_snapshot& snapshot,
+                                                             const char* subsystem)
+    {
+        for (const auto& stats : snapshot.by_subsystem())
+        {
+            if (stats.subsystem != nullptr && std::strcmp(stats.subsystem, subsystem) == 0)
+            {
+                return stats;
+            }
+        }
+
+        return {};
+    }
+} // namespace
+
+TEST_F(allocation_tracker_fixture, disabled_records_nothing)
+{
+    tempest::new_delete_allocator alloc;
+
+    auto ptr = alloc.allocate(64, 8);
+    alloc.deallocate(ptr);
+
+    EXPECT_EQ(tempest::core::allocation_tracker::mode(), tempest::core::allocation_tracking_mode::disabled);
+    EXPECT_TRUE(tempest::core::allocation_tracker::snapshot().sites.empty());
+}
+
+TEST_F(allocation_tracker_fixture, full_mode_tracks_live_and_peak_bytes)
+{
+    tempest::core::allocation_tracker::enable(tempest::core::allocation_tracking_mode::full);
+
+    tempest::new_delete_allocator alloc;
+    tempest::core::allocation_scope scope("full_mode");
+
+    void* ptrs[4];
+    for (auto& ptr : ptrs)
+    {
+        ptr = alloc.allocate(128, 16);
+    }
+
+    alloc.deallocate(ptrs[0]);
+    alloc.deallocate(ptrs[1]);
+
+    auto stats = find_subsystem(tempest::core::allocation_tracker::snapshot(), "full_mode");
+    EXPECT_EQ(stats.allocation_count, 4u);
+    EXPECT_EQ(stats.deallocation_count, 2u);
+    EXPECT_EQ(stats.allocated_bytes, 4u * 128);
+    EXPECT_EQ(stats.live_bytes, 2 * 128);
+    EXPECT_EQ(stats.peak_bytes, 4 * 128);
+
+    alloc.deallocate(ptrs[2]);
+    alloc.deallocate(ptrs[3]);
+
+    stats = find_subsystem(tempest::core::allocation_tracker::snapshot(), "full_mode");
+    EXPECT_EQ(stats.live_bytes, 0);
+    EXPECT_EQ(stats.peak_bytes, 4 * 128);
+}
+
+TEST_F(allocation_tracker_fixture, scopes_tag_subsystems)
+{
+    tempest::core::allocation_tracker::enable(tempest::core::allocation_tracking_mode::full);
+
+    tempest::vector<int> outer_values;
+    tempest::vector<int> inner_values;
+
+    {
+        tempest::core::allocation_scope outer("outer");
+        outer_values.reserve(16);
+
+        {
+            tempest::core::allocation_scope inner("inner");
+            inner_values.reserve(32);
+        }
+
+        outer_values.reserve(64);
+    }
+
+    auto snapshot = tempest::core::allocation_tracker::snapshot();
+    auto outer = find_subsystem(snapshot, "outer");
+    auto inner = find_subsystem(snapshot, "inner");
+
+    EXPECT_EQ(outer.allocation_count, 2u);
+    EXPECT_EQ(outer.allocated_bytes, (16 + 64) * sizeof(int));
+    EXPECT_EQ(outer.live_bytes, static_cast<int64_t>(64 * sizeof(int)));
+    EXPECT_EQ(inner.allocation_count, 1u);
+    EXPECT_EQ(inner.live_bytes, static_cast<int64_t>(32 * sizeof(int)));
+}
+
+TEST_F(allocation_tracker_fixture, sampled_mode_scales_statistics)
+{
+    tempest::core::allocation_tracker::enable(tempest::core::allocation_tracking_mode::sampled, 8);
+
+    tempest::new_delete_allocator alloc;
+    tempest::core::allocation_scope scope("sampled");
+
+    tempest::vector<void*> ptrs;
+    ptrs.reserve(64);
+
+    for (int i = 0; i < 64; ++i)
+    {
+        ptrs.push_back(alloc.allocate(32, 8));
+    }
+
+    auto stats = find_subsystem(tempest::core::allocation_tracker::snapshot(), "sampled");
+    EXPECT_EQ(stats.allocation_count, 64u);
+    EXPECT_EQ(stats.allocated_bytes, 64u * 32);
+    EXPECT_EQ(stats.live_bytes, 64 * 32);
+
+    for (auto ptr : ptrs)
+    {
+        alloc.deallocate(ptr);
+    }
+
+    stats = find_subsystem(tempest::core::allocation_tracker::snapshot(), "sampled");
+    EXPECT_EQ(stats.live_bytes, 0);
+    EXPECT_EQ(stats.deallocation_count, 64u);
+}
+
+TEST_F(allocation_tracker_fixture, end_frame_reports_per_frame_allocations)
+{
+    tempest::core::allocation_tracker::enable(tempest::core::allocation_tracking_mode::full);
+
+    tempest::stack_allocator stack(1024);
+    tempest::core::allocation_scope scope("frame");
+
+    for (int i = 0; i < 3; ++i)
+    {
+        (void)stack.allocate(16, 8);
+    }
+
+    tempest::core::allocation_tracker::end_frame();
+
+    auto snapshot = tempest::core::allocation_tracker::snapshot();
+    auto stats = find_subsystem(snapshot, "frame");
+    EXPECT_EQ(snapshot.frame, 1u);
+    EXPECT_EQ(stats.frame_allocation_count, 3u);
+    EXPECT_EQ(stats.frame_allocated_bytes, 3u * 16);
+
+    // Transient allocations are released in bulk, they never contribute live bytes
+    EXPECT_EQ(stats.live_bytes, 0);
+
+    tempest::core::allocation_tracker::end_frame();
+
+    stats = find_subsystem(tempest::core::allocation_tracker::snapshot(), "frame");
+    EXPECT_EQ(stats.frame_allocation_count, 0u);
+    EXPECT_EQ(stats.allocation_count, 3u);
+}
+
+TEST_F(allocation_tracker_fixture, diff_finds_growing_sites)
+{
+    tempest::core::allocation_tracker::enable(tempest::core::allocation_tracking_mode::full);
+
+    tempest::new_delete_allocator alloc;
+    tempest::core::allocation_scope scope("diff");
+
+    auto kept = alloc.allocate(64, 8);
+    auto before = tempest::core::allocation_tracker::snapshot();
+
+    auto leaked = alloc.allocate(256, 8);
+    auto released = alloc.allocate(512, 8);
+    alloc.deallocate(released);
+
+    auto after = tempest::core::allocation_tracker::snapshot();
+    auto deltas = tempest::core::allocation_tracker::diff(before, after);
+
+    int64_t live_delta = 0;
+    int64_t allocation_delta = 0;
+    for (const auto& delta : deltas)
+    {
+        EXPECT_STREQ(delta.subsystem, "diff");
+        live_delta += delta.live_bytes;
+        allocation_delta += delta.allocation_count;
+    }
+
+    // The site of the kept allocation did not change and is omitted
+    EXPECT_EQ(deltas.size(), 2u);
+    EXPECT_EQ(live_delta, 256);
+    EXPECT_EQ(allocation_delta, 2);
+
+    alloc.deallocate(leaked);
+    alloc.deallocate(kept);
+}
+
+TEST_F(allocation_tracker_fixture, container_growth_is_keyed_by_call_stack)
+{
+    tempest::core::allocation_tracker::enable(tempest::core::allocation_tracking_mode::full);
+
+    tempest::vector<int> first;
+    tempest::vector<int> second;
+
+    {
+        tempest::core::allocation_scope scope("growth");
+        first.reserve(16);
+        second.reserve(16);
+    }
+
+    auto snapshot = tempest::core::allocation_tracker::snapshot();
+
+    tempest::vector<tempest::core::allocation_site_stats> sites;
+    for (const auto& site : snapshot.sites)
+    {
+        if (site.subsystem != nullptr && std::strcmp(site.subsystem, "growth") == 0)
+        {
+            sites.push_back(site);
+        }
+    }
+
+    // Growth goes through allocator_traits, which has no source location to offer
+    ASSERT_EQ(sites.size(), 2u);
+    for (const auto& site : sites)
+    {
+        EXPECT_EQ(site.file, nullptr);
+        EXPECT_NE(site.callstack[0], nullptr);
+        EXPECT_EQ(site.allocation_count, 1u);
+    }
+
+    EXPECT_NE(sites[0].callstack, sites[1].callstack);
+}
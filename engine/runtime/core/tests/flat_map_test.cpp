@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <tempest/flat_map.hpp>
+#include <tempest/string.hpp>
 
 TEST(flat_map, default_constructor)
 {
@@ -367,4 +368,29 @@ TEST(flat_map, iterator_checks)
 
     EXPECT_TRUE(tempest::input_iterator<it>);
     // EXPECT_TRUE(tempest::input_iterator<const_it>);
-}
\ No newline at end of file
+}
+
+TEST(flat_map, heterogeneous_lookup)
+{
+    tempest::flat_map<tempest::string, int> map;
+    map.insert({tempest::string("apple"), 1});
+    map.insert({tempest::string("banana"), 2});
+
+    tempest::string_view key = "banana";
+
+    auto it = map.find(key);
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ(it->second, 2);
+
+    EXPECT_TRUE(map.contains(tempest::string_view("apple")));
+    EXPECT_FALSE(map.contains(tempest::string_view("cherry")));
+    EXPECT_EQ(map.count(tempest::string_view("apple")), 1);
+
+    map[tempest::string_view("cherry")] = 3;
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_EQ(map[tempest::string_view("cherry")], 3);
+
+    EXPECT_EQ(map.erase(tempest::string_view("apple")), 1);
+    EXPECT_EQ(map.erase(tempest::string_view("apple")), 0);
+    EXPECT_EQ(map.size(), 2);
+}
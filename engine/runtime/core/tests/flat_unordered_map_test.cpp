@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <tempest/flat_unordered_map.hpp>
+#include <tempest/string.hpp>
 
 #include <algorithm>
 #include <utility>
@@ -189,6 +190,25 @@ TEST(metadata_group, match_byte_all)
     EXPECT_EQ(group.match_byte(1), expected);
 }
 
+TEST(metadata_group, match_empty_and_deleted)
+{
+    tempest::detail::metadata_group group;
+
+    for (std::size_t i = 0; i < tempest::detail::metadata_group::group_size; ++i)
+    {
+        group.entries[i] = 0x7F;
+    }
+
+    group.entries[1] = tempest::detail::empty_entry;
+    group.entries[7] = tempest::detail::deleted_entry;
+    group.entries[15] = tempest::detail::empty_entry;
+
+    EXPECT_EQ(group.match_empty(), (1 << 1) | (1 << 15));
+    EXPECT_EQ(group.match_empty_or_deleted(), (1 << 1) | (1 << 7) | (1 << 15));
+    EXPECT_EQ(group.match_full(), static_cast<std::uint16_t>(~((1 << 1) | (1 << 7) | (1 << 15))));
+    EXPECT_EQ(group.match_byte(0x7F), group.match_full());
+}
+
 TEST(flat_unordered_map, default_constructor)
 {
     tempest::flat_unordered_map<int, int> map;
@@ -282,6 +302,49 @@ TEST(flat_unordered_map, erase_value_that_does_not_exist)
     ASSERT_EQ(map.size(), 2);
 }
 
+TEST(flat_unordered_map, erase_all_then_iterate)
+{
+    tempest::flat_unordered_map<int, int> map;
+
+    map.insert({1, 1});
+    map.insert({2, 2});
+
+    map.erase(1);
+    map.erase(2);
+
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(flat_unordered_map, reinsert_into_deleted_slots)
+{
+    tempest::flat_unordered_map<int, int> map;
+
+    for (int i = 0; i < 64; ++i)
+    {
+        map.insert({i, i});
+    }
+
+    for (int i = 0; i < 64; i += 2)
+    {
+        map.erase(i);
+    }
+
+    for (int i = 0; i < 64; i += 2)
+    {
+        auto [it, inserted] = map.insert({i, -i});
+        EXPECT_TRUE(inserted);
+    }
+
+    ASSERT_EQ(map.size(), 64);
+    for (int i = 0; i < 64; ++i)
+    {
+        auto it = map.find(i);
+        ASSERT_NE(it, map.end());
+        EXPECT_EQ(it->second, i % 2 == 0 ? -i : i);
+    }
+}
+
 TEST(flat_unordered_map, iterate)
 {
     tempest::flat_unordered_map<int, int> map;
@@ -327,4 +390,31 @@ TEST(flat_unordered_map, const_iterator)
     {
         ASSERT_EQ(found_values[i], std::make_pair(i, 9 - i));
     }
-}
\ No newline at end of file
+}
+
+TEST(flat_unordered_map, heterogeneous_lookup)
+{
+    tempest::flat_unordered_map<tempest::string, int> map;
+    map.insert({tempest::string("apple"), 1});
+    map.insert({tempest::string("banana"), 2});
+
+    tempest::string_view key = "banana";
+
+    auto it = map.find(key);
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ(it->second, 2);
+
+    const auto& const_map = map;
+    EXPECT_NE(const_map.find(tempest::string_view("apple")), const_map.cend());
+    EXPECT_TRUE(map.contains(tempest::string_view("apple")));
+    EXPECT_TRUE(map.contains("apple"));
+    EXPECT_FALSE(map.contains(tempest::string_view("cherry")));
+
+    map[tempest::string_view("cherry")] = 3;
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_EQ(map[tempest::string_view("cherry")], 3);
+
+    map.erase(tempest::string_view("apple"));
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_FALSE(map.contains(tempest::string_view("apple")));
+}
@@ -0,0 +1,115 @@
+#include <tempest/frame_arena.hpp>
+
+#include <tempest/atomic.hpp>
+#include <tempest/job_system.hpp>
+#include <tempest/vector.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(frame_arena, allocate_array_value_initializes)
+{
+    tempest::core::frame_arena arena(1024, 2);
+
+    auto values = arena.allocate_array<uint32_t>(16);
+
+    ASSERT_EQ(values.size(), 16);
+    for (auto value : values)
+    {
+        EXPECT_EQ(value, 0u);
+    }
+
+    EXPECT_EQ(arena.thread_count(), 1);
+    EXPECT_GE(arena.bytes_allocated(0), 16 * sizeof(uint32_t));
+}
+
+TEST(frame_arena, allocations_respect_alignment)
+{
+    tempest::core::frame_arena arena(1024, 2);
+
+    (void)arena.allocate(1, 1);
+    auto ptr = arena.allocate(64, 64);
+
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % 64, 0u);
+}
+
+TEST(frame_arena, begin_frame_releases_only_that_frame)
+{
+    tempest::core::frame_arena arena(1024, 2);
+
+    arena.begin_frame(0);
+    (void)arena.allocate_array<uint64_t>(8);
+
+    arena.begin_frame(1);
+    (void)arena.allocate_array<uint64_t>(4);
+
+    EXPECT_EQ(arena.bytes_allocated(0), 8 * sizeof(uint64_t));
+    EXPECT_EQ(arena.bytes_allocated(1), 4 * sizeof(uint64_t));
+
+    arena.begin_frame(0);
+
+    EXPECT_EQ(arena.current_frame(), 0u);
+    EXPECT_EQ(arena.bytes_allocated(0), 0u);
+    EXPECT_EQ(arena.bytes_allocated(1), 4 * sizeof(uint64_t));
+}
+
+TEST(frame_arena, overflow_spills_to_heap)
+{
+    tempest::core::frame_arena arena(64, 1);
+
+    auto small = arena.allocate_array<uint8_t>(32);
+    auto large = arena.allocate_array<uint8_t>(256);
+
+    EXPECT_NE(small.data(), nullptr);
+    EXPECT_NE(large.data(), nullptr);
+    EXPECT_EQ(arena.bytes_allocated(0), 32 + 256);
+
+    arena.begin_frame(0);
+    EXPECT_EQ(arena.bytes_allocated(0), 0u);
+}
+
+TEST(frame_arena, thread_allocator_backs_pmr_containers)
+{
+    tempest::core::frame_arena arena(4096, 2);
+
+    tempest::pmr::vector<int> values(arena.thread_allocator());
+    for (int i = 0; i < 100; ++i)
+    {
+        values.push_back(i);
+    }
+
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(values[i], i);
+    }
+
+    EXPECT_GE(arena.bytes_allocated(0), 100 * sizeof(int));
+}
+
+TEST(frame_arena, each_thread_gets_its_own_region)
+{
+    tempest::core::frame_arena arena(4096, 2);
+    tempest::core::job_system jobs(4);
+
+    tempest::atomic<uint32_t> failures{0};
+
+    jobs.parallel_for(0, 256, 1, [&](size_t index) {
+        auto values = arena.allocate_array<size_t>(4);
+        for (auto& value : values)
+        {
+            value = index;
+        }
+
+        for (auto value : values)
+        {
+            if (value != index)
+            {
+                failures.fetch_add(1, tempest::memory_order::relaxed);
+            }
+        }
+    });
+
+    EXPECT_EQ(failures.load(tempest::memory_order::relaxed), 0u);
+    EXPECT_GE(arena.thread_count(), 1u);
+    EXPECT_LE(arena.thread_count(), jobs.worker_count() + 1);
+    EXPECT_EQ(arena.bytes_allocated(0), 256 * 4 * sizeof(size_t));
+}
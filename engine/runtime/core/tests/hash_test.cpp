@@ -0,0 +1,167 @@
+#include <tempest/hash.hpp>
+
+#include <tempest/array.hpp>
+#include <tempest/meta.hpp>
+#include <tempest/string.hpp>
+#include <tempest/string_view.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    constexpr const char text[] = "The quick brown fox jumps over the lazy dog while material parameters are hashed.";
+    constexpr std::size_t text_length = sizeof(text) - 1;
+
+    // Hash of every prefix of the text, computed at compile time
+    constexpr auto prefix_hashes = [] {
+        tempest::array<tempest::uint64_t, text_length + 1> hashes{};
+        for (std::size_t i = 0; i <= text_length; ++i)
+        {
+            hashes[i] = tempest::detail::wyhash(text, i);
+        }
+        return hashes;
+    }();
+
+    // Writes "assets/textures/texture_<index>.png" into the buffer and returns its length
+    std::size_t make_asset_path(char* buffer, std::size_t index)
+    {
+        constexpr char prefix[] = "assets/textures/texture_";
+        constexpr char suffix[] = ".png";
+
+        std::size_t length = 0;
+        for (std::size_t i = 0; i < sizeof(prefix) - 1; ++i)
+        {
+            buffer[length++] = prefix[i];
+        }
+
+        char digits[20];
+        std::size_t digit_count = 0;
+        do
+        {
+            digits[digit_count++] = static_cast<char>('0' + index % 10);
+            index /= 10;
+        } while (index != 0);
+
+        while (digit_count > 0)
+        {
+            buffer[length++] = digits[--digit_count];
+        }
+
+        for (std::size_t i = 0; i < sizeof(suffix) - 1; ++i)
+        {
+            buffer[length++] = suffix[i];
+        }
+
+        return length;
+    }
+
+    template <typename F>
+    void expect_uniform_top_bits(std::size_t key_count, F&& hash_key)
+    {
+        constexpr std::size_t bucket_count = 128;
+        std::size_t buckets[bucket_count] = {};
+
+        for (std::size_t i = 0; i < key_count; ++i)
+        {
+            const auto h = static_cast<tempest::uint64_t>(hash_key(i));
+            ++buckets[h >> 57];
+        }
+
+        // Each bucket is expected to hold key_count / 128 keys, allow a generous deviation
+        const auto expected = static_cast<double>(key_count) / bucket_count;
+        for (std::size_t bucket = 0; bucket < bucket_count; ++bucket)
+        {
+            EXPECT_GT(static_cast<double>(buckets[bucket]), expected * 0.75) << "bucket " << bucket;
+            EXPECT_LT(static_cast<double>(buckets[bucket]), expected * 1.25) << "bucket " << bucket;
+        }
+    }
+} // namespace
+
+TEST(hash, compile_time_matches_runtime)
+{
+    // Covers the short, medium and 48 byte block paths
+    for (std::size_t i = 0; i <= text_length; ++i)
+    {
+        EXPECT_EQ(prefix_hashes[i], tempest::hash_bytes(text, i)) << "length " << i;
+    }
+}
+
+TEST(hash, prefixes_differ)
+{
+    for (std::size_t i = 0; i < text_length; ++i)
+    {
+        for (std::size_t j = i + 1; j <= text_length; ++j)
+        {
+            EXPECT_NE(prefix_hashes[i], prefix_hashes[j]);
+        }
+    }
+}
+
+TEST(hash, seed_changes_hash)
+{
+    EXPECT_NE(tempest::hash_bytes(text, text_length, 0), tempest::hash_bytes(text, text_length, 1));
+}
+
+TEST(hash, string_types_agree)
+{
+    const auto sv = tempest::string_view(text);
+    const auto str = tempest::string(text);
+
+    EXPECT_EQ(tempest::hash<tempest::string_view>{}(sv), tempest::hash_bytes(text, text_length));
+    EXPECT_EQ(tempest::hash<tempest::string>{}(str), tempest::hash<tempest::string_view>{}(sv));
+}
+
+TEST(hash, wide_strings_hash_at_compile_time)
+{
+    constexpr wchar_t wide_text[] = L"assets/textures/\u00e9t\u00e9.png";
+    constexpr auto wide_length = sizeof(wide_text) / sizeof(wchar_t) - 1;
+
+    constexpr auto wide_hash = tempest::core::detail::basic_hash_string<wchar_t>(wide_text).value();
+    constexpr auto u32_hash = tempest::detail::hash_chars(U"assets", 6);
+
+    static_assert(wide_hash != 0);
+    static_assert(u32_hash != tempest::detail::hash_chars(U"assetz", 6));
+
+    EXPECT_EQ(wide_hash, tempest::hash_bytes(wide_text, wide_length * sizeof(wchar_t)));
+    EXPECT_EQ(u32_hash, tempest::hash_bytes(U"assets", 6 * sizeof(char32_t)));
+}
+
+TEST(hash, type_hash_is_constant)
+{
+    constexpr auto int_hash = tempest::core::type_hash<int>::value();
+    constexpr auto float_hash = tempest::core::type_hash<float>::value();
+
+    static_assert(int_hash != float_hash);
+
+    const auto name = tempest::core::get_type_name<int>();
+    EXPECT_EQ(int_hash, tempest::hash_bytes(name.data(), name.size()));
+}
+
+TEST(hash, asset_path_top_bits_are_uniform)
+{
+    expect_uniform_top_bits(128 * 1024, [](std::size_t i) {
+        char buffer[64];
+        const auto length = make_asset_path(buffer, i);
+        return tempest::hash<tempest::string_view>{}(tempest::string_view(buffer, length));
+    });
+}
+
+TEST(hash, sequential_bytes_top_bits_are_uniform)
+{
+    // Keys differing only in their low bytes, as in short parameter names with numeric suffixes
+    expect_uniform_top_bits(128 * 1024, [](std::size_t i) {
+        const tempest::uint32_t key = static_cast<tempest::uint32_t>(i);
+        return tempest::hash_bytes(&key, sizeof(key));
+    });
+}
+
+TEST(hash, long_input_top_bits_are_uniform)
+{
+    // Exercises the 48 byte block loop
+    expect_uniform_top_bits(64 * 1024, [](std::size_t i) {
+        tempest::uint64_t block[16] = {};
+        block[i % 16] = i;
+        block[15] ^= 0x5555;
+        return tempest::hash_bytes(block, sizeof(block));
+    });
+}
@@ -0,0 +1,208 @@
+#include <tempest/job_system.hpp>
+
+#include <tempest/atomic.hpp>
+#include <tempest/vector.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(job_system, default_worker_count)
+{
+    tempest::core::job_system jobs;
+
+    EXPECT_GE(jobs.worker_count(), 1u);
+    EXPECT_EQ(jobs.current_worker_index(), jobs.worker_count());
+}
+
+TEST(job_system, submit_and_wait_handle)
+{
+    tempest::core::job_system jobs(4);
+
+    int value = 0;
+    auto handle = jobs.submit([&value]() { value = 42; });
+
+    EXPECT_TRUE(handle.valid());
+    jobs.wait(handle);
+
+    EXPECT_TRUE(handle.is_complete());
+    EXPECT_EQ(value, 42);
+}
+
+TEST(job_system, default_handle_is_complete)
+{
+    tempest::core::job_system jobs(1);
+    tempest::core::job_handle handle;
+
+    EXPECT_FALSE(handle.valid());
+    EXPECT_TRUE(handle.is_complete());
+
+    jobs.wait(handle);
+}
+
+TEST(job_system, submit_many_with_counter)
+{
+    tempest::core::job_system jobs(4);
+    tempest::core::job_counter counter;
+    tempest::atomic<tempest::uint32_t> sum{0};
+
+    for (tempest::uint32_t i = 0; i < 10000; ++i)
+    {
+        jobs.submit([&sum]() { sum.fetch_add(1); }, counter);
+    }
+
+    jobs.wait(counter);
+
+    EXPECT_TRUE(counter.is_complete());
+    EXPECT_EQ(counter.pending(), 0u);
+    EXPECT_EQ(sum.load(), 10000u);
+}
+
+TEST(job_system, nested_jobs)
+{
+    tempest::core::job_system jobs(4);
+    tempest::core::job_counter outer;
+    tempest::atomic<tempest::uint32_t> sum{0};
+
+    for (tempest::uint32_t i = 0; i < 64; ++i)
+    {
+        jobs.submit(
+            [&jobs, &sum]() {
+                tempest::core::job_counter inner;
+                for (tempest::uint32_t j = 0; j < 64; ++j)
+                {
+                    jobs.submit([&sum]() { sum.fetch_add(1); }, inner);
+                }
+                jobs.wait(inner);
+            },
+            outer);
+    }
+
+    jobs.wait(outer);
+
+    EXPECT_EQ(sum.load(), 64u * 64u);
+}
+
+TEST(job_system, parallel_for_index)
+{
+    tempest::core::job_system jobs(4);
+    tempest::vector<tempest::uint32_t> values(100000, 0);
+
+    jobs.parallel_for(0, values.size(), 1024,
+                      [&values](tempest::size_t i) { values[i] = static_cast<tempest::uint32_t>(i); });
+
+    for (tempest::size_t i = 0; i < values.size(); ++i)
+    {
+        ASSERT_EQ(values[i], i);
+    }
+}
+
+TEST(job_system, parallel_for_range)
+{
+    tempest::core::job_system jobs(4);
+    tempest::atomic<tempest::uint64_t> sum{0};
+    tempest::atomic<tempest::uint32_t> chunks{0};
+
+    jobs.parallel_for(0, 1000, 100, [&](tempest::size_t first, tempest::size_t last) {
+        EXPECT_LE(last - first, 100u);
+
+        tempest::uint64_t local = 0;
+        for (tempest::size_t i = first; i < last; ++i)
+        {
+            local += i;
+        }
+        sum.fetch_add(local);
+        chunks.fetch_add(1);
+    });
+
+    EXPECT_EQ(sum.load(), 999u * 1000u / 2u);
+    EXPECT_EQ(chunks.load(), 10u);
+}
+
+TEST(job_system, parallel_for_empty_range)
+{
+    tempest::core::job_system jobs(2);
+    bool invoked = false;
+
+    jobs.parallel_for(10, 10, 0, [&invoked](tempest::size_t) { invoked = true; });
+
+    EXPECT_FALSE(invoked);
+}
+
+TEST(job_system, parallel_for_async)
+{
+    tempest::core::job_system jobs(4);
+    tempest::core::job_counter counter;
+    tempest::vector<tempest::uint32_t> values(4096, 0);
+
+    jobs.parallel_for(0, values.size(), 0, [&values](tempest::size_t i) { values[i] = 1; }, counter);
+    jobs.wait(counter);
+
+    for (auto v : values)
+    {
+        ASSERT_EQ(v, 1u);
+    }
+}
+
+TEST(job_system, short_lived_counters)
+{
+    tempest::core::job_system jobs(4);
+    tempest::atomic<tempest::uint32_t> sum{0};
+
+    // Each counter goes out of scope as soon as the wait returns, while the worker that released it may still be
+    // waking waiters
+    for (tempest::uint32_t i = 0; i < 1000; ++i)
+    {
+        tempest::core::job_counter counter;
+        jobs.submit(
+            [&sum]() {
+                for (tempest::uint32_t j = 0; j < 1000; ++j)
+                {
+                    sum.fetch_add(1);
+                }
+            },
+            counter);
+        jobs.wait(counter);
+
+        ASSERT_EQ(sum.load(), (i + 1) * 1000u);
+    }
+}
+
+TEST(work_stealing_deque, push_pop_is_lifo)
+{
+    auto queue = tempest::make_unique<tempest::core::detail::work_stealing_deque>();
+    tempest::core::detail::job a, b;
+
+    EXPECT_TRUE(queue->empty());
+    EXPECT_TRUE(queue->push(&a));
+    EXPECT_TRUE(queue->push(&b));
+
+    EXPECT_EQ(queue->pop(), &b);
+    EXPECT_EQ(queue->pop(), &a);
+    EXPECT_EQ(queue->pop(), nullptr);
+    EXPECT_TRUE(queue->empty());
+}
+
+TEST(work_stealing_deque, steal_is_fifo)
+{
+    auto queue = tempest::make_unique<tempest::core::detail::work_stealing_deque>();
+    tempest::core::detail::job a, b;
+
+    EXPECT_TRUE(queue->push(&a));
+    EXPECT_TRUE(queue->push(&b));
+
+    EXPECT_EQ(queue->steal(), &a);
+    EXPECT_EQ(queue->pop(), &b);
+    EXPECT_EQ(queue->steal(), nullptr);
+}
+
+TEST(work_stealing_deque, push_fails_when_full)
+{
+    auto queue = tempest::make_unique<tempest::core::detail::work_stealing_deque>();
+    tempest::core::detail::job j;
+
+    for (tempest::int64_t i = 0; i < tempest::core::detail::work_stealing_deque::capacity; ++i)
+    {
+        ASSERT_TRUE(queue->push(&j));
+    }
+
+    EXPECT_FALSE(queue->push(&j));
+}
@@ -0,0 +1,278 @@
+#include <tempest/flat_unordered_map.hpp>
+#include <tempest/job_system.hpp>
+#include <tempest/memory.hpp>
+#include <tempest/slot_map.hpp>
+#include <tempest/string.hpp>
+#include <tempest/vector.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    class counting_allocator final : public tempest::abstract_allocator
+    {
+      public:
+        void* allocate(size_t size, size_t alignment, tempest::source_location loc) override
+        {
+            auto ptr = _backing.allocate(size, alignment, loc);
+            if (ptr != nullptr)
+            {
+                ++allocations;
+            }
+            return ptr;
+        }
+
+        void deallocate(void* ptr) override
+        {
+            ++deallocations;
+            _backing.deallocate(ptr);
+        }
+
+        size_t allocations{0};
+        size_t deallocations{0};
+
+      private:
+        tempest::new_delete_allocator _backing;
+    };
+} // namespace
+
+TEST(stack_allocator, deallocate_top_reclaims_memory)
+{
+    tempest::stack_allocator alloc{1024};
+
+    auto first = alloc.allocate(16, 8);
+    auto marker = alloc.get_marker();
+    auto second = alloc.allocate(16, 8);
+
+    alloc.deallocate(second);
+    EXPECT_EQ(alloc.get_marker(), marker);
+
+    // Deallocating below the top of the stack must not release the memory above it
+    auto third = alloc.allocate(16, 8);
+    alloc.deallocate(first);
+    EXPECT_EQ(alloc.allocate(16, 8), static_cast<tempest::byte*>(third) + 16);
+}
+
+TEST(heap_allocator, honors_alignment)
+{
+    tempest::heap_allocator alloc{1024 * 1024};
+
+    for (size_t alignment : {8, 16, 32, 64, 256, 4096})
+    {
+        for (size_t size : {1, 24, 200, 1000})
+        {
+            auto ptr = alloc.allocate(size, alignment);
+            ASSERT_NE(ptr, nullptr);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignment, 0u);
+            alloc.deallocate(ptr);
+        }
+    }
+}
+
+TEST(heap_allocator, small_objects_are_reused)
+{
+    tempest::heap_allocator alloc{1024 * 1024, 256 * 1024};
+
+    auto first = alloc.allocate(32, 8);
+    alloc.deallocate(first);
+
+    // The block sits on top of the thread cache
+    EXPECT_EQ(alloc.allocate(32, 8), first);
+    alloc.deallocate(first);
+}
+
+TEST(heap_allocator, small_and_large_allocations_do_not_overlap)
+{
+    tempest::heap_allocator alloc{1024 * 1024, 256 * 1024};
+
+    tempest::vector<tempest::byte*> ptrs;
+    tempest::vector<size_t> sizes;
+
+    for (size_t i = 0; i < 512; ++i)
+    {
+        const auto size = (i * 37) % 700 + 1;
+        auto ptr = static_cast<tempest::byte*>(alloc.allocate(size, 8));
+        ASSERT_NE(ptr, nullptr);
+
+        for (size_t j = 0; j < size; ++j)
+        {
+            ptr[j] = static_cast<tempest::byte>(i);
+        }
+
+        ptrs.push_back(ptr);
+        sizes.push_back(size);
+    }
+
+    for (size_t i = 0; i < ptrs.size(); ++i)
+    {
+        for (size_t j = 0; j < sizes[i]; ++j)
+        {
+            ASSERT_EQ(ptrs[i][j], static_cast<tempest::byte>(i));
+        }
+
+        alloc.deallocate(ptrs[i]);
+    }
+}
+
+TEST(heap_allocator, falls_back_to_tlsf_when_small_region_is_exhausted)
+{
+    // A single slab holds 256 blocks of 64 bytes, the rest go through TLSF
+    tempest::heap_allocator alloc{64 * 1024, 16 * 1024};
+
+    tempest::vector<void*> ptrs;
+    for (size_t i = 0; i < 512; ++i)
+    {
+        auto ptr = alloc.allocate(64, 8);
+        ASSERT_NE(ptr, nullptr);
+        ptrs.push_back(ptr);
+    }
+
+    for (auto ptr : ptrs)
+    {
+        alloc.deallocate(ptr);
+    }
+}
+
+TEST(heap_allocator, heap_without_small_object_region_serves_small_objects)
+{
+    tempest::heap_allocator alloc{32 * 1024};
+
+    tempest::vector<void*> ptrs;
+    for (size_t i = 0; i < 64; ++i)
+    {
+        auto ptr = alloc.allocate(64, 8);
+        ASSERT_NE(ptr, nullptr);
+        ptrs.push_back(ptr);
+    }
+
+    for (auto ptr : ptrs)
+    {
+        alloc.deallocate(ptr);
+    }
+}
+
+TEST(heap_allocator, whole_heap_is_available_without_small_object_region)
+{
+    tempest::heap_allocator alloc{1024 * 1024};
+
+    // Nothing is held back for small objects, so nearly the whole block can go to a single allocation
+    auto ptr = alloc.allocate(900 * 1024, 16);
+    ASSERT_NE(ptr, nullptr);
+    alloc.deallocate(ptr);
+}
+
+TEST(heap_allocator, threads_free_blocks_allocated_elsewhere)
+{
+    tempest::heap_allocator alloc{4 * 1024 * 1024, 1024 * 1024};
+    tempest::core::job_system jobs(4);
+
+    tempest::vector<void*> ptrs(1024);
+    for (auto& ptr : ptrs)
+    {
+        ptr = alloc.allocate(48, 16);
+    }
+
+    // Blocks are released into the worker caches and reused from there
+    jobs.parallel_for(0, ptrs.size(), 16, [&](size_t index) {
+        alloc.deallocate(ptrs[index]);
+        auto ptr = alloc.allocate(48, 16);
+        alloc.deallocate(ptr);
+    });
+
+    auto ptr = alloc.allocate(48, 16);
+    EXPECT_NE(ptr, nullptr);
+    alloc.deallocate(ptr);
+}
+
+TEST(polymorphic_allocator, default_uses_default_allocator)
+{
+    tempest::polymorphic_allocator<int> alloc;
+    EXPECT_EQ(alloc.resource(), tempest::get_default_allocator());
+
+    counting_allocator counting;
+    auto previous = tempest::set_default_allocator(&counting);
+
+    tempest::polymorphic_allocator<int> counted;
+    EXPECT_EQ(counted.resource(), &counting);
+
+    tempest::set_default_allocator(previous);
+    EXPECT_EQ(tempest::get_default_allocator(), previous);
+}
+
+TEST(polymorphic_allocator, rebind_keeps_resource)
+{
+    counting_allocator counting;
+    tempest::polymorphic_allocator<int> alloc{&counting};
+
+    using traits = tempest::allocator_traits<tempest::polymorphic_allocator<int>>;
+    static_assert(tempest::is_same_v<traits::rebind_alloc<double>, tempest::polymorphic_allocator<double>>);
+
+    traits::rebind_alloc<double> rebound{alloc};
+    EXPECT_EQ(rebound.resource(), &counting);
+    EXPECT_EQ(rebound, alloc);
+}
+
+TEST(polymorphic_allocator, vector_uses_resource)
+{
+    counting_allocator counting;
+
+    {
+        tempest::pmr::vector<int> vec{&counting};
+        for (int i = 0; i < 100; ++i)
+        {
+            vec.push_back(i);
+        }
+
+        for (int i = 0; i < 100; ++i)
+        {
+            EXPECT_EQ(vec[i], i);
+        }
+    }
+
+    EXPECT_GT(counting.allocations, 0);
+    EXPECT_EQ(counting.allocations, counting.deallocations);
+}
+
+TEST(polymorphic_allocator, string_uses_stack_allocator)
+{
+    tempest::stack_allocator arena{4096};
+    tempest::pmr::string str{&arena};
+
+    str = "a string long enough to not fit in the small string buffer";
+
+    EXPECT_EQ(str, "a string long enough to not fit in the small string buffer");
+    EXPECT_GT(arena.get_marker(), 0);
+}
+
+TEST(polymorphic_allocator, flat_unordered_map_uses_resource)
+{
+    counting_allocator counting;
+
+    {
+        tempest::pmr::flat_unordered_map<int, int> map{&counting};
+        for (int i = 0; i < 64; ++i)
+        {
+            map.insert({i, i * 2});
+        }
+
+        for (int i = 0; i < 64; ++i)
+        {
+            ASSERT_NE(map.find(i), map.end());
+            EXPECT_EQ(map.find(i)->second, i * 2);
+        }
+    }
+
+    EXPECT_GT(counting.allocations, 0);
+    EXPECT_EQ(counting.allocations, counting.deallocations);
+}
+
+TEST(polymorphic_allocator, slot_map_uses_stack_allocator)
+{
+    tempest::stack_allocator arena{64 * 1024};
+    tempest::pmr::slot_map<int> map{&arena};
+
+    auto key = map.insert(42);
+
+    EXPECT_EQ(map[key], 42);
+    EXPECT_GT(arena.get_marker(), 0);
+}
@@ -0,0 +1,114 @@
+#include <tempest/object_pool.hpp>
+
+#include <tempest/atomic.hpp>
+#include <tempest/job_system.hpp>
+#include <tempest/vector.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(concurrent_object_pool, acquire_and_access)
+{
+    tempest::new_delete_allocator alloc;
+    tempest::core::concurrent_object_pool pool(&alloc, 8, sizeof(uint64_t));
+
+    auto key = pool.acquire_resource();
+    ASSERT_TRUE(key);
+
+    auto value = static_cast<uint64_t*>(pool.access(key));
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, 0u);
+
+    *value = 42;
+    EXPECT_EQ(*static_cast<const uint64_t*>(pool.access(key)), 42u);
+}
+
+TEST(concurrent_object_pool, stale_keys_are_rejected)
+{
+    tempest::new_delete_allocator alloc;
+    tempest::core::concurrent_object_pool pool(&alloc, 1, sizeof(uint32_t));
+
+    auto first = pool.acquire_resource();
+    pool.release_resource(first);
+
+    auto second = pool.acquire_resource();
+    EXPECT_EQ(first.index, second.index);
+    EXPECT_NE(first.generation, second.generation);
+
+    EXPECT_EQ(pool.access(first), nullptr);
+    EXPECT_NE(pool.access(second), nullptr);
+
+    // Releasing the stale key must not release the live resource
+    pool.release_resource(first);
+    EXPECT_NE(pool.access(second), nullptr);
+}
+
+TEST(concurrent_object_pool, exhaustion_returns_invalid_key)
+{
+    tempest::new_delete_allocator alloc;
+    tempest::core::concurrent_object_pool pool(&alloc, 4, sizeof(uint32_t));
+
+    tempest::vector<tempest::core::concurrent_object_pool::key> keys;
+    for (int i = 0; i < 4; ++i)
+    {
+        auto key = pool.acquire_resource();
+        ASSERT_TRUE(key);
+        keys.push_back(key);
+    }
+
+    EXPECT_FALSE(pool.acquire_resource());
+
+    pool.release_resource(keys[2]);
+    EXPECT_TRUE(pool.acquire_resource());
+}
+
+TEST(concurrent_object_pool, release_all_invalidates_keys)
+{
+    tempest::new_delete_allocator alloc;
+    tempest::core::concurrent_object_pool pool(&alloc, 4, sizeof(uint32_t), 2);
+
+    auto key = pool.acquire_resource();
+    pool.release_all_resources();
+
+    EXPECT_EQ(pool.access(key), nullptr);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(pool.acquire_resource());
+    }
+}
+
+TEST(concurrent_object_pool, workers_share_the_pool)
+{
+    constexpr uint32_t pool_size = 256;
+
+    for (uint32_t thread_cache_size : {0u, 8u})
+    {
+        tempest::new_delete_allocator alloc;
+        tempest::core::concurrent_object_pool pool(&alloc, pool_size, sizeof(size_t), thread_cache_size);
+        tempest::core::job_system jobs(4);
+
+        tempest::atomic<uint32_t> failures{0};
+
+        jobs.parallel_for(0, 4096, 1, [&](size_t index) {
+            auto key = pool.acquire_resource();
+            if (!key)
+            {
+                failures.fetch_add(1, tempest::memory_order::relaxed);
+                return;
+            }
+
+            auto value = static_cast<size_t*>(pool.access(key));
+            *value = index;
+
+            // No other worker may hold the same resource
+            if (*static_cast<size_t*>(pool.access(key)) != index)
+            {
+                failures.fetch_add(1, tempest::memory_order::relaxed);
+            }
+
+            pool.release_resource(key);
+        });
+
+        EXPECT_EQ(failures.load(tempest::memory_order::relaxed), 0u);
+    }
+}
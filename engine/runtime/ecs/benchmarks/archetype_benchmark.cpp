@@ -0,0 +1,201 @@
+#include "sparse_registry.hpp"
+
+#include <tempest/archetype.hpp>
+#include <tempest/benchmark.hpp>
+#include <tempest/event_registry.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using tempest::ecs::benchmarks::component;
+
+    using archetype_registry = tempest::ecs::archetype_registry;
+    using sparse_registry = tempest::ecs::benchmarks::sparse_registry<component<0>, component<1>, component<2>,
+                                                                      component<3>, component<4>, component<5>,
+                                                                      component<6>, component<7>>;
+
+    constexpr size_t entity_counts[] = {10'000, 100'000, 1'000'000};
+
+    // The archetype registry keeps a pointer to the event registry, so both live on the heap together
+    struct archetype_fixture
+    {
+        tempest::event::event_registry events;
+        archetype_registry registry{events};
+        std::vector<tempest::ecs::entity> entities;
+    };
+
+    struct sparse_fixture
+    {
+        sparse_registry registry;
+        std::vector<tempest::ecs::entity> entities;
+    };
+
+    template <size_t... Is>
+    std::unique_ptr<archetype_fixture> make_archetype(size_t count, std::index_sequence<Is...>)
+    {
+        auto fixture = std::make_unique<archetype_fixture>();
+        fixture->entities.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            fixture->entities.push_back(fixture->registry.create<component<Is>...>());
+        }
+        return fixture;
+    }
+
+    template <size_t... Is>
+    std::unique_ptr<sparse_fixture> make_sparse(size_t count, std::index_sequence<Is...>)
+    {
+        auto fixture = std::make_unique<sparse_fixture>();
+        fixture->entities.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto e = fixture->registry.create();
+            (fixture->registry.emplace(e, component<Is>{}), ...);
+            fixture->entities.push_back(e);
+        }
+        return fixture;
+    }
+
+    template <size_t... Is>
+    void archetype_each(archetype_registry& registry, std::index_sequence<Is...>)
+    {
+        float total = 0.0f;
+        registry.each([&](component<Is>&... components) { total += (components.value[0] + ...); });
+        tempest::bench::do_not_optimize(total);
+    }
+
+    template <size_t... Is>
+    void sparse_each(sparse_registry& registry, std::index_sequence<Is...>)
+    {
+        float total = 0.0f;
+        registry.each<component<Is>...>([&](component<Is>&... components) { total += (components.value[0] + ...); });
+        tempest::bench::do_not_optimize(total);
+    }
+
+    std::string sized(const char* name, size_t count, const char* storage)
+    {
+        return std::string(name) + "/" + std::to_string(count) + "/" + storage;
+    }
+
+    template <size_t ComponentCount>
+    void run_each(tempest::bench::runner& runner, size_t count, archetype_fixture& archetype, sparse_fixture& sparse)
+    {
+        const auto name = "each_" + std::to_string(ComponentCount);
+
+        runner.run(sized(name.c_str(), count, "archetype"), count,
+                   [&] { archetype_each(archetype.registry, std::make_index_sequence<ComponentCount>{}); });
+        runner.run(sized(name.c_str(), count, "sparse_map"), count,
+                   [&] { sparse_each(sparse.registry, std::make_index_sequence<ComponentCount>{}); });
+    }
+} // namespace
+
+TEMPEST_BENCHMARK_SUITE(archetype_registry)
+{
+    using four_components = std::make_index_sequence<4>;
+    using eight_components = std::make_index_sequence<8>;
+
+    for (auto count : entity_counts)
+    {
+        if (count > runner.get_options().max_size)
+        {
+            continue;
+        }
+
+        runner.run(
+            sized("create", count, "archetype"), count, [] { return std::make_unique<archetype_fixture>(); },
+            [&](auto& f) {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    f->entities.push_back(
+                        f->registry.template create<component<0>, component<1>, component<2>, component<3>>());
+                }
+            });
+        runner.run(
+            sized("create", count, "sparse_map"), count, [] { return std::make_unique<sparse_fixture>(); },
+            [&](auto& f) {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    auto e = f->registry.create();
+                    f->registry.emplace(e, component<0>{});
+                    f->registry.emplace(e, component<1>{});
+                    f->registry.emplace(e, component<2>{});
+                    f->registry.emplace(e, component<3>{});
+                    f->entities.push_back(e);
+                }
+            });
+
+        // Moves every entity to the archetype with one more component and back again
+        runner.run(
+            sized("assign_remove", count, "archetype"), 2 * count,
+            [&] { return make_archetype(count, four_components{}); },
+            [](auto& f) {
+                for (auto e : f->entities)
+                {
+                    (void)f->registry.assign(e, component<4>{});
+                }
+                for (auto e : f->entities)
+                {
+                    f->registry.template remove<component<4>>(e);
+                }
+            });
+        runner.run(
+            sized("assign_remove", count, "sparse_map"), 2 * count,
+            [&] { return make_sparse(count, four_components{}); },
+            [](auto& f) {
+                for (auto e : f->entities)
+                {
+                    f->registry.emplace(e, component<4>{});
+                }
+                for (auto e : f->entities)
+                {
+                    f->registry.template remove<component<4>>(e);
+                }
+            });
+
+        runner.run(
+            sized("duplicate", count, "archetype"), count, [&] { return make_archetype(count, four_components{}); },
+            [&](auto& f) {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    tempest::bench::do_not_optimize(f->registry.duplicate(f->entities[i]));
+                }
+            });
+        runner.run(
+            sized("duplicate", count, "sparse_map"), count, [&] { return make_sparse(count, four_components{}); },
+            [&](auto& f) {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    tempest::bench::do_not_optimize(f->registry.duplicate(f->entities[i]));
+                }
+            });
+
+        runner.run(
+            sized("destroy", count, "archetype"), count, [&] { return make_archetype(count, four_components{}); },
+            [](auto& f) {
+                for (auto e : f->entities)
+                {
+                    f->registry.destroy(e);
+                }
+            });
+        runner.run(
+            sized("destroy", count, "sparse_map"), count, [&] { return make_sparse(count, four_components{}); },
+            [](auto& f) {
+                for (auto e : f->entities)
+                {
+                    f->registry.destroy(e);
+                }
+            });
+
+        auto archetype = make_archetype(count, eight_components{});
+        auto sparse = make_sparse(count, eight_components{});
+
+        run_each<1>(runner, count, *archetype, *sparse);
+        run_each<2>(runner, count, *archetype, *sparse);
+        run_each<4>(runner, count, *archetype, *sparse);
+        run_each<8>(runner, count, *archetype, *sparse);
+    }
+}
@@ -0,0 +1,163 @@
+#include "sparse_registry.hpp"
+
+#include <tempest/archetype.hpp>
+#include <tempest/benchmark.hpp>
+#include <tempest/event_registry.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using tempest::ecs::benchmarks::component;
+
+    using relationship = tempest::ecs::relationship_component<tempest::ecs::entity>;
+    using sparse_registry = tempest::ecs::benchmarks::sparse_registry<component<0>, relationship>;
+
+    constexpr size_t entity_counts[] = {10'000, 100'000, 1'000'000};
+
+    // Children per node, gives a tree of depth log8(count) similar to a large scene graph
+    constexpr size_t fanout = 8;
+
+    struct archetype_fixture
+    {
+        tempest::event::event_registry events;
+        tempest::ecs::archetype_registry registry{events};
+        tempest::ecs::entity root;
+    };
+
+    struct sparse_fixture
+    {
+        sparse_registry registry;
+        tempest::ecs::entity root;
+    };
+
+    std::unique_ptr<archetype_fixture> make_archetype(size_t count)
+    {
+        auto fixture = std::make_unique<archetype_fixture>();
+
+        std::vector<tempest::ecs::entity> entities;
+        entities.reserve(count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto e = fixture->registry.create<component<0>>();
+            if (i > 0)
+            {
+                tempest::ecs::create_parent_child_relationship(fixture->registry, entities[(i - 1) / fanout], e);
+            }
+            entities.push_back(e);
+        }
+
+        fixture->root = entities.front();
+        return fixture;
+    }
+
+    std::unique_ptr<sparse_fixture> make_sparse(size_t count)
+    {
+        auto fixture = std::make_unique<sparse_fixture>();
+        auto& registry = fixture->registry;
+
+        std::vector<tempest::ecs::entity> entities;
+        entities.reserve(count);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto e = registry.create();
+            registry.emplace(e, component<0>{});
+            registry.emplace(e, relationship{
+                                    .parent = tempest::ecs::tombstone,
+                                    .next_sibling = tempest::ecs::tombstone,
+                                    .first_child = tempest::ecs::tombstone,
+                                });
+
+            if (i > 0)
+            {
+                // Prepend to the parent's child list, as create_parent_child_relationship does
+                auto parent = entities[(i - 1) / fanout];
+                auto& parent_rel = registry.pool<relationship>()[parent];
+                auto& child_rel = registry.pool<relationship>()[e];
+                child_rel.parent = parent;
+                child_rel.next_sibling = parent_rel.first_child;
+                parent_rel.first_child = e;
+            }
+
+            entities.push_back(e);
+        }
+
+        fixture->root = entities.front();
+        return fixture;
+    }
+
+    // Depth first walk over first_child and next_sibling, the same traversal as the archetype hierarchy iterator
+    size_t sparse_traverse(sparse_registry& registry, tempest::ecs::entity root)
+    {
+        size_t visited = 0;
+        auto current = root;
+        size_t level = 0;
+
+        while (current != tempest::ecs::tombstone)
+        {
+            ++visited;
+
+            auto rel = registry.try_get<relationship>(current);
+            if (rel->first_child != tempest::ecs::tombstone)
+            {
+                current = rel->first_child;
+                ++level;
+                continue;
+            }
+
+            if (rel->next_sibling != tempest::ecs::tombstone)
+            {
+                current = rel->next_sibling;
+                continue;
+            }
+
+            current = tempest::ecs::tombstone;
+            while (rel->parent != tempest::ecs::tombstone && --level > 0)
+            {
+                rel = registry.try_get<relationship>(rel->parent);
+                if (rel->next_sibling != tempest::ecs::tombstone)
+                {
+                    current = rel->next_sibling;
+                    break;
+                }
+            }
+        }
+
+        return visited;
+    }
+
+    std::string sized(const char* name, size_t count, const char* storage)
+    {
+        return std::string(name) + "/" + std::to_string(count) + "/" + storage;
+    }
+} // namespace
+
+TEMPEST_BENCHMARK_SUITE(hierarchy)
+{
+    for (auto count : entity_counts)
+    {
+        if (count > runner.get_options().max_size)
+        {
+            continue;
+        }
+
+        auto archetype = make_archetype(count);
+        auto sparse = make_sparse(count);
+
+        runner.run(sized("traverse", count, "archetype"), count, [&] {
+            size_t visited = 0;
+            for (auto e : tempest::ecs::basic_archetype_entity_hierarchy_view(archetype->registry, archetype->root))
+            {
+                tempest::bench::do_not_optimize(e);
+                ++visited;
+            }
+            tempest::bench::do_not_optimize(visited);
+        });
+        runner.run(sized("traverse", count, "sparse_map"), count,
+                   [&] { tempest::bench::do_not_optimize(sparse_traverse(sparse->registry, sparse->root)); });
+    }
+}
@@ -0,0 +1,109 @@
+#ifndef tempest_ecs_benchmarks_sparse_registry_hpp
+#define tempest_ecs_benchmarks_sparse_registry_hpp
+
+#include <tempest/relationship_component.hpp>
+#include <tempest/sparse.hpp>
+#include <tempest/traits.hpp>
+
+#include <tuple>
+
+namespace tempest::ecs::benchmarks
+{
+    template <size_t I>
+    struct component
+    {
+        float value[4];
+    };
+
+    /// @brief Baseline registry storing each component type in its own sparse map, in the style of sparse set ECS
+    ///        libraries. Used to compare the archetype registry against per-component storage.
+    template <typename... Ts>
+    class sparse_registry
+    {
+      public:
+        using traits_type = entity_traits<entity>;
+
+        entity create()
+        {
+            return traits_type::construct(static_cast<traits_type::entity_type>(_next_entity++), 0);
+        }
+
+        template <typename T>
+        void emplace(entity e, const T& value)
+        {
+            (void)pool<T>().insert(e, value);
+        }
+
+        template <typename T>
+        void remove(entity e)
+        {
+            auto& p = pool<T>();
+            if (p.contains(e))
+            {
+                p.erase(e);
+            }
+        }
+
+        void destroy(entity e)
+        {
+            (remove<Ts>(e), ...);
+        }
+
+        entity duplicate(entity src)
+        {
+            const auto dst = create();
+            (_duplicate_one<Ts>(src, dst), ...);
+            return dst;
+        }
+
+        template <typename T>
+        [[nodiscard]] T* try_get(entity e)
+        {
+            auto& p = pool<T>();
+            return p.contains(e) ? &p[e] : nullptr;
+        }
+
+        /// @brief Iterates the pool of the first component and probes the others, as a sparse set registry does for
+        ///        a multi-component view.
+        template <typename Lead, typename... Rest, typename Fn>
+        void each(Fn&& fn)
+        {
+            auto& lead = pool<Lead>();
+            const auto keys = lead.keys();
+            const auto values = lead.values();
+
+            for (size_t i = 0; i < lead.size(); ++i)
+            {
+                const auto e = keys[i];
+                if ((pool<Rest>().contains(e) && ...))
+                {
+                    fn(values[i], pool<Rest>()[e]...);
+                }
+            }
+        }
+
+        template <typename T>
+        [[nodiscard]] sparse_map<T>& pool() noexcept
+        {
+            return std::get<sparse_map<T>>(_pools);
+        }
+
+      private:
+        std::tuple<sparse_map<Ts>...> _pools;
+        uint64_t _next_entity = 0;
+
+        template <typename T>
+        void _duplicate_one(entity src, entity dst)
+        {
+            auto& p = pool<T>();
+            if (p.contains(src))
+            {
+                // Copy out first, the insertion may reallocate the packed storage
+                const auto value = p[src];
+                (void)p.insert(dst, value);
+            }
+        }
+    };
+} // namespace tempest::ecs::benchmarks
+
+#endif // tempest_ecs_benchmarks_sparse_registry_hpp
@@ -11,6 +11,7 @@
 #include <tempest/flat_unordered_map.hpp>
 #include <tempest/functional.hpp>
 #include <tempest/int.hpp>
+#include <tempest/job_system.hpp>
 #include <tempest/limits.hpp>
 #include <tempest/meta.hpp>
 #include <tempest/optional.hpp>
@@ -123,12 +124,26 @@ namespace tempest::ecs
         return !(lhs == rhs);
     }
 
+    /**
+     * @brief Storage for every entity sharing a set of components. Entities are stored in fixed size chunks, with each
+     * chunk holding a contiguous column per component. Entities are densely packed in [0, size()), with entity index i
+     * living in chunk i / chunk_capacity(). Growing the archetype allocates a new chunk and never moves existing data.
+     */
     class TEMPEST_API basic_archetype
     {
       public:
         using key_type = basic_archetype_key;
 
+        /// @brief Target size of a single chunk, in bytes. Chunks grow beyond this only if a single entity does not fit.
+        static constexpr size_t chunk_bytes = 16 * 1024;
+
         basic_archetype(span<const basic_archetype_type_info> field_info);
+        basic_archetype(const basic_archetype&) = delete;
+        basic_archetype(basic_archetype&& rhs) noexcept;
+        ~basic_archetype();
+
+        basic_archetype& operator=(const basic_archetype&) = delete;
+        basic_archetype& operator=(basic_archetype&& rhs) noexcept;
 
         key_type allocate();
         void reserve(size_t count);
@@ -143,16 +158,45 @@ namespace tempest::ecs
         size_t capacity() const noexcept;
         bool empty() const noexcept;
 
-        span<const basic_archetype_storage> storages() const noexcept;
+        span<const basic_archetype_type_info> types() const noexcept;
+
+        /// @brief Fetches the number of allocated chunks.
+        size_t chunk_count() const noexcept;
+
+        /// @brief Fetches the number of entities a single chunk can hold.
+        size_t chunk_capacity() const noexcept;
+
+        /// @brief Fetches the number of live entities in a chunk. Only the trailing non-empty chunk may be partially
+        ///        filled.
+        /// @param chunk_index Index of the chunk.
+        /// @return Number of live entities in the chunk.
+        size_t chunk_size(size_t chunk_index) const noexcept;
+
+        /// @brief Fetches the first element of a component column in a chunk. Elements of the column are contiguous.
+        /// @param chunk_index Index of the chunk.
+        /// @param type_info_index Index of the component in types().
+        /// @return Pointer to the first element of the column.
+        byte* chunk_column(size_t chunk_index, size_t type_info_index) noexcept;
+        const byte* chunk_column(size_t chunk_index, size_t type_info_index) const noexcept;
 
       private:
         vector<basic_archetype_key> _trampoline;
         vector<uint32_t> _look_back_table; // points from the index of the value to the trampoline table
 
-        vector<basic_archetype_storage> _storage;
+        vector<basic_archetype_type_info> _types;
+        vector<size_t> _column_offsets; // offset of each column from the start of a chunk
+        vector<byte*> _chunks;
+
+        size_t _chunk_capacity;
+        size_t _chunk_alignment;
+        size_t _chunk_size_bytes;
+
         size_t _element_count;
         size_t _element_capacity;
         size_t _first_free_element;
+
+        void _grow_free_list(size_t new_capacity);
+        void _release_chunks() noexcept;
     };
 
     inline size_t basic_archetype::size() const noexcept
@@ -170,9 +214,53 @@ namespace tempest::ecs
         return _element_count == 0;
     }
 
-    inline span<const basic_archetype_storage> basic_archetype::storages() const noexcept
+    inline span<const basic_archetype_type_info> basic_archetype::types() const noexcept
+    {
+        return _types;
+    }
+
+    inline size_t basic_archetype::chunk_count() const noexcept
+    {
+        return _chunks.size();
+    }
+
+    inline size_t basic_archetype::chunk_capacity() const noexcept
+    {
+        return _chunk_capacity;
+    }
+
+    inline size_t basic_archetype::chunk_size(size_t chunk_index) const noexcept
+    {
+        const auto first = chunk_index * _chunk_capacity;
+        if (first >= _element_count)
+        {
+            return 0;
+        }
+        return tempest::min(_element_count - first, _chunk_capacity);
+    }
+
+    inline byte* basic_archetype::chunk_column(size_t chunk_index, size_t type_info_index) noexcept
+    {
+        return _chunks[chunk_index] + _column_offsets[type_info_index];
+    }
+
+    inline const byte* basic_archetype::chunk_column(size_t chunk_index, size_t type_info_index) const noexcept
     {
-        return _storage;
+        return _chunks[chunk_index] + _column_offsets[type_info_index];
+    }
+
+    inline byte* basic_archetype::element_at(size_t el_index, size_t type_info_index)
+    {
+        const auto chunk_index = el_index / _chunk_capacity;
+        const auto chunk_offset = el_index - chunk_index * _chunk_capacity;
+        return chunk_column(chunk_index, type_info_index) + chunk_offset * _types[type_info_index].size;
+    }
+
+    inline const byte* basic_archetype::element_at(size_t el_index, size_t type_info_index) const
+    {
+        const auto chunk_index = el_index / _chunk_capacity;
+        const auto chunk_offset = el_index - chunk_index * _chunk_capacity;
+        return chunk_column(chunk_index, type_info_index) + chunk_offset * _types[type_info_index].size;
     }
 
     template <size_t N>
@@ -196,6 +284,13 @@ namespace tempest::ecs
         return !(lhs == rhs);
     }
 
+    /// @brief Cached archetype transitions, keyed by the type index of the component added or removed.
+    struct basic_archetype_edges
+    {
+        flat_unordered_map<size_t, size_t> add;
+        flat_unordered_map<size_t, size_t> remove;
+    };
+
     struct basic_archetype_entity
     {
         basic_archetype::key_type archetype_key;
@@ -903,6 +998,9 @@ namespace tempest::ecs
         auto _acquire_next_entity(/*inout*/ size_t& archetype_index, /*intout*/ size_t& entity_index) const -> void;
     };
 
+    template <typename... Ts>
+    class basic_archetype_query;
+
     class TEMPEST_API basic_archetype_registry
     {
       public:
@@ -938,6 +1036,9 @@ namespace tempest::ecs
         template <typename T>
         const remove_cvref_t<T>* try_get(entity_type entity) const noexcept;
 
+        template <typename T>
+        remove_cvref_t<T>* try_get(entity_type entity) noexcept;
+
         template <typename... Ts>
         bool has(entity_type entity) const;
 
@@ -948,6 +1049,20 @@ namespace tempest::ecs
         template <typename Fn>
         void each(Fn&& func);
 
+        /// @brief Default number of entities per range dispatched by par_each.
+        static constexpr size_t default_par_each_grain_size = 1024;
+
+        /// @brief Invokes the callable for every entity with the requested components, splitting each matching
+        ///        archetype into ranges of at most grain_size entities that are executed on the job system. Blocks until
+        ///        every range has completed. The callable is invoked concurrently; a callable that only writes to the
+        ///        components passed to it by non-const reference is race free. The registry must not be structurally
+        ///        modified during iteration.
+        /// @param jobs Job system to execute the ranges on.
+        /// @param func Callable to invoke for each entity.
+        /// @param grain_size Maximum number of entities per range.
+        template <typename Fn>
+        void par_each(core::job_system& jobs, Fn&& func, size_t grain_size = default_par_each_grain_size);
+
         [[nodiscard]] optional<string_view> name(entity_type entity) const;
         void name(entity_type entity, string_view name);
 
@@ -966,9 +1081,19 @@ namespace tempest::ecs
             return basic_archetype_with_components_view<Ts...>(*this);
         }
 
+        template <typename... Ts>
+        basic_archetype_query<Ts...> query()
+        {
+            return basic_archetype_query<Ts...>(*this);
+        }
+
       private:
         vector<basic_archetype> _archetypes;
         vector<basic_archetype_types_hash<256u>> _hashes;
+        vector<basic_archetype_edges> _edges;
+
+        // Transitions taken by entities that do not yet belong to an archetype
+        flat_unordered_map<size_t, size_t> _empty_add_edges;
 
         basic_entity_store<entity_type, 4096, uint64_t> _entities;
         sparse_map<basic_archetype_entity> _entity_archetype_mapping;
@@ -978,12 +1103,17 @@ namespace tempest::ecs
         event::event_registry* _event_registry;
 
         size_t _index_of_component_in_archetype(size_t arch_index, size_t component_id) const;
+        size_t _find_archetype(const basic_archetype_types_hash<256u>& hash) const;
+        size_t _add_archetype(span<const basic_archetype_type_info> types, const basic_archetype_types_hash<256u>& hash);
 
         template <typename... Ts>
         friend class basic_archetype_with_components_iter;
 
         template <typename... Ts>
         friend class basic_archetype_with_components_view;
+
+        template <typename... Ts>
+        friend class basic_archetype_query;
     };
 
     struct TEMPEST_API self_component
@@ -1035,55 +1165,67 @@ namespace tempest::ecs
     {
         using component_type = remove_cvref_t<T>;
 
+        static const auto component_type_index = detail::get_archetype_type_index<component_type>();
+
         // Check if the entity has an archetype
         const auto archetype_key_iter = _entity_archetype_mapping.find(entity);
         const auto is_empty_entity = archetype_key_iter == _entity_archetype_mapping.end();
-        const auto type_hash = [&]() {
-            if (is_empty_entity)
-            {
-                static const auto hash = detail::create_archetype_types_hash<256u, component_type>();
-                return hash;
-            }
-
-            const auto existing_key = archetype_key_iter->second;
-            const auto existing_archetype_index = existing_key.archetype_index;
 
-            static const auto type_index = detail::get_archetype_type_index<component_type>();
+        const auto add_edges = [&]() -> flat_unordered_map<size_t, size_t>& {
+            return is_empty_entity ? _empty_add_edges : _edges[archetype_key_iter->second.archetype_index].add;
+        };
 
-            auto existing_hash = _hashes[existing_archetype_index];
-            existing_hash.hash[type_index / 8] |= static_cast<byte>(1 << (type_index % 8));
+        // Follow the cached transition if one exists, otherwise fall back to searching the archetypes by hash
+        auto target_archetype_index = _archetypes.size();
+        if (const auto edge = add_edges().find(component_type_index); edge != add_edges().end())
+        {
+            target_archetype_index = edge->second;
+        }
+        else
+        {
+            const auto type_hash = [&]() {
+                if (is_empty_entity)
+                {
+                    static const auto hash = detail::create_archetype_types_hash<256u, component_type>();
+                    return hash;
+                }
 
-            return existing_hash;
-        }();
+                auto existing_hash = _hashes[archetype_key_iter->second.archetype_index];
+                existing_hash.hash[component_type_index / 8] |= static_cast<byte>(1 << (component_type_index % 8));
 
-        auto hash_iter = tempest::find(_hashes.begin(), _hashes.end(), type_hash);
-        if (hash_iter == _hashes.end())
-        {
-            // Create a new archetype
-            auto new_types = vector<basic_archetype_type_info>();
-            new_types.push_back(create_archetype_type_info<component_type>());
+                return existing_hash;
+            }();
 
-            if (!is_empty_entity)
+            target_archetype_index = _find_archetype(type_hash);
+            if (target_archetype_index == _archetypes.size())
             {
-                const auto& existing_arch = _archetypes[archetype_key_iter->second.archetype_index];
-                auto existing_storage_view = existing_arch.storages();
+                // Create a new archetype
+                auto new_types = vector<basic_archetype_type_info>();
+                new_types.push_back(create_archetype_type_info<component_type>());
 
-                for (const auto& storage : existing_storage_view)
+                if (!is_empty_entity)
                 {
-                    new_types.push_back(storage.type_info());
+                    const auto& existing_arch = _archetypes[archetype_key_iter->second.archetype_index];
+                    for (const auto& ti : existing_arch.types())
+                    {
+                        new_types.push_back(ti);
+                    }
+
+                    std::sort(new_types.begin(), new_types.end(),
+                              [](const auto& lhs, const auto& rhs) { return lhs.index < rhs.index; });
                 }
 
-                std::sort(new_types.begin(), new_types.end(),
-                          [](const auto& lhs, const auto& rhs) { return lhs.index < rhs.index; });
+                target_archetype_index = _add_archetype(new_types, type_hash);
             }
 
-            auto& new_archetype = _archetypes.emplace_back(new_types);
-            _hashes.push_back(type_hash);
-
-            hash_iter = _hashes.end() - 1;
+            add_edges()[component_type_index] = target_archetype_index;
+            if (!is_empty_entity)
+            {
+                _edges[target_archetype_index].remove[component_type_index] =
+                    archetype_key_iter->second.archetype_index;
+            }
         }
 
-        const auto target_archetype_index = tempest::distance(_hashes.begin(), hash_iter);
         auto& target_arch = _archetypes[target_archetype_index];
         const auto target_arch_key = target_arch.allocate();
 
@@ -1093,9 +1235,9 @@ namespace tempest::ecs
             const auto existing_arch_index = archetype_key_iter->second.archetype_index;
             auto& existing_arch = _archetypes[existing_arch_index];
 
-            for (size_t i = 0; i < existing_arch.storages().size(); ++i)
+            for (size_t i = 0; i < existing_arch.types().size(); ++i)
             {
-                auto ti = existing_arch.storages()[i].type_info();
+                auto ti = existing_arch.types()[i];
                 auto storage_index = ti.index;
                 auto existing_component_index = _index_of_component_in_archetype(existing_arch_index, storage_index);
                 auto new_component_index = _index_of_component_in_archetype(target_archetype_index, storage_index);
@@ -1197,39 +1339,44 @@ namespace tempest::ecs
         (void)destroy_at(reinterpret_cast<component_type*>(data));
 
         // Create a hash without the component
-        auto hash = _hashes[archetype_index];
-        hash.hash[detail::get_archetype_type_index<component_type>() / 8] &=
-            static_cast<byte>(~(1 << (detail::get_archetype_type_index<component_type>() % 8)));
-
-        // Check if the archetype already exists
-        const auto* archetype_it = tempest::find(_hashes.begin(), _hashes.end(), hash);
-
-        if (archetype_it == _hashes.end())
+        // Follow the cached transition if one exists, otherwise fall back to searching the archetypes by hash
+        auto new_archetype_index = _archetypes.size();
+        if (const auto edge = _edges[archetype_index].remove.find(type_info_index);
+            edge != _edges[archetype_index].remove.end())
         {
-            // Create a new archetype
-            auto existing_storage_view = arch->storages();
-            vector<basic_archetype_type_info> new_types;
+            new_archetype_index = edge->second;
+        }
+        else
+        {
+            auto hash = _hashes[archetype_index];
+            hash.hash[type_info_index / 8] &= static_cast<byte>(~(1 << (type_info_index % 8)));
 
-            for (const auto& storage : existing_storage_view)
+            new_archetype_index = _find_archetype(hash);
+            if (new_archetype_index == _archetypes.size())
             {
-                if (storage.type_info().index != type_info_index)
+                // Create a new archetype
+                vector<basic_archetype_type_info> new_types;
+
+                for (const auto& ti : arch->types())
                 {
-                    new_types.push_back(storage.type_info());
+                    if (ti.index != type_info_index)
+                    {
+                        new_types.push_back(ti);
+                    }
                 }
-            }
 
-            std::sort(new_types.begin(), new_types.end(),
-                      [](const auto& lhs, const auto& rhs) { return lhs.index < rhs.index; });
+                std::sort(new_types.begin(), new_types.end(),
+                          [](const auto& lhs, const auto& rhs) { return lhs.index < rhs.index; });
 
-            auto capacity = arch->capacity();
-            auto& new_arch = _archetypes.emplace_back(new_types);
-            new_arch.reserve(capacity);
-            _hashes.push_back(hash);
+                auto capacity = arch->capacity();
+                new_archetype_index = _add_archetype(new_types, hash);
+                _archetypes[new_archetype_index].reserve(capacity);
+            }
 
-            archetype_it = _hashes.end() - 1;
+            _edges[archetype_index].remove[type_info_index] = new_archetype_index;
+            _edges[new_archetype_index].add[type_info_index] = archetype_index;
         }
 
-        auto new_archetype_index = tempest::distance(_hashes.cbegin(), archetype_it);
         auto& new_arch = _archetypes[new_archetype_index];
         auto new_key = new_arch.allocate();
 
@@ -1256,13 +1403,13 @@ namespace tempest::ecs
                 // Copy the component
                 auto* existing_data = arch->element_at(key.archetype_key, existing_component_index);
                 auto* new_data = new_arch.element_at(new_key, new_component_index);
-                copy_n(existing_data, arch->storages()[existing_component_index].type_info().size, new_data);
+                copy_n(existing_data, arch->types()[existing_component_index].size, new_data);
 
                 ++components_written;
             }
 
             // Early exit if we've copied all the components
-            if (components_written == new_arch.storages().size())
+            if (components_written == new_arch.types().size())
             {
                 break;
             }
@@ -1323,11 +1470,19 @@ namespace tempest::ecs
         return reinterpret_cast<const remove_cvref_t<T>*>(data);
     }
 
+    template <typename T>
+    inline remove_cvref_t<T>* basic_archetype_registry::try_get(
+        typename basic_archetype_registry::entity_type entity) noexcept
+    {
+        // Components are edited in place without raising a replace event
+        return const_cast<remove_cvref_t<T>*>(static_cast<const basic_archetype_registry&>(*this).try_get<T>(entity));
+    }
+
     template <typename... Ts>
     inline bool basic_archetype_registry::has(typename basic_archetype_registry::entity_type entity) const
     {
         auto key = _entity_archetype_mapping[entity];
-        auto len = _archetypes[key.archetype_index].storages().size();
+        auto len = _archetypes[key.archetype_index].types().size();
         return (((_index_of_component_in_archetype(key.archetype_index,
                                                    create_archetype_type_info<remove_cvref_t<Ts>>().index) != len) &&
                  ...) &&
@@ -1344,9 +1499,9 @@ namespace tempest::ecs
     {
         size_t result = 0;
 
-        for (size_t i = 0; i < _archetypes[arch_index].storages().size(); ++i)
+        for (size_t i = 0; i < _archetypes[arch_index].types().size(); ++i)
         {
-            if (_archetypes[arch_index].storages()[i].type_info().index == component_id)
+            if (_archetypes[arch_index].types()[i].index == component_id)
             {
                 return result;
             }
@@ -1379,6 +1534,24 @@ namespace tempest::ecs
 
                 apply(tempest::forward<Fn>(fn), tempest::move(args), arg_indices{});
             }
+
+            template <typename Fn, size_t... Is>
+            static void apply_range(Fn& fn, const array<byte*, N>& columns, size_t count, index_sequence<Is...>)
+            {
+                // Cast each column once so the per entity loop only indexes typed pointers
+                [&](remove_cvref_t<Ts>*... typed_columns) {
+                    for (size_t j = 0; j < count; ++j)
+                    {
+                        fn(typed_columns[j]...);
+                    }
+                }(reinterpret_cast<remove_cvref_t<Ts>*>(columns[Is])...);
+            }
+
+            template <typename Fn>
+            static void apply_range(Fn& fn, const array<byte*, N>& columns, size_t count)
+            {
+                apply_range(fn, columns, count, make_index_sequence<N>{});
+            }
         };
     } // namespace detail
 
@@ -1416,30 +1589,391 @@ namespace tempest::ecs
                     },
                     tempest::make_index_sequence<argument_count>());
 
-                // TODO: Build a tuple of pointers to the first element of each component pool
-                // Use that to iterate instead
-
-                for (size_t j = 0; j < arch.size(); ++j)
+                for (size_t chunk = 0; chunk < arch.chunk_count(); ++chunk)
                 {
-                    array<byte*, argument_count> arguments;
+                    const auto chunk_size = arch.chunk_size(chunk);
+                    if (chunk_size == 0)
+                    {
+                        break;
+                    }
+
+                    array<byte*, argument_count> columns;
 
                     for (size_t k = 0; k < argument_count; ++k)
                     {
-                        size_t storage_index = argument_indices[k];
-                        byte* storage_data = arch.element_at(j, storage_index);
-
-                        arguments[k] = storage_data;
+                        columns[k] = arch.chunk_column(chunk, argument_indices[k]);
                     }
 
-                    detail::for_each_fn_applier<argument_count, typename fn_traits::argument_types>::apply(
-                        tempest::forward<Fn>(func), tempest::move(arguments));
+                    detail::for_each_fn_applier<argument_count, typename fn_traits::argument_types>::apply_range(
+                        func, columns, chunk_size);
                 }
             }
         }
     }
 
+    template <typename Fn>
+    inline void basic_archetype_registry::par_each(core::job_system& jobs, Fn&& func, size_t grain_size)
+    {
+        using fn_traits = function_traits<remove_cvref_t<Fn>>;
+        static const auto hash_mask = detail::hash_mask_type_list_traits<typename fn_traits::argument_types>::create();
+        static constexpr auto argument_count = core::type_list_size_v<typename fn_traits::argument_types>;
+
+        struct entity_range
+        {
+            basic_archetype* arch;
+            array<size_t, argument_count> argument_indices;
+            size_t chunk;
+            size_t first;
+            size_t last;
+        };
+
+        grain_size = tempest::max<size_t>(grain_size, 1);
+
+        // Resolve the matching archetypes up front so the workers never touch the registry's bookkeeping
+        vector<entity_range> ranges;
+
+        for (size_t i = 0; i < _archetypes.size(); ++i)
+        {
+            const auto& hash = _hashes[i];
+            bool matches = true;
+            for (size_t j = 0; j < 256u / 8u; ++j)
+            {
+                if ((hash_mask.hash[j] & hash.hash[j]) != hash_mask.hash[j])
+                {
+                    matches = false;
+                    break;
+                }
+            }
+
+            if (!matches || _archetypes[i].empty())
+            {
+                continue;
+            }
+
+            auto argument_indices = detail::arch_index_iter::iterate<typename fn_traits::argument_types>(
+                i,
+                [&](size_t arch_idx, size_t type_id) { return _index_of_component_in_archetype(arch_idx, type_id); },
+                tempest::make_index_sequence<argument_count>());
+
+            // Ranges never straddle a chunk so each range covers contiguous columns
+            auto& arch = _archetypes[i];
+            for (size_t chunk = 0; chunk < arch.chunk_count(); ++chunk)
+            {
+                const auto chunk_size = arch.chunk_size(chunk);
+                for (size_t first = 0; first < chunk_size; first += grain_size)
+                {
+                    ranges.push_back(entity_range{
+                        .arch = &arch,
+                        .argument_indices = argument_indices,
+                        .chunk = chunk,
+                        .first = first,
+                        .last = tempest::min(first + grain_size, chunk_size),
+                    });
+                }
+            }
+        }
+
+        jobs.parallel_for(0, ranges.size(), 1, [&ranges, &func](size_t range_index) {
+            const auto& range = ranges[range_index];
+            const auto types = range.arch->types();
+
+            array<byte*, argument_count> columns;
+
+            for (size_t k = 0; k < argument_count; ++k)
+            {
+                const auto column = range.argument_indices[k];
+                columns[k] = range.arch->chunk_column(range.chunk, column) + range.first * types[column].size;
+            }
+
+            detail::for_each_fn_applier<argument_count, typename fn_traits::argument_types>::apply_range(
+                func, columns, range.last - range.first);
+        });
+    }
+
     using archetype_registry = basic_archetype_registry;
 
+    /**
+     * @brief A persistent query over every archetype containing at least the components specified. The matching
+     * archetypes and the column of each requested component are resolved once and cached. Archetypes are never removed
+     * from a registry, so the cache is updated incrementally by testing only the archetypes created since the last
+     * refresh.
+     *
+     * @tparam Ts The types of the components to query.
+     */
+    template <typename... Ts>
+    class basic_archetype_query
+    {
+      public:
+        static constexpr size_t component_count = sizeof...(Ts);
+
+        struct match
+        {
+            size_t archetype_index;
+            array<size_t, component_count> columns;
+
+            // Column of the self_component, or the archetype's type count if the archetype has no self_component
+            size_t entity_column;
+        };
+
+        explicit basic_archetype_query(basic_archetype_registry& registry);
+
+        /// @brief Tests archetypes created since the last refresh against the query.
+        void refresh();
+
+        /// @brief Fetches the archetypes matching the query, refreshing the cache first.
+        /// @return Span of the matching archetypes and their resolved columns.
+        [[nodiscard]] span<const match> matches();
+
+        /// @brief Invokes the callable as func(Ts&...) for every entity matching the query.
+        /// @param func Callable to invoke for each entity.
+        template <typename Fn>
+        void each(Fn&& func);
+
+        /// @brief Invokes the callable as func(span<const self_component>, span<Ts>...) once for every non-empty chunk
+        ///        of every matching archetype. Each span covers the contiguous column of the chunk, so the callable can
+        ///        run a tight loop over the components. The entity span is empty for archetypes without a
+        ///        self_component; entities created through the registry always have one.
+        /// @param func Callable to invoke for each chunk.
+        template <typename Fn>
+        void each_chunk(Fn&& func);
+
+        /// @brief Invokes the callable as func(Ts&...) for every entity matching the query, splitting each matching
+        ///        archetype into ranges of at most grain_size entities executed on the job system. Blocks until every
+        ///        range has completed. See basic_archetype_registry::par_each for the concurrency contract.
+        /// @param jobs Job system to execute the ranges on.
+        /// @param func Callable to invoke for each entity.
+        /// @param grain_size Maximum number of entities per range.
+        template <typename Fn>
+        void par_each(core::job_system& jobs, Fn&& func,
+                      size_t grain_size = basic_archetype_registry::default_par_each_grain_size);
+
+        /// @brief Invokes the callable as func(span<const self_component>, span<Ts>...) once for every non-empty chunk
+        ///        of every matching archetype, executing the chunks on the job system. Blocks until every chunk has
+        ///        completed.
+        /// @param jobs Job system to execute the chunks on.
+        /// @param func Callable to invoke for each chunk.
+        template <typename Fn>
+        void par_each_chunk(core::job_system& jobs, Fn&& func);
+
+      private:
+        using arg_types = core::type_list<remove_cvref_t<Ts>...>;
+
+        struct chunk_range
+        {
+            const match* source;
+            size_t chunk;
+            size_t first;
+            size_t last;
+        };
+
+        inline static const auto _type_hash_mask = detail::hash_mask_type_list_traits<arg_types>::create();
+
+        basic_archetype_registry* _registry;
+        vector<match> _matches;
+        size_t _archetypes_seen{0};
+
+        [[nodiscard]] vector<chunk_range> _build_ranges(size_t grain_size) const;
+
+        template <typename Fn, size_t... Is>
+        void _invoke_entities(Fn& func, const chunk_range& range, index_sequence<Is...>) const;
+
+        template <typename Fn, size_t... Is>
+        void _invoke_chunk(Fn& func, const chunk_range& range, index_sequence<Is...>) const;
+    };
+
+    template <typename... Ts>
+    inline basic_archetype_query<Ts...>::basic_archetype_query(basic_archetype_registry& registry)
+        : _registry{&registry}
+    {
+        refresh();
+    }
+
+    template <typename... Ts>
+    inline void basic_archetype_query<Ts...>::refresh()
+    {
+        static const auto self_type_index = create_archetype_type_info<self_component>().index;
+
+        const auto archetype_count = _registry->_archetypes.size();
+
+        for (size_t idx = _archetypes_seen; idx < archetype_count; ++idx)
+        {
+            const auto& archetype_hash = _registry->_hashes[idx];
+
+            auto match_found = true;
+            for (size_t j = 0; j < remove_cvref_t<decltype(archetype_hash)>::count; ++j)
+            {
+                if ((_type_hash_mask.hash[j] & archetype_hash.hash[j]) != _type_hash_mask.hash[j])
+                {
+                    match_found = false;
+                    break;
+                }
+            }
+
+            if (match_found)
+            {
+                _matches.push_back(match{
+                    .archetype_index = idx,
+                    .columns = detail::arch_index_iter::iterate<arg_types>(
+                        idx,
+                        [&](size_t arch_idx, size_t type_id) {
+                            return _registry->_index_of_component_in_archetype(arch_idx, type_id);
+                        },
+                        make_index_sequence<component_count>{}),
+                    .entity_column = _registry->_index_of_component_in_archetype(idx, self_type_index),
+                });
+            }
+        }
+
+        _archetypes_seen = archetype_count;
+    }
+
+    template <typename... Ts>
+    inline auto basic_archetype_query<Ts...>::matches() -> span<const match>
+    {
+        refresh();
+        return _matches;
+    }
+
+    template <typename... Ts>
+    inline auto basic_archetype_query<Ts...>::_build_ranges(size_t grain_size) const -> vector<chunk_range>
+    {
+        vector<chunk_range> ranges;
+
+        for (const auto& m : _matches)
+        {
+            const auto& arch = _registry->_archetypes[m.archetype_index];
+            for (size_t chunk = 0; chunk < arch.chunk_count(); ++chunk)
+            {
+                const auto chunk_size = arch.chunk_size(chunk);
+                for (size_t first = 0; first < chunk_size; first += grain_size)
+                {
+                    ranges.push_back(chunk_range{
+                        .source = &m,
+                        .chunk = chunk,
+                        .first = first,
+                        .last = tempest::min(first + grain_size, chunk_size),
+                    });
+                }
+            }
+        }
+
+        return ranges;
+    }
+
+    template <typename... Ts>
+    template <typename Fn>
+    inline void basic_archetype_query<Ts...>::each(Fn&& func)
+    {
+        refresh();
+
+        for (const auto& m : _matches)
+        {
+            const auto& arch = _registry->_archetypes[m.archetype_index];
+            for (size_t chunk = 0; chunk < arch.chunk_count(); ++chunk)
+            {
+                const auto chunk_size = arch.chunk_size(chunk);
+                if (chunk_size == 0)
+                {
+                    break;
+                }
+
+                _invoke_entities(func, chunk_range{.source = &m, .chunk = chunk, .first = 0, .last = chunk_size},
+                                 make_index_sequence<component_count>{});
+            }
+        }
+    }
+
+    template <typename... Ts>
+    template <typename Fn>
+    inline void basic_archetype_query<Ts...>::each_chunk(Fn&& func)
+    {
+        refresh();
+
+        for (const auto& m : _matches)
+        {
+            const auto& arch = _registry->_archetypes[m.archetype_index];
+            for (size_t chunk = 0; chunk < arch.chunk_count(); ++chunk)
+            {
+                const auto chunk_size = arch.chunk_size(chunk);
+                if (chunk_size == 0)
+                {
+                    break;
+                }
+
+                _invoke_chunk(func, chunk_range{.source = &m, .chunk = chunk, .first = 0, .last = chunk_size},
+                              make_index_sequence<component_count>{});
+            }
+        }
+    }
+
+    template <typename... Ts>
+    template <typename Fn>
+    inline void basic_archetype_query<Ts...>::par_each(core::job_system& jobs, Fn&& func, size_t grain_size)
+    {
+        refresh();
+
+        // Ranges never straddle a chunk so each range covers contiguous columns
+        const auto ranges = _build_ranges(tempest::max<size_t>(grain_size, 1));
+
+        jobs.parallel_for(0, ranges.size(), 1, [this, &ranges, &func](size_t range_index) {
+            _invoke_entities(func, ranges[range_index], make_index_sequence<component_count>{});
+        });
+    }
+
+    template <typename... Ts>
+    template <typename Fn>
+    inline void basic_archetype_query<Ts...>::par_each_chunk(core::job_system& jobs, Fn&& func)
+    {
+        refresh();
+
+        const auto ranges = _build_ranges(numeric_limits<size_t>::max());
+
+        jobs.parallel_for(0, ranges.size(), 1, [this, &ranges, &func](size_t range_index) {
+            _invoke_chunk(func, ranges[range_index], make_index_sequence<component_count>{});
+        });
+    }
+
+    template <typename... Ts>
+    template <typename Fn, size_t... Is>
+    inline void basic_archetype_query<Ts...>::_invoke_entities(Fn& func, const chunk_range& range,
+                                                               index_sequence<Is...>) const
+    {
+        auto& arch = _registry->_archetypes[range.source->archetype_index];
+
+        [&](remove_reference_t<Ts>*... columns) {
+            for (size_t j = range.first; j < range.last; ++j)
+            {
+                func(columns[j]...);
+            }
+        }(reinterpret_cast<remove_reference_t<Ts>*>(arch.chunk_column(range.chunk, range.source->columns[Is]))...);
+    }
+
+    template <typename... Ts>
+    template <typename Fn, size_t... Is>
+    inline void basic_archetype_query<Ts...>::_invoke_chunk(Fn& func, const chunk_range& range,
+                                                            index_sequence<Is...>) const
+    {
+        auto& arch = _registry->_archetypes[range.source->archetype_index];
+        const auto count = range.last - range.first;
+
+        auto entities = span<const self_component>();
+        if (range.source->entity_column < arch.types().size())
+        {
+            entities = span<const self_component>(
+                reinterpret_cast<const self_component*>(arch.chunk_column(range.chunk, range.source->entity_column)) +
+                    range.first,
+                count);
+        }
+
+        func(entities, span<remove_reference_t<Ts>>(reinterpret_cast<remove_reference_t<Ts>*>(arch.chunk_column(
+                                                         range.chunk, range.source->columns[Is])) +
+                                                         range.first,
+                                                     count)...);
+    }
+
+    template <typename... Ts>
+    using archetype_query = basic_archetype_query<Ts...>;
+
     class TEMPEST_API basic_archetype_entity_hierarchy_iterator
     {
       public:
@@ -73,6 +73,13 @@ namespace tempest::ecs
         }
     };
 
+    /// @brief Cached world space matrices of an entity, maintained by transform_propagation_system.
+    struct TEMPEST_API world_transform_component
+    {
+        math::mat4<float> matrix;
+        math::mat4<float> inv_transpose;
+    };
+
     static_assert(is_trivial<math::mat4<float>>::value);
 } // namespace tempest::ecs
 
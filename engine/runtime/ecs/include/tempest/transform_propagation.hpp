@@ -0,0 +1,86 @@
+#ifndef tempest_ecs_transform_propagation_hpp
+#define tempest_ecs_transform_propagation_hpp
+
+#include <tempest/api.hpp>
+#include <tempest/archetype.hpp>
+#include <tempest/ecs_events.hpp>
+#include <tempest/event_registry.hpp>
+#include <tempest/flat_unordered_map.hpp>
+#include <tempest/mat4.hpp>
+#include <tempest/relationship_component.hpp>
+#include <tempest/transform_component.hpp>
+#include <tempest/vector.hpp>
+
+namespace tempest::ecs
+{
+    /// @brief Keeps world_transform_component up to date for every entity with a transform_component.
+    ///
+    /// The system listens for transform and relationship changes on the registry and records the affected entities as
+    /// dirty. update() recomputes the world matrix of every dirty entity and its descendants, visiting parents before
+    /// their children so each entity is computed from its parent's cached world matrix. Entities whose transforms did
+    /// not change are not visited.
+    ///
+    /// The world matrix of an entity is the world matrix of its nearest ancestor with a transform_component multiplied
+    /// by the entity's local matrix.
+    ///
+    /// Only changes that raise a registry event are seen: assigning or replacing a transform_component or a
+    /// relationship_component, and destroying an entity. Editing a component in place through try_get or with
+    /// raises no event, so the world transform goes stale. Replace the component through archetype_registry::replace
+    /// instead, or call mark_dirty after editing it in place.
+    ///
+    /// Existing world_transform_components are overwritten in place and raise no replace event. Only the first world
+    /// transform of an entity raises an added event.
+    class TEMPEST_API transform_propagation_system
+    {
+      public:
+        transform_propagation_system(archetype_registry& registry, event::event_registry& events);
+        transform_propagation_system(const transform_propagation_system&) = delete;
+        transform_propagation_system(transform_propagation_system&&) noexcept = delete;
+        ~transform_propagation_system();
+
+        transform_propagation_system& operator=(const transform_propagation_system&) = delete;
+        transform_propagation_system& operator=(transform_propagation_system&&) noexcept = delete;
+
+        /// @brief Marks an entity's world transform, and the world transforms of its descendants, as stale.
+        /// @param entity Entity to mark.
+        void mark_dirty(archetype_entity entity);
+
+        /// @brief Recomputes the world transforms of every dirty subtree.
+        void update();
+
+        /// @brief Fetches the number of entities marked dirty since the last update.
+        [[nodiscard]] size_t dirty_count() const noexcept;
+
+      private:
+        using relationship_type = relationship_component<archetype_entity>;
+
+        archetype_registry* _registry;
+        event::event_registry* _events;
+
+        flat_unordered_map<archetype_entity, bool> _dirty;
+        flat_unordered_map<archetype_entity, bool> _updated;
+
+        struct pending_entity
+        {
+            archetype_entity entity;
+            math::mat4<float> parent_world;
+        };
+
+        vector<pending_entity> _pending;
+
+        event::subscription_handle<component_added_event<archetype_entity, transform_component>> _transform_added;
+        event::subscription_handle<component_replaced_event<archetype_entity, transform_component>>
+            _transform_replaced;
+        event::subscription_handle<component_added_event<archetype_entity, relationship_type>> _relationship_added;
+        event::subscription_handle<component_replaced_event<archetype_entity, relationship_type>>
+            _relationship_replaced;
+        event::subscription_handle<component_replaced_event<archetype_entity, self_component>> _self_replaced;
+        event::subscription_handle<entity_destroyed_event<archetype_entity>> _entity_destroyed;
+
+        [[nodiscard]] size_t _depth(archetype_entity entity) const;
+        [[nodiscard]] math::mat4<float> _parent_world(archetype_entity entity) const;
+        void _update_subtree(archetype_entity root);
+    };
+} // namespace tempest::ecs
+
+#endif // tempest_ecs_transform_propagation_hpp
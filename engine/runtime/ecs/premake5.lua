@@ -94,4 +94,36 @@ scoped.group('Tests', function()
 
         warnings 'Extra'
     end)
-end)
\ No newline at end of file
+end)
+
+scoped.group('Benchmarks', function()
+    scoped.project('ecs-benchmarks', function()
+        kind 'ConsoleApp'
+        language 'C++'
+        cppdialect 'C++20'
+
+        targetdir '%{binaries}'
+        objdir '%{intermediates}'
+
+        files {
+            'benchmarks/**.cpp',
+            'benchmarks/**.hpp',
+        }
+
+        includedirs {
+            'include',
+            '../core/benchmarks/harness',
+        }
+
+        uses {
+            'tempest',
+        }
+
+        scoped.filter({ 'system:linux' }, function()
+            links { 'X11' }
+            linkgroups 'On'
+        end)
+
+        warnings 'Extra'
+    end)
+end)
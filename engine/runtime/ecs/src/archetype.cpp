@@ -7,8 +7,6 @@
 #include <tempest/string.hpp>
 #include <tempest/utility.hpp>
 
-#include <bit>
-
 namespace tempest::ecs
 {
     basic_archetype_storage::basic_archetype_storage(basic_archetype_type_info info, size_t initial_capacity)
@@ -88,49 +86,117 @@ namespace tempest::ecs
         copy_n(src_p, _storage.size, dst_p);
     }
 
+    namespace
+    {
+        // Chunks start on a cache line so the first element of every column is never split across lines
+        constexpr size_t minimum_chunk_alignment = 64;
+
+        constexpr size_t align_up(size_t value, size_t alignment) noexcept
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        // Computes the offset of each column for a chunk holding count entities, returning the bytes required
+        size_t layout_chunk_columns(span<const basic_archetype_type_info> types, size_t count, size_t* offsets) noexcept
+        {
+            size_t offset = 0;
+            for (size_t i = 0; i < types.size(); ++i)
+            {
+                offset = align_up(offset, types[i].alignment);
+                if (offsets != nullptr)
+                {
+                    offsets[i] = offset;
+                }
+                offset += types[i].size * count;
+            }
+            return offset;
+        }
+    } // namespace
+
     basic_archetype::basic_archetype(span<const basic_archetype_type_info> fields)
-        : _element_count{0}, _element_capacity{0}, _first_free_element{0}
+        : _chunk_capacity{1}, _chunk_alignment{minimum_chunk_alignment}, _chunk_size_bytes{0}, _element_count{0},
+          _element_capacity{0}, _first_free_element{0}
     {
-        _storage.reserve(fields.size());
+        _types.reserve(fields.size());
 
+        size_t bytes_per_entity = 0;
         for (const auto& field : fields)
         {
-            _storage.emplace_back(field);
+            _types.push_back(field);
+            bytes_per_entity += field.size;
+            _chunk_alignment = tempest::max<size_t>(_chunk_alignment, field.alignment);
         }
+
+        // Fit as many entities as possible into a chunk, accounting for the padding between columns
+        if (bytes_per_entity > 0)
+        {
+            _chunk_capacity = tempest::max<size_t>(chunk_bytes / bytes_per_entity, 1);
+            while (_chunk_capacity > 1 && layout_chunk_columns(_types, _chunk_capacity, nullptr) > chunk_bytes)
+            {
+                --_chunk_capacity;
+            }
+        }
+        else
+        {
+            _chunk_capacity = chunk_bytes;
+        }
+
+        _column_offsets.resize(_types.size());
+        _chunk_size_bytes = align_up(
+            tempest::max<size_t>(layout_chunk_columns(_types, _chunk_capacity, _column_offsets.data()), 1),
+            _chunk_alignment);
     }
 
-    typename basic_archetype::key_type basic_archetype::allocate()
+    basic_archetype::basic_archetype(basic_archetype&& rhs) noexcept
+        : _trampoline{tempest::move(rhs._trampoline)}, _look_back_table{tempest::move(rhs._look_back_table)},
+          _types{tempest::move(rhs._types)}, _column_offsets{tempest::move(rhs._column_offsets)},
+          _chunks{tempest::move(rhs._chunks)}, _chunk_capacity{rhs._chunk_capacity},
+          _chunk_alignment{rhs._chunk_alignment}, _chunk_size_bytes{rhs._chunk_size_bytes},
+          _element_count{tempest::exchange(rhs._element_count, 0)},
+          _element_capacity{tempest::exchange(rhs._element_capacity, 0)},
+          _first_free_element{tempest::exchange(rhs._first_free_element, 0)}
     {
-        if (_element_count >= _element_capacity)
-        {
-            // no elements in the implicit free list
-            // reserve more entities
+        rhs._chunks.clear();
+    }
 
-            auto new_size = std::bit_ceil(_element_capacity + 8); // Force a minimum of 8
-            _trampoline.reserve(new_size);
-            _look_back_table.reserve(new_size);
+    basic_archetype::~basic_archetype()
+    {
+        _release_chunks();
+    }
 
-            for (size_t idx = _element_capacity; idx < new_size; ++idx)
-            {
-                auto next_idx = idx + 1;
+    basic_archetype& basic_archetype::operator=(basic_archetype&& rhs) noexcept
+    {
+        if (&rhs == this)
+        {
+            return *this;
+        }
 
-                key_type next_key = {
-                    .index = static_cast<uint32_t>(next_idx),
-                    .generation = 0,
-                };
+        _release_chunks();
 
-                _trampoline.push_back(next_key);
-                _look_back_table.push_back(static_cast<uint32_t>(idx));
-            }
+        _trampoline = tempest::move(rhs._trampoline);
+        _look_back_table = tempest::move(rhs._look_back_table);
+        _types = tempest::move(rhs._types);
+        _column_offsets = tempest::move(rhs._column_offsets);
+        _chunks = tempest::move(rhs._chunks);
+        _chunk_capacity = rhs._chunk_capacity;
+        _chunk_alignment = rhs._chunk_alignment;
+        _chunk_size_bytes = rhs._chunk_size_bytes;
+        _element_count = tempest::exchange(rhs._element_count, 0);
+        _element_capacity = tempest::exchange(rhs._element_capacity, 0);
+        _first_free_element = tempest::exchange(rhs._first_free_element, 0);
 
-            _first_free_element = _element_capacity;
+        rhs._chunks.clear();
 
-            _element_capacity = new_size;
+        return *this;
+    }
 
-            for (auto& storage : _storage)
-            {
-                storage.reserve(new_size);
-            }
+    typename basic_archetype::key_type basic_archetype::allocate()
+    {
+        if (_element_count >= _element_capacity)
+        {
+            // no elements in the implicit free list
+            // allocate another chunk
+            _grow_free_list(_element_capacity + _chunk_capacity);
         }
 
         // Pop off the front of the implicit free list
@@ -143,7 +209,8 @@ namespace tempest::ecs
             .generation = trampoline.generation,
         };
 
-        _trampoline[_first_free_element].index = _element_count;
+        _trampoline[_first_free_element].index = static_cast<uint32_t>(_element_count);
+        _look_back_table[_element_count] = index;
 
         _first_free_element = next_index;
 
@@ -154,18 +221,21 @@ namespace tempest::ecs
 
     void basic_archetype::reserve(size_t count)
     {
-        if (count < _element_capacity)
+        if (count <= _element_capacity)
         {
             return;
         }
 
-        // Round up to a power of 2
-        count = std::bit_ceil(count);
+        // Round up to a whole number of chunks
+        _grow_free_list((count + _chunk_capacity - 1) / _chunk_capacity * _chunk_capacity);
+    }
 
-        _trampoline.reserve(count);
-        _look_back_table.reserve(count);
+    void basic_archetype::_grow_free_list(size_t new_capacity)
+    {
+        _trampoline.reserve(new_capacity);
+        _look_back_table.reserve(new_capacity);
 
-        for (size_t idx = _element_capacity; idx < count; ++idx)
+        for (size_t idx = _element_capacity; idx < new_capacity; ++idx)
         {
             auto next_idx = idx + 1;
 
@@ -184,16 +254,28 @@ namespace tempest::ecs
         // and reset the first element
         if (_element_count != _element_capacity)
         {
-            _trampoline[count - 1].index = static_cast<uint32_t>(_first_free_element);
-            _first_free_element = _element_capacity;
+            _trampoline[new_capacity - 1].index = static_cast<uint32_t>(_first_free_element);
         }
+        _first_free_element = _element_capacity;
 
-        for (auto& storage : _storage)
+        // Existing chunks are never moved, new chunks are appended for the additional capacity
+        const auto required_chunks = new_capacity / _chunk_capacity;
+        _chunks.reserve(required_chunks);
+        while (_chunks.size() < required_chunks)
         {
-            storage.reserve(count);
+            _chunks.push_back(static_cast<byte*>(aligned_alloc(_chunk_size_bytes, _chunk_alignment)));
         }
 
-        _element_capacity = count;
+        _element_capacity = new_capacity;
+    }
+
+    void basic_archetype::_release_chunks() noexcept
+    {
+        for (auto chunk : _chunks)
+        {
+            aligned_free(chunk);
+        }
+        _chunks.clear();
     }
 
     bool basic_archetype::erase(typename basic_archetype::key_type key)
@@ -207,18 +289,18 @@ namespace tempest::ecs
         auto index_to_erase = trampoline.index;
         auto index_to_move = _element_count - 1;
 
-        // If the index to erase is the same as the index to move, just destroy
-        // Else, move the target element to the index of the erased element, update the lookback
+        // If the index to erase is the last element, nothing needs to move
+        // Else, move the last element into the erased slot to keep the elements dense and patch its trampoline
         if (index_to_erase != index_to_move)
         {
-        }
-        else
-        {
-            for (auto& s : _storage)
+            for (size_t i = 0; i < _types.size(); ++i)
             {
-                s.copy(index_to_erase, index_to_move);
+                copy_n(element_at(index_to_move, i), _types[i].size, element_at(index_to_erase, i));
             }
-            _look_back_table[index_to_erase] = key.index;
+
+            const auto moved_key_index = _look_back_table[index_to_move];
+            _trampoline[moved_key_index].index = index_to_erase;
+            _look_back_table[index_to_erase] = moved_key_index;
         }
 
         --_element_count;
@@ -230,18 +312,6 @@ namespace tempest::ecs
         return true;
     }
 
-    byte* basic_archetype::element_at(size_t el_index, size_t type_info_index)
-    {
-        auto& s = _storage[type_info_index];
-        return s.element_at(el_index);
-    }
-
-    const byte* basic_archetype::element_at(size_t el_index, size_t type_info_index) const
-    {
-        const auto& s = _storage[type_info_index];
-        return s.element_at(el_index);
-    }
-
     byte* basic_archetype::element_at(typename basic_archetype::key_type key, size_t type_info_index)
     {
         auto trampoline = _trampoline[key.index];
@@ -249,7 +319,7 @@ namespace tempest::ecs
         {
             return nullptr;
         }
-        return _storage[type_info_index].element_at(trampoline.index);
+        return element_at(static_cast<size_t>(trampoline.index), type_info_index);
     }
 
     const byte* basic_archetype::element_at(typename basic_archetype::key_type key, size_t type_info_index) const
@@ -259,7 +329,7 @@ namespace tempest::ecs
         {
             return nullptr;
         }
-        return _storage[type_info_index].element_at(trampoline.index);
+        return element_at(static_cast<size_t>(trampoline.index), type_info_index);
     }
 
     namespace detail
@@ -296,16 +366,15 @@ namespace tempest::ecs
         typename basic_archetype_registry::entity_type src)
     {
         auto src_key = _entity_archetype_mapping[src];
-        auto& src_arch = _archetypes[src_key.archetype_index];
+        auto* src_arch = &_archetypes[src_key.archetype_index];
 
         // Create a hash of the archetype without the non-duplicatable components
         auto hash = _hashes[src_key.archetype_index];
-        for (size_t i = 0; i < src_arch.storages().size(); ++i)
+        for (const auto& ti : src_arch->types())
         {
-            if (!src_arch.storages()[i].type_info().should_duplicate)
+            if (!ti.should_duplicate)
             {
-                hash.hash[src_arch.storages()[i].type_info().index / 8] &=
-                    static_cast<byte>(~(1 << (src_arch.storages()[i].type_info().index % 8)));
+                hash.hash[ti.index / 8] &= static_cast<byte>(~(1 << (ti.index % 8)));
             }
         }
 
@@ -315,17 +384,16 @@ namespace tempest::ecs
         hash.hash[self_component_ti.index / 8] = static_cast<byte>(updated_byte);
 
         // Find the archetype
-        auto it = tempest::find(_hashes.begin(), _hashes.end(), hash);
-        if (it == _hashes.end())
+        auto new_archetype_index = _find_archetype(hash);
+        if (new_archetype_index == _archetypes.size())
         {
             // Create a new archetype
-            auto existing_storage_view = src_arch.storages();
             vector<basic_archetype_type_info> new_types;
-            for (const auto& storage : existing_storage_view)
+            for (const auto& ti : src_arch->types())
             {
-                if (storage.type_info().should_duplicate)
+                if (ti.should_duplicate)
                 {
-                    new_types.push_back(storage.type_info());
+                    new_types.push_back(ti);
                 }
             }
 
@@ -335,26 +403,24 @@ namespace tempest::ecs
             std::sort(new_types.begin(), new_types.end(),
                       [](const auto& lhs, const auto& rhs) { return lhs.index < rhs.index; });
 
-            _archetypes.emplace_back(new_types);
-            _hashes.push_back(hash);
-            it = _hashes.end() - 1;
+            new_archetype_index = _add_archetype(new_types, hash);
         }
 
-        auto new_archetype_index = tempest::distance(_hashes.begin(), it);
-
         auto& new_arch = _archetypes[new_archetype_index];
         auto new_key = new_arch.allocate();
 
+        src_arch = &_archetypes[src_key.archetype_index];
+
         // Copy the entity's data to the new archetype, skipping the non-duplicatable components
-        for (const auto& storage : new_arch.storages())
+        for (const auto& ti : new_arch.types())
         {
-            const auto index = storage.type_info().index;
+            const auto index = ti.index;
             auto src_index = _index_of_component_in_archetype(src_key.archetype_index, index);
             auto dst_index = _index_of_component_in_archetype(new_archetype_index, index);
 
-            auto src_bytes = src_arch.element_at(src_key.archetype_key, src_index);
+            auto src_bytes = src_arch->element_at(src_key.archetype_key, src_index);
             auto dst_bytes = new_arch.element_at(new_key, dst_index);
-            copy_n(src_bytes, storage.type_info().size, dst_bytes);
+            copy_n(src_bytes, ti.size, dst_bytes);
         }
 
         // Create the new entity
@@ -394,6 +460,22 @@ namespace tempest::ecs
         return result;
     }
 
+    size_t basic_archetype_registry::_find_archetype(const basic_archetype_types_hash<256u>& hash) const
+    {
+        auto it = tempest::find(_hashes.begin(), _hashes.end(), hash);
+        return static_cast<size_t>(tempest::distance(_hashes.begin(), it));
+    }
+
+    size_t basic_archetype_registry::_add_archetype(span<const basic_archetype_type_info> types,
+                                                    const basic_archetype_types_hash<256u>& hash)
+    {
+        _archetypes.emplace_back(types);
+        _hashes.push_back(hash);
+        _edges.emplace_back();
+
+        return _archetypes.size() - 1;
+    }
+
     optional<string_view> basic_archetype_registry::name(entity_type entity) const
     {
         if (auto it = _names.find(entity); it != _names.end())
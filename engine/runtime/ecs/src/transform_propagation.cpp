@@ -0,0 +1,192 @@
+#include <tempest/transform_propagation.hpp>
+
+#include <tempest/algorithm.hpp>
+
+#include <algorithm>
+
+namespace tempest::ecs
+{
+    transform_propagation_system::transform_propagation_system(archetype_registry& registry,
+                                                               event::event_registry& events)
+        : _registry{&registry}, _events{&events}
+    {
+        _transform_added =
+            events.dispatcher<component_added_event<archetype_entity, transform_component>>().subscribe(
+                [this](const auto& evt) { mark_dirty(evt.entity); });
+
+        _transform_replaced =
+            events.dispatcher<component_replaced_event<archetype_entity, transform_component>>().subscribe(
+                [this](const auto& evt) { mark_dirty(evt.entity); });
+
+        _relationship_added =
+            events.dispatcher<component_added_event<archetype_entity, relationship_type>>().subscribe(
+                [this](const auto& evt) { mark_dirty(evt.entity); });
+
+        _relationship_replaced =
+            events.dispatcher<component_replaced_event<archetype_entity, relationship_type>>().subscribe(
+                [this](const auto& evt) { mark_dirty(evt.entity); });
+
+        // duplicate() copies components without publishing per component events, but always restamps the self
+        // component of the new entity
+        _self_replaced = events.dispatcher<component_replaced_event<archetype_entity, self_component>>().subscribe(
+            [this](const auto& evt) { mark_dirty(evt.entity); });
+
+        _entity_destroyed = events.dispatcher<entity_destroyed_event<archetype_entity>>().subscribe(
+            [this](const auto& evt) { _dirty.erase(evt.entity); });
+    }
+
+    transform_propagation_system::~transform_propagation_system()
+    {
+        (void)_events->dispatcher<component_added_event<archetype_entity, transform_component>>().unsubscribe(
+            _transform_added);
+        (void)_events->dispatcher<component_replaced_event<archetype_entity, transform_component>>().unsubscribe(
+            _transform_replaced);
+        (void)_events->dispatcher<component_added_event<archetype_entity, relationship_type>>().unsubscribe(
+            _relationship_added);
+        (void)_events->dispatcher<component_replaced_event<archetype_entity, relationship_type>>().unsubscribe(
+            _relationship_replaced);
+        (void)_events->dispatcher<component_replaced_event<archetype_entity, self_component>>().unsubscribe(
+            _self_replaced);
+        (void)_events->dispatcher<entity_destroyed_event<archetype_entity>>().unsubscribe(_entity_destroyed);
+    }
+
+    void transform_propagation_system::mark_dirty(archetype_entity entity)
+    {
+        _dirty[entity] = true;
+    }
+
+    size_t transform_propagation_system::dirty_count() const noexcept
+    {
+        return _dirty.size();
+    }
+
+    void transform_propagation_system::update()
+    {
+        if (_dirty.empty())
+        {
+            return;
+        }
+
+        struct dirty_root
+        {
+            size_t depth;
+            archetype_entity entity;
+        };
+
+        vector<dirty_root> roots;
+        roots.reserve(_dirty.size());
+
+        for (const auto& [entity, _] : _dirty)
+        {
+            roots.push_back({
+                .depth = _depth(entity),
+                .entity = entity,
+            });
+        }
+
+        _dirty.clear();
+
+        // Shallow entities first, so a dirty ancestor's subtree pass covers any dirty descendants
+        std::sort(roots.begin(), roots.end(), [](const auto& lhs, const auto& rhs) { return lhs.depth < rhs.depth; });
+
+        _updated.clear();
+
+        for (const auto& root : roots)
+        {
+            if (_updated.find(root.entity) != _updated.end())
+            {
+                continue;
+            }
+
+            _update_subtree(root.entity);
+        }
+    }
+
+    size_t transform_propagation_system::_depth(archetype_entity entity) const
+    {
+        size_t depth = 0;
+
+        auto rel = _registry->try_get<relationship_type>(entity);
+        while (rel != nullptr && rel->parent != tombstone)
+        {
+            ++depth;
+            rel = _registry->try_get<relationship_type>(rel->parent);
+        }
+
+        return depth;
+    }
+
+    math::mat4<float> transform_propagation_system::_parent_world(archetype_entity entity) const
+    {
+        auto rel = _registry->try_get<relationship_type>(entity);
+        while (rel != nullptr && rel->parent != tombstone)
+        {
+            if (auto parent_world = _registry->try_get<world_transform_component>(rel->parent))
+            {
+                return parent_world->matrix;
+            }
+
+            // Ancestors without a transform do not contribute to the world matrix
+            rel = _registry->try_get<relationship_type>(rel->parent);
+        }
+
+        return math::mat4<float>(1.0f);
+    }
+
+    void transform_propagation_system::_update_subtree(archetype_entity root)
+    {
+        _pending.clear();
+        _pending.push_back({
+            .entity = root,
+            .parent_world = _parent_world(root),
+        });
+
+        // Depth first, each entity is computed before any of its children are pushed
+        while (!_pending.empty())
+        {
+            const auto current = _pending.back();
+            _pending.pop_back();
+
+            auto world = current.parent_world;
+
+            if (auto local = _registry->try_get<transform_component>(current.entity))
+            {
+                world = current.parent_world * local->matrix();
+
+                const auto world_transform = world_transform_component{
+                    .matrix = world,
+                    .inv_transpose = math::transpose(math::inverse(world)),
+                };
+
+                // Written in place once it exists, a replace event per entity per update would flood the dispatcher
+                if (auto existing = _registry->try_get<world_transform_component>(current.entity))
+                {
+                    *existing = world_transform;
+                }
+                else
+                {
+                    _registry->assign_or_replace(current.entity, world_transform);
+                }
+            }
+
+            _updated[current.entity] = true;
+
+            auto rel = _registry->try_get<relationship_type>(current.entity);
+            if (rel == nullptr)
+            {
+                continue;
+            }
+
+            for (auto child = rel->first_child; child != tombstone;)
+            {
+                _pending.push_back({
+                    .entity = child,
+                    .parent_world = world,
+                });
+
+                auto child_rel = _registry->try_get<relationship_type>(child);
+                child = child_rel != nullptr ? child_rel->next_sibling : tombstone;
+            }
+        }
+    }
+} // namespace tempest::ecs
@@ -3,7 +3,9 @@
 #include <cstring>
 #include <gtest/gtest.h>
 #include <tempest/ecs_events.hpp>
+#include <tempest/job_system.hpp>
 #include <tempest/traits.hpp>
+#include <tempest/utility.hpp>
 
 TEST(basic_archetype_type_info, get_trivial_type_info)
 {
@@ -124,6 +126,108 @@ TEST(basic_archetype, single_type_with_resize)
     ASSERT_EQ(32, archetype.size());
 }
 
+TEST(basic_archetype, chunk_layout_fits_chunk)
+{
+    struct big
+    {
+        double values[4];
+    };
+
+    tempest::ecs::basic_archetype_type_info ti[] = {
+        tempest::ecs::create_archetype_type_info<char>(),
+        tempest::ecs::create_archetype_type_info<big>(),
+        tempest::ecs::create_archetype_type_info<float>(),
+    };
+
+    auto archetype = tempest::ecs::basic_archetype(ti);
+    archetype.reserve(1);
+
+    const auto per_chunk = archetype.chunk_capacity();
+    ASSERT_GT(per_chunk, 1u);
+    ASSERT_LE(per_chunk * (sizeof(char) + sizeof(big) + sizeof(float)), tempest::ecs::basic_archetype::chunk_bytes);
+    ASSERT_EQ(1u, archetype.chunk_count());
+
+    // Columns are aligned and do not overlap
+    auto chunk_begin = archetype.chunk_column(0, 0);
+    for (size_t i = 0; i < 3; ++i)
+    {
+        auto column = archetype.chunk_column(0, i);
+        ASSERT_EQ(0u, reinterpret_cast<tempest::uintptr_t>(column) % ti[i].alignment);
+
+        auto column_end = column + per_chunk * ti[i].size;
+        ASSERT_LE(static_cast<size_t>(column_end - chunk_begin), tempest::ecs::basic_archetype::chunk_bytes);
+
+        if (i + 1 < 3)
+        {
+            ASSERT_LE(column_end, archetype.chunk_column(0, i + 1));
+        }
+    }
+}
+
+TEST(basic_archetype, growth_does_not_move_elements)
+{
+    tempest::ecs::basic_archetype_type_info ti[] = {
+        tempest::ecs::create_archetype_type_info<int>(),
+    };
+
+    auto archetype = tempest::ecs::basic_archetype(ti);
+
+    auto first = archetype.allocate();
+    *reinterpret_cast<int*>(archetype.element_at(first, 0)) = 42;
+    auto first_ptr = archetype.element_at(first, 0);
+
+    const auto count = archetype.chunk_capacity() * 4 + 1;
+    for (size_t i = 1; i < count; ++i)
+    {
+        auto key = archetype.allocate();
+        *reinterpret_cast<int*>(archetype.element_at(key, 0)) = static_cast<int>(i);
+    }
+
+    ASSERT_EQ(count, archetype.size());
+    ASSERT_EQ(5u, archetype.chunk_count());
+    ASSERT_EQ(first_ptr, archetype.element_at(first, 0));
+    ASSERT_EQ(42, *reinterpret_cast<int*>(first_ptr));
+
+    size_t total = 0;
+    for (size_t c = 0; c < archetype.chunk_count(); ++c)
+    {
+        total += archetype.chunk_size(c);
+    }
+    ASSERT_EQ(count, total);
+    ASSERT_EQ(1u, archetype.chunk_size(4));
+}
+
+TEST(basic_archetype, erase_keeps_elements_dense)
+{
+    tempest::ecs::basic_archetype_type_info ti[] = {
+        tempest::ecs::create_archetype_type_info<int>(),
+    };
+
+    auto archetype = tempest::ecs::basic_archetype(ti);
+
+    auto e1 = archetype.allocate();
+    auto e2 = archetype.allocate();
+    auto e3 = archetype.allocate();
+    *reinterpret_cast<int*>(archetype.element_at(e1, 0)) = 1;
+    *reinterpret_cast<int*>(archetype.element_at(e2, 0)) = 2;
+    *reinterpret_cast<int*>(archetype.element_at(e3, 0)) = 3;
+
+    ASSERT_TRUE(archetype.erase(e1));
+    ASSERT_EQ(2u, archetype.size());
+
+    // The last element fills the hole left by the erased element
+    ASSERT_EQ(3, *reinterpret_cast<int*>(archetype.element_at(size_t{0}, 0)));
+    ASSERT_EQ(2, *reinterpret_cast<int*>(archetype.element_at(size_t{1}, 0)));
+    ASSERT_EQ(2, *reinterpret_cast<int*>(archetype.element_at(e2, 0)));
+    ASSERT_EQ(3, *reinterpret_cast<int*>(archetype.element_at(e3, 0)));
+    ASSERT_EQ(nullptr, archetype.element_at(e1, 0));
+
+    auto e4 = archetype.allocate();
+    *reinterpret_cast<int*>(archetype.element_at(e4, 0)) = 4;
+    ASSERT_EQ(3, *reinterpret_cast<int*>(archetype.element_at(e3, 0)));
+    ASSERT_EQ(4, *reinterpret_cast<int*>(archetype.element_at(size_t{2}, 0)));
+}
+
 TEST(basic_archetype_registry, create)
 {
     auto events = tempest::event::event_registry();
@@ -367,6 +471,58 @@ TEST(basic_archetype_registry, create_multiple_different_archetypes_with_removes
     ASSERT_TRUE(reg.has<short>(e10));
 }
 
+TEST(basic_archetype_registry, assign_remove_round_trip_reuses_archetypes)
+{
+    auto events = tempest::event::event_registry();
+    auto reg = tempest::ecs::basic_archetype_registry(events);
+
+    auto e1 = reg.create<int>();
+    reg.assign_or_replace(e1, 1);
+
+    for (int i = 0; i < 8; ++i)
+    {
+        reg.assign(e1, static_cast<float>(i));
+        ASSERT_EQ(1, reg.get<int>(e1));
+        ASSERT_EQ(static_cast<float>(i), reg.get<float>(e1));
+
+        reg.remove<float>(e1);
+        ASSERT_EQ(1, reg.get<int>(e1));
+        ASSERT_FALSE(reg.has<float>(e1));
+    }
+
+    auto e2 = reg.create<int>();
+    reg.assign_or_replace(e2, 2);
+    reg.assign(e2, 3.0f);
+
+    // Entities taking the same transitions land in the same archetypes
+    auto query = reg.query<int>();
+    ASSERT_EQ(2u, query.matches().size());
+
+    ASSERT_EQ(2, reg.get<int>(e2));
+    ASSERT_EQ(3.0f, reg.get<float>(e2));
+}
+
+TEST(basic_archetype_registry, remove_then_assign_follows_reverse_edge)
+{
+    auto events = tempest::event::event_registry();
+    auto reg = tempest::ecs::basic_archetype_registry(events);
+
+    auto e1 = reg.create<int, float, char>();
+    reg.assign_or_replace(e1, 1);
+    reg.assign_or_replace(e1, 2.0f);
+    reg.assign_or_replace(e1, 'c');
+
+    reg.remove<float>(e1);
+    reg.assign(e1, 4.0f);
+
+    ASSERT_EQ(1, reg.get<int>(e1));
+    ASSERT_EQ(4.0f, reg.get<float>(e1));
+    ASSERT_EQ('c', reg.get<char>(e1));
+
+    auto query = reg.query<int, float, char>();
+    ASSERT_EQ(1u, query.matches().size());
+}
+
 TEST(basic_archetype_registry, each_single_component)
 {
     auto events = tempest::event::event_registry();
@@ -400,6 +556,28 @@ TEST(basic_archetype_registry, each_single_component)
     ASSERT_EQ(21, sum);
 }
 
+TEST(basic_archetype_registry, each_after_destroy)
+{
+    auto events = tempest::event::event_registry();
+    auto reg = tempest::ecs::basic_archetype_registry(events);
+
+    auto e1 = reg.create<int>();
+    auto e2 = reg.create<int>();
+    auto e3 = reg.create<int>();
+    reg.assign_or_replace(e1, 1);
+    reg.assign_or_replace(e2, 2);
+    reg.assign_or_replace(e3, 4);
+
+    reg.destroy(e1);
+
+    int sum = 0;
+    reg.each([&sum](int i) { sum += i; });
+
+    ASSERT_EQ(6, sum);
+    ASSERT_EQ(2, reg.get<int>(e2));
+    ASSERT_EQ(4, reg.get<int>(e3));
+}
+
 TEST(basic_archetype_registry, each_single_component_no_match)
 {
     auto events = tempest::event::event_registry();
@@ -578,6 +756,275 @@ TEST(basic_archetype_registry, create_entity_emit_event)
     ASSERT_EQ(created_entity, event_entity);
 }
 
+TEST(basic_archetype_registry, par_each_single_component)
+{
+    auto events = tempest::event::event_registry();
+    auto reg = tempest::ecs::basic_archetype_registry(events);
+    auto jobs = tempest::core::job_system(4);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        auto e = reg.create<int>();
+        reg.assign_or_replace(e, i);
+    }
+
+    reg.par_each(jobs, [](int& i) { i *= 2; }, 128);
+
+    long long sum = 0;
+    reg.each([&sum](int i) { sum += i; });
+
+    ASSERT_EQ(2ll * (9999ll * 10000ll / 2ll), sum);
+}
+
+TEST(basic_archetype_registry, par_each_multiple_archetypes)
+{
+    auto events = tempest::event::event_registry();
+    auto reg = tempest::ecs::basic_archetype_registry(events);
+    auto jobs = tempest::core::job_system(4);
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        auto e1 = reg.create<int, float>();
+        reg.assign_or_replace<int>(e1, 1);
+        reg.assign_or_replace<float>(e1, 2.0f);
+
+        auto e2 = reg.create<int, float, char>();
+        reg.assign_or_replace<int>(e2, 1);
+        reg.assign_or_replace<float>(e2, 3.0f);
+
+        auto e3 = reg.create<int>();
+        reg.assign_or_replace<int>(e3, 1);
+    }
+
+    tempest::atomic<tempest::uint32_t> visited{0};
+    reg.par_each(
+        jobs,
+        [&visited](int& i, const float& f) {
+            i += static_cast<int>(f);
+            visited.fetch_add(1, tempest::memory_order::relaxed);
+        },
+        100);
+
+    ASSERT_EQ(6000u, visited.load());
+
+    long long sum = 0;
+    reg.each([&sum](int i) { sum += i; });
+
+    ASSERT_EQ(3000ll * 3ll + 3000ll * 4ll + 3000ll, sum);
+}
+
+TEST(basic_archetype_registry, par_each_no_match)
+{
+    auto events = tempest::event::event_registry();
+    auto reg = tempest::ecs::basic_archetype_registry(events);
+    auto jobs = tempest::core::job_system(2);
+
+    reg.create<int>();
+
+    bool invoked = false;
+    reg.par_each(jobs, [&invoked](float) { invoked = true; });
+
+    ASSERT_FALSE(invoked);
+}
+
+TEST(basic_archetype_query, each_matches_superset_archetypes)
+{
+    auto events = tempest::event::event_registry();
+    auto reg = tempest::ecs::basic_archetype_registry(events);
+
+    auto e1 = reg.create<int>();
+    reg.assign_or_replace(e1, 1);
+    auto e2 = reg.create<int, float>();
+    reg.assign_or_replace(e2, 2);
+    auto e3 = reg.create<float>();
+    reg.assign_or_replace(e3, 3.0f);
+
+    auto query = reg.query<int>();
+    ASSERT_EQ(2u, query.matches().size());
+
+    int sum = 0;
+    query.each([&sum](int& i) { sum += i; });
+
+    ASSERT_EQ(3, sum);
+}
+
+TEST(basic_archetype_query, refresh_picks_up_new_archetypes)
+{
+    auto events = tempest::event::event_registry();
+    auto reg = tempest::ecs::basic_archetype_registry(events);
+
+    auto e1 = reg.create<int>();
+    reg.assign_or_replace(e1, 1);
+
+    auto query = reg.query<int>();
+    ASSERT_EQ(1u, query.matches().size());
+
+    auto e2 = reg.create<int, char>();
+    reg.assign_or_replace(e2, 2);
+    auto e3 = reg.create<float>();
+    reg.assign_or_replace(e3, 3.0f);
+
+    ASSERT_EQ(2u, query.matches().size());
+
+    int sum = 0;
+    query.each([&sum](int i) { sum += i; });
+
+    ASSERT_EQ(3, sum);
+}
+
+TEST(basic_archetype_query, each_resolves_columns)
+{
+    auto events = tempest::event::event_registry();
+    auto reg = tempest::ecs::basic_archetype_registry(events);
+
+    auto e1 = reg.create<char, int, float>();
+    reg.assign_or_replace(e1, 'a');
+    reg.assign_or_replace(e1, 2);
+    reg.assign_or_replace(e1, 3.0f);
+
+    auto query = reg.query<float, int>();
+    query.each([](float& f, int& i) { f += static_cast<float>(i); });
+
+    ASSERT_FLOAT_EQ(5.0f, reg.get<float>(e1));
+    ASSERT_EQ(2, reg.get<int>(e1));
+    ASSERT_EQ('a', reg.get<char>(e1));
+}
+
+TEST(basic_archetype_query, par_each)
+{
+    auto events = tempest::event::event_registry();
+    auto reg = tempest::ecs::basic_archetype_registry(events);
+    auto jobs = tempest::core::job_system(4);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        auto e1 = reg.create<int>();
+        reg.assign_or_replace(e1, 1);
+        auto e2 = reg.create<int, float>();
+        reg.assign_or_replace(e2, 1);
+    }
+
+    auto query = reg.query<int>();
+    query.par_each(jobs, [](int& i) { i += 1; }, 256);
+
+    long long sum = 0;
+    query.each([&sum](int i) { sum += i; });
+
+    ASSERT_EQ(20000ll, sum);
+}
+
+TEST(basic_archetype_query, each_chunk_yields_contiguous_columns)
+{
+    auto events = tempest::event::event_registry();
+    auto reg = tempest::ecs::basic_archetype_registry(events);
+
+    tempest::vector<tempest::ecs::entity> created;
+    for (int i = 0; i < 5000; ++i)
+    {
+        auto e = reg.create<int, float>();
+        reg.assign_or_replace(e, i);
+        reg.assign_or_replace(e, 1.0f);
+        created.push_back(e);
+    }
+
+    auto query = reg.query<int, float>();
+
+    size_t visited = 0;
+    size_t chunks = 0;
+    query.each_chunk([&](tempest::span<const tempest::ecs::self_component> entities, tempest::span<int> ints,
+                         tempest::span<float> floats) {
+        ASSERT_EQ(entities.size(), ints.size());
+        ASSERT_EQ(ints.size(), floats.size());
+
+        for (size_t i = 0; i < ints.size(); ++i)
+        {
+            floats[i] += static_cast<float>(ints[i]);
+            ASSERT_EQ(ints[i], reg.get<int>(entities[i].entity));
+        }
+
+        visited += ints.size();
+        ++chunks;
+    });
+
+    ASSERT_EQ(5000u, visited);
+    ASSERT_GT(chunks, 1u);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        ASSERT_EQ(static_cast<float>(i) + 1.0f, reg.get<float>(created[i]));
+    }
+}
+
+TEST(basic_archetype_query, par_each_chunk)
+{
+    auto events = tempest::event::event_registry();
+    auto reg = tempest::ecs::basic_archetype_registry(events);
+    auto jobs = tempest::core::job_system(4);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        auto e1 = reg.create<int>();
+        reg.assign_or_replace(e1, 1);
+        auto e2 = reg.create<int, char>();
+        reg.assign_or_replace(e2, 2);
+    }
+
+    tempest::atomic<tempest::uint64_t> visited{0};
+
+    auto query = reg.query<int>();
+    query.par_each_chunk(jobs, [&visited](tempest::span<const tempest::ecs::self_component>, tempest::span<int> ints) {
+        for (auto& i : ints)
+        {
+            i *= 3;
+        }
+        visited.fetch_add(ints.size(), tempest::memory_order::relaxed);
+    });
+
+    ASSERT_EQ(10000u, visited.load());
+
+    long long sum = 0;
+    reg.each([&sum](int i) { sum += i; });
+
+    ASSERT_EQ(5000ll * 3ll + 5000ll * 6ll, sum);
+}
+
+namespace
+{
+    template <tempest::size_t N>
+    struct indexed_component
+    {
+        int value;
+    };
+} // namespace
+
+TEST(basic_archetype_query, matches_component_with_high_type_index)
+{
+    // Register enough component types that the queried one lands past the first 32 type indices
+    []<tempest::size_t... Is>(tempest::index_sequence<Is...>) {
+        (tempest::ecs::create_archetype_type_info<indexed_component<Is>>(), ...);
+    }(tempest::make_index_sequence<40>{});
+
+    using high_component = indexed_component<39>;
+    ASSERT_GE(tempest::ecs::create_archetype_type_info<high_component>().index, 32u);
+
+    auto events = tempest::event::event_registry();
+    auto reg = tempest::ecs::basic_archetype_registry(events);
+
+    auto e1 = reg.create<int>();
+    reg.assign_or_replace(e1, 1);
+    auto e2 = reg.create<int, high_component>();
+    reg.assign_or_replace(e2, 2);
+    reg.assign_or_replace(e2, high_component{.value = 20});
+
+    auto query = reg.query<high_component>();
+    ASSERT_EQ(1u, query.matches().size());
+
+    int sum = 0;
+    query.each([&sum](high_component& c) { sum += c.value; });
+
+    ASSERT_EQ(20, sum);
+}
+
 TEST(basic_archetype_registry, destroy_entity_emit_event)
 {
     auto events = tempest::event::event_registry();
@@ -0,0 +1,145 @@
+#include <tempest/transform_propagation.hpp>
+
+#include <tempest/archetype.hpp>
+#include <tempest/event_registry.hpp>
+#include <tempest/transform_component.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    tempest::ecs::transform_component make_transform(tempest::math::vec3<float> position)
+    {
+        auto tx = tempest::ecs::transform_component::identity();
+        tx.position(position);
+        return tx;
+    }
+} // namespace
+
+TEST(transform_propagation_system, root_world_matches_local)
+{
+    auto events = tempest::event::event_registry();
+    auto reg = tempest::ecs::archetype_registry(events);
+    auto transforms = tempest::ecs::transform_propagation_system(reg, events);
+
+    auto e = reg.create<tempest::ecs::transform_component>();
+    reg.assign_or_replace(e, make_transform({1.0f, 2.0f, 3.0f}));
+
+    ASSERT_EQ(1u, transforms.dirty_count());
+    transforms.update();
+    ASSERT_EQ(0u, transforms.dirty_count());
+
+    auto world = reg.try_get<tempest::ecs::world_transform_component>(e);
+    ASSERT_NE(nullptr, world);
+    ASSERT_EQ(reg.get<tempest::ecs::transform_component>(e).matrix(), world->matrix);
+}
+
+TEST(transform_propagation_system, propagates_through_hierarchy)
+{
+    auto events = tempest::event::event_registry();
+    auto reg = tempest::ecs::archetype_registry(events);
+    auto transforms = tempest::ecs::transform_propagation_system(reg, events);
+
+    auto parent = reg.create<tempest::ecs::transform_component>();
+    auto child = reg.create<tempest::ecs::transform_component>();
+    auto grandchild = reg.create<tempest::ecs::transform_component>();
+    auto sibling = reg.create<tempest::ecs::transform_component>();
+
+    reg.assign_or_replace(parent, make_transform({1.0f, 0.0f, 0.0f}));
+    reg.assign_or_replace(child, make_transform({0.0f, 2.0f, 0.0f}));
+    reg.assign_or_replace(grandchild, make_transform({0.0f, 0.0f, 3.0f}));
+    reg.assign_or_replace(sibling, make_transform({4.0f, 0.0f, 0.0f}));
+
+    tempest::ecs::create_parent_child_relationship(reg, parent, child);
+    tempest::ecs::create_parent_child_relationship(reg, child, grandchild);
+    tempest::ecs::create_parent_child_relationship(reg, parent, sibling);
+
+    transforms.update();
+
+    const auto p = reg.get<tempest::ecs::transform_component>(parent).matrix();
+    const auto c = reg.get<tempest::ecs::transform_component>(child).matrix();
+    const auto g = reg.get<tempest::ecs::transform_component>(grandchild).matrix();
+    const auto s = reg.get<tempest::ecs::transform_component>(sibling).matrix();
+
+    ASSERT_EQ(p, reg.get<tempest::ecs::world_transform_component>(parent).matrix);
+    ASSERT_EQ(p * c, reg.get<tempest::ecs::world_transform_component>(child).matrix);
+    ASSERT_EQ(p * c * g, reg.get<tempest::ecs::world_transform_component>(grandchild).matrix);
+    ASSERT_EQ(p * s, reg.get<tempest::ecs::world_transform_component>(sibling).matrix);
+}
+
+TEST(transform_propagation_system, updates_only_dirty_subtree)
+{
+    auto events = tempest::event::event_registry();
+    auto reg = tempest::ecs::archetype_registry(events);
+    auto transforms = tempest::ecs::transform_propagation_system(reg, events);
+
+    auto parent = reg.create<tempest::ecs::transform_component>();
+    auto child = reg.create<tempest::ecs::transform_component>();
+    auto grandchild = reg.create<tempest::ecs::transform_component>();
+
+    reg.assign_or_replace(parent, make_transform({1.0f, 0.0f, 0.0f}));
+    reg.assign_or_replace(child, make_transform({0.0f, 2.0f, 0.0f}));
+    reg.assign_or_replace(grandchild, make_transform({0.0f, 0.0f, 3.0f}));
+
+    tempest::ecs::create_parent_child_relationship(reg, parent, child);
+    tempest::ecs::create_parent_child_relationship(reg, child, grandchild);
+
+    transforms.update();
+
+    // A world transform that is rewritten by the next update loses this value. Children only read the parent's
+    // matrix, so the sentinel does not leak into their world transforms.
+    const auto sentinel = tempest::math::mat4<float>(0.0f);
+    reg.try_get<tempest::ecs::world_transform_component>(parent)->inv_transpose = sentinel;
+
+    reg.assign_or_replace(child, make_transform({0.0f, 5.0f, 0.0f}));
+    ASSERT_EQ(1u, transforms.dirty_count());
+
+    transforms.update();
+
+    ASSERT_EQ(sentinel, reg.get<tempest::ecs::world_transform_component>(parent).inv_transpose);
+
+    const auto p = reg.get<tempest::ecs::transform_component>(parent).matrix();
+    const auto c = reg.get<tempest::ecs::transform_component>(child).matrix();
+    const auto g = reg.get<tempest::ecs::transform_component>(grandchild).matrix();
+
+    ASSERT_EQ(p * c * g, reg.get<tempest::ecs::world_transform_component>(grandchild).matrix);
+}
+
+TEST(transform_propagation_system, mark_dirty_picks_up_in_place_edits)
+{
+    auto events = tempest::event::event_registry();
+    auto reg = tempest::ecs::archetype_registry(events);
+    auto transforms = tempest::ecs::transform_propagation_system(reg, events);
+
+    auto parent = reg.create<tempest::ecs::transform_component>();
+    auto child = reg.create<tempest::ecs::transform_component>();
+
+    reg.assign_or_replace(parent, make_transform({1.0f, 0.0f, 0.0f}));
+    reg.assign_or_replace(child, make_transform({0.0f, 2.0f, 0.0f}));
+
+    tempest::ecs::create_parent_child_relationship(reg, parent, child);
+
+    transforms.update();
+
+    // Existing world transforms are written in place, without a replace event
+    int world_replacements = 0;
+    [[maybe_unused]] auto subscription =
+        events
+            .dispatcher<tempest::ecs::component_replaced_event<tempest::ecs::archetype_entity,
+                                                               tempest::ecs::world_transform_component>>()
+            .subscribe([&]([[maybe_unused]] const auto& evt) { ++world_replacements; });
+
+    reg.try_get<tempest::ecs::transform_component>(parent)->position({4.0f, 0.0f, 0.0f});
+    ASSERT_EQ(0u, transforms.dirty_count());
+
+    transforms.mark_dirty(parent);
+    transforms.update();
+
+    ASSERT_EQ(0, world_replacements);
+
+    const auto p = reg.get<tempest::ecs::transform_component>(parent).matrix();
+    const auto c = reg.get<tempest::ecs::transform_component>(child).matrix();
+
+    ASSERT_EQ(p, reg.get<tempest::ecs::world_transform_component>(parent).matrix);
+    ASSERT_EQ(p * c, reg.get<tempest::ecs::world_transform_component>(child).matrix);
+}
@@ -5,8 +5,11 @@
 #include <tempest/concepts.hpp>
 #include <tempest/enum.hpp>
 #include <tempest/flat_unordered_map.hpp>
+#include <tempest/frame_arena.hpp>
 #include <tempest/functional.hpp>
+#include <tempest/inplace_vector.hpp>
 #include <tempest/int.hpp>
+#include <tempest/job_system.hpp>
 #include <tempest/limits.hpp>
 #include <tempest/rhi.hpp>
 #include <tempest/rhi_types.hpp>
@@ -144,12 +147,19 @@ namespace tempest::graphics
         void enable_if(function<bool()> condition);
         void fallback(base_graph_resource_handle produced, base_graph_resource_handle alternative);
 
+        // Records the pass into its own command list on a worker thread when the executor has a job system. Serial
+        // passes scheduled before the first parallel pass of a submission finish recording before any parallel pass
+        // starts, later serial passes may record concurrently. The record callback may only read state shared with
+        // other passes.
+        void record_in_parallel();
+
       protected:
         friend class graph_builder;
 
         vector<scheduled_resource_access> accesses;
         vector<string> dependencies;
-        function<bool()> _enable_condition = [] { return true; };
+        bool _record_in_parallel = false;
+        function<bool()> _enable_condition;
         function<void(task_execution_context&)> _fallback_exec;
         flat_unordered_map<uint64_t, uint64_t> _resource_fallbacks;
     };
@@ -385,6 +395,40 @@ namespace tempest::graphics
         using task_execution_context::task_execution_context;
     };
 
+    struct TEMPEST_API aliasing_barrier
+    {
+        base_graph_resource_handle before; // Resource that last occupied the memory
+        base_graph_resource_handle after;  // Resource taking over the memory in this pass
+    };
+
+    // Barriers are computed for the steady state, where the state a resource enters the frame with is the state the
+    // previous frame left it in. Queues are work_type::unknown unless ownership moves between queues.
+    struct TEMPEST_API planned_image_barrier
+    {
+        base_graph_resource_handle handle;
+        rhi::image_layout old_layout;
+        rhi::image_layout new_layout;
+        enum_mask<rhi::pipeline_stage> src_stages;
+        enum_mask<rhi::memory_access> src_access;
+        enum_mask<rhi::pipeline_stage> dst_stages;
+        enum_mask<rhi::memory_access> dst_access;
+        work_type src_queue;
+        work_type dst_queue;
+        bool first_access_in_frame; // Transitions from undefined instead when the resource was just (re)created
+    };
+
+    struct TEMPEST_API planned_buffer_barrier
+    {
+        base_graph_resource_handle handle;
+        enum_mask<rhi::pipeline_stage> src_stages;
+        enum_mask<rhi::memory_access> src_access;
+        enum_mask<rhi::pipeline_stage> dst_stages;
+        enum_mask<rhi::memory_access> dst_access;
+        work_type src_queue;
+        work_type dst_queue;
+        bool per_frame; // Covers the frame in flight's slice of the buffer rather than the whole buffer
+    };
+
     struct TEMPEST_API scheduled_pass
     {
         string name;
@@ -396,6 +440,14 @@ namespace tempest::graphics
         function<bool()> enable_condition;
         function<void(task_execution_context&)> fallback_exec;
         flat_unordered_map<uint64_t, uint64_t> resource_fallbacks;
+        bool record_in_parallel = false;
+        size_t source_pass = 0; // Index of the pass in the builder the plan was compiled from
+
+        vector<aliasing_barrier> aliasing_barriers;
+
+        // Recorded before the pass executes
+        vector<planned_image_barrier> image_barriers;
+        vector<planned_buffer_barrier> buffer_barriers;
     };
 
     struct TEMPEST_API ownership_transfer
@@ -443,6 +495,8 @@ namespace tempest::graphics
                 rhi::typed_rhi_handle<rhi::rhi_handle_type::render_surface>>;
     using internal_resource = variant<rhi::buffer_desc, rhi::image_desc>;
 
+    inline constexpr uint32_t no_transient_heap = numeric_limits<uint32_t>::max();
+
     struct TEMPEST_API scheduled_resource
     {
         base_graph_resource_handle handle;
@@ -451,6 +505,17 @@ namespace tempest::graphics
         bool temporal;
         bool render_target;
         bool presentable;
+
+        // Index of the transient heap the resource is placed in, or no_transient_heap for dedicated memory
+        uint32_t heap_index = no_transient_heap;
+    };
+
+    // Resources whose lifetimes within the frame do not overlap, backed by a single block of memory
+    struct TEMPEST_API transient_heap
+    {
+        work_type queue;
+        rhi::rhi_handle_type resource_type;
+        vector<base_graph_resource_handle> resources; // Ordered by first use
     };
 
     struct TEMPEST_API queue_configuration
@@ -464,6 +529,8 @@ namespace tempest::graphics
     {
         vector<scheduled_resource> resources;
         vector<submit_instructions> submissions;
+        vector<transient_heap> transient_heaps;
+        vector<planned_image_barrier> present_barriers; // One per render surface, recorded at the end of the frame
         queue_configuration queue_cfg;
     };
 
@@ -473,6 +540,7 @@ namespace tempest::graphics
         work_type type;
         function<void(task_execution_context&)> execution_context;
         bool async = false;
+        bool record_in_parallel = false;
 
         vector<scheduled_resource_access> resource_accesses;
         vector<base_graph_resource_handle> outputs; // Resources written in this pass, subset of resource_accesses
@@ -496,6 +564,20 @@ namespace tempest::graphics
         bool presentable = false;
     };
 
+    // Compiled plans keyed by graph_builder::structural_hash. Plans are stored without their pass callbacks, which are
+    // taken from the builder that hits the cache.
+    class TEMPEST_API graph_plan_cache
+    {
+      public:
+        optional<const graph_execution_plan&> find(uint64_t structural_hash) const noexcept;
+        void insert(uint64_t structural_hash, graph_execution_plan plan);
+        void clear() noexcept;
+        size_t size() const noexcept;
+
+      private:
+        flat_unordered_map<uint64_t, graph_execution_plan> _plans;
+    };
+
     class TEMPEST_API graph_builder
     {
       public:
@@ -541,7 +623,12 @@ namespace tempest::graphics
             invocable_no_capture<transfer_task_execution_context&, unwrap_reference_t<ExecTs>...> auto&& record,
             ExecTs&&... exec_args);
 
+        // Covers passes, their accesses and resource descriptors. Render target extents and imported handles are left
+        // out, as a cached plan has them patched in from the builder.
+        uint64_t structural_hash(const queue_configuration& cfg) const;
+
         graph_execution_plan compile(queue_configuration cfg) &&;
+        graph_execution_plan compile(queue_configuration cfg, graph_plan_cache& cache) &&;
 
       private:
         vector<resource_entry> _resources;
@@ -606,6 +693,8 @@ namespace tempest::graphics
             span<const size_t> topo_order, const flat_unordered_map<size_t, work_type>& queue_assignments) const;
         graph_execution_plan _build_execution_plan(span<const submit_batch> batches,
                                                    span<const size_t> resource_indices);
+        void _alias_transient_resources(graph_execution_plan& plan) const;
+        void _plan_barriers(graph_execution_plan& plan) const;
     };
 
     template <typename... ExecTs>
@@ -725,10 +814,31 @@ namespace tempest::graphics
         bool queue_used = false;
     };
 
+    // CPU timings of the last graph_executor::execute call, measured with a steady clock on the calling thread. No
+    // GPU time is measured.
+    struct TEMPEST_API frame_pacing_stats
+    {
+        uint64_t frame_ns = 0;      // Wall time of execute, including swapchain acquire and present
+        uint64_t fence_wait_ns = 0; // Time blocked on the fences of the frame in flight being reused
+
+        // Share of the frame spent blocked on frame in flight fences, in [0, 1]. Time blocked in swapchain acquire or
+        // present is not counted as a stall.
+        double fence_stall_ratio() const noexcept
+        {
+            if (frame_ns == 0)
+            {
+                return 0.0;
+            }
+
+            return static_cast<double>(fence_wait_ns) / static_cast<double>(frame_ns);
+        }
+    };
+
     class TEMPEST_API graph_executor
     {
       public:
-        explicit graph_executor(rhi::device& device);
+        // Passes opting into parallel recording are recorded on the job system's workers, if one is given
+        explicit graph_executor(rhi::device& device, core::job_system* jobs = nullptr);
 
         void execute();
         void set_execution_plan(graph_execution_plan plan);
@@ -744,57 +854,43 @@ namespace tempest::graphics
         void resize_render_target(graph_resource_handle<rhi::rhi_handle_type::image> img, uint32_t width,
                                   uint32_t height);
 
+        // Rebuilds each affected transient heap and the baked barriers once for the whole set
+        void resize_render_targets(span<const graph_resource_handle<rhi::rhi_handle_type::image>> images,
+                                   uint32_t width, uint32_t height);
+
+        // Scratch memory valid until the frame being executed retires
+        core::frame_arena& get_frame_arena() noexcept;
+
+        // Timings of the last executed frame
+        const frame_pacing_stats& get_frame_pacing_stats() const noexcept;
+
       private:
+        static constexpr size_t _frame_arena_bytes_per_thread = 256 * 1024;
+
         rhi::device* _device;
+        core::job_system* _jobs;
+        core::frame_arena _frame_arena;
         optional<graph_execution_plan> _plan;
         flat_unordered_map<uint64_t, uint64_t> _execution_alias_map;
 
-        struct buffer_usage
-        {
-            uint64_t offset;
-            uint64_t range;
-        };
-
-        struct image_usage
+        // Barriers of the plan resolved to RHI handles, in flattened pass order
+        struct baked_barriers
         {
-            uint32_t base_mip;
-            uint32_t mip_levels;
-            uint32_t base_array_layer;
-            uint32_t array_layers;
-            rhi::image_layout layout;
-        };
+            vector<vector<rhi::work_queue::image_barrier>> image_barriers;   // frame in flight -> barriers
+            vector<vector<rhi::work_queue::buffer_barrier>> buffer_barriers; // frame in flight -> barriers
 
-        struct resource_usage
-        {
-            work_type queue;
-            uint32_t queue_index;
-            enum_mask<rhi::pipeline_stage> stages;
-            enum_mask<rhi::memory_access> accesses;
-            variant<buffer_usage, image_usage> usage;
-            uint64_t timeline_value;
+            // Indices of barriers whose resource is only known while executing, such as swapchain images
+            vector<size_t> dynamic_images;
+            vector<size_t> dynamic_buffers;
         };
 
-        struct write_barrier_details
-        {
-            enum_mask<rhi::pipeline_stage> write_stages;
-            enum_mask<rhi::memory_access> write_accesses;
-
-            enum_mask<rhi::pipeline_stage> read_stages_seen;
-            enum_mask<rhi::memory_access> read_accesses_seen;
-        };
-
-        struct per_frame_in_flight_usage
-        {
-            flat_unordered_map<uint64_t, resource_usage> resource_states; // handle -> state
-        };
-
-        flat_unordered_map<uint64_t, resource_usage> _current_resource_states; // handle -> state
-        vector<per_frame_in_flight_usage> _in_flight_usages;
-        flat_unordered_map<uint64_t, write_barrier_details> _write_barriers; // handle -> details
+        vector<baked_barriers> _baked_barriers;
+        vector<uint64_t> _reset_resources; // Recreated since their last use, so their contents are undefined
 
         // Owned resources
         flat_unordered_map<uint64_t, rhi::typed_rhi_handle<rhi::rhi_handle_type::buffer>> _owned_buffers;
         flat_unordered_map<uint64_t, rhi::typed_rhi_handle<rhi::rhi_handle_type::image>> _owned_images;
+        vector<rhi::typed_rhi_handle<rhi::rhi_handle_type::memory_heap>> _transient_heaps; // Indexed as in the plan
 
         // Unowned resources
         vector<pair<uint64_t, rhi::typed_rhi_handle<rhi::rhi_handle_type::render_surface>>> _external_surfaces;
@@ -823,8 +919,21 @@ namespace tempest::graphics
 
         size_t _current_frame = 0;
 
+        // Frame complete fences of other queues to wait on before each submission is recorded
+        vector<inplace_vector<work_type, 3>> _submission_fence_waits;
+        inplace_vector<work_type, 3> _retired_queues;      // Fences handled so far this frame
+        inplace_vector<rhi::work_queue*, 3> _reset_queues; // Queues reset so far this frame
+        frame_pacing_stats _pacing_stats;
+
         void _construct_owned_resources();
         void _destroy_owned_resources();
+        void _construct_transient_heap(size_t heap_index);
+        void _destroy_transient_heap(size_t heap_index);
+        void _bake_barriers();
+        void _plan_fence_waits();
+        void _retire_queue(work_type type, size_t frame_in_flight);
+        void _prepare_queue(work_type type, size_t frame_in_flight);
+        rhi::work_queue& _get_queue(work_type type) const;
 
         using acquired_swapchains = vector<pair<rhi::typed_rhi_handle<rhi::rhi_handle_type::render_surface>,
                                                 rhi::swapchain_image_acquire_info_result>>;
@@ -0,0 +1,81 @@
+#ifndef tempest_graphics_frustum_culling_hpp
+#define tempest_graphics_frustum_culling_hpp
+
+#include <tempest/api.hpp>
+#include <tempest/array.hpp>
+#include <tempest/int.hpp>
+#include <tempest/mat4.hpp>
+#include <tempest/span.hpp>
+#include <tempest/vec3.hpp>
+#include <tempest/vec4.hpp>
+#include <tempest/vector.hpp>
+#include <tempest/vertex.hpp>
+
+namespace tempest::graphics
+{
+    struct TEMPEST_API bounding_sphere
+    {
+        math::vec3<float> center;
+        float radius;
+    };
+
+    /// @brief Computes a sphere enclosing every vertex position of a mesh.
+    /// @param vertices Vertices of the mesh
+    /// @return Sphere centered on the vertex bounding box
+    TEMPEST_API bounding_sphere compute_bounding_sphere(span<const core::vertex> vertices) noexcept;
+
+    /// @brief Transforms a sphere by an affine matrix. The radius is scaled by the largest axis scale, so the result
+    /// stays conservative under non-uniform scaling.
+    /// @param sphere Sphere to transform
+    /// @param transform Affine transform
+    /// @return Transformed sphere
+    TEMPEST_API bounding_sphere transform_bounding_sphere(const bounding_sphere& sphere,
+                                                          const math::mat4<float>& transform) noexcept;
+
+    /// @brief Six clip planes of a view frustum, in world space. Each plane is stored as (normal, distance) with the
+    /// normal pointing into the frustum.
+    struct TEMPEST_API frustum
+    {
+        array<math::vec4<float>, 6> planes;
+
+        /// @brief Extracts the planes of a view-projection matrix using a [0, 1] clip space depth range. Degenerate
+        /// planes, such as the far plane of an infinite projection, never reject anything.
+        /// @param view_projection World to clip space transform
+        /// @return Frustum of the matrix
+        [[nodiscard]] static frustum from_view_projection(const math::mat4<float>& view_projection) noexcept;
+
+        /// @brief Tests if a sphere is at least partially inside the frustum.
+        /// @param sphere Sphere to test
+        /// @return True if the sphere intersects the frustum
+        [[nodiscard]] bool intersects(const bounding_sphere& sphere) const noexcept;
+    };
+
+    /// @brief Set of bounding spheres stored as separate component arrays, so they can be tested against frustum
+    /// planes four at a time.
+    class TEMPEST_API bounding_sphere_set
+    {
+      public:
+        void clear() noexcept;
+        void reserve(size_t count);
+
+        /// @brief Adds a sphere to the set.
+        /// @param sphere Sphere to add
+        /// @return Index of the sphere
+        uint32_t push_back(const bounding_sphere& sphere);
+
+        [[nodiscard]] size_t size() const noexcept;
+
+        /// @brief Appends the indices of every sphere intersecting a frustum, in increasing order.
+        /// @param view Frustum to test against
+        /// @param visible Receives the indices of visible spheres
+        void cull(const frustum& view, vector<uint32_t>& visible) const;
+
+      private:
+        vector<float> _center_x;
+        vector<float> _center_y;
+        vector<float> _center_z;
+        vector<float> _radius;
+    };
+} // namespace tempest::graphics
+
+#endif // tempest_graphics_frustum_culling_hpp
@@ -0,0 +1,306 @@
+#ifndef tempest_graphics_gpu_scene_hpp
+#define tempest_graphics_gpu_scene_hpp
+
+#include <tempest/assert.hpp>
+#include <tempest/flat_unordered_map.hpp>
+#include <tempest/int.hpp>
+#include <tempest/optional.hpp>
+#include <tempest/span.hpp>
+#include <tempest/type_traits.hpp>
+#include <tempest/vector.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace tempest::graphics
+{
+    /// @brief Contiguous range of dirty elements in a persistent object buffer.
+    struct gpu_dirty_range
+    {
+        uint32_t first;
+        uint32_t count;
+    };
+
+    /// @brief CPU mirror of a GPU buffer of objects that persists across frames.
+    ///
+    /// Every key is assigned a stable slot in the buffer. Writing a value that differs from the one already stored in
+    /// the slot marks it dirty for every copy of the buffer, where each frame in flight owns one copy. The frame that
+    /// owns a copy takes the dirty ranges for that copy and uploads only those, so unchanged objects are never copied
+    /// again once every copy holds them.
+    ///
+    /// Slots of keys that were not written between begin_update() and end_update() are released and reused by later
+    /// keys.
+    ///
+    /// @tparam K Key type identifying an object
+    /// @tparam T Trivially copyable element type stored on the GPU
+    template <typename K, typename T>
+    class persistent_object_buffer
+    {
+        static_assert(is_trivially_copyable_v<T>, "Persistent buffer elements must be trivially copyable.");
+
+      public:
+        /// @brief Maximum number of buffer copies that can be tracked.
+        static constexpr uint32_t max_copies = 32;
+
+        /// @brief Creates an empty buffer.
+        /// @param copy_count Number of copies of the GPU buffer, typically the number of frames in flight
+        /// @param capacity Maximum number of objects the GPU buffer can hold
+        persistent_object_buffer(uint32_t copy_count, uint32_t capacity);
+
+        /// @brief Starts a new update. Every live key must be written again before end_update() to keep its slot.
+        void begin_update() noexcept;
+
+        /// @brief Writes the value of a key, allocating a slot on first use.
+        /// @param key Key of the object
+        /// @param value Value of the object
+        /// @return Slot of the object, or an empty optional if the buffer is full
+        optional<uint32_t> write(const K& key, const T& value);
+
+        /// @brief Releases the slots of every key that was not written since begin_update().
+        /// @return Number of released slots
+        size_t end_update();
+
+        /// @brief Marks every live slot dirty in every copy, for example after the GPU buffers were recreated.
+        void invalidate();
+
+        /// @brief Takes the dirty ranges of a copy, sorted by slot, and marks the copy clean.
+        /// @param copy Index of the copy being uploaded
+        /// @return Dirty ranges, valid until the next call to take_dirty_ranges()
+        span<const gpu_dirty_range> take_dirty_ranges(uint32_t copy);
+
+        /// @brief Fetches the slot of a key.
+        /// @param key Key of the object
+        /// @return Slot of the key, or an empty optional if the key has no slot
+        [[nodiscard]] optional<uint32_t> slot_of(const K& key) const;
+
+        /// @brief Fetches the CPU copy of the objects, indexed by slot.
+        [[nodiscard]] const T* data() const noexcept;
+
+        /// @brief Fetches the number of slots in use, including released slots below the highest live slot.
+        [[nodiscard]] size_t size() const noexcept;
+
+        /// @brief Fetches the number of keys holding a slot.
+        [[nodiscard]] size_t live_count() const noexcept;
+
+        /// @brief Fetches the maximum number of objects.
+        [[nodiscard]] size_t capacity() const noexcept;
+
+        /// @brief Fetches the number of copies tracked.
+        [[nodiscard]] uint32_t copy_count() const noexcept;
+
+      private:
+        struct slot_state
+        {
+            K key;
+            uint64_t generation;
+            uint32_t pending_copies;
+            bool live;
+        };
+
+        uint32_t _copy_count;
+        uint32_t _capacity;
+        uint64_t _generation = 0;
+
+        flat_unordered_map<K, uint32_t> _key_to_slot;
+        vector<T> _values;
+        vector<slot_state> _slots;
+        vector<uint32_t> _free_slots;
+
+        vector<vector<uint32_t>> _dirty_slots; // Per copy
+        vector<gpu_dirty_range> _ranges;
+
+        void _mark_dirty(uint32_t slot);
+    };
+
+    template <typename K, typename T>
+    inline persistent_object_buffer<K, T>::persistent_object_buffer(uint32_t copy_count, uint32_t capacity)
+        : _copy_count{copy_count}, _capacity{capacity}
+    {
+        TEMPEST_ASSERT(copy_count > 0 && copy_count <= max_copies);
+        _dirty_slots.resize(copy_count);
+    }
+
+    template <typename K, typename T>
+    inline void persistent_object_buffer<K, T>::begin_update() noexcept
+    {
+        ++_generation;
+    }
+
+    template <typename K, typename T>
+    inline optional<uint32_t> persistent_object_buffer<K, T>::write(const K& key, const T& value)
+    {
+        if (auto it = _key_to_slot.find(key); it != _key_to_slot.end())
+        {
+            const auto slot = it->second;
+            _slots[slot].generation = _generation;
+
+            if (std::memcmp(&_values[slot], &value, sizeof(T)) != 0)
+            {
+                std::memcpy(&_values[slot], &value, sizeof(T));
+                _mark_dirty(slot);
+            }
+
+            return slot;
+        }
+
+        uint32_t slot;
+        if (!_free_slots.empty())
+        {
+            slot = _free_slots.back();
+            _free_slots.pop_back();
+        }
+        else if (_values.size() < _capacity)
+        {
+            slot = static_cast<uint32_t>(_values.size());
+            _values.push_back(value);
+            _slots.push_back({});
+        }
+        else
+        {
+            return none();
+        }
+
+        std::memcpy(&_values[slot], &value, sizeof(T));
+        _slots[slot].key = key;
+        _slots[slot].generation = _generation;
+        _slots[slot].live = true;
+        _key_to_slot[key] = slot;
+
+        _mark_dirty(slot);
+
+        return slot;
+    }
+
+    template <typename K, typename T>
+    inline size_t persistent_object_buffer<K, T>::end_update()
+    {
+        size_t released = 0;
+
+        for (uint32_t slot = 0; slot < _slots.size(); ++slot)
+        {
+            auto& state = _slots[slot];
+            if (state.live && state.generation != _generation)
+            {
+                // Released slots keep their stale contents, nothing on the GPU references them anymore
+                _key_to_slot.erase(state.key);
+                state.live = false;
+                _free_slots.push_back(slot);
+                ++released;
+            }
+        }
+
+        if (released > 0)
+        {
+            // Hand out low slots first to keep the uploaded region compact
+            std::sort(_free_slots.begin(), _free_slots.end(), [](uint32_t lhs, uint32_t rhs) { return lhs > rhs; });
+        }
+
+        return released;
+    }
+
+    template <typename K, typename T>
+    inline void persistent_object_buffer<K, T>::invalidate()
+    {
+        for (uint32_t slot = 0; slot < _slots.size(); ++slot)
+        {
+            if (_slots[slot].live)
+            {
+                _mark_dirty(slot);
+            }
+        }
+    }
+
+    template <typename K, typename T>
+    inline span<const gpu_dirty_range> persistent_object_buffer<K, T>::take_dirty_ranges(uint32_t copy)
+    {
+        TEMPEST_ASSERT(copy < _copy_count);
+
+        auto& dirty = _dirty_slots[copy];
+        std::sort(dirty.begin(), dirty.end());
+
+        _ranges.clear();
+
+        const auto copy_bit = 1u << copy;
+        for (const auto slot : dirty)
+        {
+            _slots[slot].pending_copies &= ~copy_bit;
+
+            if (!_ranges.empty() && _ranges.back().first + _ranges.back().count == slot)
+            {
+                ++_ranges.back().count;
+            }
+            else
+            {
+                _ranges.push_back({
+                    .first = slot,
+                    .count = 1,
+                });
+            }
+        }
+
+        dirty.clear();
+
+        return _ranges;
+    }
+
+    template <typename K, typename T>
+    inline optional<uint32_t> persistent_object_buffer<K, T>::slot_of(const K& key) const
+    {
+        if (auto it = _key_to_slot.find(key); it != _key_to_slot.end())
+        {
+            return it->second;
+        }
+
+        return none();
+    }
+
+    template <typename K, typename T>
+    inline const T* persistent_object_buffer<K, T>::data() const noexcept
+    {
+        return _values.data();
+    }
+
+    template <typename K, typename T>
+    inline size_t persistent_object_buffer<K, T>::size() const noexcept
+    {
+        return _values.size();
+    }
+
+    template <typename K, typename T>
+    inline size_t persistent_object_buffer<K, T>::live_count() const noexcept
+    {
+        return _key_to_slot.size();
+    }
+
+    template <typename K, typename T>
+    inline size_t persistent_object_buffer<K, T>::capacity() const noexcept
+    {
+        return _capacity;
+    }
+
+    template <typename K, typename T>
+    inline uint32_t persistent_object_buffer<K, T>::copy_count() const noexcept
+    {
+        return _copy_count;
+    }
+
+    template <typename K, typename T>
+    inline void persistent_object_buffer<K, T>::_mark_dirty(uint32_t slot)
+    {
+        auto& state = _slots[slot];
+        const auto all_copies = _copy_count == max_copies ? ~0u : (1u << _copy_count) - 1;
+        const auto missing = all_copies & ~state.pending_copies;
+
+        for (uint32_t copy = 0; copy < _copy_count; ++copy)
+        {
+            if ((missing & (1u << copy)) != 0)
+            {
+                _dirty_slots[copy].push_back(slot);
+            }
+        }
+
+        state.pending_copies = all_copies;
+    }
+} // namespace tempest::graphics
+
+#endif // tempest_graphics_gpu_scene_hpp
@@ -5,6 +5,8 @@
 #include <tempest/archetype.hpp>
 #include <tempest/flat_map.hpp>
 #include <tempest/frame_graph.hpp>
+#include <tempest/frustum_culling.hpp>
+#include <tempest/gpu_scene.hpp>
 #include <tempest/graphics_components.hpp>
 #include <tempest/inplace_vector.hpp>
 #include <tempest/int.hpp>
@@ -58,6 +60,7 @@ namespace tempest::graphics
     struct TEMPEST_API pbr_frame_graph_inputs
     {
         ecs::archetype_registry* entity_registry = nullptr;
+        core::job_system* jobs = nullptr; // Records the draw heavy passes in parallel when set
     };
 
     class TEMPEST_API pbr_frame_graph
@@ -98,6 +101,11 @@ namespace tempest::graphics
 
         void execute();
 
+        const frame_pacing_stats& get_frame_pacing_stats() const noexcept
+        {
+            return _executor->get_frame_pacing_stats();
+        }
+
         void upload_objects_sync(span<const ecs::entity> entities, const core::mesh_registry& meshes,
                                  const core::texture_registry& textures, const core::material_registry& materials);
 
@@ -548,13 +556,33 @@ namespace tempest::graphics
             constexpr auto operator<=>(const draw_batch_key&) const noexcept = default;
         };
 
-        struct draw_batch_payload
+        struct draw_instance
+        {
+            uint32_t mesh_id;
+            uint32_t object_slot;
+
+            constexpr auto operator<=>(const draw_instance&) const noexcept = default;
+        };
+
+        struct draw_batch_view
         {
-            vector<indexed_indirect_command> commands;
             size_t indirect_command_offset;
-            ecs::basic_sparse_map<ecs::basic_archetype_registry::entity_type, object_data> objects;
+            uint32_t command_count;
         };
 
+        struct draw_batch_payload
+        {
+            vector<draw_instance> instances; // Visible instances of the view being built, grouped by mesh
+            vector<draw_batch_view> views;   // Indexed by culling view, view 0 is the primary camera
+        };
+
+        static constexpr size_t primary_culling_view = 0;
+
+        // Instances of every culling view share the instance buffer, which holds this many instances per object. The
+        // primary view is culled first and always fits, shadow cascade views that would overflow the instance or
+        // indirect command buffer are not drawn.
+        static constexpr uint32_t max_view_instances_per_object = 4;
+
         struct
         {
             flat_unordered_map<guid, size_t> image_to_index;
@@ -576,13 +604,39 @@ namespace tempest::graphics
         {
             flat_unordered_map<guid, size_t> mesh_to_index;
             vector<mesh_layout> meshes;
+            vector<bounding_sphere> bounds; // Object space bounds, parallel to meshes
         } _meshes = {};
 
         struct
         {
             flat_map<draw_batch_key, draw_batch_payload> draw_batches;
+            vector<indexed_indirect_command> commands; // Commands of every batch and view, in upload order
         } _drawables = {};
 
+        struct culled_object
+        {
+            draw_batch_key key;
+            draw_instance instance;
+        };
+
+        struct
+        {
+            bounding_sphere_set bounds;    // World space bounds of the renderables drawn this frame
+            vector<culled_object> objects; // Parallel to bounds
+            vector<frustum> views;
+            vector<uint32_t> visible;
+        } _culling = {};
+
+        struct
+        {
+            // Objects keep their slot in the object buffer across frames, only changed slots are uploaded
+            optional<persistent_object_buffer<ecs::entity, object_data>> objects;
+
+            // Instance buffer contents last uploaded to each per-frame copy
+            vector<vector<uint32_t>> uploaded_instances;
+            vector<uint32_t> instances;
+        } _gpu_scene = {};
+
         struct
         {
             vector<math::vec4<float>> noise_kernel;
@@ -601,6 +655,8 @@ namespace tempest::graphics
             float split_depth;
             float blend_start;
             float texel_size_ws;
+
+            uint32_t culling_view;
         };
 
         struct csm_shadow_data
@@ -614,6 +670,8 @@ namespace tempest::graphics
                                             const shadow_map_component& shadow_comp, const camera_component& cam,
                                             const ecs::transform_component& camera_transform,
                                             math::uint2 atlas_resolution);
+        void _prepare_directional_shadows(const camera_component& cam,
+                                          const ecs::transform_component& camera_transform);
 
         struct directional_shadow_map_atlas_slot
         {
@@ -660,6 +718,9 @@ namespace tempest::graphics
             alignas(16) uint32_t directional_light_count;
         };
 
+        // Built by the frame upload pass so shadow cascades can be culled, uploaded by the shadow upload pass
+        shadow_gpu_layout _directional_shadow_gpu_data = {};
+
         struct
         {
             math::vec3<float> ambient_scene_light;
@@ -157,6 +157,7 @@ scoped.group('Tests', function()
         uses {
             'tempest',
             'googletest',
+            'rhi-mock',
         }
 
         linkgroups 'On'
@@ -1,3 +1,4 @@
+#include <tempest/allocation_tracker.hpp>
 #include <tempest/assert.hpp>
 #include <tempest/enum.hpp>
 #include <tempest/frame_graph.hpp>
@@ -5,11 +6,14 @@
 // TODO: Implement deque + queue
 // TODO: Implement unordered_set + set
 #include <tempest/flat_unordered_map.hpp>
+#include <tempest/hash.hpp>
 #include <tempest/int.hpp>
 #include <tempest/math_utils.hpp>
 #include <tempest/rhi_types.hpp>
 #include <tempest/vector.hpp>
 
+#include <chrono>
+
 namespace tempest::graphics
 {
     namespace
@@ -41,6 +45,50 @@ namespace tempest::graphics
             return (access & write_access_mask) != enum_mask<rhi::memory_access>(rhi::memory_access::none);
         }
 
+        variant<external_resource, rhi::buffer_desc, rhi::image_desc> to_creation_info(const resource_entry& resource)
+        {
+            if (holds_alternative<internal_resource>(resource.resource))
+            {
+                const auto& res = get<internal_resource>(resource.resource);
+                if (holds_alternative<rhi::buffer_desc>(res))
+                {
+                    return get<rhi::buffer_desc>(res);
+                }
+                else if (holds_alternative<rhi::image_desc>(res))
+                {
+                    return get<rhi::image_desc>(res);
+                }
+            }
+
+            return get<external_resource>(resource.resource);
+        }
+
+        size_t hash_resource_desc(const resource_entry& resource)
+        {
+            if (holds_alternative<external_resource>(resource.resource))
+            {
+                // Only the kind of import matters, the handle itself is patched into a cached plan
+                return hash_combine(get<external_resource>(resource.resource).index());
+            }
+
+            const auto& res = get<internal_resource>(resource.resource);
+            if (holds_alternative<rhi::buffer_desc>(res))
+            {
+                const auto& desc = get<rhi::buffer_desc>(res);
+                return hash_combine(desc.size, desc.location, to_underlying(desc.usage.value()), desc.access_type,
+                                    desc.access_pattern);
+            }
+
+            const auto& desc = get<rhi::image_desc>(res);
+
+            // Render targets are resized in place, so their extent does not shape the plan
+            const auto width = resource.render_target ? 0u : desc.width;
+            const auto height = resource.render_target ? 0u : desc.height;
+
+            return hash_combine(desc.format, desc.type, width, height, desc.depth, desc.array_layers, desc.mip_levels,
+                                desc.sample_count, desc.tiling, desc.location, to_underlying(desc.usage.value()));
+        }
+
         inline constexpr enum_mask<rhi::memory_access> get_access_mask_for_layout(rhi::image_layout layout)
         {
             switch (layout)
@@ -80,6 +128,57 @@ namespace tempest::graphics
             unreachable();
         }
 
+        constexpr size_t bytes_per_texel(rhi::image_format format)
+        {
+            switch (format)
+            {
+            case rhi::image_format::r8_unorm:
+            case rhi::image_format::r8_snorm:
+            case rhi::image_format::s8_uint:
+                return 1;
+            case rhi::image_format::r16_unorm:
+            case rhi::image_format::r16_snorm:
+            case rhi::image_format::r16_float:
+            case rhi::image_format::rg8_unorm:
+            case rhi::image_format::rg8_snorm:
+            case rhi::image_format::d16_unorm:
+                return 2;
+            case rhi::image_format::r32_float:
+            case rhi::image_format::rg16_unorm:
+            case rhi::image_format::rg16_snorm:
+            case rhi::image_format::rg16_float:
+            case rhi::image_format::rgba8_unorm:
+            case rhi::image_format::rgba8_snorm:
+            case rhi::image_format::rgba8_srgb:
+            case rhi::image_format::bgra8_srgb:
+            case rhi::image_format::d24_unorm:
+            case rhi::image_format::d32_float:
+            case rhi::image_format::d16_unorm_s8_uint:
+            case rhi::image_format::d24_unorm_s8_uint:
+            case rhi::image_format::a2bgr10_unorm_pack32:
+                return 4;
+            case rhi::image_format::rg32_float:
+            case rhi::image_format::rgba16_unorm:
+            case rhi::image_format::rgba16_snorm:
+            case rhi::image_format::rgba16_float:
+            case rhi::image_format::d32_float_s8_uint:
+                return 8;
+            case rhi::image_format::rgba32_float:
+                return 16;
+            }
+
+            unreachable();
+        }
+
+        // Only used to rank resources against each other, the device reports the real requirements
+        constexpr size_t estimate_image_size(const rhi::image_desc& desc)
+        {
+            const auto base_size = static_cast<size_t>(desc.width) * desc.height * desc.depth * desc.array_layers *
+                                   static_cast<size_t>(desc.sample_count) * bytes_per_texel(desc.format);
+
+            // A full mip chain adds about a third
+            return desc.mip_levels > 1 ? base_size + base_size / 3 : base_size;
+        }
     } // namespace
 
     void task_builder::read(graph_resource_handle<rhi::rhi_handle_type::buffer>& handle)
@@ -299,6 +398,11 @@ namespace tempest::graphics
         _resource_fallbacks[p_v] = a_v;
     }
 
+    void task_builder::record_in_parallel()
+    {
+        _record_in_parallel = true;
+    }
+
     void compute_task_builder::prefer_async()
     {
         _prefer_async = true;
@@ -567,6 +671,132 @@ namespace tempest::graphics
         return graph_compiler(tempest::move(_resources), tempest::move(_passes), cfg).compile();
     }
 
+    graph_execution_plan graph_builder::compile(queue_configuration cfg, graph_plan_cache& cache) &&
+    {
+        const auto key = structural_hash(cfg);
+
+        if (auto cached = cache.find(key))
+        {
+            auto plan = *cached;
+
+            for (auto& submission : plan.submissions)
+            {
+                for (auto& pass : submission.passes)
+                {
+                    auto& source = _passes[pass.source_pass];
+                    pass.execution_context = tempest::move(source.execution_context);
+                    pass.enable_condition = tempest::move(source.enable_condition);
+                    pass.fallback_exec = tempest::move(source.fallback_exec);
+                }
+            }
+
+            // Descriptors may differ in the parts left out of the hash, such as render target extents
+            for (auto& resource : plan.resources)
+            {
+                const auto it = tempest::find_if(_resources.cbegin(), _resources.cend(), [&](const auto& entry) {
+                    return entry.handle == resource.handle;
+                });
+
+                if (it != _resources.cend())
+                {
+                    resource.creation_info = to_creation_info(*it);
+                }
+            }
+
+            return plan;
+        }
+
+        auto plan = tempest::move(*this).compile(cfg);
+
+        // The cached copy must not keep the state captured by this builder's callbacks alive
+        auto cached = plan;
+        for (auto& submission : cached.submissions)
+        {
+            for (auto& pass : submission.passes)
+            {
+                pass.execution_context = nullptr;
+                pass.enable_condition = nullptr;
+                pass.fallback_exec = nullptr;
+            }
+        }
+
+        cache.insert(key, tempest::move(cached));
+
+        return plan;
+    }
+
+    uint64_t graph_builder::structural_hash(const queue_configuration& cfg) const
+    {
+        auto structure = hash_combine(cfg.graphics_queues, cfg.compute_queues, cfg.transfer_queues, _resources.size(),
+                                      _passes.size());
+
+        for (const auto& resource : _resources)
+        {
+            structure = hash_combine(structure, bit_cast<uint64_t>(resource.handle), hash_resource_desc(resource),
+                                     static_cast<uint8_t>(resource.per_frame), static_cast<uint8_t>(resource.temporal),
+                                     static_cast<uint8_t>(resource.render_target),
+                                     static_cast<uint8_t>(resource.presentable));
+        }
+
+        for (const auto& pass : _passes)
+        {
+            structure = hash_combine(structure, hash<string>{}(pass.name), pass.type, static_cast<uint8_t>(pass.async),
+                                     static_cast<uint8_t>(pass.record_in_parallel),
+                                     static_cast<uint8_t>(static_cast<bool>(pass.enable_condition)),
+                                     static_cast<uint8_t>(static_cast<bool>(pass.fallback_exec)),
+                                     pass.resource_accesses.size(), pass.explicit_dependencies.size());
+
+            for (const auto& access : pass.resource_accesses)
+            {
+                structure = hash_combine(structure, bit_cast<uint64_t>(access.handle),
+                                         to_underlying(access.stages.value()), to_underlying(access.accesses.value()),
+                                         access.layout);
+            }
+
+            for (const auto& dependency : pass.explicit_dependencies)
+            {
+                structure = hash_combine(structure, hash<string>{}(dependency));
+            }
+
+            // The fallback map is unordered, so its entries are summed rather than chained
+            size_t fallbacks = 0;
+            for (const auto& [produced, alternative] : pass.resource_fallbacks)
+            {
+                fallbacks += hash_combine(produced, alternative);
+            }
+
+            structure = hash_combine(structure, fallbacks);
+        }
+
+        return structure;
+    }
+
+    optional<const graph_execution_plan&> graph_plan_cache::find(uint64_t structural_hash) const noexcept
+    {
+        const auto it = _plans.find(structural_hash);
+        if (it != _plans.cend())
+        {
+            return it->second;
+        }
+
+        return nullopt;
+    }
+
+    void graph_plan_cache::insert(uint64_t structural_hash, graph_execution_plan plan)
+    {
+        _plans[structural_hash] = tempest::move(plan);
+    }
+
+    void graph_plan_cache::clear() noexcept
+    {
+        _plans.clear();
+    }
+
+    size_t graph_plan_cache::size() const noexcept
+    {
+        return _plans.size();
+    }
+
     void graph_builder::_create_pass_entry(string name, work_type type,
                                            function<void(task_execution_context&)> execution_context,
                                            task_builder& builder, bool async)
@@ -576,6 +806,7 @@ namespace tempest::graphics
         pass.type = type;
         pass.execution_context = tempest::move(execution_context);
         pass.async = async;
+        pass.record_in_parallel = builder._record_in_parallel;
         pass.explicit_dependencies = tempest::move(builder.dependencies);
         pass.enable_condition = tempest::move(builder._enable_condition);
         pass.fallback_exec = tempest::move(builder._fallback_exec);
@@ -611,7 +842,10 @@ namespace tempest::graphics
         const auto sorted_passes = _topo_sort_kahns(dependency_graph);
         const auto queue_assignments = _assign_queue_type(live_set);
         const auto submit_batches = _create_submit_batches(sorted_passes, queue_assignments);
-        return _build_execution_plan(submit_batches, live_set.resource_indices);
+        auto plan = _build_execution_plan(submit_batches, live_set.resource_indices);
+        _alias_transient_resources(plan);
+        _plan_barriers(plan);
+        return plan;
     }
 
     graph_compiler::live_set graph_compiler::_gather_live_set() const
@@ -1013,22 +1247,7 @@ namespace tempest::graphics
 
             auto sched_res = scheduled_resource{
                 .handle = copy(resource.handle),
-                .creation_info = [&]() -> variant<external_resource, rhi::buffer_desc, rhi::image_desc> {
-                    if (holds_alternative<internal_resource>(resource.resource))
-                    {
-                        const auto& res = get<internal_resource>(resource.resource);
-                        if (holds_alternative<rhi::buffer_desc>(res))
-                        {
-                            return get<rhi::buffer_desc>(res);
-                        }
-                        else if (holds_alternative<rhi::image_desc>(res))
-                        {
-                            return get<rhi::image_desc>(res);
-                        }
-                    }
-
-                    return get<external_resource>(resource.resource);
-                }(),
+                .creation_info = to_creation_info(resource),
                 .per_frame = resource.per_frame,
                 .temporal = resource.temporal,
                 .render_target = resource.render_target,
@@ -1100,6 +1319,7 @@ namespace tempest::graphics
                 scheduled_pass sched_pass;
                 sched_pass.name = pass.name;
                 sched_pass.type = pass.type;
+                sched_pass.source_pass = pass_idx;
 
                 for (auto& access : pass.resource_accesses)
                 {
@@ -1189,6 +1409,7 @@ namespace tempest::graphics
                 sched_pass.enable_condition = pass.enable_condition;
                 sched_pass.fallback_exec = pass.fallback_exec;
                 sched_pass.resource_fallbacks = pass.resource_fallbacks;
+                sched_pass.record_in_parallel = pass.record_in_parallel;
                 instructions.passes.push_back(move(sched_pass));
             }
 
@@ -1200,142 +1421,706 @@ namespace tempest::graphics
         return plan;
     }
 
-    graph_executor::graph_executor(rhi::device& device) : _device{&device}
+    void graph_compiler::_alias_transient_resources(graph_execution_plan& plan) const
     {
-    }
+        struct resource_lifetime
+        {
+            size_t first_pass = numeric_limits<size_t>::max();
+            size_t last_pass = 0;
+            work_type queue = work_type::unknown;
+            bool shared_across_queues = false;
+            bool reads_prior_contents = false;
+            bool conditional = false;
+        };
 
-    void graph_executor::execute()
-    {
-        // Get all queues that need to be waited on
-        const auto frame_in_flight = _current_frame % _device->frames_in_flight();
-        auto fences_to_wait = vector<rhi::typed_rhi_handle<rhi::rhi_handle_type::fence>>{};
-        for (auto& [type, fence_info] : _per_frame_fences[frame_in_flight].frame_complete_fence)
+        auto lifetimes = flat_unordered_map<uint64_t, resource_lifetime>{}; // handle -> lifetime
+        auto passes = vector<scheduled_pass*>{};
+
+        for (auto& submission : plan.submissions)
         {
-            if (fence_info.queue_used)
+            for (auto& pass : submission.passes)
             {
-                fences_to_wait.push_back(fence_info.fence);
-                fence_info.queue_used = false;
+                const auto pass_index = passes.size();
+                passes.push_back(&pass);
+
+                // A skipped pass leaves its outputs unwritten and redirects readers to the fallbacks, so the lifetimes
+                // seen here cannot be relied on
+                const auto conditional = static_cast<bool>(pass.enable_condition);
+
+                for (const auto& access : pass.accesses)
+                {
+                    auto& lifetime = lifetimes[access.handle.handle];
+                    if (lifetime.first_pass == numeric_limits<size_t>::max())
+                    {
+                        lifetime.first_pass = pass_index;
+                        lifetime.queue = submission.type;
+                    }
+                    else if (lifetime.queue != submission.type)
+                    {
+                        lifetime.shared_across_queues = true;
+                    }
+
+                    lifetime.last_pass = pass_index;
+                    lifetime.conditional |= conditional;
+
+                    // Version zero is whatever the resource held before the first write of the frame
+                    if (access.handle.version == 0)
+                    {
+                        lifetime.reads_prior_contents = true;
+                    }
+                }
+
+                for (const auto& [produced, alternative] : pass.resource_fallbacks)
+                {
+                    lifetimes[bit_cast<base_graph_resource_handle>(produced).handle].conditional = true;
+                    lifetimes[bit_cast<base_graph_resource_handle>(alternative).handle].conditional = true;
+                }
             }
         }
 
-        // TODO: Restructure so only the graphics/present fence is waited on here, and all others are waited on
-        // just before their first use in the frame. This can also allow deferral of work queue reset and fence reset
-        // until just before first use in the frame (not first submission on the queue, but first command buffer usage)
-        if (!fences_to_wait.empty())
+        struct alias_candidate
         {
-            _device->wait(fences_to_wait);
-        }
-
-        _device->release_resources();
+            size_t resource_index;
+            size_t first_pass;
+            size_t last_pass;
+            work_type queue;
+            rhi::rhi_handle_type type;
+            size_t size;
+        };
 
-        _device->get_primary_work_queue().reset(frame_in_flight);
-        _device->get_dedicated_compute_queue().reset(frame_in_flight);
-        _device->get_dedicated_transfer_queue().reset(frame_in_flight);
+        // Ordered by first use
+        auto candidates = vector<alias_candidate>{};
 
-        const auto acquired_swapchains = _acquire_swapchain_images();
-        const bool headless = _external_surfaces.empty();
-        if (headless || !acquired_swapchains.empty())
+        for (size_t resource_index = 0; resource_index < plan.resources.size(); ++resource_index)
         {
-            if (!fences_to_wait.empty())
+            const auto& resource = plan.resources[resource_index];
+            if (resource.temporal || resource.presentable)
             {
-                _device->reset(fences_to_wait);
+                continue;
             }
 
-            _wait_for_swapchain_acquire(acquired_swapchains);
-            _execute_plan(acquired_swapchains);
-            if (!headless)
+            const auto lifetime_it = lifetimes.find(resource.handle.handle);
+            if (lifetime_it == lifetimes.end())
             {
-                _present_swapchain_images(acquired_swapchains);
+                continue;
             }
-        }
 
-        _device->finish_frame();
-    }
+            const auto& lifetime = lifetime_it->second;
+            if (lifetime.first_pass == numeric_limits<size_t>::max() || lifetime.shared_across_queues ||
+                lifetime.reads_prior_contents || lifetime.conditional)
+            {
+                continue;
+            }
 
-    void graph_executor::set_execution_plan(graph_execution_plan plan)
-    {
-        _destroy_owned_resources();
-        _plan = tempest::move(plan);
-        _construct_owned_resources();
-    }
+            auto candidate = alias_candidate{
+                .resource_index = resource_index,
+                .first_pass = lifetime.first_pass,
+                .last_pass = lifetime.last_pass,
+                .queue = lifetime.queue,
+                .type = rhi::rhi_handle_type::buffer,
+                .size = 0,
+            };
 
-    rhi::typed_rhi_handle<rhi::rhi_handle_type::buffer> graph_executor::get_buffer(
-        const base_graph_resource_handle& handle) const
-    {
-        if (get_resource_type(handle) != rhi::rhi_handle_type::buffer)
-        {
-            return rhi::typed_rhi_handle<rhi::rhi_handle_type::buffer>::null_handle;
-        }
+            if (const auto buffer_desc = get_if<rhi::buffer_desc>(&resource.creation_info))
+            {
+                // Per frame buffers are written by the host at a per frame offset
+                if (resource.per_frame || buffer_desc->location != rhi::memory_location::device)
+                {
+                    continue;
+                }
 
-        uint64_t target_handle = handle.handle;
+                candidate.size = buffer_desc->size;
+            }
+            else if (const auto image_desc = get_if<rhi::image_desc>(&resource.creation_info))
+            {
+                if (image_desc->location != rhi::memory_location::device)
+                {
+                    continue;
+                }
 
-        auto pack = [](const base_graph_resource_handle& h) { return bit_cast<uint64_t>(h); };
+                candidate.type = rhi::rhi_handle_type::image;
+                candidate.size = estimate_image_size(*image_desc);
+            }
+            else
+            {
+                continue;
+            }
 
-        // Resolve aliases
-        uint64_t current_val = pack(handle);
-        auto alias = _execution_alias_map.find(current_val);
-        while (alias != _execution_alias_map.end())
-        {
-            current_val = alias->second;
-            base_graph_resource_handle aliased_handle;
-            aliased_handle = bit_cast<base_graph_resource_handle>(current_val);
-            target_handle = aliased_handle.handle;
-            alias = _execution_alias_map.find(current_val);
+            const auto insert_it = tempest::find_if(candidates.begin(), candidates.end(), [&](const auto& other) {
+                return other.first_pass > candidate.first_pass;
+            });
+            candidates.insert(insert_it, candidate);
         }
 
-        const auto it = _all_buffers.find(target_handle);
-        if (it != _all_buffers.cend())
+        struct heap_assignment
         {
-            return it->second;
-        }
-        return rhi::typed_rhi_handle<rhi::rhi_handle_type::buffer>::null_handle;
-    }
-
-    rhi::typed_rhi_handle<rhi::rhi_handle_type::image> graph_executor::get_image(
-        const base_graph_resource_handle& handle) const
-    {
-        uint64_t target_handle = handle.handle;
-        rhi::rhi_handle_type target_type = get_resource_type(handle);
+            transient_heap heap;
+            size_t last_pass;
+            size_t size;
+        };
 
-        auto pack = [](const base_graph_resource_handle& h) { return bit_cast<uint64_t>(h); };
+        auto assignments = vector<heap_assignment>{};
 
-        // Resolve aliases
-        uint64_t current_val = pack(handle);
-        auto alias = _execution_alias_map.find(current_val);
-        while (alias != _execution_alias_map.end())
+        for (const auto& candidate : candidates)
         {
-            current_val = alias->second;
-            base_graph_resource_handle aliased_handle;
-            aliased_handle = bit_cast<base_graph_resource_handle>(current_val);
-            target_handle = aliased_handle.handle;
-            target_type = get_resource_type(aliased_handle);
-            alias = _execution_alias_map.find(current_val);
-        }
+            // Every member is placed at the start of the heap, so pick the heap closest in size to waste the least
+            const auto distance = [&](const heap_assignment& assignment) {
+                return assignment.size > candidate.size ? assignment.size - candidate.size
+                                                        : candidate.size - assignment.size;
+            };
 
-        if (target_type == rhi::rhi_handle_type::image)
-        {
-            const auto it = _all_images.find(target_handle);
-            if (it != _all_images.cend())
+            heap_assignment* best = nullptr;
+            for (auto& assignment : assignments)
             {
-                return it->second;
+                if (assignment.heap.queue != candidate.queue || assignment.heap.resource_type != candidate.type ||
+                    assignment.last_pass >= candidate.first_pass)
+                {
+                    continue;
+                }
+
+                if (best == nullptr || distance(assignment) < distance(*best))
+                {
+                    best = &assignment;
+                }
+            }
+
+            if (best == nullptr)
+            {
+                assignments.push_back({
+                    .heap =
+                        {
+                            .queue = candidate.queue,
+                            .resource_type = candidate.type,
+                            .resources = {},
+                        },
+                    .last_pass = 0,
+                    .size = 0,
+                });
+                best = &assignments.back();
             }
+
+            best->heap.resources.push_back(copy(plan.resources[candidate.resource_index].handle));
+            best->last_pass = candidate.last_pass;
+            best->size = tempest::max(best->size, candidate.size);
         }
-        else if (target_type == rhi::rhi_handle_type::render_surface)
+
+        for (auto& assignment : assignments)
         {
-            const auto it = _current_swapchain_images.find(target_handle);
-            if (it != _current_swapchain_images.cend())
+            // A heap with a single member saves nothing over a dedicated allocation
+            const auto member_count = assignment.heap.resources.size();
+            if (member_count < 2)
             {
-                return it->second;
+                continue;
             }
-        }
 
-        return rhi::typed_rhi_handle<rhi::rhi_handle_type::image>::null_handle;
+            const auto heap_index = static_cast<uint32_t>(plan.transient_heaps.size());
+
+            for (size_t member = 0; member < member_count; ++member)
+            {
+                const auto& handle = assignment.heap.resources[member];
+
+                auto resource_it = tempest::find_if(plan.resources.begin(), plan.resources.end(), [&](const auto& res) {
+                    return res.handle.handle == handle.handle && res.handle.type == handle.type;
+                });
+                resource_it->heap_index = heap_index;
+
+                // The first member takes over the memory from the last member of the previous frame
+                const auto& before = assignment.heap.resources[(member + member_count - 1) % member_count];
+                passes[lifetimes[handle.handle].first_pass]->aliasing_barriers.push_back({
+                    .before = copy(before),
+                    .after = copy(handle),
+                });
+            }
+
+            plan.transient_heaps.push_back(tempest::move(assignment.heap));
+        }
     }
 
-    uint64_t graph_executor::get_current_frame_resource_offset(
-        graph_resource_handle<rhi::rhi_handle_type::buffer> buffer) const
+    void graph_compiler::_plan_barriers(graph_execution_plan& plan) const
     {
-        const auto it = tempest::find_if(_plan->resources.cbegin(), _plan->resources.cend(), [&](const auto& res) {
+        struct resource_state
+        {
+            work_type queue;
+            enum_mask<rhi::pipeline_stage> stages;
+            enum_mask<rhi::memory_access> accesses;
+            rhi::image_layout layout;
+            bool accessed_this_frame;
+        };
+
+        struct write_tracking
+        {
+            enum_mask<rhi::pipeline_stage> write_stages;
+            enum_mask<rhi::memory_access> write_accesses;
+            enum_mask<rhi::pipeline_stage> read_stages_seen;
+            enum_mask<rhi::memory_access> read_accesses_seen;
+        };
+
+        auto states = flat_unordered_map<uint64_t, resource_state>{}; // handle -> state
+        auto writes = flat_unordered_map<uint64_t, write_tracking>{}; // handle -> unwaited writes
+
+        const auto first_use_src_stages =
+            make_enum_mask(rhi::pipeline_stage::all_transfer, rhi::pipeline_stage::color_attachment_output);
+        const auto first_use_src_access =
+            make_enum_mask(rhi::memory_access::transfer_write, rhi::memory_access::color_attachment_write);
+        const auto host_stage = make_enum_mask(rhi::pipeline_stage::host);
+
+        const auto is_per_frame = [&](const base_graph_resource_handle& handle) {
+            const auto it = tempest::find_if(plan.resources.cbegin(), plan.resources.cend(), [&](const auto& res) {
+                return res.handle.handle == handle.handle && res.handle.type == handle.type;
+            });
+            return it != plan.resources.cend() && it->per_frame &&
+                   holds_alternative<rhi::buffer_desc>(it->creation_info);
+        };
+
+        // The first frame establishes the state resources carry into the next one. Barriers of the second frame are
+        // the ones recorded every frame from then on.
+        for (int frame = 0; frame < 2; ++frame)
+        {
+            const bool record = frame == 1;
+
+            for (auto& [_, state] : states)
+            {
+                state.accessed_this_frame = false;
+            }
+
+            for (auto& submission : plan.submissions)
+            {
+                for (auto& pass : submission.passes)
+                {
+                    auto image_barriers = vector<planned_image_barrier>{};
+                    auto buffer_barriers = vector<planned_buffer_barrier>{};
+
+                    const auto find_image_barrier = [&](const base_graph_resource_handle& handle) {
+                        return tempest::find_if(image_barriers.begin(), image_barriers.end(), [&](const auto& barrier) {
+                            return barrier.handle.handle == handle.handle;
+                        });
+                    };
+
+                    const auto find_buffer_barrier = [&](const base_graph_resource_handle& handle) {
+                        return tempest::find_if(buffer_barriers.begin(), buffer_barriers.end(),
+                                                [&](const auto& barrier) {
+                                                    return barrier.handle.handle == handle.handle;
+                                                });
+                    };
+
+                    for (const auto& resource : pass.accesses)
+                    {
+                        const auto res_type = get_resource_type(resource.handle);
+                        const auto is_image =
+                            res_type == rhi::rhi_handle_type::image || res_type == rhi::rhi_handle_type::render_surface;
+
+                        const auto prior_it = states.find(resource.handle.handle);
+                        const auto first_access_in_frame =
+                            prior_it == states.end() || !prior_it->second.accessed_this_frame;
+
+                        if (is_image)
+                        {
+                            if (auto existing = find_image_barrier(resource.handle); existing != image_barriers.end())
+                            {
+                                TEMPEST_ASSERT(existing->new_layout == resource.layout);
+                                existing->dst_stages |= resource.stages;
+                                existing->dst_access |= resource.accesses;
+                                continue;
+                            }
+                        }
+                        else if (auto existing = find_buffer_barrier(resource.handle);
+                                 existing != buffer_barriers.end())
+                        {
+                            existing->dst_stages |= resource.stages;
+                            existing->dst_access |= resource.accesses;
+
+                            // Keep the unwaited write tracking in step with the access
+                            if (auto write_it = writes.find(resource.handle.handle); write_it != writes.end())
+                            {
+                                if (is_write_access(resource.accesses))
+                                {
+                                    write_it->second.read_stages_seen = enum_mask<rhi::pipeline_stage>();
+                                    write_it->second.read_accesses_seen = enum_mask<rhi::memory_access>();
+                                    write_it->second.write_stages |= resource.stages;
+                                    write_it->second.write_accesses |= resource.accesses;
+                                }
+
+                                if (is_read_access(resource.accesses))
+                                {
+                                    write_it->second.read_stages_seen |= resource.stages;
+                                    write_it->second.read_accesses_seen |= resource.accesses;
+                                }
+                            }
+                            continue;
+                        }
+
+                        const auto aliasing_it = tempest::find_if(
+                            pass.aliasing_barriers.cbegin(), pass.aliasing_barriers.cend(),
+                            [&](const auto& barrier) { return barrier.after.handle == resource.handle.handle; });
+                        if (aliasing_it != pass.aliasing_barriers.cend())
+                        {
+                            // The memory was last used by another resource of the same heap. Its contents are
+                            // discarded, only the work of the previous occupant has to complete.
+                            const auto occupant_it = states.find(aliasing_it->before.handle);
+                            const auto src_stages = occupant_it != states.end()
+                                                        ? occupant_it->second.stages
+                                                        : make_enum_mask(rhi::pipeline_stage::top);
+                            const auto src_access = occupant_it != states.end()
+                                                        ? occupant_it->second.accesses
+                                                        : make_enum_mask(rhi::memory_access::none);
+
+                            if (is_image)
+                            {
+                                image_barriers.push_back({
+                                    .handle = resource.handle,
+                                    .old_layout = rhi::image_layout::undefined,
+                                    .new_layout = resource.layout,
+                                    .src_stages = src_stages,
+                                    .src_access = src_access,
+                                    .dst_stages = resource.stages,
+                                    .dst_access = resource.accesses,
+                                    .src_queue = work_type::unknown,
+                                    .dst_queue = work_type::unknown,
+                                    .first_access_in_frame = false,
+                                });
+                            }
+                            else
+                            {
+                                buffer_barriers.push_back({
+                                    .handle = resource.handle,
+                                    .src_stages = src_stages,
+                                    .src_access = src_access,
+                                    .dst_stages = resource.stages,
+                                    .dst_access = resource.accesses,
+                                    .src_queue = work_type::unknown,
+                                    .dst_queue = work_type::unknown,
+                                    .per_frame = false,
+                                });
+
+                                // Writes from the previous frame were to memory that has since been reused
+                                writes[resource.handle.handle] = write_tracking{
+                                    .write_stages = is_write_access(resource.accesses)
+                                                        ? resource.stages
+                                                        : enum_mask<rhi::pipeline_stage>(),
+                                    .write_accesses = is_write_access(resource.accesses)
+                                                          ? resource.accesses
+                                                          : enum_mask<rhi::memory_access>(),
+                                    .read_stages_seen = enum_mask<rhi::pipeline_stage>(),
+                                    .read_accesses_seen = enum_mask<rhi::memory_access>(),
+                                };
+                            }
+
+                            continue;
+                        }
+
+                        // Swapchain images are acquired in an undefined state every frame
+                        const auto has_prior = prior_it != states.end() &&
+                                               (res_type != rhi::rhi_handle_type::render_surface ||
+                                                prior_it->second.accessed_this_frame);
+
+                        if (!has_prior)
+                        {
+                            if (is_image)
+                            {
+                                image_barriers.push_back({
+                                    .handle = resource.handle,
+                                    .old_layout = rhi::image_layout::undefined,
+                                    .new_layout = resource.layout,
+                                    .src_stages = first_use_src_stages,
+                                    .src_access = first_use_src_access,
+                                    .dst_stages = resource.stages,
+                                    .dst_access = resource.accesses,
+                                    .src_queue = work_type::unknown,
+                                    .dst_queue = work_type::unknown,
+                                    .first_access_in_frame = false,
+                                });
+                            }
+                            continue;
+                        }
+
+                        const auto& prior = prior_it->second;
+                        const auto cross_queue = prior.queue != submission.type;
+                        const auto src_queue = cross_queue ? prior.queue : work_type::unknown;
+                        const auto dst_queue = cross_queue ? submission.type : work_type::unknown;
+                        const auto after_host = (prior.stages & host_stage) == host_stage && !cross_queue;
+
+                        if (is_image)
+                        {
+                            // Host accesses are made visible by the submission itself
+                            if (after_host && prior.layout == resource.layout)
+                            {
+                                continue;
+                            }
+
+                            image_barriers.push_back({
+                                .handle = resource.handle,
+                                .old_layout = prior.layout,
+                                .new_layout = resource.layout,
+                                .src_stages = prior.stages,
+                                .src_access = prior.accesses,
+                                .dst_stages = resource.stages,
+                                .dst_access = resource.accesses,
+                                .src_queue = src_queue,
+                                .dst_queue = dst_queue,
+                                .first_access_in_frame = first_access_in_frame,
+                            });
+                            continue;
+                        }
+
+                        // Search for prior write accesses that have not been waited on yet
+                        auto existing_write_stages = enum_mask<rhi::pipeline_stage>();
+                        auto existing_write_accesses = enum_mask<rhi::memory_access>();
+
+                        if (auto write_it = writes.find(resource.handle.handle); write_it != writes.end())
+                        {
+                            auto& write_usage = write_it->second;
+                            if ((write_usage.read_accesses_seen & resource.accesses) != resource.accesses ||
+                                (write_usage.read_stages_seen & resource.stages) != resource.stages)
+                            {
+                                existing_write_stages |= write_usage.write_stages;
+                                existing_write_accesses |= write_usage.write_accesses;
+                            }
+
+                            if (is_write_access(resource.accesses))
+                            {
+                                write_usage.read_accesses_seen = enum_mask<rhi::memory_access>();
+                                write_usage.read_stages_seen = enum_mask<rhi::pipeline_stage>();
+                                write_usage.write_accesses |= resource.accesses;
+                                write_usage.write_stages |= resource.stages;
+                            }
+
+                            if (is_read_access(resource.accesses))
+                            {
+                                write_usage.read_accesses_seen |= resource.accesses;
+                                write_usage.read_stages_seen |= resource.stages;
+                            }
+                        }
+                        else
+                        {
+                            writes[resource.handle.handle] = write_tracking{
+                                .write_stages = is_write_access(resource.accesses) ? resource.stages
+                                                                                   : enum_mask<rhi::pipeline_stage>(),
+                                .write_accesses = is_write_access(resource.accesses) ? resource.accesses
+                                                                                     : enum_mask<rhi::memory_access>(),
+                                .read_stages_seen = is_read_access(resource.accesses)
+                                                        ? resource.stages
+                                                        : enum_mask<rhi::pipeline_stage>(),
+                                .read_accesses_seen = is_read_access(resource.accesses)
+                                                          ? resource.accesses
+                                                          : enum_mask<rhi::memory_access>(),
+                            };
+                        }
+
+                        if (after_host)
+                        {
+                            continue;
+                        }
+
+                        buffer_barriers.push_back({
+                            .handle = resource.handle,
+                            .src_stages = existing_write_stages | prior.stages,
+                            .src_access = existing_write_accesses | prior.accesses,
+                            .dst_stages = resource.stages,
+                            .dst_access = resource.accesses,
+                            .src_queue = src_queue,
+                            .dst_queue = dst_queue,
+                            .per_frame = !cross_queue && is_per_frame(resource.handle),
+                        });
+                    }
+
+                    // Update the last used state for each resource
+                    for (const auto& resource : pass.accesses)
+                    {
+                        states[resource.handle.handle] = resource_state{
+                            .queue = submission.type,
+                            .stages = resource.stages,
+                            .accesses = resource.accesses,
+                            .layout = resource.layout,
+                            .accessed_this_frame = true,
+                        };
+                    }
+
+                    if (record)
+                    {
+                        pass.image_barriers = tempest::move(image_barriers);
+                        pass.buffer_barriers = tempest::move(buffer_barriers);
+                    }
+                }
+            }
+
+            if (!record)
+            {
+                continue;
+            }
+
+            // Swapchain images are handed back for presentation in whatever state the last pass left them in
+            for (const auto& resource : plan.resources)
+            {
+                if (get_resource_type(resource.handle) != rhi::rhi_handle_type::render_surface)
+                {
+                    continue;
+                }
+
+                const auto state_it = states.find(resource.handle.handle);
+                const auto used = state_it != states.end() && state_it->second.accessed_this_frame;
+
+                plan.present_barriers.push_back({
+                    .handle = resource.handle,
+                    .old_layout = used ? state_it->second.layout : rhi::image_layout::undefined,
+                    .new_layout = rhi::image_layout::present,
+                    .src_stages = used ? state_it->second.stages : make_enum_mask(rhi::pipeline_stage::bottom),
+                    .src_access = used ? state_it->second.accesses : make_enum_mask(rhi::memory_access::none),
+                    .dst_stages = make_enum_mask(rhi::pipeline_stage::top),
+                    .dst_access = make_enum_mask(rhi::memory_access::none),
+                    .src_queue = work_type::unknown,
+                    .dst_queue = work_type::unknown,
+                    .first_access_in_frame = false,
+                });
+            }
+        }
+    }
+
+    graph_executor::graph_executor(rhi::device& device, core::job_system* jobs)
+        : _device{&device}, _jobs{jobs},
+          _frame_arena{_frame_arena_bytes_per_thread, device.frames_in_flight()}
+    {
+    }
+
+    void graph_executor::execute()
+    {
+        core::allocation_scope allocation_scope("frame_graph");
+
+        const auto frame_start = std::chrono::steady_clock::now();
+        const auto frame_in_flight = _current_frame % _device->frames_in_flight();
+
+        _pacing_stats.fence_wait_ns = 0;
+        _retired_queues.clear();
+        _reset_queues.clear();
+
+        // Only the queue acquiring and presenting swapchain images is waited on up front, every other queue is waited
+        // on and reset right before its first command list of the frame
+        _prepare_queue(work_type::graphics, frame_in_flight);
+
+        // Scratch memory of the last use of this frame in flight is only read while recording, which has finished
+        _frame_arena.begin_frame(static_cast<uint32_t>(frame_in_flight));
+
+        const auto acquired_swapchains = _acquire_swapchain_images();
+        const bool headless = _external_surfaces.empty();
+        if (headless || !acquired_swapchains.empty())
+        {
+            _wait_for_swapchain_acquire(acquired_swapchains);
+            _execute_plan(acquired_swapchains);
+            if (!headless)
+            {
+                _present_swapchain_images(acquired_swapchains);
+            }
+        }
+
+        // Queues without work this frame still have to retire this frame in flight before deferred deletions are
+        // released
+        _retire_queue(work_type::compute, frame_in_flight);
+        _retire_queue(work_type::transfer, frame_in_flight);
+        _device->release_resources();
+
+        _device->finish_frame();
+
+        _pacing_stats.frame_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - frame_start)
+                .count());
+
+        core::allocation_tracker::end_frame();
+    }
+
+    core::frame_arena& graph_executor::get_frame_arena() noexcept
+    {
+        return _frame_arena;
+    }
+
+    const frame_pacing_stats& graph_executor::get_frame_pacing_stats() const noexcept
+    {
+        return _pacing_stats;
+    }
+
+    void graph_executor::set_execution_plan(graph_execution_plan plan)
+    {
+        _destroy_owned_resources();
+        _plan = tempest::move(plan);
+        _construct_owned_resources();
+        _plan_fence_waits();
+    }
+
+    rhi::typed_rhi_handle<rhi::rhi_handle_type::buffer> graph_executor::get_buffer(
+        const base_graph_resource_handle& handle) const
+    {
+        if (get_resource_type(handle) != rhi::rhi_handle_type::buffer)
+        {
+            return rhi::typed_rhi_handle<rhi::rhi_handle_type::buffer>::null_handle;
+        }
+
+        uint64_t target_handle = handle.handle;
+
+        auto pack = [](const base_graph_resource_handle& h) { return bit_cast<uint64_t>(h); };
+
+        // Resolve aliases
+        uint64_t current_val = pack(handle);
+        auto alias = _execution_alias_map.find(current_val);
+        while (alias != _execution_alias_map.end())
+        {
+            current_val = alias->second;
+            base_graph_resource_handle aliased_handle;
+            aliased_handle = bit_cast<base_graph_resource_handle>(current_val);
+            target_handle = aliased_handle.handle;
+            alias = _execution_alias_map.find(current_val);
+        }
+
+        const auto it = _all_buffers.find(target_handle);
+        if (it != _all_buffers.cend())
+        {
+            return it->second;
+        }
+        return rhi::typed_rhi_handle<rhi::rhi_handle_type::buffer>::null_handle;
+    }
+
+    rhi::typed_rhi_handle<rhi::rhi_handle_type::image> graph_executor::get_image(
+        const base_graph_resource_handle& handle) const
+    {
+        uint64_t target_handle = handle.handle;
+        rhi::rhi_handle_type target_type = get_resource_type(handle);
+
+        auto pack = [](const base_graph_resource_handle& h) { return bit_cast<uint64_t>(h); };
+
+        // Resolve aliases
+        uint64_t current_val = pack(handle);
+        auto alias = _execution_alias_map.find(current_val);
+        while (alias != _execution_alias_map.end())
+        {
+            current_val = alias->second;
+            base_graph_resource_handle aliased_handle;
+            aliased_handle = bit_cast<base_graph_resource_handle>(current_val);
+            target_handle = aliased_handle.handle;
+            target_type = get_resource_type(aliased_handle);
+            alias = _execution_alias_map.find(current_val);
+        }
+
+        if (target_type == rhi::rhi_handle_type::image)
+        {
+            const auto it = _all_images.find(target_handle);
+            if (it != _all_images.cend())
+            {
+                return it->second;
+            }
+        }
+        else if (target_type == rhi::rhi_handle_type::render_surface)
+        {
+            const auto it = _current_swapchain_images.find(target_handle);
+            if (it != _current_swapchain_images.cend())
+            {
+                return it->second;
+            }
+        }
+
+        return rhi::typed_rhi_handle<rhi::rhi_handle_type::image>::null_handle;
+    }
+
+    uint64_t graph_executor::get_current_frame_resource_offset(
+        graph_resource_handle<rhi::rhi_handle_type::buffer> buffer) const
+    {
+        const auto it = tempest::find_if(_plan->resources.cbegin(), _plan->resources.cend(), [&](const auto& res) {
             return res.handle.handle == buffer.handle && res.handle.type == buffer.type;
         });
 
@@ -1415,35 +2200,77 @@ namespace tempest::graphics
     void graph_executor::resize_render_target(graph_resource_handle<rhi::rhi_handle_type::image> img, uint32_t width,
                                               uint32_t height)
     {
-        const auto it = tempest::find_if(_plan->resources.cbegin(), _plan->resources.cend(), [&](const auto& res) {
-            return res.handle.handle == img.handle && res.handle.type == img.type;
-        });
+        resize_render_targets(span<const graph_resource_handle<rhi::rhi_handle_type::image>>(&img, 1), width, height);
+    }
 
-        if (it == _plan->resources.cend() || !holds_alternative<rhi::image_desc>(it->creation_info))
+    void graph_executor::resize_render_targets(span<const graph_resource_handle<rhi::rhi_handle_type::image>> images,
+                                               uint32_t width, uint32_t height)
+    {
+        auto resized_heaps = vector<uint32_t>{};
+        auto resized = false;
+
+        for (const auto& img : images)
         {
-            return;
-        }
+            const auto it = tempest::find_if(_plan->resources.begin(), _plan->resources.end(), [&](const auto& res) {
+                return res.handle.handle == img.handle && res.handle.type == img.type;
+            });
 
-        const auto& image_desc = get<rhi::image_desc>(it->creation_info);
+            if (it == _plan->resources.end() || !holds_alternative<rhi::image_desc>(it->creation_info))
+            {
+                continue;
+            }
 
-        // Find and destroy the old image
-        const auto old_image_it = _owned_images.find(img.handle);
-        if (old_image_it != _owned_images.cend())
-        {
-            _device->destroy_image(old_image_it->second);
-            _owned_images.erase(old_image_it);
+            auto& image_desc = get<rhi::image_desc>(it->creation_info);
+            if (image_desc.width == width && image_desc.height == height)
+            {
+                continue;
+            }
+
+            image_desc.width = width;
+            image_desc.height = height;
+            resized = true;
+
+            if (it->heap_index != no_transient_heap)
+            {
+                // Every member shares the same memory, so the heap is rebuilt once all of its members are patched
+                if (tempest::find(resized_heaps.cbegin(), resized_heaps.cend(), it->heap_index) ==
+                    resized_heaps.cend())
+                {
+                    resized_heaps.push_back(it->heap_index);
+                }
+                continue;
+            }
+
+            // Find and destroy the old image
+            const auto old_image_it = _owned_images.find(img.handle);
+            if (old_image_it != _owned_images.cend())
+            {
+                _device->destroy_image(old_image_it->second);
+                _owned_images.erase(old_image_it);
+            }
+
+            auto new_image = _device->create_image(image_desc);
+            _owned_images[img.handle] = new_image;
+            _all_images[img.handle] = new_image;
+
+            _reset_resources.push_back(img.handle);
         }
 
-        // Create new image with updated dimensions
-        auto new_desc = image_desc;
-        new_desc.width = width;
-        new_desc.height = height;
+        for (auto heap_index : resized_heaps)
+        {
+            _destroy_transient_heap(heap_index);
+            _construct_transient_heap(heap_index);
 
-        auto new_image = _device->create_image(new_desc);
-        _owned_images[img.handle] = new_image;
-        _all_images[img.handle] = new_image;
+            for (const auto& member : _plan->transient_heaps[heap_index].resources)
+            {
+                _reset_resources.push_back(member.handle);
+            }
+        }
 
-        _current_resource_states.erase(img.handle);
+        if (resized)
+        {
+            _bake_barriers();
+        }
     }
 
     rhi::typed_rhi_handle<rhi::rhi_handle_type::render_surface> graph_executor::get_render_surface(
@@ -1497,12 +2324,23 @@ namespace tempest::graphics
 
                 get<rhi::buffer_desc>(resource.creation_info).size = aligned_size;
 
+                // Aliased resources are placed once the requirements of every heap member are known
+                if (resource.heap_index != no_transient_heap)
+                {
+                    continue;
+                }
+
                 auto buffer = _device->create_buffer(desc);
                 _owned_buffers[resource.handle.handle] = buffer;
                 _all_buffers[resource.handle.handle] = buffer;
             }
             else if (holds_alternative<rhi::image_desc>(resource.creation_info))
             {
+                if (resource.heap_index != no_transient_heap)
+                {
+                    continue;
+                }
+
                 const auto& desc = get<rhi::image_desc>(resource.creation_info);
                 auto image = _device->create_image(desc);
                 _owned_images[resource.handle.handle] = image;
@@ -1510,6 +2348,21 @@ namespace tempest::graphics
             }
         }
 
+        _transient_heaps.resize(_plan->transient_heaps.size(),
+                                rhi::typed_rhi_handle<rhi::rhi_handle_type::memory_heap>::null_handle);
+        for (size_t heap_index = 0; heap_index < _plan->transient_heaps.size(); ++heap_index)
+        {
+            _construct_transient_heap(heap_index);
+        }
+
+        // Nothing has been recorded against the new resources yet
+        for (const auto& resource : _plan->resources)
+        {
+            _reset_resources.push_back(resource.handle.handle);
+        }
+
+        _bake_barriers();
+
         // Construct the queue timelines
         for (size_t idx = 0; idx < _plan->queue_cfg.graphics_queues; ++idx)
         {
@@ -1564,50 +2417,374 @@ namespace tempest::graphics
                 };
             }
 
-            if (_plan->queue_cfg.transfer_queues > 0)
-            {
-                _per_frame_fences[idx].frame_complete_fence[work_type::transfer] = {
-                    .fence = _device->create_fence({.signaled = false}),
-                    .queue_used = false,
-                };
-            }
+            if (_plan->queue_cfg.transfer_queues > 0)
+            {
+                _per_frame_fences[idx].frame_complete_fence[work_type::transfer] = {
+                    .fence = _device->create_fence({.signaled = false}),
+                    .queue_used = false,
+                };
+            }
+        }
+    }
+
+    void graph_executor::_destroy_owned_resources()
+    {
+        for (const auto& [handle, buffer] : _owned_buffers)
+        {
+            _device->destroy_buffer(buffer);
+        }
+
+        for (const auto& [handle, image] : _owned_images)
+        {
+            _device->destroy_image(image);
+        }
+
+        for (const auto& heap : _transient_heaps)
+        {
+            if (heap != rhi::typed_rhi_handle<rhi::rhi_handle_type::memory_heap>::null_handle)
+            {
+                _device->destroy_memory_heap(heap);
+            }
+        }
+
+        for (const auto& [type, timelines] : _queue_timelines)
+        {
+            for (const auto& timeline : timelines)
+            {
+                _device->destroy_semaphore(timeline.sem);
+            }
+        }
+
+        for (auto& frame_fences : _per_frame_fences)
+        {
+            for (const auto& [type, exec_fence] : frame_fences.frame_complete_fence)
+            {
+                _device->destroy_fence(exec_fence.fence);
+            }
+        }
+
+        _queue_timelines.clear();
+        _owned_buffers.clear();
+        _owned_images.clear();
+        _transient_heaps.clear();
+        _all_buffers.clear();
+        _all_images.clear();
+        _external_surfaces.clear();
+        _baked_barriers.clear();
+        _reset_resources.clear();
+    }
+
+    void graph_executor::_construct_transient_heap(size_t heap_index)
+    {
+        const auto& heap = _plan->transient_heaps[heap_index];
+
+        auto heap_desc = rhi::memory_heap_desc{
+            .size = 0,
+            .alignment = 1,
+            .memory_type_bits = ~0u,
+            .location = rhi::memory_location::device,
+            .name = "Frame Graph Transient Heap",
+        };
+
+        for (const auto& handle : heap.resources)
+        {
+            const auto resource = _find_resource(handle);
+            const auto requirements =
+                holds_alternative<rhi::buffer_desc>(resource->creation_info)
+                    ? _device->get_memory_requirements(get<rhi::buffer_desc>(resource->creation_info))
+                    : _device->get_memory_requirements(get<rhi::image_desc>(resource->creation_info));
+
+            heap_desc.size = tempest::max(heap_desc.size, requirements.size);
+            heap_desc.alignment = tempest::max(heap_desc.alignment, requirements.alignment);
+            heap_desc.memory_type_bits &= requirements.memory_type_bits;
+        }
+
+        // Members that cannot share a memory type get dedicated allocations instead
+        auto memory_heap = rhi::typed_rhi_handle<rhi::rhi_handle_type::memory_heap>::null_handle;
+        if (heap_desc.memory_type_bits != 0)
+        {
+            memory_heap = _device->create_memory_heap(heap_desc);
+        }
+
+        _transient_heaps[heap_index] = memory_heap;
+
+        const auto placed = memory_heap != rhi::typed_rhi_handle<rhi::rhi_handle_type::memory_heap>::null_handle;
+
+        for (const auto& handle : heap.resources)
+        {
+            const auto resource = _find_resource(handle);
+            if (holds_alternative<rhi::buffer_desc>(resource->creation_info))
+            {
+                const auto& desc = get<rhi::buffer_desc>(resource->creation_info);
+                auto buffer = placed ? _device->create_placed_buffer(desc, memory_heap, 0) : _device->create_buffer(desc);
+                _owned_buffers[handle.handle] = buffer;
+                _all_buffers[handle.handle] = buffer;
+            }
+            else
+            {
+                const auto& desc = get<rhi::image_desc>(resource->creation_info);
+                auto image = placed ? _device->create_placed_image(desc, memory_heap, 0) : _device->create_image(desc);
+                _owned_images[handle.handle] = image;
+                _all_images[handle.handle] = image;
+            }
+        }
+    }
+
+    void graph_executor::_destroy_transient_heap(size_t heap_index)
+    {
+        for (const auto& handle : _plan->transient_heaps[heap_index].resources)
+        {
+            if (const auto buffer_it = _owned_buffers.find(handle.handle); buffer_it != _owned_buffers.end())
+            {
+                _device->destroy_buffer(buffer_it->second);
+                _owned_buffers.erase(buffer_it);
+                _all_buffers.erase(handle.handle);
+            }
+
+            if (const auto image_it = _owned_images.find(handle.handle); image_it != _owned_images.end())
+            {
+                _device->destroy_image(image_it->second);
+                _owned_images.erase(image_it);
+                _all_images.erase(handle.handle);
+            }
+        }
+
+        if (_transient_heaps[heap_index] != rhi::typed_rhi_handle<rhi::rhi_handle_type::memory_heap>::null_handle)
+        {
+            _device->destroy_memory_heap(_transient_heaps[heap_index]);
+            _transient_heaps[heap_index] = rhi::typed_rhi_handle<rhi::rhi_handle_type::memory_heap>::null_handle;
+        }
+    }
+
+    void graph_executor::_bake_barriers()
+    {
+        const auto frames_in_flight = _device->frames_in_flight();
+
+        // Barriers on resources a skipped pass may substitute can only be resolved while executing
+        auto fallback_targets = vector<uint64_t>{};
+        for (const auto& submission : _plan->submissions)
+        {
+            for (const auto& pass : submission.passes)
+            {
+                for (const auto& [produced, _] : pass.resource_fallbacks)
+                {
+                    fallback_targets.push_back(produced);
+                }
+            }
+        }
+
+        const auto is_dynamic = [&](const base_graph_resource_handle& handle) {
+            return get_resource_type(handle) == rhi::rhi_handle_type::render_surface ||
+                   tempest::find(fallback_targets.cbegin(), fallback_targets.cend(), bit_cast<uint64_t>(handle)) !=
+                       fallback_targets.cend();
+        };
+
+        const auto queue_or_null = [&](work_type type) -> rhi::work_queue* {
+            return type == work_type::unknown ? nullptr : &_get_queue(type);
+        };
+
+        _baked_barriers.clear();
+
+        for (const auto& submission : _plan->submissions)
+        {
+            for (const auto& pass : submission.passes)
+            {
+                auto& baked = _baked_barriers.emplace_back();
+                baked.image_barriers.resize(frames_in_flight);
+                baked.buffer_barriers.resize(frames_in_flight);
+
+                for (size_t idx = 0; idx < pass.image_barriers.size(); ++idx)
+                {
+                    const auto& planned = pass.image_barriers[idx];
+                    if (is_dynamic(planned.handle))
+                    {
+                        baked.dynamic_images.push_back(idx);
+                    }
+
+                    const auto image_it = _all_images.find(planned.handle.handle);
+                    const auto barrier = rhi::work_queue::image_barrier{
+                        .image = image_it != _all_images.cend()
+                                     ? image_it->second
+                                     : rhi::typed_rhi_handle<rhi::rhi_handle_type::image>::null_handle,
+                        .old_layout = planned.old_layout,
+                        .new_layout = planned.new_layout,
+                        .src_stages = planned.src_stages,
+                        .src_access = planned.src_access,
+                        .dst_stages = planned.dst_stages,
+                        .dst_access = planned.dst_access,
+                        .src_queue = queue_or_null(planned.src_queue),
+                        .dst_queue = queue_or_null(planned.dst_queue),
+                    };
+
+                    for (auto& barriers : baked.image_barriers)
+                    {
+                        barriers.push_back(barrier);
+                    }
+                }
+
+                for (size_t idx = 0; idx < pass.buffer_barriers.size(); ++idx)
+                {
+                    const auto& planned = pass.buffer_barriers[idx];
+                    if (is_dynamic(planned.handle))
+                    {
+                        baked.dynamic_buffers.push_back(idx);
+                    }
+
+                    const auto buffer_it = _all_buffers.find(planned.handle.handle);
+                    auto barrier = rhi::work_queue::buffer_barrier{
+                        .buffer = buffer_it != _all_buffers.cend()
+                                      ? buffer_it->second
+                                      : rhi::typed_rhi_handle<rhi::rhi_handle_type::buffer>::null_handle,
+                        .src_stages = planned.src_stages,
+                        .src_access = planned.src_access,
+                        .dst_stages = planned.dst_stages,
+                        .dst_access = planned.dst_access,
+                        .src_queue = queue_or_null(planned.src_queue),
+                        .dst_queue = queue_or_null(planned.dst_queue),
+                        .offset = 0,
+                        .size = numeric_limits<size_t>::max(),
+                    };
+
+                    // Ownership transfers cover the whole buffer, otherwise only the range the frame uses
+                    const auto resource = _find_resource(planned.handle);
+                    const auto owned = planned.src_queue == work_type::unknown && resource &&
+                                       holds_alternative<rhi::buffer_desc>(resource->creation_info);
+                    const auto per_frame_size = owned ? get<rhi::buffer_desc>(resource->creation_info).size : 0;
+
+                    for (size_t frame = 0; frame < frames_in_flight; ++frame)
+                    {
+                        if (owned)
+                        {
+                            barrier.offset = planned.per_frame ? frame * per_frame_size : 0;
+                            barrier.size = per_frame_size;
+                        }
+
+                        baked.buffer_barriers[frame].push_back(barrier);
+                    }
+                }
+            }
+        }
+    }
+
+    void graph_executor::_plan_fence_waits()
+    {
+        // The CPU may write per frame resources while recording any pass using them, so every queue using such a
+        // resource has to have retired this frame in flight before the pass is recorded
+        auto resource_queues = flat_unordered_map<uint64_t, inplace_vector<work_type, 3>>{};
+        for (const auto& submission : _plan->submissions)
+        {
+            for (const auto& pass : submission.passes)
+            {
+                for (const auto& access : pass.accesses)
+                {
+                    const auto resource = _find_resource(access.handle);
+                    if (!resource.has_value() || !resource->per_frame)
+                    {
+                        continue;
+                    }
+
+                    auto& queues = resource_queues[access.handle.handle];
+                    if (tempest::find(queues.cbegin(), queues.cend(), submission.type) == queues.cend())
+                    {
+                        queues.push_back(submission.type);
+                    }
+                }
+            }
+        }
+
+        _submission_fence_waits.clear();
+        for (const auto& submission : _plan->submissions)
+        {
+            auto waits = inplace_vector<work_type, 3>{};
+            for (const auto& pass : submission.passes)
+            {
+                for (const auto& access : pass.accesses)
+                {
+                    const auto it = resource_queues.find(access.handle.handle);
+                    if (it == resource_queues.end())
+                    {
+                        continue;
+                    }
+
+                    for (const auto type : it->second)
+                    {
+                        if (type != submission.type &&
+                            tempest::find(waits.cbegin(), waits.cend(), type) == waits.cend())
+                        {
+                            waits.push_back(type);
+                        }
+                    }
+                }
+            }
+
+            _submission_fence_waits.push_back(tempest::move(waits));
         }
     }
 
-    void graph_executor::_destroy_owned_resources()
+    void graph_executor::_retire_queue(work_type type, size_t frame_in_flight)
     {
-        for (const auto& [handle, buffer] : _owned_buffers)
+        // Once handled, the fence belongs to this frame's submissions
+        if (tempest::find(_retired_queues.cbegin(), _retired_queues.cend(), type) != _retired_queues.cend())
         {
-            _device->destroy_buffer(buffer);
+            return;
         }
 
-        for (const auto& [handle, image] : _owned_images)
+        _retired_queues.push_back(type);
+
+        auto& fences = _per_frame_fences[frame_in_flight].frame_complete_fence;
+        const auto fence_it = fences.find(type);
+        if (fence_it == fences.end() || !fence_it->second.queue_used)
         {
-            _device->destroy_image(image);
+            return;
         }
 
-        for (const auto& [type, timelines] : _queue_timelines)
+        const auto wait_start = std::chrono::steady_clock::now();
+
+        const array fences_to_wait = {fence_it->second.fence};
+        _device->wait(fences_to_wait);
+        _device->reset(fences_to_wait);
+        fence_it->second.queue_used = false;
+
+        _pacing_stats.fence_wait_ns += static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - wait_start)
+                .count());
+    }
+
+    void graph_executor::_prepare_queue(work_type type, size_t frame_in_flight)
+    {
+        auto& queue = _get_queue(type);
+        if (tempest::find(_reset_queues.cbegin(), _reset_queues.cend(), &queue) != _reset_queues.cend())
         {
-            for (const auto& timeline : timelines)
-            {
-                _device->destroy_semaphore(timeline.sem);
-            }
+            _retire_queue(type, frame_in_flight);
+            return;
         }
 
-        for (auto& frame_fences : _per_frame_fences)
+        // Without a dedicated queue family, work types share a queue, and all of their work has to retire before the
+        // queue's command lists are reset
+        const array work_types = {work_type::graphics, work_type::compute, work_type::transfer};
+        for (const auto shared : work_types)
         {
-            for (const auto& [type, exec_fence] : frame_fences.frame_complete_fence)
+            if (&_get_queue(shared) == &queue)
             {
-                _device->destroy_fence(exec_fence.fence);
+                _retire_queue(shared, frame_in_flight);
             }
         }
 
-        _queue_timelines.clear();
-        _owned_buffers.clear();
-        _owned_images.clear();
-        _all_buffers.clear();
-        _all_images.clear();
-        _external_surfaces.clear();
+        queue.reset(frame_in_flight);
+        _reset_queues.push_back(&queue);
+    }
+
+    rhi::work_queue& graph_executor::_get_queue(work_type type) const
+    {
+        switch (type)
+        {
+        case work_type::compute:
+            return _device->get_dedicated_compute_queue();
+        case work_type::transfer:
+            return _device->get_dedicated_transfer_queue();
+        default:
+            return _device->get_primary_work_queue();
+        }
     }
 
     graph_executor::acquired_swapchains graph_executor::_acquire_swapchain_images()
@@ -1719,30 +2896,43 @@ namespace tempest::graphics
             }
         }
 
+        const auto frame_in_flight = _current_frame % _device->frames_in_flight();
+
+        // Consecutive passes recorded on the calling thread share a command list, passes recorded in parallel each get
+        // their own. Command lists are submitted in pass order.
+        struct command_list_segment
+        {
+            size_t first_pass;
+            size_t pass_count;
+            bool parallel;
+            uint32_t slot;
+            rhi::typed_rhi_handle<rhi::rhi_handle_type::command_list> command_list;
+        };
+
+        struct pass_recording
+        {
+            pmr::vector<rhi::work_queue::image_barrier> patched_images;
+            pmr::vector<rhi::work_queue::buffer_barrier> patched_buffers;
+            bool images_patched = false;
+            bool buffers_patched = false;
+            bool skip = false;
+        };
+
         size_t submission_index = 0;
+        size_t pass_index = 0;
         for (const auto& submission : _plan->submissions)
         {
-            auto get_queue = [dev = _device](work_type type) -> rhi::work_queue& {
-                switch (type)
-                {
-                case work_type::graphics:
-                    return dev->get_primary_work_queue();
-                case work_type::compute:
-                    return dev->get_dedicated_compute_queue();
-                case work_type::transfer:
-                    return dev->get_dedicated_transfer_queue();
-                default:
-                    return dev->get_primary_work_queue();
-                }
-            };
+            // Previous work of this frame in flight is only waited on once recording needs it
+            for (const auto type : _submission_fence_waits[submission_index])
+            {
+                _retire_queue(type, frame_in_flight);
+            }
 
-            auto& queue = get_queue(submission.type);
+            _prepare_queue(submission.type, frame_in_flight);
 
-            auto command_list = queue.get_next_command_list();
-            queue.begin_command_list(command_list, true);
+            auto& queue = _get_queue(submission.type);
 
             auto submit_info = rhi::work_queue::submit_info{};
-            auto timeline_value = _queue_timelines[submission.type][submission.queue_index].value;
 
             struct sem_value
             {
@@ -1752,304 +2942,197 @@ namespace tempest::graphics
                 enum_mask<rhi::pipeline_stage> stages;
             };
 
-            // Handle waits on cross-queue ownership transfers with timeline semaphores
-            auto wait_map = flat_unordered_map<uint64_t, sem_value>{}; // semaphore handle -> max wait value
+            auto frame_allocator = _frame_arena.thread_allocator();
 
+            // Work of the previous frames on every queue has to complete before this submission starts
             for (const auto& [_, sems] : _queue_timelines)
             {
                 for (const auto& sem : sems)
                 {
-                    wait_map[sem.sem.id] = {
-                        .sem = sem.sem,
-                        .offset = 0,
-                        .queue_value = sem.value,
+                    submit_info.wait_semaphores.push_back({
+                        .semaphore = sem.sem,
+                        .value = sem.value,
                         .stages = make_enum_mask(rhi::pipeline_stage::none),
-                    };
-                }
-            }
-
-            for (const auto& wait : submission.waits)
-            {
-                const auto& timeline = _queue_timelines[wait.type][wait.queue_index];
-                const auto& current_value = wait_map[timeline.sem.id];
-                if (current_value.offset > wait.value)
-                {
-                    wait_map[timeline.sem.id].offset = current_value.offset;
-                    wait_map[timeline.sem.id].stages |= wait.stages;
+                    });
                 }
             }
 
             // Handle signals on cross-queue ownership transfers with timeline semaphores
-            auto signal_map = flat_unordered_map<uint64_t, sem_value>{}; // semaphore handle -> max signal value
+            // semaphore handle -> max signal value
+            auto signal_map = pmr::flat_unordered_map<uint64_t, sem_value>(frame_allocator);
+
+            // Resolve the barriers and enable conditions of every pass before recording starts, so that recording only
+            // reads executor state and may happen on several threads
+            const auto first_pass_index = pass_index;
+            auto recordings = pmr::vector<pass_recording>(frame_allocator);
+            recordings.reserve(submission.passes.size());
 
             for (const auto& pass : submission.passes)
             {
-                auto image_barriers = vector<rhi::work_queue::image_barrier>{};
-                auto buffer_barriers = vector<rhi::work_queue::buffer_barrier>{};
+                const auto& baked = _baked_barriers[pass_index++];
 
-                for (const auto& resource : pass.accesses)
+                auto recording = pass_recording{
+                    .patched_images = pmr::vector<rhi::work_queue::image_barrier>(frame_allocator),
+                    .patched_buffers = pmr::vector<rhi::work_queue::buffer_barrier>(frame_allocator),
+                };
+
+                // Only barriers on resources that changed since the plan was baked are patched
+                if (!baked.dynamic_images.empty() || !_reset_resources.empty())
                 {
-                    auto prior_usage_it = _current_resource_states.find(resource.handle.handle);
-                    if (prior_usage_it != _current_resource_states.cend())
+                    const auto& image_barriers = baked.image_barriers[frame_in_flight];
+                    for (size_t idx = 0; idx < image_barriers.size(); ++idx)
                     {
-                        auto& prior_usage = prior_usage_it->second;
-                        const auto cross_queue = prior_usage.queue != submission.type;
+                        auto barrier = image_barriers[idx];
+                        const auto& planned = pass.image_barriers[idx];
 
-                        if (cross_queue)
+                        if (tempest::find(baked.dynamic_images.cbegin(), baked.dynamic_images.cend(), idx) !=
+                            baked.dynamic_images.cend())
                         {
-                            auto sem_to_wait = _queue_timelines[prior_usage.queue][prior_usage.queue_index].sem;
-                            auto wait_value = prior_usage.timeline_value;
-
-                            const auto& current_value = wait_map[sem_to_wait.id];
-                            if (current_value.offset > wait_value)
-                            {
-                                wait_map[sem_to_wait.id].offset = current_value.offset;
-                                wait_map[sem_to_wait.id].stages |= prior_usage.stages;
-                            }
+                            barrier.image = get_image(planned.handle);
                         }
 
-                        rhi::work_queue* src_queue = nullptr;
-                        rhi::work_queue* dst_queue = nullptr;
-
-                        if (cross_queue)
+                        // Swapchain images that were not acquired this frame
+                        if (barrier.image.id == rhi::typed_rhi_handle<rhi::rhi_handle_type::image>::null_handle.id)
                         {
-                            src_queue = &get_queue(prior_usage.queue);
-                            dst_queue = &queue;
+                            continue;
                         }
 
-                        const auto res_type = get_resource_type(resource.handle);
-                        if (res_type == rhi::rhi_handle_type::image || res_type == rhi::rhi_handle_type::render_surface)
+                        if (planned.first_access_in_frame &&
+                            tempest::find(_reset_resources.cbegin(), _reset_resources.cend(),
+                                          static_cast<uint64_t>(planned.handle.handle)) != _reset_resources.cend())
                         {
-                            const auto physical_image = get_image(resource.handle);
-                            if (physical_image.id != rhi::typed_rhi_handle<rhi::rhi_handle_type::image>::null_handle.id)
-                            {
-                                const auto& img_usage = tempest::get<image_usage>(prior_usage.usage);
-
-                                auto existing_barrier_it = tempest::find_if(
-                                    image_barriers.begin(), image_barriers.end(),
-                                    [&](const auto& barrier) { return barrier.image.id == physical_image.id; });
-                                if (existing_barrier_it != image_barriers.end())
-                                {
-                                    // Update existing barrier
-                                    TEMPEST_ASSERT(existing_barrier_it->new_layout == resource.layout);
-                                    existing_barrier_it->dst_stages |= resource.stages;
-                                    existing_barrier_it->dst_access |= resource.accesses;
-                                }
-                                else
-                                {
-                                    // If src is a host operation and there is no ownership transfer or layout
-                                    // transition, we can skip the barrier entirely
-                                    if ((prior_usage.stages & make_enum_mask(rhi::pipeline_stage::host)) ==
-                                            make_enum_mask(rhi::pipeline_stage::host) &&
-                                        !cross_queue && img_usage.layout == resource.layout)
-                                    {
-                                        continue;
-                                    }
-
-                                    // Create new barrier
-                                    const auto barrier = rhi::work_queue::image_barrier{
-                                        .image = physical_image,
-                                        .old_layout = img_usage.layout,
-                                        .new_layout = resource.layout,
-                                        .src_stages = prior_usage.stages,
-                                        .src_access = prior_usage.accesses,
-                                        .dst_stages = resource.stages,
-                                        .dst_access = resource.accesses,
-                                        .src_queue = src_queue,
-                                        .dst_queue = dst_queue,
-                                    };
-
-                                    image_barriers.push_back(barrier);
-                                }
-                            }
+                            barrier.old_layout = rhi::image_layout::undefined;
                         }
-                        else if (res_type == rhi::rhi_handle_type::buffer)
-                        {
-                            const auto physical_buffer = get_buffer(resource.handle);
-                            const auto& buf_usage = tempest::get<buffer_usage>(prior_usage.usage);
-                            auto offset = buf_usage.offset;
-                            auto range = buf_usage.range;
-
-                            const auto create_info = _find_resource(resource.handle);
 
-                            if (create_info && holds_alternative<rhi::buffer_desc>(create_info->creation_info))
-                            {
-                                const auto& buf_desc = get<rhi::buffer_desc>(create_info->creation_info);
-
-                                // Get size of per-frame buffer
-                                const auto per_frame_size = buf_desc.size;
-                                const auto frame_offset = create_info->per_frame ? per_frame_size * _current_frame %
-                                                                                       _device->frames_in_flight()
-                                                                                 : 0;
-
-                                offset = frame_offset + buf_usage.offset;
-                                range = per_frame_size;
-                            }
-
-                            if (cross_queue)
-                            {
-                                offset = 0;
-                                range = numeric_limits<size_t>::max();
-                            }
-
-                            // Search for prior write accesses that have not been waited on yet
-                            const auto existing_write_barrier = _write_barriers.find(resource.handle.handle);
+                        recording.patched_images.push_back(barrier);
+                    }
 
-                            auto existing_write_stages = enum_mask<rhi::pipeline_stage>();
-                            auto existing_write_accesses = enum_mask<rhi::memory_access>();
+                    recording.images_patched = true;
+                }
 
-                            if (existing_write_barrier != _write_barriers.cend())
-                            {
-                                // Check if this pass's read usage overlaps with the existing write usage's reads
-                                auto& write_usage = existing_write_barrier->second;
-                                if ((write_usage.read_accesses_seen & resource.accesses) != resource.accesses ||
-                                    (write_usage.read_stages_seen & resource.stages) != resource.stages)
-                                {
-                                    existing_write_stages |= write_usage.write_stages;
-                                    existing_write_accesses |= write_usage.write_accesses;
-                                }
+                if (!baked.dynamic_buffers.empty())
+                {
+                    const auto& buffer_barriers = baked.buffer_barriers[frame_in_flight];
+                    recording.patched_buffers.reserve(buffer_barriers.size());
+                    for (const auto& barrier : buffer_barriers)
+                    {
+                        recording.patched_buffers.push_back(barrier);
+                    }
 
-                                // Reset the seen read accesses
-                                if (is_write_access(resource.accesses))
-                                {
-                                    write_usage.read_accesses_seen = enum_mask<rhi::memory_access>();
-                                    write_usage.read_stages_seen = enum_mask<rhi::pipeline_stage>();
-                                    write_usage.write_accesses |= resource.accesses;
-                                    write_usage.write_stages |= resource.stages;
-                                }
+                    for (const auto idx : baked.dynamic_buffers)
+                    {
+                        recording.patched_buffers[idx].buffer = get_buffer(pass.buffer_barriers[idx].handle);
+                    }
 
-                                if (is_read_access(resource.accesses))
-                                {
-                                    write_usage.read_accesses_seen |= resource.accesses;
-                                    write_usage.read_stages_seen |= resource.stages;
-                                }
-                            }
-                            else
-                            {
-                                auto write_usage = write_barrier_details{
-                                    .write_stages = is_write_access(resource.accesses)
-                                                        ? resource.stages
-                                                        : enum_mask<rhi::pipeline_stage>(),
-                                    .write_accesses = is_write_access(resource.accesses)
-                                                          ? resource.accesses
-                                                          : enum_mask<rhi::memory_access>(),
-                                    .read_stages_seen = is_read_access(resource.accesses)
-                                                            ? resource.stages
-                                                            : enum_mask<rhi::pipeline_stage>(),
-                                    .read_accesses_seen = is_read_access(resource.accesses)
-                                                              ? resource.accesses
-                                                              : enum_mask<rhi::memory_access>(),
-                                };
-                                _write_barriers[resource.handle.handle] = write_usage;
-                            }
+                    recording.buffers_patched = true;
+                }
 
-                            const auto existing_barrier_it = tempest::find_if(
-                                buffer_barriers.begin(), buffer_barriers.end(),
-                                [&](const auto& barrier) { return barrier.buffer.id == physical_buffer.id; });
-                            if (existing_barrier_it != buffer_barriers.end())
-                            {
-                                // Update existing barrier
-                                existing_barrier_it->dst_stages |= resource.stages;
-                                existing_barrier_it->dst_access |= resource.accesses;
-                            }
-                            else
-                            {
-                                // If src is a host operation and there is no ownership transfer,
-                                // we can skip the barrier entirely
-                                if ((prior_usage.stages & make_enum_mask(rhi::pipeline_stage::host)) ==
-                                        make_enum_mask(rhi::pipeline_stage::host) &&
-                                    !cross_queue)
-                                {
-                                    continue;
-                                }
+                recording.skip = pass.enable_condition && !pass.enable_condition();
+                if (recording.skip)
+                {
+                    for (const auto& [produced, alternative] : pass.resource_fallbacks)
+                    {
+                        _execution_alias_map[produced] = alternative;
+                    }
+                }
 
-                                const auto barrier = rhi::work_queue::buffer_barrier{
-                                    .buffer = physical_buffer,
-                                    .src_stages = existing_write_stages | prior_usage.stages,
-                                    .src_access = existing_write_accesses | prior_usage.accesses,
-                                    .dst_stages = resource.stages,
-                                    .dst_access = resource.accesses,
-                                    .src_queue = src_queue,
-                                    .dst_queue = dst_queue,
-                                    .offset = offset,
-                                    .size = range,
-                                };
+                recordings.push_back(tempest::move(recording));
+            }
 
-                                buffer_barriers.push_back(barrier);
-                            }
-                        }
-                    }
-                    else
+            // If this is the last submission in the frame, transition any swapchain images back to present
+            auto present_transitions = pmr::vector<rhi::work_queue::image_barrier>(frame_allocator);
+            if (submission_index == _plan->submissions.size() - 1)
+            {
+                for (const auto& img : acquired)
+                {
+                    auto swapchain_resource_handle_it =
+                        tempest::find_if(_external_surfaces.begin(), _external_surfaces.end(),
+                                         [&](const auto& pair) { return pair.second == img.first; });
+                    if (swapchain_resource_handle_it != _external_surfaces.cend())
                     {
-                        // If this is an image resource, we need to transition it from undefined to the first usage
-                        // If this is a swapchain image, we need to transition it from the present layout to the first
-                        // usage
-                        const auto res_type = get_resource_type(resource.handle);
-                        if (res_type == rhi::rhi_handle_type::image)
+                        const auto planned_it = tempest::find_if(
+                            _plan->present_barriers.cbegin(), _plan->present_barriers.cend(), [&](const auto& barrier) {
+                                return barrier.handle.handle == swapchain_resource_handle_it->first;
+                            });
+                        if (planned_it == _plan->present_barriers.cend())
                         {
-                            const auto image_it = _all_images.find(resource.handle.handle);
-
-                            const auto barrier = rhi::work_queue::image_barrier{
-                                .image = image_it->second,
-                                .old_layout = rhi::image_layout::undefined,
-                                .new_layout = resource.layout,
-                                .src_stages = make_enum_mask(rhi::pipeline_stage::all_transfer,
-                                                             rhi::pipeline_stage::color_attachment_output),
-                                .src_access = make_enum_mask(rhi::memory_access::transfer_write,
-                                                             rhi::memory_access::color_attachment_write),
-                                .dst_stages = resource.stages,
-                                .dst_access = resource.accesses,
-                                .src_queue = nullptr,
-                                .dst_queue = nullptr,
-                            };
-
-                            image_barriers.push_back(barrier);
+                            continue;
                         }
-                        else if (res_type == rhi::rhi_handle_type::render_surface)
-                        {
-                            const auto surface_it = tempest::find_if(
-                                _external_surfaces.begin(), _external_surfaces.end(),
-                                [&](const auto& pair) { return pair.first == resource.handle.handle; });
-                            const auto render_surface_info_it =
-                                tempest::find_if(acquired.cbegin(), acquired.cend(),
-                                                 [&](const auto& info) { return info.first == surface_it->second; });
-
-                            if (render_surface_info_it != acquired.cend())
-                            {
-                                // Add image layout transition from undefined to first usage
-                                const auto barrier = rhi::work_queue::image_barrier{
-                                    .image = render_surface_info_it->second.image,
-                                    .old_layout = rhi::image_layout::undefined,
-                                    .new_layout = resource.layout,
-                                    .src_stages = make_enum_mask(rhi::pipeline_stage::all_transfer,
-                                                                 rhi::pipeline_stage::color_attachment_output),
-                                    .src_access = make_enum_mask(rhi::memory_access::transfer_write,
-                                                                 rhi::memory_access::color_attachment_write),
-                                    .dst_stages = resource.stages,
-                                    .dst_access = resource.accesses,
-                                    .src_queue = nullptr,
-                                    .dst_queue = nullptr,
-                                };
 
-                                image_barriers.push_back(barrier);
-                            }
-                        }
+                        present_transitions.push_back(rhi::work_queue::image_barrier{
+                            .image = img.second.image,
+                            .old_layout = planned_it->old_layout,
+                            .new_layout = planned_it->new_layout,
+                            .src_stages = planned_it->src_stages,
+                            .src_access = planned_it->src_access,
+                            .dst_stages = planned_it->dst_stages,
+                            .dst_access = planned_it->dst_access,
+                            .src_queue = nullptr,
+                            .dst_queue = nullptr,
+                        });
                     }
                 }
+            }
 
-                queue.pipeline_barriers(command_list, image_barriers, buffer_barriers);
+            // Split the submission into command lists
+            const auto slot_count = _jobs != nullptr ? queue.parallel_command_list_slot_count() : 0u;
+            auto segments = pmr::vector<command_list_segment>(frame_allocator);
+            uint32_t parallel_segment_count = 0;
 
-                bool skip_pass = pass.enable_condition && !pass.enable_condition();
-                if (skip_pass)
+            for (size_t idx = 0; idx < submission.passes.size(); ++idx)
+            {
+                const auto parallel = slot_count > 0 && submission.passes[idx].record_in_parallel;
+                if (!parallel && !segments.empty() && !segments.back().parallel)
                 {
-                    for (const auto& [produced, alternative] : pass.resource_fallbacks)
-                    {
-                        _execution_alias_map[produced] = alternative;
-                    }
+                    ++segments.back().pass_count;
+                    continue;
                 }
 
+                segments.push_back({
+                    .first_pass = idx,
+                    .pass_count = 1,
+                    .parallel = parallel,
+                    .slot = parallel ? parallel_segment_count++ % slot_count : 0,
+                    .command_list = rhi::typed_rhi_handle<rhi::rhi_handle_type::command_list>::null_handle,
+                });
+            }
+
+            if (segments.empty())
+            {
+                segments.push_back({
+                    .first_pass = 0,
+                    .pass_count = 0,
+                    .parallel = false,
+                    .slot = 0,
+                    .command_list = rhi::typed_rhi_handle<rhi::rhi_handle_type::command_list>::null_handle,
+                });
+            }
+
+            // Command lists are acquired up front, acquisition is not thread safe
+            for (auto& segment : segments)
+            {
+                segment.command_list = segment.parallel ? queue.get_next_parallel_command_list(segment.slot)
+                                                        : queue.get_next_command_list();
+            }
+
+            auto record_pass = [&](size_t idx, rhi::typed_rhi_handle<rhi::rhi_handle_type::command_list> command_list) {
+                const auto& pass = submission.passes[idx];
+                const auto& baked = _baked_barriers[first_pass_index + idx];
+                const auto& recording = recordings[idx];
+
+                const auto image_barriers =
+                    recording.images_patched
+                        ? span<const rhi::work_queue::image_barrier>(recording.patched_images)
+                        : span<const rhi::work_queue::image_barrier>(baked.image_barriers[frame_in_flight]);
+                const auto buffer_barriers =
+                    recording.buffers_patched
+                        ? span<const rhi::work_queue::buffer_barrier>(recording.patched_buffers)
+                        : span<const rhi::work_queue::buffer_barrier>(baked.buffer_barriers[frame_in_flight]);
+
+                queue.pipeline_barriers(command_list, image_barriers, buffer_barriers);
+
                 auto execute_lambda = [&](task_execution_context& executor) {
-                    if (skip_pass)
+                    if (recording.skip)
                     {
                         if (pass.fallback_exec)
                         {
@@ -2090,64 +3173,67 @@ namespace tempest::graphics
                     // Should never reach here
                     break;
                 }
+            };
 
-                // Update the last used state for each resource
-                for (const auto& resource : pass.accesses)
+            auto record_segment = [&](const command_list_segment& segment) {
+                queue.begin_command_list(segment.command_list, true);
+
+                for (size_t idx = segment.first_pass; idx < segment.first_pass + segment.pass_count; ++idx)
                 {
-                    auto res_type = get_resource_type(resource.handle);
-                    if (res_type == rhi::rhi_handle_type::buffer)
-                    {
-                        auto buf_usage = buffer_usage{
-                            .offset = 0,
-                            .range = numeric_limits<size_t>::max(),
-                        };
+                    record_pass(idx, segment.command_list);
+                }
 
-                        _current_resource_states[resource.handle.handle] = resource_usage{
-                            .queue = submission.type,
-                            .queue_index = submission.queue_index,
-                            .stages = resource.stages,
-                            .accesses = resource.accesses,
-                            .usage = buf_usage,
-                            .timeline_value = timeline_value,
-                        };
-                    }
-                    else if (res_type == rhi::rhi_handle_type::image)
-                    {
-                        _current_resource_states[resource.handle.handle] = resource_usage{
-                            .queue = submission.type,
-                            .queue_index = submission.queue_index,
-                            .stages = resource.stages,
-                            .accesses = resource.accesses,
-                            .usage =
-                                image_usage{
-                                    .base_mip = 0,
-                                    .mip_levels = 1,
-                                    .base_array_layer = 0,
-                                    .array_layers = 1,
-                                    .layout = resource.layout,
-                                },
-                            .timeline_value = timeline_value,
-                        };
-                    }
-                    else if (res_type == rhi::rhi_handle_type::render_surface)
+                if (&segment == &segments.back())
+                {
+                    for (const auto& barrier : present_transitions)
                     {
-                        _current_resource_states[resource.handle.handle] = resource_usage{
-                            .queue = submission.type,
-                            .queue_index = submission.queue_index,
-                            .stages = resource.stages,
-                            .accesses = resource.accesses,
-                            .usage =
-                                image_usage{
-                                    .base_mip = 0,
-                                    .mip_levels = 1,
-                                    .base_array_layer = 0,
-                                    .array_layers = 1,
-                                    .layout = resource.layout,
-                                },
-                            .timeline_value = timeline_value,
-                        };
+                        queue.transition_image(segment.command_list, {&barrier, 1});
                     }
                 }
+
+                queue.end_command_list(segment.command_list);
+            };
+
+            // Serial passes ahead of the first parallel pass often prepare the state parallel passes read, so they are
+            // recorded before any worker starts
+            const auto first_parallel = tempest::find_if(segments.cbegin(), segments.cend(),
+                                                         [](const auto& segment) { return segment.parallel; });
+            for (auto it = segments.cbegin(); it != first_parallel; ++it)
+            {
+                record_segment(*it);
+            }
+
+            // Every slot is recorded by a single job, command lists of the same slot may not be recorded concurrently
+            auto recording_jobs = core::job_counter{};
+            for (uint32_t slot = 0; slot < tempest::min(parallel_segment_count, slot_count); ++slot)
+            {
+                _jobs->submit(
+                    [&, slot] {
+                        // The scope opened by execute only covers the calling thread
+                        core::allocation_scope allocation_scope("frame_graph");
+
+                        for (const auto& segment : segments)
+                        {
+                            if (segment.parallel && segment.slot == slot)
+                            {
+                                record_segment(segment);
+                            }
+                        }
+                    },
+                    recording_jobs);
+            }
+
+            for (auto it = first_parallel; it != segments.cend(); ++it)
+            {
+                if (!it->parallel)
+                {
+                    record_segment(*it);
+                }
+            }
+
+            if (parallel_segment_count > 0)
+            {
+                _jobs->wait(recording_jobs);
             }
 
             for (const auto& signal : submission.signals)
@@ -2162,8 +3248,8 @@ namespace tempest::graphics
             }
 
             // Set up barriers to transition any resources that were released in this submission to another queue
-            auto release_buffer_ownership = vector<rhi::work_queue::buffer_barrier>{};
-            auto release_image_ownership = vector<rhi::work_queue::image_barrier>{};
+            auto release_buffer_ownership = pmr::vector<rhi::work_queue::buffer_barrier>(frame_allocator);
+            auto release_image_ownership = pmr::vector<rhi::work_queue::image_barrier>(frame_allocator);
 
             for (const auto& rel_res : submission.released_resources)
             {
@@ -2178,7 +3264,7 @@ namespace tempest::graphics
                         .dst_stages = rel_res.dst_stages,
                         .dst_access = rel_res.dst_accesses,
                         .src_queue = &queue,
-                        .dst_queue = &get_queue(rel_res.dst_queue),
+                        .dst_queue = &_get_queue(rel_res.dst_queue),
                         .offset = 0,
                         .size = numeric_limits<size_t>::max(),
                     };
@@ -2197,7 +3283,7 @@ namespace tempest::graphics
                         .dst_stages = rel_res.dst_stages,
                         .dst_access = rel_res.dst_accesses,
                         .src_queue = &queue,
-                        .dst_queue = &get_queue(rel_res.dst_queue),
+                        .dst_queue = &_get_queue(rel_res.dst_queue),
                     };
                     release_image_ownership.push_back(barrier);
                     break;
@@ -2207,16 +3293,7 @@ namespace tempest::graphics
                 }
             }
 
-            // Fill out the wait and signal semaphores for the submit info
-            for (const auto& [sem_id, value] : wait_map)
-            {
-                submit_info.wait_semaphores.push_back({
-                    .semaphore = value.sem,
-                    .value = value.offset + value.queue_value,
-                    .stages = value.stages,
-                });
-            }
-
+            // Fill out the signal semaphores for the submit info
             for (const auto& [sem_id, value] : signal_map)
             {
                 submit_info.signal_semaphores.push_back({
@@ -2227,9 +3304,8 @@ namespace tempest::graphics
             }
 
             // If this is the last submission in the frame for this queue family, signal the frame complete fence
-            const auto frame_idx = _current_frame % _device->frames_in_flight();
-            auto fence_handle = _per_frame_fences[frame_idx].frame_complete_fence[submission.type].fence;
-            _per_frame_fences[frame_idx].frame_complete_fence[submission.type].queue_used = true;
+            auto fence_handle = _per_frame_fences[frame_in_flight].frame_complete_fence[submission.type].fence;
+            _per_frame_fences[frame_in_flight].frame_complete_fence[submission.type].queue_used = true;
 
             // Check the rest of the submissions for a queue match
             for (auto idx = submission_index + 1; idx < _plan->submissions.size(); ++idx)
@@ -2241,53 +3317,20 @@ namespace tempest::graphics
                 }
             }
 
-            // If this is the last submission in the frame, transition any swapchain images back to present
-            if (submission_index == _plan->submissions.size() - 1)
+            for (const auto& segment : segments)
             {
-                for (const auto& img : acquired)
-                {
-                    auto swapchain_resource_handle_it =
-                        tempest::find_if(_external_surfaces.begin(), _external_surfaces.end(),
-                                         [&](const auto& pair) { return pair.second == img.first; });
-                    if (swapchain_resource_handle_it != _external_surfaces.cend())
-                    {
-                        auto last_usage_it = _current_resource_states.find(swapchain_resource_handle_it->first);
-
-                        auto barrier = rhi::work_queue::image_barrier{
-                            .image = img.second.image,
-                            .old_layout = last_usage_it == _current_resource_states.end()
-                                              ? rhi::image_layout::undefined
-                                              : get<image_usage>(last_usage_it->second.usage).layout,
-                            .new_layout = rhi::image_layout::present,
-                            .src_stages = last_usage_it == _current_resource_states.end()
-                                              ? make_enum_mask(rhi::pipeline_stage::bottom)
-                                              : last_usage_it->second.stages,
-                            .src_access = last_usage_it == _current_resource_states.end()
-                                              ? make_enum_mask(rhi::memory_access::none)
-                                              : last_usage_it->second.accesses,
-                            .dst_stages = make_enum_mask(rhi::pipeline_stage::top),
-                            .dst_access = make_enum_mask(rhi::memory_access::none),
-                            .src_queue = nullptr,
-                            .dst_queue = nullptr,
-                        };
-
-                        queue.transition_image(command_list, {&barrier, 1});
-
-                        // Remove the swapchain image from the current resource states
-                        _current_resource_states.erase(swapchain_resource_handle_it->first);
-                    }
-                }
+                submit_info.command_lists.push_back(segment.command_list);
             }
 
-            queue.end_command_list(command_list);
-            submit_info.command_lists.push_back(command_list);
-
             const array submits = {submit_info};
             queue.submit(submits, fence_handle);
 
             ++submission_index;
         }
 
+        // Every resource has been entered from undefined once
+        _reset_resources.clear();
+
         ++_current_frame;
     }
 
@@ -0,0 +1,239 @@
+#include <tempest/frustum_culling.hpp>
+
+#include <tempest/algorithm.hpp>
+#include <tempest/limits.hpp>
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define TEMPEST_FRUSTUM_CULLING_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define TEMPEST_FRUSTUM_CULLING_NEON
+#endif
+
+namespace tempest::graphics
+{
+    namespace
+    {
+        constexpr float degenerate_plane_epsilon = 1e-6f;
+
+        math::vec4<float> normalize_plane(const math::vec4<float>& plane) noexcept
+        {
+            const auto length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+            if (length < degenerate_plane_epsilon)
+            {
+                // Plane at infinity, accepts every point
+                return math::vec4<float>(0.0f, 0.0f, 0.0f, 1.0f);
+            }
+
+            return math::vec4<float>(plane.x / length, plane.y / length, plane.z / length, plane.w / length);
+        }
+
+        bool sphere_inside(const frustum& view, float x, float y, float z, float r) noexcept
+        {
+            for (const auto& plane : view.planes)
+            {
+                if (plane.x * x + plane.y * y + plane.z * z + plane.w + r < 0.0f)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    } // namespace
+
+    bounding_sphere compute_bounding_sphere(span<const core::vertex> vertices) noexcept
+    {
+        if (vertices.empty())
+        {
+            return {
+                .center = math::vec3<float>(0.0f),
+                .radius = 0.0f,
+            };
+        }
+
+        auto min_extents = math::vec3<float>(numeric_limits<float>::max());
+        auto max_extents = math::vec3<float>(numeric_limits<float>::lowest());
+
+        for (const auto& vertex : vertices)
+        {
+            min_extents.x = tempest::min(min_extents.x, vertex.position.x);
+            min_extents.y = tempest::min(min_extents.y, vertex.position.y);
+            min_extents.z = tempest::min(min_extents.z, vertex.position.z);
+
+            max_extents.x = tempest::max(max_extents.x, vertex.position.x);
+            max_extents.y = tempest::max(max_extents.y, vertex.position.y);
+            max_extents.z = tempest::max(max_extents.z, vertex.position.z);
+        }
+
+        const auto center = (min_extents + max_extents) * 0.5f;
+
+        auto radius_squared = 0.0f;
+        for (const auto& vertex : vertices)
+        {
+            const auto offset = vertex.position - center;
+            radius_squared = tempest::max(radius_squared, math::dot(offset, offset));
+        }
+
+        return {
+            .center = center,
+            .radius = std::sqrt(radius_squared),
+        };
+    }
+
+    bounding_sphere transform_bounding_sphere(const bounding_sphere& sphere,
+                                              const math::mat4<float>& transform) noexcept
+    {
+        const auto center = transform * math::vec4<float>(sphere.center.x, sphere.center.y, sphere.center.z, 1.0f);
+
+        const auto axis_scale_squared = [&](size_t column) {
+            const auto& axis = transform[column];
+            return axis.x * axis.x + axis.y * axis.y + axis.z * axis.z;
+        };
+
+        const auto max_scale_squared =
+            tempest::max(axis_scale_squared(0), tempest::max(axis_scale_squared(1), axis_scale_squared(2)));
+
+        return {
+            .center = math::vec3<float>(center.x, center.y, center.z),
+            .radius = sphere.radius * std::sqrt(max_scale_squared),
+        };
+    }
+
+    frustum frustum::from_view_projection(const math::mat4<float>& view_projection) noexcept
+    {
+        const auto row = [&](size_t index) {
+            return math::vec4<float>(view_projection[0][index], view_projection[1][index], view_projection[2][index],
+                                     view_projection[3][index]);
+        };
+
+        const auto r0 = row(0);
+        const auto r1 = row(1);
+        const auto r2 = row(2);
+        const auto r3 = row(3);
+
+        return frustum{
+            .planes =
+                {
+                    normalize_plane(r3 + r0), // Left
+                    normalize_plane(r3 - r0), // Right
+                    normalize_plane(r3 + r1), // Bottom
+                    normalize_plane(r3 - r1), // Top
+                    normalize_plane(r2),      // z >= 0
+                    normalize_plane(r3 - r2), // z <= w
+                },
+        };
+    }
+
+    bool frustum::intersects(const bounding_sphere& sphere) const noexcept
+    {
+        return sphere_inside(*this, sphere.center.x, sphere.center.y, sphere.center.z, sphere.radius);
+    }
+
+    void bounding_sphere_set::clear() noexcept
+    {
+        _center_x.clear();
+        _center_y.clear();
+        _center_z.clear();
+        _radius.clear();
+    }
+
+    void bounding_sphere_set::reserve(size_t count)
+    {
+        _center_x.reserve(count);
+        _center_y.reserve(count);
+        _center_z.reserve(count);
+        _radius.reserve(count);
+    }
+
+    uint32_t bounding_sphere_set::push_back(const bounding_sphere& sphere)
+    {
+        const auto index = static_cast<uint32_t>(_radius.size());
+
+        _center_x.push_back(sphere.center.x);
+        _center_y.push_back(sphere.center.y);
+        _center_z.push_back(sphere.center.z);
+        _radius.push_back(sphere.radius);
+
+        return index;
+    }
+
+    size_t bounding_sphere_set::size() const noexcept
+    {
+        return _radius.size();
+    }
+
+    void bounding_sphere_set::cull(const frustum& view, vector<uint32_t>& visible) const
+    {
+        const auto count = _radius.size();
+        size_t i = 0;
+
+#if defined(TEMPEST_FRUSTUM_CULLING_SSE2)
+        for (; i + 4 <= count; i += 4)
+        {
+            const auto x = _mm_loadu_ps(_center_x.data() + i);
+            const auto y = _mm_loadu_ps(_center_y.data() + i);
+            const auto z = _mm_loadu_ps(_center_z.data() + i);
+            const auto r = _mm_loadu_ps(_radius.data() + i);
+
+            auto inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (const auto& plane : view.planes)
+            {
+                auto distance = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)), _mm_set1_ps(plane.w));
+                distance = _mm_add_ps(distance, _mm_mul_ps(y, _mm_set1_ps(plane.y)));
+                distance = _mm_add_ps(distance, _mm_mul_ps(z, _mm_set1_ps(plane.z)));
+                distance = _mm_add_ps(distance, r);
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+            }
+
+            const auto mask = _mm_movemask_ps(inside);
+            for (uint32_t lane = 0; lane < 4; ++lane)
+            {
+                if ((mask & (1 << lane)) != 0)
+                {
+                    visible.push_back(static_cast<uint32_t>(i) + lane);
+                }
+            }
+        }
+#elif defined(TEMPEST_FRUSTUM_CULLING_NEON)
+        for (; i + 4 <= count; i += 4)
+        {
+            const auto x = vld1q_f32(_center_x.data() + i);
+            const auto y = vld1q_f32(_center_y.data() + i);
+            const auto z = vld1q_f32(_center_z.data() + i);
+            const auto r = vld1q_f32(_radius.data() + i);
+
+            auto inside = vdupq_n_u32(~0u);
+            for (const auto& plane : view.planes)
+            {
+                auto distance = vmlaq_n_f32(vdupq_n_f32(plane.w), x, plane.x);
+                distance = vmlaq_n_f32(distance, y, plane.y);
+                distance = vmlaq_n_f32(distance, z, plane.z);
+                distance = vaddq_f32(distance, r);
+                inside = vandq_u32(inside, vcgeq_f32(distance, vdupq_n_f32(0.0f)));
+            }
+
+            uint32_t lanes[4];
+            vst1q_u32(lanes, inside);
+            for (uint32_t lane = 0; lane < 4; ++lane)
+            {
+                if (lanes[lane] != 0)
+                {
+                    visible.push_back(static_cast<uint32_t>(i) + lane);
+                }
+            }
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            if (sphere_inside(view, _center_x[i], _center_y[i], _center_z[i], _radius[i]))
+            {
+                visible.push_back(static_cast<uint32_t>(i));
+            }
+        }
+    }
+} // namespace tempest::graphics
@@ -1,5 +1,6 @@
 #include <tempest/frame_graph.hpp>
 
+#include <algorithm>
 #include <cstring>
 #include <random>
 
@@ -82,17 +83,20 @@ namespace tempest::graphics
 
     void pbr_frame_graph::resize_render_targets(uint32_t width, uint32_t height)
     {
-        _executor->resize_render_target(_pass_output_resource_handles.depth_prepass.depth, width, height);
-        _executor->resize_render_target(_pass_output_resource_handles.depth_prepass.encoded_normals, width, height);
-        _executor->resize_render_target(_pass_output_resource_handles.hierarchical_z_buffer.hzb, width, height);
-        _executor->resize_render_target(_pass_output_resource_handles.ssao.ssao_output, width, height);
-        _executor->resize_render_target(_pass_output_resource_handles.pbr_opaque.hdr_color, width, height);
-        _executor->resize_render_target(_pass_output_resource_handles.ssao_blur.ssao_blurred_output, width, height);
-        _executor->resize_render_target(_pass_output_resource_handles.tonemapping.tonemapped_color, width, height);
-        _executor->resize_render_target(_pass_output_resource_handles.mboit_gather.transparency_accumulation, width,
-                                        height);
-        _executor->resize_render_target(_pass_output_resource_handles.mboit_gather.moments_buffer, width, height);
-        _executor->resize_render_target(_pass_output_resource_handles.mboit_gather.zeroth_moment_buffer, width, height);
+        const auto render_targets = array<graph_resource_handle<rhi::rhi_handle_type::image>, 10>{
+            _pass_output_resource_handles.depth_prepass.depth,
+            _pass_output_resource_handles.depth_prepass.encoded_normals,
+            _pass_output_resource_handles.hierarchical_z_buffer.hzb,
+            _pass_output_resource_handles.ssao.ssao_output,
+            _pass_output_resource_handles.pbr_opaque.hdr_color,
+            _pass_output_resource_handles.ssao_blur.ssao_blurred_output,
+            _pass_output_resource_handles.tonemapping.tonemapped_color,
+            _pass_output_resource_handles.mboit_gather.transparency_accumulation,
+            _pass_output_resource_handles.mboit_gather.moments_buffer,
+            _pass_output_resource_handles.mboit_gather.zeroth_moment_buffer,
+        };
+
+        _executor->resize_render_targets(render_targets, width, height);
 
         _cfg.render_target_width = width;
         _cfg.render_target_height = height;
@@ -103,8 +107,15 @@ namespace tempest::graphics
         auto exec_plan = move(_builder).value().compile(cfg);
 
         _builder = none();
-        _executor = graph_executor(*_device);
+        _executor.emplace(*_device, _inputs.jobs);
         _executor->set_execution_plan(tempest::move(exec_plan));
+
+        // The executor owns freshly created buffers, so every copy needs the full scene again
+        _gpu_scene.objects->invalidate();
+        for (auto& instances : _gpu_scene.uploaded_instances)
+        {
+            instances.clear();
+        }
     }
 
     void pbr_frame_graph::execute()
@@ -318,9 +329,11 @@ namespace tempest::graphics
         });
 
         _global_resources.graph_object_buffer = object_buffer;
+        _gpu_scene.objects.emplace(_device->frames_in_flight(), _cfg.max_object_count);
+        _gpu_scene.uploaded_instances.resize(_device->frames_in_flight());
 
         auto instance_buffer = _builder->create_per_frame_buffer({
-            .size = _cfg.max_object_count * sizeof(uint32_t),
+            .size = _cfg.max_object_count * max_view_instances_per_object * sizeof(uint32_t),
             .location = rhi::memory_location::device,
             .usage = make_enum_mask(rhi::buffer_usage::structured, rhi::buffer_usage::transfer_dst),
             .access_type = rhi::host_access_type::none,
@@ -1729,6 +1742,8 @@ namespace tempest::graphics
                                make_enum_mask(rhi::pipeline_stage::all_fragment_tests),
                                make_enum_mask(rhi::memory_access::depth_stencil_attachment_write));
                 }
+
+                task.record_in_parallel();
             },
             &_shadow_map_pass_task, this, descriptor_buffer);
 
@@ -2178,6 +2193,8 @@ namespace tempest::graphics
                 task.write(hdr_color_output, rhi::image_layout::color_attachment,
                            make_enum_mask(rhi::pipeline_stage::color_attachment_output),
                            make_enum_mask(rhi::memory_access::color_attachment_write));
+
+                task.record_in_parallel();
             },
             &_pbr_opaque_pass_task, this, scene_descriptor_buffer, shadow_descriptor_buffer);
 
@@ -2560,6 +2577,8 @@ namespace tempest::graphics
                                 make_enum_mask(rhi::memory_access::shader_read),
                                 make_enum_mask(rhi::pipeline_stage::fragment_shader),
                                 make_enum_mask(rhi::memory_access::shader_write));
+
+                task.record_in_parallel();
             },
             &_mboit_gather_pass_task, this, scene_descriptor_buffer, shadow_descriptor_buffer);
 
@@ -3230,6 +3249,11 @@ namespace tempest::graphics
 
         self->_scene_data.primary_camera = scene_constants_data.cam;
 
+        // Culling view 0 is the primary camera, every shadow cascade adds a view of its own
+        self->_culling.views.clear();
+        self->_culling.views.push_back(frustum::from_view_projection(projection * view));
+        self->_prepare_directional_shadows(*camera_data, *camera_transform);
+
         // Set up the lights
         self->_inputs.entity_registry->each([&](ecs::self_component self_entity, point_light_component point_light,
                                                 const ecs::transform_component& transform) {
@@ -3313,10 +3337,11 @@ namespace tempest::graphics
         scene_constants_data.sun = self->_scene_data.dir_lights[sun_entity];
 
         // Build out the draw commands
-        for (auto&& [_, draw_batch] : self->_drawables.draw_batches)
-        {
-            draw_batch.commands.clear();
-        }
+        self->_culling.bounds.clear();
+        self->_culling.objects.clear();
+
+        auto& gpu_objects = *self->_gpu_scene.objects;
+        gpu_objects.begin_update();
 
         auto entity_registry = self->_inputs.entity_registry;
         entity_registry->each([&](ecs::self_component self_entity, renderable_component renderable) {
@@ -3330,16 +3355,33 @@ namespace tempest::graphics
                 .self_id = static_cast<uint32_t>(renderable.object_id),
             };
 
-            auto ancestors = ecs::archetype_entity_ancestor_view(*entity_registry, entity);
-            for (auto ancestor : ancestors)
+            if (auto world_tx = entity_registry->try_get<ecs::world_transform_component>(entity))
+            {
+                // Maintained by the transform propagation system, only dirty subtrees are recomputed
+                object_payload.model = world_tx->matrix;
+                object_payload.inv_tranpose_model = world_tx->inv_transpose;
+            }
+            else
             {
-                if (auto parent_tx = entity_registry->try_get<ecs::transform_component>(ancestor))
+                auto ancestors = ecs::archetype_entity_ancestor_view(*entity_registry, entity);
+                for (auto ancestor : ancestors)
                 {
-                    object_payload.model = parent_tx->matrix() * object_payload.model;
+                    if (auto parent_tx = entity_registry->try_get<ecs::transform_component>(ancestor))
+                    {
+                        object_payload.model = parent_tx->matrix() * object_payload.model;
+                    }
                 }
+
+                object_payload.inv_tranpose_model = math::transpose(math::inverse(object_payload.model));
             }
 
-            object_payload.inv_tranpose_model = math::transpose(math::inverse(object_payload.model));
+            // Unchanged objects keep their slot and are not marked for upload
+            const auto slot = gpu_objects.write(entity, object_payload);
+            if (!slot.has_value()) [[unlikely]]
+            {
+                // Object buffer is full, the renderable is not drawn
+                return;
+            }
 
             const auto alpha = static_cast<alpha_behavior>(self->_materials.materials[renderable.material_id].type);
             const auto key = draw_batch_key{
@@ -3347,35 +3389,118 @@ namespace tempest::graphics
                 .double_sided = renderable.double_sided,
             };
 
-            auto& draw_batch = self->_drawables.draw_batches[key];
-            const auto& mesh = self->_meshes.meshes[renderable.mesh_id];
+            // Create the batch up front so batches are not inserted while views are being built
+            (void)self->_drawables.draw_batches[key];
+
+            self->_culling.bounds.push_back(
+                transform_bounding_sphere(self->_meshes.bounds[renderable.mesh_id], object_payload.model));
+            self->_culling.objects.push_back({
+                .key = key,
+                .instance =
+                    {
+                        .mesh_id = static_cast<uint32_t>(renderable.mesh_id),
+                        .object_slot = *slot,
+                    },
+            });
+        });
+
+        // Renderables that were destroyed or lost their renderable component give their slots back
+        gpu_objects.end_update();
+
+        auto& instances = self->_gpu_scene.instances;
+        instances.clear();
+
+        auto& commands = self->_drawables.commands;
+        commands.clear();
+
+        const auto view_count = self->_culling.views.size();
+        const auto instance_capacity = static_cast<size_t>(self->_cfg.max_object_count) * max_view_instances_per_object;
+        const auto command_capacity = static_cast<size_t>(self->_cfg.max_object_count);
+
+        for (auto&& [_, draw_batch] : self->_drawables.draw_batches)
+        {
+            draw_batch.views.clear();
+            draw_batch.views.resize(view_count, draw_batch_view{
+                                                    .indirect_command_offset = 0,
+                                                    .command_count = 0,
+                                                });
+        }
+
+        for (size_t view_index = 0; view_index < view_count; ++view_index)
+        {
+            auto& visible = self->_culling.visible;
+            visible.clear();
+            self->_culling.bounds.cull(self->_culling.views[view_index], visible);
 
-            if (draw_batch.objects.find(entity) == draw_batch.objects.end())
+            // Each visible object adds one instance, views that do not fit are not drawn
+            if (instances.size() + visible.size() > instance_capacity) [[unlikely]]
             {
-                draw_batch.objects.insert(entity, object_payload);
+                continue;
             }
-            else
+
+            const auto view_first_instance = instances.size();
+            const auto view_first_command = commands.size();
+
+            for (const auto object_index : visible)
             {
-                draw_batch.objects[entity] = object_payload;
+                const auto& object = self->_culling.objects[object_index];
+                self->_drawables.draw_batches.find(object.key)->second.instances.push_back(object.instance);
             }
 
-            draw_batch.commands.push_back({
-                .index_count = mesh.index_count,
-                .instance_count = 1,
-                .first_index = (mesh.mesh_start_offset + mesh.index_offset) / static_cast<uint32_t>(sizeof(uint32_t)),
-                .vertex_offset = 0,
-                .first_instance = static_cast<uint32_t>(draw_batch.objects.index_of(entity)),
-            });
-        });
+            for (auto&& [_, draw_batch] : self->_drawables.draw_batches)
+            {
+                // Materials are fetched per object, so every instance of a mesh in the batch shares one command.
+                // Sorting by slot within a mesh keeps the instance buffer identical across frames while the scene is
+                // unchanged.
+                std::sort(draw_batch.instances.begin(), draw_batch.instances.end());
 
-        auto instance_written_count = 0u;
-        for (const auto& [_, batch] : self->_drawables.draw_batches)
-        {
-            for (auto& cmd : batch.commands)
+                const auto first_command = commands.size();
+
+                for (size_t first = 0; first < draw_batch.instances.size();)
+                {
+                    const auto mesh_id = draw_batch.instances[first].mesh_id;
+
+                    auto last = first;
+                    while (last < draw_batch.instances.size() && draw_batch.instances[last].mesh_id == mesh_id)
+                    {
+                        instances.push_back(draw_batch.instances[last].object_slot);
+                        ++last;
+                    }
+
+                    const auto& mesh = self->_meshes.meshes[mesh_id];
+                    commands.push_back({
+                        .index_count = mesh.index_count,
+                        .instance_count = static_cast<uint32_t>(last - first),
+                        .first_index =
+                            (mesh.mesh_start_offset + mesh.index_offset) / static_cast<uint32_t>(sizeof(uint32_t)),
+                        .vertex_offset = 0,
+                        .first_instance = static_cast<uint32_t>(instances.size() - (last - first)),
+                    });
+
+                    first = last;
+                }
+
+                draw_batch.views[view_index] = {
+                    .indirect_command_offset = first_command,
+                    .command_count = static_cast<uint32_t>(commands.size() - first_command),
+                };
+                draw_batch.instances.clear();
+            }
+
+            // Instances of a mesh share a command, so whether the commands fit is only known once the view is built
+            if (commands.size() > command_capacity) [[unlikely]]
             {
-                cmd.first_instance += instance_written_count;
+                instances.resize(view_first_instance);
+                commands.resize(view_first_command);
+
+                for (auto&& [_, draw_batch] : self->_drawables.draw_batches)
+                {
+                    draw_batch.views[view_index] = {
+                        .indirect_command_offset = 0,
+                        .command_count = 0,
+                    };
+                }
             }
-            instance_written_count += static_cast<uint32_t>(batch.objects.size());
         }
 
         // Copy scene constants to staging buffer
@@ -3386,23 +3511,24 @@ namespace tempest::graphics
 
         staging_bytes_written += sizeof(scene_constants);
 
-        // Upload the object data buffer
+        // Upload the object data that changed since this frame's copy of the object buffer was last written
 
         const auto object_buffer = self->_global_resources.graph_object_buffer;
-        auto object_buffer_offset = self->_executor->get_current_frame_resource_offset(object_buffer);
-        auto object_buffer_written = static_cast<size_t>(0u);
+        const auto object_buffer_offset = self->_executor->get_current_frame_resource_offset(object_buffer);
+        const auto object_buffer_copy =
+            static_cast<uint32_t>(object_buffer_offset / self->_executor->get_resource_size(object_buffer));
 
         const auto object_buffer_staging_offset = staging_bytes_written;
+        const auto dirty_objects = gpu_objects.take_dirty_ranges(object_buffer_copy);
 
-        for (auto&& [_, draw_batch] : self->_drawables.draw_batches)
+        for (const auto& range : dirty_objects)
         {
             std::memcpy(staging_buffer_bytes + staging_buffer_offset + staging_bytes_written,
-                        draw_batch.objects.values(), draw_batch.objects.size() * sizeof(object_data));
-            staging_bytes_written += draw_batch.objects.size() * sizeof(object_data);
-            object_buffer_written += draw_batch.objects.size() * sizeof(object_data);
+                        gpu_objects.data() + range.first, range.count * sizeof(object_data));
+            staging_bytes_written += range.count * sizeof(object_data);
         }
 
-        // Write instances
+        // Write instances, only when the draw layout differs from the one in this frame's copy
 
         auto instance_buffer = self->_global_resources.graph_instance_buffer;
         auto instance_buffer_offset = self->_executor->get_current_frame_resource_offset(instance_buffer);
@@ -3410,18 +3536,15 @@ namespace tempest::graphics
 
         const auto instance_buffer_staging_offset = staging_bytes_written;
 
-        auto instances_written = 0u;
-        for (auto&& [_, draw_batch] : self->_drawables.draw_batches)
+        auto& uploaded_instances = self->_gpu_scene.uploaded_instances[object_buffer_copy];
+        if (uploaded_instances != instances)
         {
-            auto instance_indices = vector<uint32_t>{draw_batch.objects.size()};
-            std::iota(instance_indices.begin(), instance_indices.end(), instances_written);
-            std::memcpy(staging_buffer_bytes + staging_buffer_offset + staging_bytes_written, instance_indices.data(),
-                        instance_indices.size() * sizeof(uint32_t));
-            staging_bytes_written += instance_indices.size() * sizeof(uint32_t);
-            draw_batch.indirect_command_offset = instances_written;
-
-            instances_written += static_cast<uint32_t>(draw_batch.objects.size());
-            instance_bytes_written += draw_batch.objects.size() * sizeof(uint32_t);
+            std::memcpy(staging_buffer_bytes + staging_buffer_offset + staging_bytes_written, instances.data(),
+                        instances.size() * sizeof(uint32_t));
+            staging_bytes_written += instances.size() * sizeof(uint32_t);
+            instance_bytes_written += instances.size() * sizeof(uint32_t);
+
+            uploaded_instances = instances;
         }
 
         // Upload the point and spot lights
@@ -3452,13 +3575,22 @@ namespace tempest::graphics
                                       self->_pass_output_resource_handles.upload_pass.scene_constants),
                                   sizeof(scene_constants));
 
-        ctx.copy_buffer_to_buffer(
-            self->_global_resources.graph_per_frame_staging_buffer, self->_global_resources.graph_object_buffer,
-            staging_buffer_offset + object_buffer_staging_offset, object_buffer_offset, object_buffer_written);
+        auto object_staging_offset = staging_buffer_offset + object_buffer_staging_offset;
+        for (const auto& range : dirty_objects)
+        {
+            const auto range_bytes = range.count * sizeof(object_data);
+            ctx.copy_buffer_to_buffer(self->_global_resources.graph_per_frame_staging_buffer,
+                                      self->_global_resources.graph_object_buffer, object_staging_offset,
+                                      object_buffer_offset + range.first * sizeof(object_data), range_bytes);
+            object_staging_offset += range_bytes;
+        }
 
-        ctx.copy_buffer_to_buffer(
-            self->_global_resources.graph_per_frame_staging_buffer, self->_global_resources.graph_instance_buffer,
-            staging_buffer_offset + instance_buffer_staging_offset, instance_buffer_offset, instance_bytes_written);
+        if (instance_bytes_written > 0)
+        {
+            ctx.copy_buffer_to_buffer(
+                self->_global_resources.graph_per_frame_staging_buffer, self->_global_resources.graph_instance_buffer,
+                staging_buffer_offset + instance_buffer_staging_offset, instance_buffer_offset, instance_bytes_written);
+        }
 
         ctx.copy_buffer_to_buffer(
             self->_global_resources.graph_per_frame_staging_buffer, self->_global_resources.graph_light_buffer,
@@ -3467,13 +3599,9 @@ namespace tempest::graphics
         // Upload draw commands
         const auto draw_command_buffer = self->_pass_output_resource_handles.upload_pass.draw_commands;
         auto draw_command_bytes = self->_device->map_buffer(self->_executor->get_buffer(draw_command_buffer));
-        auto draw_command_offset = self->_executor->get_current_frame_resource_offset(draw_command_buffer);
-        for (auto&& [_, draw_batch] : self->_drawables.draw_batches)
-        {
-            std::memcpy(draw_command_bytes + draw_command_offset, draw_batch.commands.data(),
-                        sizeof(indexed_indirect_command) * draw_batch.commands.size());
-            draw_command_offset += sizeof(indexed_indirect_command) * draw_batch.commands.size();
-        }
+        const auto draw_command_offset = self->_executor->get_current_frame_resource_offset(draw_command_buffer);
+        std::memcpy(draw_command_bytes + draw_command_offset, commands.data(),
+                    sizeof(indexed_indirect_command) * commands.size());
         self->_device->unmap_buffer(self->_executor->get_buffer(draw_command_buffer));
 
         self->_global_resources.utilization.staging_buffer_bytes_written +=
@@ -3617,11 +3745,12 @@ namespace tempest::graphics
         {
             if (key.alpha_type == alpha_behavior::opaque)
             {
+                const auto& batch_view = draw_batch.views[primary_culling_view];
                 ctx.draw_indirect(
                     draw_command_buffer,
                     static_cast<uint32_t>(draw_command_buffer_offset +
-                                          draw_batch.indirect_command_offset * sizeof(indexed_indirect_command)),
-                    static_cast<uint32_t>(draw_batch.commands.size()), sizeof(indexed_indirect_command));
+                                          batch_view.indirect_command_offset * sizeof(indexed_indirect_command)),
+                    batch_view.command_count, sizeof(indexed_indirect_command));
             }
         }
 
@@ -4059,79 +4188,9 @@ namespace tempest::graphics
         auto staging_buffer_bytes = self->_device->map_buffer(
             self->_executor->get_buffer(self->_global_resources.graph_per_frame_staging_buffer));
 
-        auto camera = ecs::entity{ecs::tombstone};
-        auto camera_data = optional<camera_component>();
-        auto camera_transform = optional<ecs::transform_component>();
-
-        self->_inputs.entity_registry->each(
-            [&](ecs::self_component entity, const camera_component& cam_comp, const ecs::transform_component& tx) {
-                camera = entity.entity;
-                camera_data = cam_comp;
-                camera_transform = tx;
-            });
-
-        self->_directional_shadows.directional_shadows.clear();
-        auto gpu_shadow_data = shadow_gpu_layout{};
-        auto shadowed_dir_light_count = 0u;
-
-        // Reset usage
-        for (auto& img : self->_directional_shadows.atlas_pool.atlas_slots)
-        {
-            img.in_use = false;
-        }
-
-        self->_inputs.entity_registry->each([&]([[maybe_unused]] directional_light_component light,
-                                                const ecs::transform_component& transform, shadow_map_component shadows,
-                                                ecs::self_component self_entity) {
-            if (self->_directional_shadows.directional_shadows.size() >=
-                self->_directional_shadows.atlas_pool.atlas_slots.size())
-            {
-                return;
-            }
-
-            // Create a camera with corrected aspect ratio matching the actual render target
-            auto corrected_camera = *camera_data;
-            corrected_camera.aspect_ratio = static_cast<float>(self->_cfg.render_target_width) /
-                                            static_cast<float>(self->_cfg.render_target_height);
-
-            auto csm_data = self->_create_shadow_data(
-                transform, shadows, corrected_camera, *camera_transform,
-                {self->_cfg.shadows.directional_shadow_map_width, self->_cfg.shadows.directional_shadow_map_height});
-
-            // Build the GPU shadow data
-            gpu_shadow_data.directional_lights[shadowed_dir_light_count] =
-                shadow_gpu_layout::directional_shadow_gpu_layout{};
-            gpu_shadow_data.directional_lights[shadowed_dir_light_count].cascade_count = shadows.cascade_count;
-            gpu_shadow_data.directional_lights[shadowed_dir_light_count].atlas_index =
-                csm_data.directional_light_atlas_index;
-            gpu_shadow_data.directional_lights[shadowed_dir_light_count].inv_atlas_resolution =
-                math::vec2<float>{1.0f / static_cast<float>(csm_data.atlas_resolution.x),
-                                  1.0f / static_cast<float>(csm_data.atlas_resolution.y)};
-
-            for (auto i = 0u; i < shadows.cascade_count; ++i)
-            {
-                gpu_shadow_data.directional_lights[shadowed_dir_light_count].cascades[i] = {
-                    .light_view_projection = csm_data.cascades[i].light_view_projection,
-                    .atlas_offset = math::vec2<float>(static_cast<float>(csm_data.cascades[i].atlas_offset.x) /
-                                                          static_cast<float>(csm_data.atlas_resolution.x),
-                                                      static_cast<float>(csm_data.cascades[i].atlas_offset.y) /
-                                                          static_cast<float>(csm_data.atlas_resolution.y)),
-                    .atlas_scale = math::vec2<float>(static_cast<float>(csm_data.cascades[i].cascade_resolution.x) /
-                                                         static_cast<float>(csm_data.atlas_resolution.x),
-                                                     static_cast<float>(csm_data.cascades[i].cascade_resolution.y) /
-                                                         static_cast<float>(csm_data.atlas_resolution.y)),
-                    .split_depth = csm_data.cascades[i].split_depth,
-                    .blend_start = csm_data.cascades[i].blend_start,
-                    .texel_size_ws = csm_data.cascades[i].texel_size_ws,
-                    .cascade_index = i,
-                };
-            }
-
-            self->_directional_shadows.atlas_pool.atlas_slots[csm_data.directional_light_atlas_index].in_use = true;
-            self->_directional_shadows.directional_shadows.insert(make_pair(self_entity.entity, std::move(csm_data)));
-
-            ++shadowed_dir_light_count;
-        });
+        // Cascades were built by the frame upload pass, which culls the scene against them
+        const auto& gpu_shadow_data = self->_directional_shadow_gpu_data;
+        const auto shadowed_dir_light_count = gpu_shadow_data.directional_light_count;
 
         // Upload shadows
         auto shadow_data_buffer = self->_pass_output_resource_handles.shadow_map.shadow_data;
@@ -4141,7 +4200,6 @@ namespace tempest::graphics
 
         if (shadowed_dir_light_count > 0)
         {
-            gpu_shadow_data.directional_light_count = shadowed_dir_light_count;
             std::memcpy(staging_buffer_bytes + staging_buffer_offset +
                             self->_global_resources.utilization.staging_buffer_bytes_written,
                         &gpu_shadow_data, sizeof(shadow_gpu_layout::directional_shadow_gpu_layout));
@@ -4327,11 +4385,13 @@ namespace tempest::graphics
                 {
                     if (key.alpha_type == alpha_behavior::opaque || key.alpha_type == alpha_behavior::mask)
                     {
+                        // Only the renderables inside this cascade's volume
+                        const auto& batch_view = draw_batch.views[cascade.culling_view];
                         ctx.draw_indirect(
                             draw_command_buffer,
-                            static_cast<uint32_t>(draw_command_buffer_offset + draw_batch.indirect_command_offset *
+                            static_cast<uint32_t>(draw_command_buffer_offset + batch_view.indirect_command_offset *
                                                                                    sizeof(indexed_indirect_command)),
-                            static_cast<uint32_t>(draw_batch.commands.size()), sizeof(indexed_indirect_command));
+                            batch_view.command_count, sizeof(indexed_indirect_command));
                     }
                 }
             }
@@ -4648,10 +4708,11 @@ namespace tempest::graphics
         {
             if (key.alpha_type == alpha_behavior::opaque || key.alpha_type == alpha_behavior::mask)
             {
+                const auto& batch_view = batch.views[primary_culling_view];
                 ctx.draw_indirect(self->_pass_output_resource_handles.upload_pass.draw_commands,
-                                  static_cast<uint32_t>(indirect_command_offset + batch.indirect_command_offset *
+                                  static_cast<uint32_t>(indirect_command_offset + batch_view.indirect_command_offset *
                                                                                       sizeof(indexed_indirect_command)),
-                                  static_cast<uint32_t>(batch.commands.size()),
+                                  batch_view.command_count,
                                   static_cast<uint32_t>(sizeof(indexed_indirect_command)));
             }
         }
@@ -4911,10 +4972,11 @@ namespace tempest::graphics
         {
             if (key.alpha_type == alpha_behavior::transmissive || key.alpha_type == alpha_behavior::transparent)
             {
+                const auto& batch_view = batch.views[primary_culling_view];
                 ctx.draw_indirect(self->_pass_output_resource_handles.upload_pass.draw_commands,
-                                  static_cast<uint32_t>(indirect_command_offset + batch.indirect_command_offset *
+                                  static_cast<uint32_t>(indirect_command_offset + batch_view.indirect_command_offset *
                                                                                       sizeof(indexed_indirect_command)),
-                                  static_cast<uint32_t>(batch.commands.size()),
+                                  batch_view.command_count,
                                   static_cast<uint32_t>(sizeof(indexed_indirect_command)));
             }
         }
@@ -5174,10 +5236,11 @@ namespace tempest::graphics
         {
             if (key.alpha_type == alpha_behavior::transmissive || key.alpha_type == alpha_behavior::transparent)
             {
+                const auto& batch_view = batch.views[primary_culling_view];
                 ctx.draw_indirect(self->_pass_output_resource_handles.upload_pass.draw_commands,
-                                  static_cast<uint32_t>(indirect_command_offset + batch.indirect_command_offset *
+                                  static_cast<uint32_t>(indirect_command_offset + batch_view.indirect_command_offset *
                                                                                       sizeof(indexed_indirect_command)),
-                                  static_cast<uint32_t>(batch.commands.size()),
+                                  batch_view.command_count,
                                   static_cast<uint32_t>(sizeof(indexed_indirect_command)));
             }
         }
@@ -5330,6 +5393,7 @@ namespace tempest::graphics
     void pbr_frame_graph::_load_meshes(span<const guid> mesh_ids, const core::mesh_registry& mesh_registry)
     {
         auto result = flat_unordered_map<guid, mesh_layout>{};
+        auto result_bounds = flat_unordered_map<guid, bounding_sphere>{};
 
         auto bytes_written = 0u;
         auto vertex_bytes_required = 0u;
@@ -5409,6 +5473,7 @@ namespace tempest::graphics
             layout.index_count = static_cast<uint32_t>(mesh.indices.size());
 
             result[mesh_id] = layout;
+            result_bounds[mesh_id] = compute_bounding_sphere(mesh.vertices);
 
             // Position attribute
             size_t vertices_written = 0;
@@ -5458,6 +5523,7 @@ namespace tempest::graphics
 
             _meshes.mesh_to_index.insert({guid, _meshes.meshes.size()});
             _meshes.meshes.push_back(layout);
+            _meshes.bounds.push_back(result_bounds[guid]);
         }
 
         // Flush the staging buffer
@@ -5942,6 +6008,76 @@ namespace tempest::graphics
         }
     } // namespace
 
+    void pbr_frame_graph::_prepare_directional_shadows(const camera_component& cam,
+                                                       const ecs::transform_component& camera_transform)
+    {
+        _directional_shadows.directional_shadows.clear();
+        _directional_shadow_gpu_data = shadow_gpu_layout{};
+        auto shadowed_dir_light_count = 0u;
+
+        // Reset usage
+        for (auto& img : _directional_shadows.atlas_pool.atlas_slots)
+        {
+            img.in_use = false;
+        }
+
+        _inputs.entity_registry->each([&]([[maybe_unused]] directional_light_component light,
+                                          const ecs::transform_component& transform, shadow_map_component shadows,
+                                          ecs::self_component self_entity) {
+            if (_directional_shadows.directional_shadows.size() >= _directional_shadows.atlas_pool.atlas_slots.size())
+            {
+                return;
+            }
+
+            // Create a camera with corrected aspect ratio matching the actual render target
+            auto corrected_camera = cam;
+            corrected_camera.aspect_ratio =
+                static_cast<float>(_cfg.render_target_width) / static_cast<float>(_cfg.render_target_height);
+
+            auto csm_data = _create_shadow_data(
+                transform, shadows, corrected_camera, camera_transform,
+                {_cfg.shadows.directional_shadow_map_width, _cfg.shadows.directional_shadow_map_height});
+
+            // Build the GPU shadow data
+            auto& gpu_light = _directional_shadow_gpu_data.directional_lights[shadowed_dir_light_count];
+            gpu_light = shadow_gpu_layout::directional_shadow_gpu_layout{};
+            gpu_light.cascade_count = shadows.cascade_count;
+            gpu_light.atlas_index = csm_data.directional_light_atlas_index;
+            gpu_light.inv_atlas_resolution = math::vec2<float>{1.0f / static_cast<float>(csm_data.atlas_resolution.x),
+                                                               1.0f / static_cast<float>(csm_data.atlas_resolution.y)};
+
+            for (auto i = 0u; i < shadows.cascade_count; ++i)
+            {
+                gpu_light.cascades[i] = {
+                    .light_view_projection = csm_data.cascades[i].light_view_projection,
+                    .atlas_offset = math::vec2<float>(static_cast<float>(csm_data.cascades[i].atlas_offset.x) /
+                                                          static_cast<float>(csm_data.atlas_resolution.x),
+                                                      static_cast<float>(csm_data.cascades[i].atlas_offset.y) /
+                                                          static_cast<float>(csm_data.atlas_resolution.y)),
+                    .atlas_scale = math::vec2<float>(static_cast<float>(csm_data.cascades[i].cascade_resolution.x) /
+                                                         static_cast<float>(csm_data.atlas_resolution.x),
+                                                     static_cast<float>(csm_data.cascades[i].cascade_resolution.y) /
+                                                         static_cast<float>(csm_data.atlas_resolution.y)),
+                    .split_depth = csm_data.cascades[i].split_depth,
+                    .blend_start = csm_data.cascades[i].blend_start,
+                    .texel_size_ws = csm_data.cascades[i].texel_size_ws,
+                    .cascade_index = i,
+                };
+
+                // Each cascade draws the renderables inside its own light space volume
+                csm_data.cascades[i].culling_view = static_cast<uint32_t>(_culling.views.size());
+                _culling.views.push_back(frustum::from_view_projection(csm_data.cascades[i].light_view_projection));
+            }
+
+            _directional_shadows.atlas_pool.atlas_slots[csm_data.directional_light_atlas_index].in_use = true;
+            _directional_shadows.directional_shadows.insert(make_pair(self_entity.entity, std::move(csm_data)));
+
+            ++shadowed_dir_light_count;
+        });
+
+        _directional_shadow_gpu_data.directional_light_count = shadowed_dir_light_count;
+    }
+
     pbr_frame_graph::csm_shadow_data pbr_frame_graph::_create_shadow_data(
         const ecs::transform_component& light_transform, const shadow_map_component& shadow_comp,
         const camera_component& cam, const ecs::transform_component& camera_transform, math::uint2 atlas_resolution)
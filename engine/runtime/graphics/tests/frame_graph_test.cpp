@@ -1,7 +1,12 @@
 #include <tempest/frame_graph.hpp>
+#include <tempest/job_system.hpp>
+#include <tempest/rhi/mock/mock_device.hpp>
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <thread>
+
 TEST(frame_graph, simple_frame_graph)
 {
     using namespace tempest;
@@ -569,3 +574,728 @@ TEST(frame_graph, dynamic_pass_enabling)
     ASSERT_EQ(plan.submissions.size(), 1);
     ASSERT_EQ(plan.submissions[0].passes.size(), 4);
 }
+
+namespace
+{
+    tempest::rhi::image_desc make_transient_image_desc(tempest::string name)
+    {
+        using namespace tempest;
+
+        return {
+            .format = rhi::image_format::rgba16_float,
+            .type = rhi::image_type::image_2d,
+            .width = 1920,
+            .height = 1080,
+            .depth = 1,
+            .array_layers = 1,
+            .mip_levels = 1,
+            .sample_count = rhi::image_sample_count::sample_count_1,
+            .tiling = rhi::image_tiling_type::optimal,
+            .location = rhi::memory_location::device,
+            .usage = make_enum_mask(rhi::image_usage::color_attachment, rhi::image_usage::sampled),
+            .name = tempest::move(name),
+        };
+    }
+} // namespace
+
+TEST(frame_graph, transient_resources_share_heap)
+{
+    using namespace tempest;
+
+    auto builder = graphics::graph_builder{};
+    auto render_surface_handle = rhi::typed_rhi_handle<rhi::rhi_handle_type::render_surface>{.id = 1, .generation = 0};
+
+    auto first = builder.create_image(make_transient_image_desc("First"));
+    auto second = builder.create_image(make_transient_image_desc("Second"));
+    auto third = builder.create_image(make_transient_image_desc("Third"));
+    auto surface = builder.import_render_surface("Main Window Surface", render_surface_handle);
+
+    builder.create_graphics_pass(
+        "Write First",
+        [&](graphics::graphics_task_builder& task) { task.write(first, rhi::image_layout::color_attachment); },
+        []([[maybe_unused]] graphics::graphics_task_execution_context& ctx) {});
+
+    builder.create_graphics_pass(
+        "First To Second",
+        [&](graphics::graphics_task_builder& task) {
+            task.read(first, rhi::image_layout::shader_read_only);
+            task.write(second, rhi::image_layout::color_attachment);
+        },
+        []([[maybe_unused]] graphics::graphics_task_execution_context& ctx) {});
+
+    builder.create_graphics_pass(
+        "Second To Third",
+        [&](graphics::graphics_task_builder& task) {
+            task.read(second, rhi::image_layout::shader_read_only);
+            task.write(third, rhi::image_layout::color_attachment);
+        },
+        []([[maybe_unused]] graphics::graphics_task_execution_context& ctx) {});
+
+    builder.create_graphics_pass(
+        "Present",
+        [&](graphics::graphics_task_builder& task) {
+            task.read(third, rhi::image_layout::shader_read_only);
+            task.write(surface, rhi::image_layout::color_attachment);
+        },
+        []([[maybe_unused]] graphics::graphics_task_execution_context& ctx) {});
+
+    auto queue_cfg = graphics::queue_configuration{
+        .graphics_queues = 1,
+        .compute_queues = 0,
+        .transfer_queues = 0,
+    };
+
+    auto plan = tempest::move(builder).compile(queue_cfg);
+
+    ASSERT_EQ(plan.submissions.size(), 1);
+    const auto& passes = plan.submissions[0].passes;
+    ASSERT_EQ(passes.size(), 4);
+
+    // First and third are never alive at the same time, second overlaps both
+    ASSERT_EQ(plan.transient_heaps.size(), 1);
+    const auto& heap = plan.transient_heaps[0];
+    EXPECT_EQ(heap.queue, graphics::work_type::graphics);
+    EXPECT_EQ(heap.resource_type, rhi::rhi_handle_type::image);
+    ASSERT_EQ(heap.resources.size(), 2);
+    EXPECT_EQ(heap.resources[0].handle, first.handle);
+    EXPECT_EQ(heap.resources[1].handle, third.handle);
+
+    for (const auto& resource : plan.resources)
+    {
+        if (resource.handle.handle == first.handle || resource.handle.handle == third.handle)
+        {
+            EXPECT_EQ(resource.heap_index, 0u);
+        }
+        else
+        {
+            EXPECT_EQ(resource.heap_index, graphics::no_transient_heap);
+        }
+    }
+
+    // Each member takes over the memory in the pass that first uses it
+    ASSERT_EQ(passes[0].aliasing_barriers.size(), 1);
+    EXPECT_EQ(passes[0].aliasing_barriers[0].before.handle, third.handle);
+    EXPECT_EQ(passes[0].aliasing_barriers[0].after.handle, first.handle);
+
+    EXPECT_TRUE(passes[1].aliasing_barriers.empty());
+
+    ASSERT_EQ(passes[2].aliasing_barriers.size(), 1);
+    EXPECT_EQ(passes[2].aliasing_barriers[0].before.handle, first.handle);
+    EXPECT_EQ(passes[2].aliasing_barriers[0].after.handle, third.handle);
+
+    EXPECT_TRUE(passes[3].aliasing_barriers.empty());
+}
+
+TEST(frame_graph, resources_with_persistent_contents_are_not_aliased)
+{
+    using namespace tempest;
+
+    auto builder = graphics::graph_builder{};
+    auto render_surface_handle = rhi::typed_rhi_handle<rhi::rhi_handle_type::render_surface>{.id = 1, .generation = 0};
+
+    auto history = builder.create_temporal_image(make_transient_image_desc("History"));
+    auto accumulated = builder.create_image(make_transient_image_desc("Accumulated"));
+    auto optional_output = builder.create_image(make_transient_image_desc("Optional Output"));
+    auto lit = builder.create_image(make_transient_image_desc("Lit"));
+    auto surface = builder.import_render_surface("Main Window Surface", render_surface_handle);
+
+    builder.create_graphics_pass(
+        "Write History",
+        [&](graphics::graphics_task_builder& task) { task.write(history, rhi::image_layout::color_attachment); },
+        []([[maybe_unused]] graphics::graphics_task_execution_context& ctx) {});
+
+    // Reads what the previous frame left behind
+    builder.create_graphics_pass(
+        "Accumulate",
+        [&](graphics::graphics_task_builder& task) {
+            task.read(history, rhi::image_layout::shader_read_only);
+            task.read_write(accumulated, rhi::image_layout::color_attachment);
+        },
+        []([[maybe_unused]] graphics::graphics_task_execution_context& ctx) {});
+
+    bool enabled = false;
+
+    builder.create_graphics_pass(
+        "Optional",
+        [&](graphics::graphics_task_builder& task) {
+            task.read(accumulated, rhi::image_layout::shader_read_only);
+            task.write(optional_output, rhi::image_layout::color_attachment);
+            task.enable_if([&] { return enabled; });
+        },
+        []([[maybe_unused]] graphics::graphics_task_execution_context& ctx) {});
+
+    builder.create_graphics_pass(
+        "Light",
+        [&](graphics::graphics_task_builder& task) {
+            task.read(optional_output, rhi::image_layout::shader_read_only);
+            task.write(lit, rhi::image_layout::color_attachment);
+        },
+        []([[maybe_unused]] graphics::graphics_task_execution_context& ctx) {});
+
+    builder.create_graphics_pass(
+        "Present",
+        [&](graphics::graphics_task_builder& task) {
+            task.read(lit, rhi::image_layout::shader_read_only);
+            task.write(surface, rhi::image_layout::color_attachment);
+        },
+        []([[maybe_unused]] graphics::graphics_task_execution_context& ctx) {});
+
+    auto queue_cfg = graphics::queue_configuration{
+        .graphics_queues = 1,
+        .compute_queues = 0,
+        .transfer_queues = 0,
+    };
+
+    auto plan = tempest::move(builder).compile(queue_cfg);
+
+    // Lit is the only resource free to alias, and it has nothing to share a heap with
+    EXPECT_TRUE(plan.transient_heaps.empty());
+    for (const auto& resource : plan.resources)
+    {
+        EXPECT_EQ(resource.heap_index, graphics::no_transient_heap);
+    }
+
+    for (const auto& submission : plan.submissions)
+    {
+        for (const auto& pass : submission.passes)
+        {
+            EXPECT_TRUE(pass.aliasing_barriers.empty());
+        }
+    }
+}
+
+TEST(frame_graph, barriers_are_precompiled)
+{
+    using namespace tempest;
+
+    auto builder = graphics::graph_builder{};
+    auto render_surface_handle = rhi::typed_rhi_handle<rhi::rhi_handle_type::render_surface>{.id = 1, .generation = 0};
+
+    auto uniforms = builder.create_per_frame_buffer({
+        .size = 256,
+        .location = rhi::memory_location::device,
+        .usage = make_enum_mask(rhi::buffer_usage::constant, rhi::buffer_usage::transfer_dst),
+        .access_type = rhi::host_access_type::none,
+        .access_pattern = rhi::host_access_pattern::none,
+        .name = "Uniforms",
+    });
+    auto color = builder.create_render_target(make_transient_image_desc("Color"));
+    auto surface = builder.import_render_surface("Main Window Surface", render_surface_handle);
+
+    builder.create_transfer_pass(
+        "Upload",
+        [&](graphics::transfer_task_builder& task) {
+            task.write(uniforms, make_enum_mask(rhi::pipeline_stage::copy),
+                       make_enum_mask(rhi::memory_access::transfer_write));
+        },
+        []([[maybe_unused]] graphics::transfer_task_execution_context& ctx) {});
+
+    builder.create_graphics_pass(
+        "Draw",
+        [&](graphics::graphics_task_builder& task) {
+            task.read(uniforms, make_enum_mask(rhi::pipeline_stage::vertex_shader),
+                      make_enum_mask(rhi::memory_access::constant_buffer_read));
+            task.write(color, rhi::image_layout::color_attachment);
+        },
+        []([[maybe_unused]] graphics::graphics_task_execution_context& ctx) {});
+
+    builder.create_graphics_pass(
+        "Present",
+        [&](graphics::graphics_task_builder& task) {
+            task.read(color, rhi::image_layout::shader_read_only);
+            task.write(surface, rhi::image_layout::color_attachment);
+        },
+        []([[maybe_unused]] graphics::graphics_task_execution_context& ctx) {});
+
+    auto queue_cfg = graphics::queue_configuration{
+        .graphics_queues = 1,
+        .compute_queues = 0,
+        .transfer_queues = 0,
+    };
+
+    auto plan = tempest::move(builder).compile(queue_cfg);
+
+    ASSERT_EQ(plan.submissions.size(), 1);
+    const auto& passes = plan.submissions[0].passes;
+    ASSERT_EQ(passes.size(), 3);
+
+    // The upload waits for the previous frame's reads of the buffer
+    ASSERT_EQ(passes[0].buffer_barriers.size(), 1);
+    EXPECT_EQ(passes[0].buffer_barriers[0].handle.handle, uniforms.handle);
+    EXPECT_EQ(passes[0].buffer_barriers[0].src_stages & make_enum_mask(rhi::pipeline_stage::vertex_shader),
+              make_enum_mask(rhi::pipeline_stage::vertex_shader));
+    EXPECT_EQ(passes[0].buffer_barriers[0].dst_access, make_enum_mask(rhi::memory_access::transfer_write));
+    EXPECT_TRUE(passes[0].buffer_barriers[0].per_frame);
+    EXPECT_TRUE(passes[0].image_barriers.empty());
+
+    ASSERT_EQ(passes[1].buffer_barriers.size(), 1);
+    EXPECT_EQ(passes[1].buffer_barriers[0].src_stages, make_enum_mask(rhi::pipeline_stage::copy));
+    EXPECT_EQ(passes[1].buffer_barriers[0].src_access, make_enum_mask(rhi::memory_access::transfer_write));
+    EXPECT_EQ(passes[1].buffer_barriers[0].dst_stages, make_enum_mask(rhi::pipeline_stage::vertex_shader));
+    EXPECT_EQ(passes[1].buffer_barriers[0].src_queue, graphics::work_type::unknown);
+    EXPECT_TRUE(passes[1].buffer_barriers[0].per_frame);
+
+    // The color target enters the frame in the layout the previous frame left it in
+    ASSERT_EQ(passes[1].image_barriers.size(), 1);
+    EXPECT_EQ(passes[1].image_barriers[0].handle.handle, color.handle);
+    EXPECT_EQ(passes[1].image_barriers[0].old_layout, rhi::image_layout::shader_read_only);
+    EXPECT_EQ(passes[1].image_barriers[0].new_layout, rhi::image_layout::color_attachment);
+    EXPECT_TRUE(passes[1].image_barriers[0].first_access_in_frame);
+
+    // The swapchain image is acquired in an undefined state every frame
+    ASSERT_EQ(passes[2].image_barriers.size(), 2);
+    for (const auto& barrier : passes[2].image_barriers)
+    {
+        EXPECT_FALSE(barrier.first_access_in_frame);
+
+        if (barrier.handle.handle == color.handle)
+        {
+            EXPECT_EQ(barrier.old_layout, rhi::image_layout::color_attachment);
+            EXPECT_EQ(barrier.new_layout, rhi::image_layout::shader_read_only);
+        }
+        else
+        {
+            EXPECT_EQ(barrier.handle.handle, surface.handle);
+            EXPECT_EQ(barrier.old_layout, rhi::image_layout::undefined);
+            EXPECT_EQ(barrier.new_layout, rhi::image_layout::color_attachment);
+        }
+    }
+
+    ASSERT_EQ(plan.present_barriers.size(), 1);
+    EXPECT_EQ(plan.present_barriers[0].handle.handle, surface.handle);
+    EXPECT_EQ(plan.present_barriers[0].old_layout, rhi::image_layout::color_attachment);
+    EXPECT_EQ(plan.present_barriers[0].new_layout, rhi::image_layout::present);
+}
+
+namespace
+{
+    // Every draw identifies its pass and its position inside of the pass
+    void record_numbered_draws(tempest::graphics::graphics_task_execution_context& ctx, uint32_t pass_index)
+    {
+        for (uint32_t draw = 0; draw < 64; ++draw)
+        {
+            ctx.draw(3, 1, pass_index * 1000 + draw, 0);
+        }
+    }
+
+    // Executes a frame on the mock device, returning the draws in the order the submitted command lists execute them
+    tempest::vector<uint32_t> execute_numbered_draws(tempest::core::job_system* jobs, size_t& command_list_count)
+    {
+        using namespace tempest;
+
+        auto builder = graphics::graph_builder{};
+        auto color = builder.create_render_target(make_transient_image_desc("Color"));
+
+        const char* names[] = {"Draw 0", "Draw 1", "Draw 2", "Draw 3", "Draw 4", "Draw 5"};
+        for (uint32_t pass_index = 0; pass_index < 6; ++pass_index)
+        {
+            builder.create_graphics_pass(
+                names[pass_index],
+                [&](graphics::graphics_task_builder& task) {
+                    task.read_write(color, rhi::image_layout::color_attachment);
+
+                    // Interleave passes recorded on the workers with passes recorded on the calling thread
+                    if (pass_index % 3 != 2)
+                    {
+                        task.record_in_parallel();
+                    }
+                },
+                &record_numbered_draws, pass_index);
+        }
+
+        auto queue_cfg = graphics::queue_configuration{
+            .graphics_queues = 1,
+            .compute_queues = 0,
+            .transfer_queues = 0,
+        };
+
+        rhi::mock::mock_device device;
+        auto executor = graphics::graph_executor(device, jobs);
+        executor.set_execution_plan(tempest::move(builder).compile(queue_cfg));
+        executor.execute();
+
+        auto& queue = static_cast<rhi::mock::mock_work_queue&>(device.get_primary_work_queue());
+        const auto history = queue.get_history();
+
+        auto command_lists = vector<rhi::typed_rhi_handle<rhi::rhi_handle_type::command_list>>{};
+        for (const auto& cmd : history)
+        {
+            if (const auto* submit = get_if<rhi::mock::submit_cmd>(&cmd))
+            {
+                for (const auto& info : submit->infos)
+                {
+                    for (const auto list : info.command_lists)
+                    {
+                        command_lists.push_back(list);
+                    }
+                }
+            }
+        }
+
+        auto draws = vector<uint32_t>{};
+        for (const auto list : command_lists)
+        {
+            for (const auto& cmd : history)
+            {
+                const auto* draw = get_if<rhi::mock::draw_cmd>(&cmd);
+                if (draw != nullptr && draw->command_list == list)
+                {
+                    draws.push_back(draw->first_vertex);
+                }
+            }
+        }
+
+        command_list_count = command_lists.size();
+        return draws;
+    }
+} // namespace
+
+TEST(frame_graph, parallel_recording_preserves_pass_order)
+{
+    using namespace tempest;
+
+    auto expected = vector<uint32_t>{};
+    for (uint32_t pass_index = 0; pass_index < 6; ++pass_index)
+    {
+        for (uint32_t draw = 0; draw < 64; ++draw)
+        {
+            expected.push_back(pass_index * 1000 + draw);
+        }
+    }
+
+    size_t serial_command_lists = 0;
+    EXPECT_EQ(execute_numbered_draws(nullptr, serial_command_lists), expected);
+    EXPECT_EQ(serial_command_lists, 1);
+
+    core::job_system jobs(4);
+
+    // Parallel passes get their own command list, the serial passes between them share one
+    for (int run = 0; run < 8; ++run)
+    {
+        size_t parallel_command_lists = 0;
+        EXPECT_EQ(execute_numbered_draws(&jobs, parallel_command_lists), expected);
+        EXPECT_EQ(parallel_command_lists, 6);
+    }
+}
+
+namespace
+{
+    // Builds a tonemapping style graph whose resolve pass either samples or rewrites the color target
+    tempest::graphics::graph_builder build_resolve_graph(uint32_t width, uint32_t height, bool resolve_writes)
+    {
+        using namespace tempest;
+
+        auto builder = graphics::graph_builder{};
+
+        auto color_desc = make_transient_image_desc("Color");
+        color_desc.width = width;
+        color_desc.height = height;
+        auto color = builder.create_render_target(color_desc);
+
+        auto output_desc = make_transient_image_desc("Output");
+        output_desc.width = width;
+        output_desc.height = height;
+        auto output = builder.create_render_target(output_desc);
+
+        builder.create_graphics_pass(
+            "Color Pass",
+            [&](graphics::graphics_task_builder& task) { task.write(color, rhi::image_layout::color_attachment); },
+            []([[maybe_unused]] graphics::graphics_task_execution_context& ctx) {});
+
+        builder.create_graphics_pass(
+            "Resolve Pass",
+            [&](graphics::graphics_task_builder& task) {
+                if (resolve_writes)
+                {
+                    task.read_write(color, rhi::image_layout::color_attachment);
+                }
+                else
+                {
+                    task.read(color, rhi::image_layout::shader_read_only);
+                }
+                task.write(output, rhi::image_layout::color_attachment);
+            },
+            []([[maybe_unused]] graphics::graphics_task_execution_context& ctx) {});
+
+        return builder;
+    }
+} // namespace
+
+TEST(frame_graph, plan_cache_reuses_plans_across_resizes)
+{
+    using namespace tempest;
+
+    auto queue_cfg = graphics::queue_configuration{
+        .graphics_queues = 1,
+        .compute_queues = 0,
+        .transfer_queues = 0,
+    };
+
+    // Render target extents are patched into the plan, so they do not change the structure
+    EXPECT_EQ(build_resolve_graph(1920, 1080, false).structural_hash(queue_cfg),
+              build_resolve_graph(1280, 720, false).structural_hash(queue_cfg));
+    EXPECT_NE(build_resolve_graph(1920, 1080, false).structural_hash(queue_cfg),
+              build_resolve_graph(1920, 1080, true).structural_hash(queue_cfg));
+
+    auto cache = graphics::graph_plan_cache{};
+
+    auto first_builder = build_resolve_graph(1920, 1080, false);
+    const auto hash = first_builder.structural_hash(queue_cfg);
+    auto first = tempest::move(first_builder).compile(queue_cfg, cache);
+    ASSERT_EQ(cache.size(), 1);
+
+    // The cached copy does not hold on to the callbacks of the builder it was compiled from
+    auto cached = cache.find(hash);
+    ASSERT_TRUE(cached.has_value());
+    for (const auto& pass : cached->submissions[0].passes)
+    {
+        EXPECT_FALSE(static_cast<bool>(pass.execution_context));
+    }
+
+    auto second = build_resolve_graph(1280, 720, false).compile(queue_cfg, cache);
+    EXPECT_EQ(cache.size(), 1);
+
+    ASSERT_EQ(second.submissions.size(), first.submissions.size());
+    ASSERT_EQ(second.submissions[0].passes.size(), 2);
+    for (size_t pass_index = 0; pass_index < 2; ++pass_index)
+    {
+        const auto& pass = second.submissions[0].passes[pass_index];
+        EXPECT_EQ(pass.name, first.submissions[0].passes[pass_index].name);
+        EXPECT_TRUE(static_cast<bool>(pass.execution_context));
+    }
+
+    ASSERT_EQ(second.resources.size(), 2);
+    for (const auto& resource : second.resources)
+    {
+        const auto& desc = get<rhi::image_desc>(resource.creation_info);
+        EXPECT_EQ(desc.width, 1280);
+        EXPECT_EQ(desc.height, 720);
+    }
+
+    // A different access pattern compiles and caches a new plan
+    auto third = build_resolve_graph(1280, 720, true).compile(queue_cfg, cache);
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(third.submissions[0].passes.size(), 2);
+}
+
+TEST(frame_graph, resize_render_targets_skips_unchanged_targets)
+{
+    using namespace tempest;
+
+    auto builder = graphics::graph_builder{};
+
+    auto color_desc = make_transient_image_desc("Color");
+    color_desc.width = 1920;
+    color_desc.height = 1080;
+    auto color = builder.create_render_target(color_desc);
+
+    auto output_desc = make_transient_image_desc("Output");
+    output_desc.width = 1920;
+    output_desc.height = 1080;
+    auto output = builder.create_render_target(output_desc);
+
+    builder.create_graphics_pass(
+        "Color Pass",
+        [&](graphics::graphics_task_builder& task) { task.write(color, rhi::image_layout::color_attachment); },
+        []([[maybe_unused]] graphics::graphics_task_execution_context& ctx) {});
+
+    builder.create_graphics_pass(
+        "Resolve Pass",
+        [&](graphics::graphics_task_builder& task) {
+            task.read(color, rhi::image_layout::shader_read_only);
+            task.write(output, rhi::image_layout::color_attachment);
+        },
+        []([[maybe_unused]] graphics::graphics_task_execution_context& ctx) {});
+
+    auto queue_cfg = graphics::queue_configuration{
+        .graphics_queues = 1,
+        .compute_queues = 0,
+        .transfer_queues = 0,
+    };
+
+    rhi::mock::mock_device device;
+    auto executor = graphics::graph_executor(device);
+    executor.set_execution_plan(tempest::move(builder).compile(queue_cfg));
+    executor.execute();
+
+    const array targets = {color, output};
+    const auto original_color = executor.get_image(color);
+    const auto original_output = executor.get_image(output);
+
+    executor.resize_render_targets(targets, 1280, 720);
+    EXPECT_NE(executor.get_image(color), original_color);
+    EXPECT_NE(executor.get_image(output), original_output);
+
+    // Targets already at the requested size are left alone
+    const auto resized_color = executor.get_image(color);
+    const auto device_commands = device.get_history_count();
+
+    executor.resize_render_targets(targets, 1280, 720);
+    EXPECT_EQ(executor.get_image(color), resized_color);
+    EXPECT_EQ(device.get_history_count(), device_commands);
+
+    executor.execute();
+}
+
+namespace
+{
+    size_t count_queue_resets(tempest::rhi::work_queue& queue)
+    {
+        using namespace tempest;
+
+        size_t resets = 0;
+        for (const auto& cmd : static_cast<rhi::mock::mock_work_queue&>(queue).get_history())
+        {
+            if (holds_alternative<rhi::mock::reset_cmd>(cmd))
+            {
+                ++resets;
+            }
+        }
+        return resets;
+    }
+} // namespace
+
+TEST(frame_graph, queues_are_reset_before_first_use)
+{
+    using namespace tempest;
+
+    const auto queue_cfg = graphics::queue_configuration{
+        .graphics_queues = 1,
+        .compute_queues = 1,
+        .transfer_queues = 0,
+    };
+
+    for (const bool use_async_compute : {false, true})
+    {
+        auto builder = graphics::graph_builder{};
+        auto color = builder.create_render_target(make_transient_image_desc("Color"));
+        auto ambient_occlusion = builder.create_image(make_transient_image_desc("Ambient Occlusion"));
+
+        builder.create_graphics_pass(
+            "Color Pass",
+            [&](graphics::graphics_task_builder& task) { task.write(color, rhi::image_layout::color_attachment); },
+            []([[maybe_unused]] graphics::graphics_task_execution_context& ctx) {});
+
+        if (use_async_compute)
+        {
+            builder.create_compute_pass(
+                "Ambient Occlusion Pass",
+                [&](graphics::compute_task_builder& task) {
+                    task.prefer_async();
+                    task.write(ambient_occlusion, rhi::image_layout::general);
+                },
+                []([[maybe_unused]] graphics::compute_task_execution_context& ctx) {});
+        }
+
+        rhi::mock::mock_device device;
+        auto executor = graphics::graph_executor(device);
+        executor.set_execution_plan(tempest::move(builder).compile(queue_cfg));
+
+        constexpr size_t frame_count = 4;
+        for (size_t frame = 0; frame < frame_count; ++frame)
+        {
+            executor.execute();
+
+            const auto& stats = executor.get_frame_pacing_stats();
+            EXPECT_LE(stats.fence_wait_ns, stats.frame_ns);
+            EXPECT_GE(stats.fence_stall_ratio(), 0.0);
+            EXPECT_LE(stats.fence_stall_ratio(), 1.0);
+        }
+
+        EXPECT_EQ(count_queue_resets(device.get_primary_work_queue()), frame_count);
+
+        // The compute queue is only reset in frames that record onto it, ahead of its first command list
+        const auto compute_history =
+            static_cast<rhi::mock::mock_work_queue&>(device.get_dedicated_compute_queue()).get_history();
+        if (use_async_compute)
+        {
+            EXPECT_EQ(count_queue_resets(device.get_dedicated_compute_queue()), frame_count);
+            ASSERT_FALSE(compute_history.empty());
+            EXPECT_TRUE(holds_alternative<rhi::mock::reset_cmd>(compute_history[0]));
+        }
+        else
+        {
+            EXPECT_TRUE(compute_history.empty());
+        }
+    }
+}
+
+namespace
+{
+    struct prepared_draws
+    {
+        uint32_t draw_count = 0;
+    };
+
+    void prepare_draws([[maybe_unused]] tempest::graphics::graphics_task_execution_context& ctx,
+                       prepared_draws* prepared)
+    {
+        // Leaves workers time to read the state early if parallel passes were started too soon
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        prepared->draw_count = 16;
+    }
+
+    void record_prepared_draws(tempest::graphics::graphics_task_execution_context& ctx, prepared_draws* prepared)
+    {
+        for (uint32_t draw = 0; draw < prepared->draw_count; ++draw)
+        {
+            ctx.draw(3, 1, draw, 0);
+        }
+    }
+} // namespace
+
+TEST(frame_graph, serial_passes_prepare_state_for_parallel_passes)
+{
+    using namespace tempest;
+
+    core::job_system jobs(4);
+
+    const auto queue_cfg = graphics::queue_configuration{
+        .graphics_queues = 1,
+        .compute_queues = 0,
+        .transfer_queues = 0,
+    };
+
+    for (int run = 0; run < 4; ++run)
+    {
+        auto prepared = prepared_draws{};
+
+        auto builder = graphics::graph_builder{};
+        auto color = builder.create_render_target(make_transient_image_desc("Color"));
+
+        builder.create_graphics_pass(
+            "Prepare Draws",
+            [&](graphics::graphics_task_builder& task) {
+                task.read_write(color, rhi::image_layout::color_attachment);
+            },
+            &prepare_draws, &prepared);
+
+        const char* names[] = {"Draw 0", "Draw 1", "Draw 2"};
+        for (const auto* name : names)
+        {
+            builder.create_graphics_pass(
+                name,
+                [&](graphics::graphics_task_builder& task) {
+                    task.read_write(color, rhi::image_layout::color_attachment);
+                    task.record_in_parallel();
+                },
+                &record_prepared_draws, &prepared);
+        }
+
+        rhi::mock::mock_device device;
+        auto executor = graphics::graph_executor(device, &jobs);
+        executor.set_execution_plan(tempest::move(builder).compile(queue_cfg));
+        executor.execute();
+
+        size_t draw_count = 0;
+        for (const auto& cmd : static_cast<rhi::mock::mock_work_queue&>(device.get_primary_work_queue()).get_history())
+        {
+            if (holds_alternative<rhi::mock::draw_cmd>(cmd))
+            {
+                ++draw_count;
+            }
+        }
+
+        EXPECT_EQ(draw_count, 3 * 16);
+    }
+}
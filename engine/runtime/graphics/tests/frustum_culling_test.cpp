@@ -0,0 +1,108 @@
+#include <tempest/frustum_culling.hpp>
+
+#include <tempest/transformations.hpp>
+
+#include <gtest/gtest.h>
+
+#include <numbers>
+
+namespace
+{
+    tempest::math::mat4<float> make_view_projection()
+    {
+        // Camera at the origin looking down -Z
+        const auto proj = tempest::math::perspective(16.0f / 9.0f, std::numbers::pi_v<float> / 2.0f, 0.1f, 100.0f);
+        const auto view = tempest::math::look_at(tempest::math::vec3<float>(0.0f),
+                                                 tempest::math::vec3<float>(0.0f, 0.0f, -1.0f),
+                                                 tempest::math::vec3<float>(0.0f, 1.0f, 0.0f));
+        return proj * view;
+    }
+
+    tempest::graphics::bounding_sphere sphere(float x, float y, float z, float r)
+    {
+        return {
+            .center = tempest::math::vec3<float>(x, y, z),
+            .radius = r,
+        };
+    }
+} // namespace
+
+TEST(frustum_culling, compute_bounding_sphere)
+{
+    auto vertices = tempest::vector<tempest::core::vertex>(2);
+    vertices[0].position = tempest::math::vec3<float>(-1.0f, 0.0f, 2.0f);
+    vertices[1].position = tempest::math::vec3<float>(3.0f, 0.0f, 2.0f);
+
+    const auto bounds = tempest::graphics::compute_bounding_sphere(vertices);
+
+    EXPECT_FLOAT_EQ(1.0f, bounds.center.x);
+    EXPECT_FLOAT_EQ(0.0f, bounds.center.y);
+    EXPECT_FLOAT_EQ(2.0f, bounds.center.z);
+    EXPECT_FLOAT_EQ(2.0f, bounds.radius);
+}
+
+TEST(frustum_culling, transform_bounding_sphere_uses_largest_scale)
+{
+    auto transform = tempest::math::mat4<float>(1.0f);
+    transform[0][0] = 2.0f;
+    transform[1][1] = 3.0f;
+    transform[3] = tempest::math::vec4<float>(5.0f, 0.0f, 0.0f, 1.0f);
+
+    const auto bounds = tempest::graphics::transform_bounding_sphere(sphere(1.0f, 0.0f, 0.0f, 1.0f), transform);
+
+    EXPECT_FLOAT_EQ(7.0f, bounds.center.x);
+    EXPECT_FLOAT_EQ(3.0f, bounds.radius);
+}
+
+TEST(frustum_culling, sphere_against_perspective_frustum)
+{
+    const auto view = tempest::graphics::frustum::from_view_projection(make_view_projection());
+
+    EXPECT_TRUE(view.intersects(sphere(0.0f, 0.0f, -10.0f, 1.0f)));
+    EXPECT_FALSE(view.intersects(sphere(0.0f, 0.0f, 10.0f, 1.0f)));     // Behind the camera
+    EXPECT_FALSE(view.intersects(sphere(0.0f, 0.0f, -200.0f, 1.0f)));   // Beyond the far plane
+    EXPECT_FALSE(view.intersects(sphere(-50.0f, 0.0f, -10.0f, 1.0f)));  // Left of the frustum
+    EXPECT_FALSE(view.intersects(sphere(0.0f, 50.0f, -10.0f, 1.0f)));   // Above the frustum
+    EXPECT_TRUE(view.intersects(sphere(-50.0f, 0.0f, -10.0f, 45.0f)));  // Straddles the left plane
+}
+
+TEST(frustum_culling, infinite_projection_has_no_far_plane)
+{
+    const auto proj = tempest::math::perspective(1.0f, std::numbers::pi_v<float> / 2.0f, 0.1f);
+    const auto view = tempest::graphics::frustum::from_view_projection(proj);
+
+    EXPECT_TRUE(view.intersects(sphere(0.0f, 0.0f, -100000.0f, 1.0f)));
+    EXPECT_FALSE(view.intersects(sphere(0.0f, 0.0f, 10.0f, 1.0f)));
+}
+
+TEST(frustum_culling, sphere_set_matches_scalar_test)
+{
+    const auto view = tempest::graphics::frustum::from_view_projection(make_view_projection());
+
+    auto spheres = tempest::graphics::bounding_sphere_set{};
+    auto expected = tempest::vector<tempest::uint32_t>{};
+
+    // Odd count so both the wide path and the remainder are exercised
+    for (tempest::uint32_t i = 0; i < 1023; ++i)
+    {
+        const auto x = static_cast<float>(static_cast<int>(i % 17) - 8) * 4.0f;
+        const auto y = static_cast<float>(static_cast<int>(i % 13) - 6) * 4.0f;
+        const auto z = static_cast<float>(static_cast<int>(i % 31) - 10) * -5.0f;
+        const auto r = static_cast<float>(i % 5) * 0.5f;
+
+        const auto s = sphere(x, y, z, r);
+        ASSERT_EQ(i, spheres.push_back(s));
+
+        if (view.intersects(s))
+        {
+            expected.push_back(i);
+        }
+    }
+
+    auto visible = tempest::vector<tempest::uint32_t>{};
+    spheres.cull(view, visible);
+
+    ASSERT_FALSE(expected.empty());
+    ASSERT_LT(expected.size(), spheres.size());
+    EXPECT_EQ(expected, visible);
+}
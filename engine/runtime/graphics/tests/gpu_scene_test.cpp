@@ -0,0 +1,194 @@
+#include <tempest/gpu_scene.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    struct test_object
+    {
+        float model[16];
+        tempest::uint32_t mesh_id;
+        tempest::uint32_t material_id;
+    };
+
+    test_object make_object(tempest::uint32_t mesh_id)
+    {
+        auto obj = test_object{};
+        obj.mesh_id = mesh_id;
+        return obj;
+    }
+
+    tempest::size_t dirty_bytes(tempest::span<const tempest::graphics::gpu_dirty_range> ranges)
+    {
+        tempest::size_t bytes = 0;
+        for (const auto& range : ranges)
+        {
+            bytes += range.count * sizeof(test_object);
+        }
+        return bytes;
+    }
+} // namespace
+
+TEST(persistent_object_buffer, new_objects_are_dirty_in_every_copy)
+{
+    auto buffer = tempest::graphics::persistent_object_buffer<tempest::uint32_t, test_object>(2, 16);
+
+    buffer.begin_update();
+    for (tempest::uint32_t i = 0; i < 4; ++i)
+    {
+        ASSERT_EQ(i, buffer.write(i, make_object(i)).value());
+    }
+    buffer.end_update();
+
+    for (tempest::uint32_t copy = 0; copy < 2; ++copy)
+    {
+        auto ranges = buffer.take_dirty_ranges(copy);
+        ASSERT_EQ(1u, ranges.size());
+        EXPECT_EQ(0u, ranges[0].first);
+        EXPECT_EQ(4u, ranges[0].count);
+        EXPECT_EQ(4 * sizeof(test_object), dirty_bytes(ranges));
+    }
+
+    EXPECT_TRUE(buffer.take_dirty_ranges(0).empty());
+    EXPECT_TRUE(buffer.take_dirty_ranges(1).empty());
+}
+
+TEST(persistent_object_buffer, unchanged_objects_are_not_uploaded)
+{
+    auto buffer = tempest::graphics::persistent_object_buffer<tempest::uint32_t, test_object>(1, 16);
+
+    buffer.begin_update();
+    for (tempest::uint32_t i = 0; i < 8; ++i)
+    {
+        (void)buffer.write(i, make_object(i));
+    }
+    buffer.end_update();
+    (void)buffer.take_dirty_ranges(0);
+
+    // Rewrite every object, changing only two of them
+    buffer.begin_update();
+    for (tempest::uint32_t i = 0; i < 8; ++i)
+    {
+        (void)buffer.write(i, make_object(i == 2 || i == 5 ? i + 100 : i));
+    }
+    buffer.end_update();
+
+    auto ranges = buffer.take_dirty_ranges(0);
+    ASSERT_EQ(2u, ranges.size());
+    EXPECT_EQ(2u, ranges[0].first);
+    EXPECT_EQ(5u, ranges[1].first);
+    EXPECT_EQ(2 * sizeof(test_object), dirty_bytes(ranges));
+    EXPECT_EQ(102u, buffer.data()[2].mesh_id);
+}
+
+TEST(persistent_object_buffer, adjacent_dirty_slots_coalesce)
+{
+    auto buffer = tempest::graphics::persistent_object_buffer<tempest::uint32_t, test_object>(1, 16);
+
+    buffer.begin_update();
+    for (tempest::uint32_t i = 0; i < 8; ++i)
+    {
+        (void)buffer.write(i, make_object(i));
+    }
+    buffer.end_update();
+    (void)buffer.take_dirty_ranges(0);
+
+    buffer.begin_update();
+    for (tempest::uint32_t i : {6u, 3u, 4u, 0u, 1u, 2u, 5u, 7u})
+    {
+        (void)buffer.write(i, make_object(i >= 3 && i <= 5 ? i + 100 : i));
+    }
+    buffer.end_update();
+
+    auto ranges = buffer.take_dirty_ranges(0);
+    ASSERT_EQ(1u, ranges.size());
+    EXPECT_EQ(3u, ranges[0].first);
+    EXPECT_EQ(3u, ranges[0].count);
+}
+
+TEST(persistent_object_buffer, change_is_uploaded_once_per_copy)
+{
+    auto buffer = tempest::graphics::persistent_object_buffer<tempest::uint32_t, test_object>(3, 16);
+
+    buffer.begin_update();
+    (void)buffer.write(7, make_object(1));
+    buffer.end_update();
+
+    for (tempest::uint32_t copy = 0; copy < 3; ++copy)
+    {
+        EXPECT_EQ(sizeof(test_object), dirty_bytes(buffer.take_dirty_ranges(copy)));
+    }
+
+    // Changing the object twice before a copy is uploaded still uploads it once to that copy
+    buffer.begin_update();
+    (void)buffer.write(7, make_object(2));
+    buffer.end_update();
+
+    EXPECT_EQ(sizeof(test_object), dirty_bytes(buffer.take_dirty_ranges(0)));
+
+    buffer.begin_update();
+    (void)buffer.write(7, make_object(3));
+    buffer.end_update();
+
+    EXPECT_EQ(sizeof(test_object), dirty_bytes(buffer.take_dirty_ranges(1)));
+    EXPECT_EQ(sizeof(test_object), dirty_bytes(buffer.take_dirty_ranges(2)));
+    EXPECT_EQ(sizeof(test_object), dirty_bytes(buffer.take_dirty_ranges(0)));
+    EXPECT_EQ(0u, dirty_bytes(buffer.take_dirty_ranges(1)));
+}
+
+TEST(persistent_object_buffer, unwritten_keys_release_their_slots)
+{
+    auto buffer = tempest::graphics::persistent_object_buffer<tempest::uint32_t, test_object>(1, 4);
+
+    buffer.begin_update();
+    for (tempest::uint32_t i = 0; i < 4; ++i)
+    {
+        (void)buffer.write(i, make_object(i));
+    }
+    EXPECT_FALSE(buffer.write(42, make_object(42)).has_value());
+    EXPECT_EQ(0u, buffer.end_update());
+    (void)buffer.take_dirty_ranges(0);
+
+    // Key 1 is not written this update, so its slot is released
+    buffer.begin_update();
+    (void)buffer.write(0, make_object(0));
+    (void)buffer.write(2, make_object(2));
+    (void)buffer.write(3, make_object(3));
+    EXPECT_EQ(1u, buffer.end_update());
+
+    EXPECT_EQ(3u, buffer.live_count());
+    EXPECT_FALSE(buffer.slot_of(1).has_value());
+    EXPECT_TRUE(buffer.take_dirty_ranges(0).empty());
+
+    buffer.begin_update();
+    (void)buffer.write(0, make_object(0));
+    (void)buffer.write(2, make_object(2));
+    (void)buffer.write(3, make_object(3));
+    EXPECT_EQ(1u, buffer.write(42, make_object(42)).value());
+    buffer.end_update();
+
+    auto ranges = buffer.take_dirty_ranges(0);
+    ASSERT_EQ(1u, ranges.size());
+    EXPECT_EQ(1u, ranges[0].first);
+    EXPECT_EQ(1u, ranges[0].count);
+}
+
+TEST(persistent_object_buffer, invalidate_marks_live_slots_dirty)
+{
+    auto buffer = tempest::graphics::persistent_object_buffer<tempest::uint32_t, test_object>(2, 16);
+
+    buffer.begin_update();
+    for (tempest::uint32_t i = 0; i < 5; ++i)
+    {
+        (void)buffer.write(i, make_object(i));
+    }
+    buffer.end_update();
+
+    (void)buffer.take_dirty_ranges(0);
+    (void)buffer.take_dirty_ranges(1);
+
+    buffer.invalidate();
+
+    EXPECT_EQ(5 * sizeof(test_object), dirty_bytes(buffer.take_dirty_ranges(0)));
+    EXPECT_EQ(5 * sizeof(test_object), dirty_bytes(buffer.take_dirty_ranges(1)));
+}
@@ -62,6 +62,12 @@ namespace tempest::rhi
         virtual typed_rhi_handle<rhi_handle_type::compute_pipeline> create_compute_pipeline(
             const compute_pipeline_desc& desc) noexcept = 0;
         virtual typed_rhi_handle<rhi_handle_type::sampler> create_sampler(const sampler_desc& desc) noexcept = 0;
+        virtual typed_rhi_handle<rhi_handle_type::memory_heap> create_memory_heap(
+            const memory_heap_desc& desc) noexcept = 0;
+        virtual typed_rhi_handle<rhi_handle_type::buffer> create_placed_buffer(
+            const buffer_desc& desc, typed_rhi_handle<rhi_handle_type::memory_heap> heap, size_t offset) noexcept = 0;
+        virtual typed_rhi_handle<rhi_handle_type::image> create_placed_image(
+            const image_desc& desc, typed_rhi_handle<rhi_handle_type::memory_heap> heap, size_t offset) noexcept = 0;
 
         virtual void destroy_buffer(typed_rhi_handle<rhi_handle_type::buffer> handle) noexcept = 0;
         virtual void destroy_image(typed_rhi_handle<rhi_handle_type::image> handle) noexcept = 0;
@@ -76,6 +82,7 @@ namespace tempest::rhi
         virtual void destroy_descriptor_set(typed_rhi_handle<rhi_handle_type::descriptor_set> handle) noexcept = 0;
         virtual void destroy_compute_pipeline(typed_rhi_handle<rhi_handle_type::compute_pipeline> handle) noexcept = 0;
         virtual void destroy_sampler(typed_rhi_handle<rhi_handle_type::sampler> handle) noexcept = 0;
+        virtual void destroy_memory_heap(typed_rhi_handle<rhi_handle_type::memory_heap> handle) noexcept = 0;
 
         virtual typed_rhi_handle<rhi::rhi_handle_type::image> get_image_mip_view(
             typed_rhi_handle<rhi::rhi_handle_type::image> image, uint32_t mip) noexcept = 0;
@@ -110,6 +117,10 @@ namespace tempest::rhi
         virtual size_t get_image_width(typed_rhi_handle<rhi_handle_type::image> handle) const noexcept = 0;
         virtual size_t get_image_height(typed_rhi_handle<rhi_handle_type::image> handle) const noexcept = 0;
 
+        // Memory Management
+        virtual memory_requirements get_memory_requirements(const buffer_desc& desc) const noexcept = 0;
+        virtual memory_requirements get_memory_requirements(const image_desc& desc) const noexcept = 0;
+
         // Swapchain info
         virtual uint32_t get_render_surface_width(
             typed_rhi_handle<rhi_handle_type::render_surface> surface) const noexcept = 0;
@@ -184,6 +195,12 @@ namespace tempest::rhi
 
         virtual typed_rhi_handle<rhi_handle_type::command_list> get_next_command_list() noexcept = 0;
 
+        // Command lists acquired from different slots, and from get_next_command_list, may be recorded concurrently.
+        // Acquiring, submitting and recording two command lists of the same slot must happen on a single thread.
+        virtual uint32_t parallel_command_list_slot_count() const noexcept = 0;
+        virtual typed_rhi_handle<rhi_handle_type::command_list> get_next_parallel_command_list(
+            uint32_t slot) noexcept = 0;
+
         virtual bool submit(span<const submit_info> infos,
                             typed_rhi_handle<rhi_handle_type::fence> fence =
                                 typed_rhi_handle<rhi_handle_type::fence>::null_handle) noexcept = 0;
@@ -32,6 +32,7 @@ namespace tempest::rhi
         descriptor_set_layout,
         pipeline_layout,
         descriptor_set,
+        memory_heap,
     };
 
     enum class bind_point
@@ -308,6 +309,24 @@ namespace tempest::rhi
         string name;
     };
 
+    struct memory_requirements
+    {
+        size_t size;
+        size_t alignment;
+        uint32_t memory_type_bits;
+    };
+
+    // Block of memory that placed buffers and images are bound into. Resources placed at overlapping ranges alias
+    // each other and must be separated by a barrier transitioning the new resource from an undefined state.
+    struct memory_heap_desc
+    {
+        size_t size;
+        size_t alignment;
+        uint32_t memory_type_bits;
+        memory_location location;
+        string name;
+    };
+
     enum class filter
     {
         nearest,
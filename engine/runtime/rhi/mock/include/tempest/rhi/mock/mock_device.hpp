@@ -40,6 +40,12 @@ namespace tempest::rhi::mock
         auto create_compute_pipeline(const compute_pipeline_desc& desc) noexcept
             -> typed_rhi_handle<rhi_handle_type::compute_pipeline> override;
         auto create_sampler(const sampler_desc& desc) noexcept -> typed_rhi_handle<rhi_handle_type::sampler> override;
+        auto create_memory_heap(const memory_heap_desc& desc) noexcept
+            -> typed_rhi_handle<rhi_handle_type::memory_heap> override;
+        auto create_placed_buffer(const buffer_desc& desc, typed_rhi_handle<rhi_handle_type::memory_heap> heap,
+                                  size_t offset) noexcept -> typed_rhi_handle<rhi_handle_type::buffer> override;
+        auto create_placed_image(const image_desc& desc, typed_rhi_handle<rhi_handle_type::memory_heap> heap,
+                                 size_t offset) noexcept -> typed_rhi_handle<rhi_handle_type::image> override;
 
         void destroy_buffer(typed_rhi_handle<rhi_handle_type::buffer> handle) noexcept override;
         void destroy_image(typed_rhi_handle<rhi_handle_type::image> handle) noexcept override;
@@ -53,6 +59,7 @@ namespace tempest::rhi::mock
         void destroy_descriptor_set(typed_rhi_handle<rhi_handle_type::descriptor_set> handle) noexcept override;
         void destroy_compute_pipeline(typed_rhi_handle<rhi_handle_type::compute_pipeline> handle) noexcept override;
         void destroy_sampler(typed_rhi_handle<rhi_handle_type::sampler> handle) noexcept override;
+        void destroy_memory_heap(typed_rhi_handle<rhi_handle_type::memory_heap> handle) noexcept override;
 
         auto get_image_mip_view(typed_rhi_handle<rhi_handle_type::image> image, uint32_t mip) noexcept
             -> typed_rhi_handle<rhi_handle_type::image> override;
@@ -90,6 +97,12 @@ namespace tempest::rhi::mock
         [[nodiscard]] auto get_image_height(typed_rhi_handle<rhi_handle_type::image> /*handle*/) const noexcept
             -> size_t override;
 
+        // Memory Management
+        [[nodiscard]] auto get_memory_requirements(const buffer_desc& desc) const noexcept
+            -> memory_requirements override;
+        [[nodiscard]] auto get_memory_requirements(const image_desc& desc) const noexcept
+            -> memory_requirements override;
+
         // Swapchain info
         [[nodiscard]] auto get_render_surface_width(
             typed_rhi_handle<rhi_handle_type::render_surface> /*surface*/) const noexcept -> uint32_t override;
@@ -73,6 +73,28 @@ namespace tempest::rhi::mock
         typed_rhi_handle<rhi_handle_type::sampler> result;
     };
 
+    struct create_memory_heap_cmd
+    {
+        memory_heap_desc desc;
+        typed_rhi_handle<rhi_handle_type::memory_heap> result;
+    };
+
+    struct create_placed_buffer_cmd
+    {
+        buffer_desc desc;
+        typed_rhi_handle<rhi_handle_type::memory_heap> heap;
+        size_t offset;
+        typed_rhi_handle<rhi_handle_type::buffer> result;
+    };
+
+    struct create_placed_image_cmd
+    {
+        image_desc desc;
+        typed_rhi_handle<rhi_handle_type::memory_heap> heap;
+        size_t offset;
+        typed_rhi_handle<rhi_handle_type::image> result;
+    };
+
     struct destroy_buffer_cmd
     {
         typed_rhi_handle<rhi_handle_type::buffer> handle;
@@ -128,6 +150,11 @@ namespace tempest::rhi::mock
         typed_rhi_handle<rhi_handle_type::sampler> handle;
     };
 
+    struct destroy_memory_heap_cmd
+    {
+        typed_rhi_handle<rhi_handle_type::memory_heap> handle;
+    };
+
     struct get_image_mip_view_cmd
     {
         typed_rhi_handle<rhi_handle_type::image> image;
@@ -195,6 +222,9 @@ namespace tempest::rhi::mock
         create_descriptor_set_cmd, 
         create_compute_pipeline_cmd, 
         create_sampler_cmd, 
+        create_memory_heap_cmd,
+        create_placed_buffer_cmd,
+        create_placed_image_cmd,
         destroy_buffer_cmd, 
         destroy_image_cmd, 
         destroy_fence_cmd, 
@@ -206,6 +236,7 @@ namespace tempest::rhi::mock
         destroy_descriptor_set_cmd, 
         destroy_compute_pipeline_cmd, 
         destroy_sampler_cmd, 
+        destroy_memory_heap_cmd,
         get_image_mip_view_cmd, 
         recreate_render_surface_cmd, 
         acquire_next_image_cmd, 
@@ -176,6 +176,58 @@ namespace tempest::rhi::mock
         return result;
     }
 
+    auto mock_device::create_memory_heap(const memory_heap_desc& desc) noexcept
+        -> typed_rhi_handle<rhi_handle_type::memory_heap>
+    {
+        auto result = typed_rhi_handle<rhi_handle_type::memory_heap>{
+            .id = _next_handle++,
+            .generation = 0,
+        };
+
+        _history.push_back(create_memory_heap_cmd{
+            .desc = desc,
+            .result = result,
+        });
+
+        return result;
+    }
+
+    auto mock_device::create_placed_buffer(const buffer_desc& desc, typed_rhi_handle<rhi_handle_type::memory_heap> heap,
+                                           size_t offset) noexcept -> typed_rhi_handle<rhi_handle_type::buffer>
+    {
+        auto result = typed_rhi_handle<rhi_handle_type::buffer>{
+            .id = _next_handle++,
+            .generation = 0,
+        };
+
+        _history.push_back(create_placed_buffer_cmd{
+            .desc = desc,
+            .heap = heap,
+            .offset = offset,
+            .result = result,
+        });
+
+        return result;
+    }
+
+    auto mock_device::create_placed_image(const image_desc& desc, typed_rhi_handle<rhi_handle_type::memory_heap> heap,
+                                          size_t offset) noexcept -> typed_rhi_handle<rhi_handle_type::image>
+    {
+        auto result = typed_rhi_handle<rhi_handle_type::image>{
+            .id = _next_handle++,
+            .generation = 0,
+        };
+
+        _history.push_back(create_placed_image_cmd{
+            .desc = desc,
+            .heap = heap,
+            .offset = offset,
+            .result = result,
+        });
+
+        return result;
+    }
+
     void mock_device::destroy_buffer(typed_rhi_handle<rhi_handle_type::buffer> handle) noexcept
     {
         _history.push_back(destroy_buffer_cmd{handle});
@@ -232,6 +284,11 @@ namespace tempest::rhi::mock
         _history.push_back(destroy_sampler_cmd{handle});
     }
 
+    void mock_device::destroy_memory_heap(typed_rhi_handle<rhi_handle_type::memory_heap> handle) noexcept
+    {
+        _history.push_back(destroy_memory_heap_cmd{handle});
+    }
+
     auto mock_device::get_image_mip_view(typed_rhi_handle<rhi_handle_type::image> image, uint32_t mip) noexcept
         -> typed_rhi_handle<rhi_handle_type::image>
     {
@@ -322,6 +379,25 @@ namespace tempest::rhi::mock
         return 0;
     }
 
+    auto mock_device::get_memory_requirements(const buffer_desc& desc) const noexcept -> memory_requirements
+    {
+        return {
+            .size = desc.size,
+            .alignment = 256,
+            .memory_type_bits = ~0u,
+        };
+    }
+
+    auto mock_device::get_memory_requirements(const image_desc& desc) const noexcept -> memory_requirements
+    {
+        // Assume four bytes per texel, the mock device does not track formats
+        return {
+            .size = static_cast<size_t>(desc.width) * desc.height * desc.depth * desc.array_layers * 4,
+            .alignment = 64 * 1024,
+            .memory_type_bits = ~0u,
+        };
+    }
+
     auto mock_device::get_render_surface_width(typed_rhi_handle<rhi_handle_type::render_surface>) const noexcept
         -> uint32_t
     {
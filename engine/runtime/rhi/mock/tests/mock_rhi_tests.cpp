@@ -63,6 +63,43 @@ TEST(MockDeviceTests, RecordsOperationsAndMaintainsGenerations)
     EXPECT_NE(cmd3->handle, buf2_gen0); // Must not be treated as equal
 }
 
+TEST(MockDeviceTests, RecordsPlacedResources)
+{
+    tempest::rhi::mock::mock_device device;
+
+    tempest::rhi::memory_heap_desc heap_desc{};
+    heap_desc.size = 4096; // NOLINT
+    heap_desc.alignment = 256; // NOLINT
+    heap_desc.memory_type_bits = ~0u;
+    auto heap = device.create_memory_heap(heap_desc);
+
+    tempest::rhi::buffer_desc buf_desc{};
+    buf_desc.size = 1024; // NOLINT
+    auto buf = device.create_placed_buffer(buf_desc, heap, 0);
+
+    device.destroy_buffer(buf);
+    device.destroy_memory_heap(heap);
+
+    EXPECT_EQ(device.get_history_count(), 4);
+
+    const auto* const cmd0 = get_if<tempest::rhi::mock::create_memory_heap_cmd>(&device.get_history(0));
+    ASSERT_NE(cmd0, nullptr);
+    EXPECT_EQ(cmd0->desc.size, 4096);
+    EXPECT_EQ(cmd0->result, heap);
+
+    const auto* const cmd1 = get_if<tempest::rhi::mock::create_placed_buffer_cmd>(&device.get_history(1));
+    ASSERT_NE(cmd1, nullptr);
+    EXPECT_EQ(cmd1->heap, heap);
+    EXPECT_EQ(cmd1->offset, 0);
+    EXPECT_EQ(cmd1->result, buf);
+
+    const auto* const cmd3 = get_if<tempest::rhi::mock::destroy_memory_heap_cmd>(&device.get_history(3));
+    ASSERT_NE(cmd3, nullptr);
+    EXPECT_EQ(cmd3->handle, heap);
+
+    EXPECT_EQ(device.get_memory_requirements(buf_desc).size, 1024);
+}
+
 auto main(int argc, char** argv) -> int
 {
     ::testing::InitGoogleTest(&argc, argv);
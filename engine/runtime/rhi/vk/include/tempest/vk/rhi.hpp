@@ -70,6 +70,8 @@ namespace tempest::rhi::vk
         ~work_queue() override;
 
         typed_rhi_handle<rhi_handle_type::command_list> get_next_command_list() noexcept override;
+        uint32_t parallel_command_list_slot_count() const noexcept override;
+        typed_rhi_handle<rhi_handle_type::command_list> get_next_parallel_command_list(uint32_t slot) noexcept override;
 
         bool submit(span<const submit_info> infos,
                     typed_rhi_handle<rhi_handle_type::fence> fence =
@@ -216,23 +218,39 @@ namespace tempest::rhi::vk
         uint64_t _next_timeline_value{1};
         uint64_t _last_submitted_value{0};
 
-        // Set of all used buffers, images, etc
-        flat_unordered_map<typed_rhi_handle<rhi_handle_type::command_list>,
-                           vector<typed_rhi_handle<rhi_handle_type::buffer>>>
-            used_buffers;
-
-        flat_unordered_map<typed_rhi_handle<rhi_handle_type::command_list>,
-                           vector<typed_rhi_handle<rhi_handle_type::image>>>
-            used_images;
-        flat_unordered_map<typed_rhi_handle<rhi_handle_type::command_list>,
-                           vector<typed_rhi_handle<rhi_handle_type::graphics_pipeline>>>
-            used_gfx_pipelines;
-        flat_unordered_map<typed_rhi_handle<rhi_handle_type::command_list>,
-                           vector<typed_rhi_handle<rhi_handle_type::compute_pipeline>>>
-            used_compute_pipelines;
-        flat_unordered_map<typed_rhi_handle<rhi_handle_type::command_list>,
-                           vector<typed_rhi_handle<rhi_handle_type::sampler>>>
-            used_samplers;
+        // Scratch memory and the set of all used buffers, images, etc for the command lists recorded from one slot.
+        // Slot 0 holds the serial command lists, parallel slot i maps to state i + 1.
+        struct recording_state
+        {
+            stack_allocator allocator{64 * 1024};
+
+            flat_unordered_map<typed_rhi_handle<rhi_handle_type::command_list>,
+                               vector<typed_rhi_handle<rhi_handle_type::buffer>>>
+                used_buffers;
+            flat_unordered_map<typed_rhi_handle<rhi_handle_type::command_list>,
+                               vector<typed_rhi_handle<rhi_handle_type::image>>>
+                used_images;
+            flat_unordered_map<typed_rhi_handle<rhi_handle_type::command_list>,
+                               vector<typed_rhi_handle<rhi_handle_type::graphics_pipeline>>>
+                used_gfx_pipelines;
+            flat_unordered_map<typed_rhi_handle<rhi_handle_type::command_list>,
+                               vector<typed_rhi_handle<rhi_handle_type::compute_pipeline>>>
+                used_compute_pipelines;
+            flat_unordered_map<typed_rhi_handle<rhi_handle_type::command_list>,
+                               vector<typed_rhi_handle<rhi_handle_type::sampler>>>
+                used_samplers;
+        };
+
+        static constexpr uint32_t _parallel_slot_count = 8;
+
+        // Indexed by parallel slot, then frame in flight. Pools are created on first use.
+        vector<vector<work_group>> _parallel_work_groups;
+        vector<recording_state> _recording_states;
+
+        // Only written while acquiring command lists, which never overlaps recording
+        flat_unordered_map<typed_rhi_handle<rhi_handle_type::command_list>, uint32_t> _command_list_states;
+
+        recording_state& _recording_state(typed_rhi_handle<rhi_handle_type::command_list> command_list) noexcept;
     };
 
     struct TEMPEST_API image
@@ -260,6 +278,12 @@ namespace tempest::rhi::vk
         VkBufferUsageFlags usage;
     };
 
+    struct TEMPEST_API memory_heap
+    {
+        VmaAllocation allocation;
+        VmaAllocationInfo allocation_info;
+    };
+
     struct TEMPEST_API sampler
     {
         VkSampler sampler;
@@ -504,6 +528,14 @@ namespace tempest::rhi::vk
         typed_rhi_handle<rhi_handle_type::compute_pipeline> create_compute_pipeline(
             const compute_pipeline_desc& desc) noexcept override;
         typed_rhi_handle<rhi_handle_type::sampler> create_sampler(const sampler_desc& desc) noexcept override;
+        typed_rhi_handle<rhi_handle_type::memory_heap> create_memory_heap(
+            const memory_heap_desc& desc) noexcept override;
+        typed_rhi_handle<rhi_handle_type::buffer> create_placed_buffer(
+            const buffer_desc& desc, typed_rhi_handle<rhi_handle_type::memory_heap> heap,
+            size_t offset) noexcept override;
+        typed_rhi_handle<rhi_handle_type::image> create_placed_image(const image_desc& desc,
+                                                                     typed_rhi_handle<rhi_handle_type::memory_heap> heap,
+                                                                     size_t offset) noexcept override;
 
         void destroy_buffer(typed_rhi_handle<rhi_handle_type::buffer> handle) noexcept override;
         void destroy_image(typed_rhi_handle<rhi_handle_type::image> handle) noexcept override;
@@ -517,6 +549,7 @@ namespace tempest::rhi::vk
         void destroy_descriptor_set(typed_rhi_handle<rhi_handle_type::descriptor_set> handle) noexcept override;
         void destroy_compute_pipeline(typed_rhi_handle<rhi_handle_type::compute_pipeline> handle) noexcept override;
         void destroy_sampler(typed_rhi_handle<rhi_handle_type::sampler> handle) noexcept override;
+        void destroy_memory_heap(typed_rhi_handle<rhi_handle_type::memory_heap> handle) noexcept override;
 
         typed_rhi_handle<rhi::rhi_handle_type::image> get_image_mip_view(
             typed_rhi_handle<rhi::rhi_handle_type::image> image, uint32_t mip) noexcept override;
@@ -548,6 +581,9 @@ namespace tempest::rhi::vk
         size_t get_image_width(typed_rhi_handle<rhi_handle_type::image> handle) const noexcept override;
         size_t get_image_height(typed_rhi_handle<rhi_handle_type::image> handle) const noexcept override;
 
+        memory_requirements get_memory_requirements(const buffer_desc& desc) const noexcept override;
+        memory_requirements get_memory_requirements(const image_desc& desc) const noexcept override;
+
         uint32_t get_render_surface_width(
             typed_rhi_handle<rhi_handle_type::render_surface> handle) const noexcept override;
         uint32_t get_render_surface_height(
@@ -653,6 +689,7 @@ namespace tempest::rhi::vk
         slot_map<compute_pipeline> _compute_pipelines;
         slot_map<descriptor_set> _descriptor_sets;
         slot_map<sampler> _samplers;
+        slot_map<memory_heap> _memory_heaps;
 
         slot_map<VkCommandBuffer> _command_buffers;
 
@@ -675,6 +712,13 @@ namespace tempest::rhi::vk
 
         void name_object(VkObjectType type, void* handle, const char* name) noexcept;
 
+        typed_rhi_handle<rhi_handle_type::buffer> register_buffer(const buffer_desc& desc, VkBuffer buffer,
+                                                                  VkBufferUsageFlags usage, VmaAllocation allocation,
+                                                                  const VmaAllocationInfo& allocation_info) noexcept;
+        typed_rhi_handle<rhi_handle_type::image> register_image(const image_desc& desc, const VkImageCreateInfo& ci,
+                                                                VkImage image, VmaAllocation allocation,
+                                                                const VmaAllocationInfo& allocation_info) noexcept;
+
 #if TEMPEST_ENABLE_AFTERMATH
         aftermath::gpu_crash_tracker::marker_map _marker_map;
         aftermath::gpu_crash_tracker _crash_tracker;
@@ -1176,6 +1176,46 @@ namespace tempest::rhi::vk
                 std::terminate();
             }
         }
+
+        VkBufferCreateInfo make_buffer_create_info(const rhi::buffer_desc& desc)
+        {
+            return {
+                .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+                .pNext = nullptr,
+                .flags = 0,
+                .size = desc.size,
+                .usage = to_vulkan(desc.usage) | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+                .queueFamilyIndexCount = 0,
+                .pQueueFamilyIndices = nullptr,
+            };
+        }
+
+        VkImageCreateInfo make_image_create_info(const rhi::image_desc& desc)
+        {
+            return {
+                .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+                .pNext = nullptr,
+                .flags = 0,
+                .imageType = to_vulkan(desc.type),
+                .format = to_vulkan(desc.format),
+                .extent =
+                    {
+                        .width = desc.width,
+                        .height = desc.height,
+                        .depth = desc.depth,
+                    },
+                .mipLevels = desc.mip_levels,
+                .arrayLayers = desc.array_layers,
+                .samples = to_vulkan(desc.sample_count),
+                .tiling = to_vulkan(desc.tiling),
+                .usage = to_vulkan(desc.usage),
+                .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+                .queueFamilyIndexCount = 0,
+                .pQueueFamilyIndices = nullptr,
+                .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+            };
+        }
     } // namespace
 
     instance::instance(vkb::Instance instance, vector<vkb::PhysicalDevice> devices) noexcept
@@ -1274,6 +1314,9 @@ namespace tempest::rhi::vk
         case VK_OBJECT_TYPE_BUFFER:
             vmaDestroyBuffer(allocator, static_cast<VkBuffer>(res.handle), res.allocation);
             break;
+        case VK_OBJECT_TYPE_DEVICE_MEMORY:
+            vmaFreeMemory(allocator, res.allocation);
+            break;
         case VK_OBJECT_TYPE_DESCRIPTOR_SET:
             dispatch->freeDescriptorSets(res.desc_pool, 1, reinterpret_cast<VkDescriptorSet*>(&res.handle));
             break;
@@ -1542,6 +1585,13 @@ namespace tempest::rhi::vk
         }
         _buffers.clear();
 
+        // Placed resources do not own their memory, so heaps are released after them
+        for (auto heap : _memory_heaps)
+        {
+            vmaFreeMemory(_vma_allocator, heap.allocation);
+        }
+        _memory_heaps.clear();
+
         for (auto sc : _swapchains)
         {
             vkb::destroy_swapchain(sc.swapchain);
@@ -1567,16 +1617,7 @@ namespace tempest::rhi::vk
 
     typed_rhi_handle<rhi_handle_type::buffer> device::create_buffer(const buffer_desc& desc) noexcept
     {
-        VkBufferCreateInfo buffer_ci = {
-            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-            .pNext = nullptr,
-            .flags = 0,
-            .size = desc.size,
-            .usage = to_vulkan(desc.usage) | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
-            .queueFamilyIndexCount = 0,
-            .pQueueFamilyIndices = nullptr,
-        };
+        auto buffer_ci = make_buffer_create_info(desc);
 
         VmaAllocationCreateInfo allocation_ci = {
             .flags = 0,
@@ -1622,61 +1663,12 @@ namespace tempest::rhi::vk
             return typed_rhi_handle<rhi_handle_type::buffer>::null_handle;
         }
 
-        auto buf_dev_address = VkBufferDeviceAddressInfo{
-            .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
-            .pNext = nullptr,
-            .buffer = buffer,
-        };
-
-        auto address = _dispatch_table.getBufferDeviceAddress(&buf_dev_address);
-
-        auto buf = vk::buffer{
-            .allocation = allocation,
-            .allocation_info = allocation_info,
-            .buffer = buffer,
-            .address = address,
-            .usage = buffer_ci.usage,
-        };
-
-        if (!desc.name.empty())
-        {
-            name_object(VK_OBJECT_TYPE_BUFFER, buf.buffer, desc.name.c_str());
-        }
-
-        auto new_key = _buffers.insert(buf);
-        auto new_key_id = get_slot_map_key_id<uint64_t>(new_key);
-        auto new_key_gen = get_slot_map_key_generation<uint64_t>(new_key);
-
-        return typed_rhi_handle<rhi_handle_type::buffer>{
-            .id = new_key_id,
-            .generation = new_key_gen,
-        };
+        return register_buffer(desc, buffer, buffer_ci.usage, allocation, allocation_info);
     }
 
     typed_rhi_handle<rhi_handle_type::image> device::create_image(const image_desc& desc) noexcept
     {
-        VkImageCreateInfo ci = {
-            .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
-            .pNext = nullptr,
-            .flags = 0,
-            .imageType = to_vulkan(desc.type),
-            .format = to_vulkan(desc.format),
-            .extent =
-                {
-                    .width = desc.width,
-                    .height = desc.height,
-                    .depth = desc.depth,
-                },
-            .mipLevels = desc.mip_levels,
-            .arrayLayers = desc.array_layers,
-            .samples = to_vulkan(desc.sample_count),
-            .tiling = to_vulkan(desc.tiling),
-            .usage = to_vulkan(desc.usage),
-            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
-            .queueFamilyIndexCount = 0,
-            .pQueueFamilyIndices = nullptr,
-            .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-        };
+        auto ci = make_image_create_info(desc);
 
         VmaAllocationCreateInfo allocation_ci = {
             .flags = 0,
@@ -1707,6 +1699,192 @@ namespace tempest::rhi::vk
             return typed_rhi_handle<rhi_handle_type::image>::null_handle;
         }
 
+        return register_image(desc, ci, image, allocation, allocation_info);
+    }
+
+    typed_rhi_handle<rhi_handle_type::memory_heap> device::create_memory_heap(const memory_heap_desc& desc) noexcept
+    {
+        VkMemoryRequirements requirements = {
+            .size = desc.size,
+            .alignment = desc.alignment,
+            .memoryTypeBits = desc.memory_type_bits,
+        };
+
+        // The automatic memory usages require a buffer or image to be known at allocation time, so the memory
+        // properties are requested explicitly
+        VmaAllocationCreateInfo allocation_ci = {
+            .flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT,
+            .usage = VMA_MEMORY_USAGE_UNKNOWN,
+            .requiredFlags = 0,
+            .preferredFlags = 0,
+            .memoryTypeBits = 0,
+            .pool = nullptr,
+            .pUserData = nullptr,
+            .priority = 0,
+        };
+
+        switch (desc.location)
+        {
+        case rhi::memory_location::device:
+            allocation_ci.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+            break;
+        case rhi::memory_location::host:
+            allocation_ci.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+            break;
+        default:
+            allocation_ci.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+            break;
+        }
+
+        VmaAllocation allocation;
+        VmaAllocationInfo allocation_info;
+
+        auto result = vmaAllocateMemory(_vma_allocator, &requirements, &allocation_ci, &allocation, &allocation_info);
+        if (result != VK_SUCCESS)
+        {
+            return typed_rhi_handle<rhi_handle_type::memory_heap>::null_handle;
+        }
+
+        if (!desc.name.empty())
+        {
+            vmaSetAllocationName(_vma_allocator, allocation, desc.name.c_str());
+            name_object(VK_OBJECT_TYPE_DEVICE_MEMORY, allocation_info.deviceMemory, desc.name.c_str());
+        }
+
+        auto new_key = _memory_heaps.insert(memory_heap{
+            .allocation = allocation,
+            .allocation_info = allocation_info,
+        });
+        auto new_key_id = get_slot_map_key_id<uint64_t>(new_key);
+        auto new_key_gen = get_slot_map_key_generation<uint64_t>(new_key);
+
+        return typed_rhi_handle<rhi_handle_type::memory_heap>{
+            .id = new_key_id,
+            .generation = new_key_gen,
+        };
+    }
+
+    typed_rhi_handle<rhi_handle_type::buffer> device::create_placed_buffer(
+        const buffer_desc& desc, typed_rhi_handle<rhi_handle_type::memory_heap> heap, size_t offset) noexcept
+    {
+        auto heap_it = _memory_heaps.find(create_slot_map_key<uint64_t>(heap.id, heap.generation));
+        if (heap_it == _memory_heaps.end())
+        {
+            return typed_rhi_handle<rhi_handle_type::buffer>::null_handle;
+        }
+
+        auto buffer_ci = make_buffer_create_info(desc);
+
+        VkBuffer buffer;
+        auto result = _dispatch_table.createBuffer(&buffer_ci, nullptr, &buffer);
+        if (result != VK_SUCCESS)
+        {
+            return typed_rhi_handle<rhi_handle_type::buffer>::null_handle;
+        }
+
+        result = vmaBindBufferMemory2(_vma_allocator, heap_it->allocation, offset, buffer, nullptr);
+        if (result != VK_SUCCESS)
+        {
+            _dispatch_table.destroyBuffer(buffer, nullptr);
+            return typed_rhi_handle<rhi_handle_type::buffer>::null_handle;
+        }
+
+        // The memory is owned by the heap, the buffer only records the range it occupies
+        auto allocation_info = VmaAllocationInfo{
+            .memoryType = heap_it->allocation_info.memoryType,
+            .deviceMemory = heap_it->allocation_info.deviceMemory,
+            .offset = heap_it->allocation_info.offset + offset,
+            .size = desc.size,
+            .pMappedData = nullptr,
+            .pUserData = nullptr,
+            .pName = nullptr,
+        };
+
+        return register_buffer(desc, buffer, buffer_ci.usage, VK_NULL_HANDLE, allocation_info);
+    }
+
+    typed_rhi_handle<rhi_handle_type::image> device::create_placed_image(
+        const image_desc& desc, typed_rhi_handle<rhi_handle_type::memory_heap> heap, size_t offset) noexcept
+    {
+        auto heap_it = _memory_heaps.find(create_slot_map_key<uint64_t>(heap.id, heap.generation));
+        if (heap_it == _memory_heaps.end())
+        {
+            return typed_rhi_handle<rhi_handle_type::image>::null_handle;
+        }
+
+        auto ci = make_image_create_info(desc);
+
+        VkImage image;
+        auto result = _dispatch_table.createImage(&ci, nullptr, &image);
+        if (result != VK_SUCCESS)
+        {
+            return typed_rhi_handle<rhi_handle_type::image>::null_handle;
+        }
+
+        result = vmaBindImageMemory2(_vma_allocator, heap_it->allocation, offset, image, nullptr);
+        if (result != VK_SUCCESS)
+        {
+            _dispatch_table.destroyImage(image, nullptr);
+            return typed_rhi_handle<rhi_handle_type::image>::null_handle;
+        }
+
+        VkMemoryRequirements requirements;
+        _dispatch_table.getImageMemoryRequirements(image, &requirements);
+
+        auto allocation_info = VmaAllocationInfo{
+            .memoryType = heap_it->allocation_info.memoryType,
+            .deviceMemory = heap_it->allocation_info.deviceMemory,
+            .offset = heap_it->allocation_info.offset + offset,
+            .size = requirements.size,
+            .pMappedData = nullptr,
+            .pUserData = nullptr,
+            .pName = nullptr,
+        };
+
+        return register_image(desc, ci, image, VK_NULL_HANDLE, allocation_info);
+    }
+
+    typed_rhi_handle<rhi_handle_type::buffer> device::register_buffer(const buffer_desc& desc, VkBuffer buffer,
+                                                                      VkBufferUsageFlags usage,
+                                                                      VmaAllocation allocation,
+                                                                      const VmaAllocationInfo& allocation_info) noexcept
+    {
+        auto buf_dev_address = VkBufferDeviceAddressInfo{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+            .pNext = nullptr,
+            .buffer = buffer,
+        };
+
+        auto address = _dispatch_table.getBufferDeviceAddress(&buf_dev_address);
+
+        auto buf = vk::buffer{
+            .allocation = allocation,
+            .allocation_info = allocation_info,
+            .buffer = buffer,
+            .address = address,
+            .usage = usage,
+        };
+
+        if (!desc.name.empty())
+        {
+            name_object(VK_OBJECT_TYPE_BUFFER, buf.buffer, desc.name.c_str());
+        }
+
+        auto new_key = _buffers.insert(buf);
+        auto new_key_id = get_slot_map_key_id<uint64_t>(new_key);
+        auto new_key_gen = get_slot_map_key_generation<uint64_t>(new_key);
+
+        return typed_rhi_handle<rhi_handle_type::buffer>{
+            .id = new_key_id,
+            .generation = new_key_gen,
+        };
+    }
+
+    typed_rhi_handle<rhi_handle_type::image> device::register_image(const image_desc& desc,
+                                                                    const VkImageCreateInfo& ci, VkImage image,
+                                                                    VmaAllocation allocation,
+                                                                    const VmaAllocationInfo& allocation_info) noexcept
+    {
         VkImageViewCreateInfo view_ci = {
             .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
             .pNext = nullptr,
@@ -1732,7 +1910,7 @@ namespace tempest::rhi::vk
         };
 
         VkImageView image_view;
-        result = _dispatch_table.createImageView(&view_ci, nullptr, &image_view);
+        auto result = _dispatch_table.createImageView(&view_ci, nullptr, &image_view);
         if (result != VK_SUCCESS)
         {
             return typed_rhi_handle<rhi_handle_type::image>::null_handle;
@@ -2687,6 +2865,18 @@ namespace tempest::rhi::vk
         }
     }
 
+    void device::destroy_memory_heap(typed_rhi_handle<rhi_handle_type::memory_heap> handle) noexcept
+    {
+        auto heap_key = create_slot_map_key<uint64_t>(handle.id, handle.generation);
+        auto heap_it = _memory_heaps.find(heap_key);
+        if (heap_it != _memory_heaps.end())
+        {
+            _delete_queue.enqueue(VK_OBJECT_TYPE_DEVICE_MEMORY, heap_it->allocation_info.deviceMemory,
+                                  heap_it->allocation, _current_frame + num_frames_in_flight);
+            _memory_heaps.erase(heap_key);
+        }
+    }
+
     void device::destroy_sampler(typed_rhi_handle<rhi_handle_type::sampler> handle) noexcept
     {
         if (_resource_tracker.is_tracked(handle))
@@ -2968,6 +3158,11 @@ namespace tempest::rhi::vk
                 return reinterpret_cast<byte*>(buf_it->allocation_info.pMappedData);
             }
 
+            if (buf_it->allocation == VK_NULL_HANDLE)
+            {
+                return nullptr;
+            }
+
             void* mapped_data;
             auto result = vmaMapMemory(_vma_allocator, buf_it->allocation, &mapped_data);
             if (result != VK_SUCCESS)
@@ -3002,7 +3197,8 @@ namespace tempest::rhi::vk
         {
             auto buf_key = create_slot_map_key<uint64_t>(buf.id, buf.generation);
             auto buf_it = _buffers.find(buf_key);
-            if (buf_it != _buffers.end())
+            // Placed buffers live in device local heaps and never need flushing
+            if (buf_it != _buffers.end() && buf_it->allocation != VK_NULL_HANDLE)
             {
                 allocations.push_back(buf_it->allocation);
             }
@@ -3051,6 +3247,57 @@ namespace tempest::rhi::vk
         return img->create_info.extent.height;
     }
 
+    memory_requirements device::get_memory_requirements(const buffer_desc& desc) const noexcept
+    {
+        auto buffer_ci = make_buffer_create_info(desc);
+
+        VkDeviceBufferMemoryRequirements info = {
+            .sType = VK_STRUCTURE_TYPE_DEVICE_BUFFER_MEMORY_REQUIREMENTS,
+            .pNext = nullptr,
+            .pCreateInfo = &buffer_ci,
+        };
+
+        VkMemoryRequirements2 requirements = {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2,
+            .pNext = nullptr,
+            .memoryRequirements = {},
+        };
+
+        _dispatch_table.getDeviceBufferMemoryRequirements(&info, &requirements);
+
+        return {
+            .size = requirements.memoryRequirements.size,
+            .alignment = requirements.memoryRequirements.alignment,
+            .memory_type_bits = requirements.memoryRequirements.memoryTypeBits,
+        };
+    }
+
+    memory_requirements device::get_memory_requirements(const image_desc& desc) const noexcept
+    {
+        auto ci = make_image_create_info(desc);
+
+        VkDeviceImageMemoryRequirements info = {
+            .sType = VK_STRUCTURE_TYPE_DEVICE_IMAGE_MEMORY_REQUIREMENTS,
+            .pNext = nullptr,
+            .pCreateInfo = &ci,
+            .planeAspect = static_cast<VkImageAspectFlagBits>(0),
+        };
+
+        VkMemoryRequirements2 requirements = {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2,
+            .pNext = nullptr,
+            .memoryRequirements = {},
+        };
+
+        _dispatch_table.getDeviceImageMemoryRequirements(&info, &requirements);
+
+        return {
+            .size = requirements.memoryRequirements.size,
+            .alignment = requirements.memoryRequirements.alignment,
+            .memory_type_bits = requirements.memoryRequirements.memoryTypeBits,
+        };
+    }
+
     uint32_t device::get_render_surface_width(typed_rhi_handle<rhi_handle_type::render_surface> handle) const noexcept
     {
         auto swapchain_key = create_slot_map_key<uint64_t>(handle.id, handle.generation);
@@ -3782,6 +4029,19 @@ namespace tempest::rhi::vk
             wg.parent = _parent;
         }
 
+        _parallel_work_groups.resize(_parallel_slot_count);
+        for (auto& slot_groups : _parallel_work_groups)
+        {
+            slot_groups.resize(fif);
+            for (auto& wg : slot_groups)
+            {
+                wg.dispatch = _dispatch;
+                wg.parent = _parent;
+            }
+        }
+
+        _recording_states.resize(_parallel_slot_count + 1);
+
         VkSemaphoreTypeCreateInfo timeline_sem_type_ci = {
             .sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
             .pNext = nullptr,
@@ -3813,6 +4073,24 @@ namespace tempest::rhi::vk
             }
             _dispatch->destroyCommandPool(wg.pool, nullptr);
         }
+
+        for (const auto& slot_groups : _parallel_work_groups)
+        {
+            for (const auto& wg : slot_groups)
+            {
+                if (wg.pool == VK_NULL_HANDLE)
+                {
+                    continue;
+                }
+
+                if (!wg.cmd_buffers.empty())
+                {
+                    _dispatch->freeCommandBuffers(wg.pool, static_cast<uint32_t>(wg.cmd_buffers.size()),
+                                                  wg.cmd_buffers.data());
+                }
+                _dispatch->destroyCommandPool(wg.pool, nullptr);
+            }
+        }
     }
 
     typed_rhi_handle<rhi_handle_type::command_list> work_queue::get_next_command_list() noexcept
@@ -3821,6 +4099,45 @@ namespace tempest::rhi::vk
         return wg.acquire_next_command_buffer();
     }
 
+    uint32_t work_queue::parallel_command_list_slot_count() const noexcept
+    {
+        return _parallel_slot_count;
+    }
+
+    typed_rhi_handle<rhi_handle_type::command_list> work_queue::get_next_parallel_command_list(uint32_t slot) noexcept
+    {
+        if (slot >= _parallel_slot_count)
+        {
+            return typed_rhi_handle<rhi_handle_type::command_list>::null_handle;
+        }
+
+        // Every slot records from its own pool, command pools may not be used from multiple threads at once
+        auto& wg = _parallel_work_groups[slot][_parent->frame_in_flight()];
+        if (wg.pool == VK_NULL_HANDLE)
+        {
+            VkCommandPoolCreateInfo pool_ci = {
+                .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+                .pNext = nullptr,
+                .flags = 0,
+                .queueFamilyIndex = _queue_family_index,
+            };
+
+            if (_dispatch->createCommandPool(&pool_ci, nullptr, &wg.pool) != VK_SUCCESS)
+            {
+                wg.pool = VK_NULL_HANDLE;
+                return typed_rhi_handle<rhi_handle_type::command_list>::null_handle;
+            }
+        }
+
+        auto command_list = wg.acquire_next_command_buffer();
+        if (command_list && !_command_list_states.contains(command_list))
+        {
+            _command_list_states.insert({command_list, slot + 1});
+        }
+
+        return command_list;
+    }
+
     bool work_queue::submit(span<const submit_info> infos, typed_rhi_handle<rhi_handle_type::fence> fence) noexcept
     {
         if (infos.empty())
@@ -3925,29 +4242,31 @@ namespace tempest::rhi::vk
         {
             for (const auto& cmd_list : info.command_lists)
             {
-                for (const auto& buf : used_buffers[cmd_list])
+                auto& state = _recording_state(cmd_list);
+
+                for (const auto& buf : state.used_buffers[cmd_list])
                 {
                     _res_tracker->track(buf, timestamp, this);
                 }
-                used_buffers.erase(cmd_list);
+                state.used_buffers.erase(cmd_list);
 
-                for (const auto& img : used_images[cmd_list])
+                for (const auto& img : state.used_images[cmd_list])
                 {
                     _res_tracker->track(img, timestamp, this);
                 }
-                used_images.erase(cmd_list);
+                state.used_images.erase(cmd_list);
 
-                for (const auto& smp : used_samplers[cmd_list])
+                for (const auto& smp : state.used_samplers[cmd_list])
                 {
                     _res_tracker->track(smp, timestamp, this);
                 }
-                used_samplers.erase(cmd_list);
+                state.used_samplers.erase(cmd_list);
 
-                for (const auto& pipe : used_gfx_pipelines[cmd_list])
+                for (const auto& pipe : state.used_gfx_pipelines[cmd_list])
                 {
                     _res_tracker->track(pipe, timestamp, this);
                 }
-                used_gfx_pipelines.erase(cmd_list);
+                state.used_gfx_pipelines.erase(cmd_list);
             }
         }
 
@@ -4014,6 +4333,14 @@ namespace tempest::rhi::vk
     void work_queue::start_frame(uint32_t frame_in_flight)
     {
         _work_groups[frame_in_flight].reset();
+
+        for (auto& slot_groups : _parallel_work_groups)
+        {
+            if (slot_groups[frame_in_flight].pool != VK_NULL_HANDLE)
+            {
+                slot_groups[frame_in_flight].reset();
+            }
+        }
     }
 
     void work_queue::begin_command_list(typed_rhi_handle<rhi_handle_type::command_list> command_list,
@@ -4042,8 +4369,10 @@ namespace tempest::rhi::vk
     void work_queue::transition_image(typed_rhi_handle<rhi_handle_type::command_list> command_list,
                                       span<const image_barrier> image_barriers) noexcept
     {
+        auto& state = _recording_state(command_list);
+
         VkImageMemoryBarrier2* img_mem_barriers =
-            _allocator.allocate_typed<VkImageMemoryBarrier2>(image_barriers.size());
+            state.allocator.allocate_typed<VkImageMemoryBarrier2>(image_barriers.size());
 
         for (size_t i = 0; i < image_barriers.size(); ++i)
         {
@@ -4078,7 +4407,7 @@ namespace tempest::rhi::vk
             };
 
             // Track the image barrier for the resource tracker
-            used_images[command_list].push_back(image_barriers[i].image);
+            state.used_images[command_list].push_back(image_barriers[i].image);
         }
 
         VkDependencyInfo dep_info = {
@@ -4100,6 +4429,8 @@ namespace tempest::rhi::vk
                                        typed_rhi_handle<rhi_handle_type::image> image, image_layout layout, float r,
                                        float g, float b, float a) noexcept
     {
+        auto& state = _recording_state(command_list);
+
         VkImageSubresourceRange subresource_range = {
             .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
             .baseMipLevel = 0,
@@ -4116,7 +4447,7 @@ namespace tempest::rhi::vk
                                       to_vulkan(layout), &clear_color, 1, &subresource_range);
 
         // Track the image for the resource tracker
-        used_images[command_list].push_back(image);
+        state.used_images[command_list].push_back(image);
     }
 
     void work_queue::blit(typed_rhi_handle<rhi_handle_type::command_list> command_list,
@@ -4124,6 +4455,8 @@ namespace tempest::rhi::vk
                           typed_rhi_handle<rhi_handle_type::image> dst, image_layout dst_layout,
                           uint32_t dst_mip) noexcept
     {
+        auto& state = _recording_state(command_list);
+
         VkImageBlit blit_region = {
             .srcSubresource =
                 {
@@ -4171,14 +4504,16 @@ namespace tempest::rhi::vk
                                 &blit_region, VK_FILTER_LINEAR);
 
         // Track the images for the resource tracker
-        used_images[command_list].push_back(src);
-        used_images[command_list].push_back(dst);
+        state.used_images[command_list].push_back(src);
+        state.used_images[command_list].push_back(dst);
     }
 
     void work_queue::generate_mip_chain(typed_rhi_handle<rhi_handle_type::command_list> command_list,
                                         typed_rhi_handle<rhi_handle_type::image> img, image_layout current_layout,
                                         uint32_t base_mip, uint32_t mip_count) noexcept
     {
+        auto& state = _recording_state(command_list);
+
         // Transition image to general layout
         // Source should wait for all previous operations to complete
 
@@ -4363,13 +4698,15 @@ namespace tempest::rhi::vk
 
         _dispatch->cmdPipelineBarrier2(_parent->get_command_buffer(command_list), &dep_info_post);
 
-        used_images[command_list].push_back(img);
+        state.used_images[command_list].push_back(img);
     }
 
     void work_queue::copy(typed_rhi_handle<rhi_handle_type::command_list> command_list,
                           typed_rhi_handle<rhi_handle_type::buffer> src, typed_rhi_handle<rhi_handle_type::buffer> dst,
                           size_t src_offset, size_t dst_offset, size_t byte_count) noexcept
     {
+        auto& state = _recording_state(command_list);
+
         if (byte_count == 0)
         {
             return;
@@ -4385,25 +4722,29 @@ namespace tempest::rhi::vk
                                  _parent->get_buffer(dst)->buffer, 1, &copy_region);
 
         // Track the buffers for the resource tracker
-        used_buffers[command_list].push_back(src);
-        used_buffers[command_list].push_back(dst);
+        state.used_buffers[command_list].push_back(src);
+        state.used_buffers[command_list].push_back(dst);
     }
 
     void work_queue::fill(typed_rhi_handle<rhi_handle_type::command_list> command_list,
                           typed_rhi_handle<rhi_handle_type::buffer> handle, size_t offset, size_t size,
                           uint32_t data) noexcept
     {
+        auto& state = _recording_state(command_list);
+
         _dispatch->cmdFillBuffer(_parent->get_command_buffer(command_list), _parent->get_buffer(handle)->buffer, offset,
                                  size, data);
 
         // Track the buffer for the resource tracker
-        used_buffers[command_list].push_back(handle);
+        state.used_buffers[command_list].push_back(handle);
     }
 
     void work_queue::copy(typed_rhi_handle<rhi_handle_type::command_list> command_list,
                           typed_rhi_handle<rhi_handle_type::buffer> src, typed_rhi_handle<rhi_handle_type::image> dst,
                           image_layout layout, size_t src_offset, uint32_t dst_mip) noexcept
     {
+        auto& state = _recording_state(command_list);
+
         const auto& img = *_parent->get_image(dst);
 
         const VkBufferImageCopy copy_region = {
@@ -4434,14 +4775,16 @@ namespace tempest::rhi::vk
                                         img.image, to_vulkan(layout), 1, &copy_region);
 
         // Track the buffer and image for the resource tracker
-        used_buffers[command_list].push_back(src);
-        used_images[command_list].push_back(dst);
+        state.used_buffers[command_list].push_back(src);
+        state.used_images[command_list].push_back(dst);
     }
 
     void work_queue::copy(typed_rhi_handle<rhi_handle_type::command_list> command_list,
                           typed_rhi_handle<rhi_handle_type::image> src, image_layout src_layout,
                           typed_rhi_handle<rhi_handle_type::buffer> dst, size_t dst_offset, uint32_t src_mip) noexcept
     {
+        auto& state = _recording_state(command_list);
+
         const auto& img = *_parent->get_image(src);
 
         const VkBufferImageCopy copy_region = {
@@ -4472,16 +4815,18 @@ namespace tempest::rhi::vk
                                         _parent->get_buffer(dst)->buffer, 1, &copy_region);
 
         // Track the image and buffer for the resource tracker
-        used_images[command_list].push_back(src);
-        used_buffers[command_list].push_back(dst);
+        state.used_images[command_list].push_back(src);
+        state.used_buffers[command_list].push_back(dst);
     }
 
     void work_queue::pipeline_barriers(typed_rhi_handle<rhi_handle_type::command_list> command_list,
                                        span<const image_barrier> image_barriers,
                                        span<const buffer_barrier> buffer_barriers) noexcept
     {
-        auto img_barriers = _allocator.allocate_typed<VkImageMemoryBarrier2>(image_barriers.size());
-        auto buf_barriers = _allocator.allocate_typed<VkBufferMemoryBarrier2>(buffer_barriers.size());
+        auto& state = _recording_state(command_list);
+
+        auto img_barriers = state.allocator.allocate_typed<VkImageMemoryBarrier2>(image_barriers.size());
+        auto buf_barriers = state.allocator.allocate_typed<VkBufferMemoryBarrier2>(buffer_barriers.size());
 
         for (size_t i = 0; i < image_barriers.size(); ++i)
         {
@@ -4515,7 +4860,7 @@ namespace tempest::rhi::vk
             };
 
             // Track the image barrier for the resource tracker
-            used_images[command_list].push_back(image_barriers[i].image);
+            state.used_images[command_list].push_back(image_barriers[i].image);
         }
 
         for (size_t i = 0; i < buffer_barriers.size(); ++i)
@@ -4542,7 +4887,7 @@ namespace tempest::rhi::vk
             };
 
             // Track the buffer barrier for the resource tracker
-            used_buffers[command_list].push_back(buffer_barriers[i].buffer);
+            state.used_buffers[command_list].push_back(buffer_barriers[i].buffer);
         }
 
         VkDependencyInfo dep_info = {
@@ -4559,20 +4904,23 @@ namespace tempest::rhi::vk
 
         _dispatch->cmdPipelineBarrier2(_parent->get_command_buffer(command_list), &dep_info);
 
-        _allocator.reset();
+        state.allocator.reset();
     }
 
     void work_queue::begin_rendering(typed_rhi_handle<rhi_handle_type::command_list> command_list,
                                      const render_pass_info& render_pass_info) noexcept
     {
+        auto& state = _recording_state(command_list);
+
         auto color_attachments =
             render_pass_info.color_attachments.empty()
                 ? nullptr
-                : _allocator.allocate_typed<VkRenderingAttachmentInfo>(render_pass_info.color_attachments.size());
+                : state.allocator.allocate_typed<VkRenderingAttachmentInfo>(render_pass_info.color_attachments.size());
         auto depth_attachment =
-            render_pass_info.depth_attachment ? _allocator.allocate_typed<VkRenderingAttachmentInfo>(1) : nullptr;
-        auto stencil_attachment =
-            render_pass_info.stencil_attachment ? _allocator.allocate_typed<VkRenderingAttachmentInfo>(1) : nullptr;
+            render_pass_info.depth_attachment ? state.allocator.allocate_typed<VkRenderingAttachmentInfo>(1) : nullptr;
+        auto stencil_attachment = render_pass_info.stencil_attachment
+                                      ? state.allocator.allocate_typed<VkRenderingAttachmentInfo>(1)
+                                      : nullptr;
 
         for (size_t i = 0; i < render_pass_info.color_attachments.size(); ++i)
         {
@@ -4601,7 +4949,7 @@ namespace tempest::rhi::vk
                     },
             };
             // Track the image for the resource tracker
-            used_images[command_list].push_back(render_pass_info.color_attachments[i].image);
+            state.used_images[command_list].push_back(render_pass_info.color_attachments[i].image);
         }
 
         if (render_pass_info.depth_attachment)
@@ -4626,7 +4974,7 @@ namespace tempest::rhi::vk
                     },
             };
             // Track the image for the resource tracker
-            used_images[command_list].push_back(render_pass_info.depth_attachment->image);
+            state.used_images[command_list].push_back(render_pass_info.depth_attachment->image);
         }
 
         if (render_pass_info.stencil_attachment)
@@ -4651,7 +4999,7 @@ namespace tempest::rhi::vk
                     },
             };
             // Track the image for the resource tracker
-            used_images[command_list].push_back(render_pass_info.stencil_attachment->image);
+            state.used_images[command_list].push_back(render_pass_info.stencil_attachment->image);
         }
 
         VkRenderingInfo render_info = {
@@ -4680,7 +5028,7 @@ namespace tempest::rhi::vk
         };
 
         _dispatch->cmdBeginRendering(_parent->get_command_buffer(command_list), &render_info);
-        _allocator.reset();
+        state.allocator.reset();
     }
 
     void work_queue::end_rendering(typed_rhi_handle<rhi_handle_type::command_list> command_list) noexcept
@@ -4692,18 +5040,22 @@ namespace tempest::rhi::vk
     void work_queue::bind(typed_rhi_handle<rhi_handle_type::command_list> command_list,
                           typed_rhi_handle<rhi_handle_type::graphics_pipeline> pipeline) noexcept
     {
+        auto& state = _recording_state(command_list);
+
         auto cmds = _parent->get_command_buffer(command_list);
         auto pipe = _parent->get_graphics_pipeline(pipeline);
         _dispatch->cmdBindPipeline(cmds, VK_PIPELINE_BIND_POINT_GRAPHICS, pipe->pipeline);
 
         // Track the pipeline for the resource tracker
-        used_gfx_pipelines[command_list].push_back(pipeline);
+        state.used_gfx_pipelines[command_list].push_back(pipeline);
     }
 
     void work_queue::draw(typed_rhi_handle<rhi_handle_type::command_list> command_list,
                           typed_rhi_handle<rhi_handle_type::buffer> indirect_buffer, uint32_t offset,
                           uint32_t draw_count, uint32_t stride) noexcept
     {
+        auto& state = _recording_state(command_list);
+
         if (draw_count == 0)
         {
             return; // No draws to perform
@@ -4714,7 +5066,7 @@ namespace tempest::rhi::vk
         _dispatch->cmdDrawIndexedIndirect(cmds, buf->buffer, offset, draw_count, stride);
 
         // Track the buffer for the resource tracker
-        used_buffers[command_list].push_back(indirect_buffer);
+        state.used_buffers[command_list].push_back(indirect_buffer);
     }
 
     void work_queue::draw(typed_rhi_handle<rhi_handle_type::command_list> command_list, uint32_t vertex_count,
@@ -4736,11 +5088,13 @@ namespace tempest::rhi::vk
                                        typed_rhi_handle<rhi_handle_type::buffer> buffer, uint32_t offset,
                                        rhi::index_format index_type) noexcept
     {
+        auto& state = _recording_state(command_list);
+
         auto cmds = _parent->get_command_buffer(command_list);
         auto buf = _parent->get_buffer(buffer);
         _dispatch->cmdBindIndexBuffer(cmds, buf->buffer, offset, to_vulkan(index_type));
         // Track the buffer for the resource tracker
-        used_buffers[command_list].push_back(buffer);
+        state.used_buffers[command_list].push_back(buffer);
     }
 
     void work_queue::bind_vertex_buffers(typed_rhi_handle<rhi_handle_type::command_list> command_list,
@@ -4748,8 +5102,10 @@ namespace tempest::rhi::vk
                                          span<const typed_rhi_handle<rhi_handle_type::buffer>> buffers,
                                          span<const size_t> offsets) noexcept
     {
-        auto vk_buffers = _allocator.allocate_typed<VkBuffer>(buffers.size());
-        auto vk_offsets = _allocator.allocate_typed<VkDeviceSize>(offsets.size());
+        auto& state = _recording_state(command_list);
+
+        auto vk_buffers = state.allocator.allocate_typed<VkBuffer>(buffers.size());
+        auto vk_offsets = state.allocator.allocate_typed<VkDeviceSize>(offsets.size());
 
         for (size_t i = 0; i < buffers.size(); ++i)
         {
@@ -4763,7 +5119,7 @@ namespace tempest::rhi::vk
 
         for (auto&& buffer : buffers)
         {
-            used_buffers[command_list].push_back(buffer);
+            state.used_buffers[command_list].push_back(buffer);
         }
     }
 
@@ -4813,11 +5169,13 @@ namespace tempest::rhi::vk
     void work_queue::bind(typed_rhi_handle<rhi_handle_type::command_list> command_list,
                           typed_rhi_handle<rhi_handle_type::compute_pipeline> pipeline) noexcept
     {
+        auto& state = _recording_state(command_list);
+
         auto cmds = _parent->get_command_buffer(command_list);
         auto pipe = _parent->get_compute_pipeline(pipeline);
         _dispatch->cmdBindPipeline(cmds, VK_PIPELINE_BIND_POINT_COMPUTE, pipe->pipeline);
         // Track the pipeline for the resource tracker
-        used_compute_pipelines[command_list].push_back(pipeline);
+        state.used_compute_pipelines[command_list].push_back(pipeline);
     }
 
     void work_queue::dispatch(typed_rhi_handle<rhi_handle_type::command_list> command_list, uint32_t x, uint32_t y,
@@ -4832,8 +5190,10 @@ namespace tempest::rhi::vk
                           uint32_t first_set_index, span<const typed_rhi_handle<rhi_handle_type::descriptor_set>> sets,
                           span<const uint32_t> dynamic_offsets) noexcept
     {
+        auto& state = _recording_state(command_list);
+
         auto cmds = _parent->get_command_buffer(command_list);
-        auto vk_sets = _allocator.allocate_typed<VkDescriptorSet>(sets.size());
+        auto vk_sets = state.allocator.allocate_typed<VkDescriptorSet>(sets.size());
         for (size_t i = 0; i < sets.size(); ++i)
         {
             auto set_payload = _parent->get_descriptor_set(sets[i]);
@@ -4842,24 +5202,24 @@ namespace tempest::rhi::vk
             // Track the descriptor set for the resource tracker
             for (const auto& buf : set_payload->bound_buffers)
             {
-                used_buffers[command_list].push_back(buf);
+                state.used_buffers[command_list].push_back(buf);
             }
 
             for (const auto& img : set_payload->bound_images)
             {
-                used_images[command_list].push_back(img);
+                state.used_images[command_list].push_back(img);
             }
 
             for (const auto& smp : set_payload->bound_samplers)
             {
-                used_samplers[command_list].push_back(smp);
+                state.used_samplers[command_list].push_back(smp);
             }
         }
 
         _dispatch->cmdBindDescriptorSets(cmds, to_vulkan(point), _parent->get_pipeline_layout(pipeline_layout),
                                          first_set_index, static_cast<uint32_t>(sets.size()), vk_sets,
                                          static_cast<uint32_t>(dynamic_offsets.size()), dynamic_offsets.data());
-        _allocator.reset();
+        state.allocator.reset();
     }
 
     void work_queue::push_descriptors(typed_rhi_handle<rhi_handle_type::command_list> command_list,
@@ -4869,6 +5229,8 @@ namespace tempest::rhi::vk
                                       span<const image_binding_descriptor> images,
                                       span<const sampler_binding_descriptor> samplers) noexcept
     {
+        auto& state = _recording_state(command_list);
+
         auto cmds = _parent->get_command_buffer(command_list);
         auto layout = _parent->get_pipeline_layout(pipeline_layout);
 
@@ -4878,12 +5240,12 @@ namespace tempest::rhi::vk
             return; // No descriptors to push
         }
 
-        auto writes = _allocator.allocate_typed<VkWriteDescriptorSet>(write_count);
+        auto writes = state.allocator.allocate_typed<VkWriteDescriptorSet>(write_count);
         auto write_index = 0u;
 
         for (const auto& buffer : buffers)
         {
-            auto buffer_write_info = _allocator.allocate_typed<VkDescriptorBufferInfo>(1);
+            auto buffer_write_info = state.allocator.allocate_typed<VkDescriptorBufferInfo>(1);
             buffer_write_info[0] = {
                 .buffer = _parent->get_buffer(buffer.buffer)->buffer,
                 .offset = buffer.offset,
@@ -4903,12 +5265,12 @@ namespace tempest::rhi::vk
                 .pTexelBufferView = nullptr,
             };
             // Track the buffer for the resource tracker
-            used_buffers[command_list].push_back(buffer.buffer);
+            state.used_buffers[command_list].push_back(buffer.buffer);
         }
 
         for (const auto& image : images)
         {
-            auto image_write_info = _allocator.allocate_typed<VkDescriptorImageInfo>(image.images.size());
+            auto image_write_info = state.allocator.allocate_typed<VkDescriptorImageInfo>(image.images.size());
             for (size_t i = 0; i < image.images.size(); ++i)
             {
                 const auto& img_info = image.images[i];
@@ -4939,17 +5301,17 @@ namespace tempest::rhi::vk
             // Track the images and samplers for the resource tracker
             for (const auto& img_info : image.images)
             {
-                used_images[command_list].push_back(img_info.image);
+                state.used_images[command_list].push_back(img_info.image);
                 if (img_info.sampler)
                 {
-                    used_samplers[command_list].push_back(img_info.sampler);
+                    state.used_samplers[command_list].push_back(img_info.sampler);
                 }
             }
         }
 
         for (const auto& sampler : samplers)
         {
-            auto sampler_write_info = _allocator.allocate_typed<VkDescriptorImageInfo>(sampler.samplers.size());
+            auto sampler_write_info = state.allocator.allocate_typed<VkDescriptorImageInfo>(sampler.samplers.size());
             for (size_t i = 0; i < sampler.samplers.size(); ++i)
             {
                 auto smp = _parent->get_sampler(sampler.samplers[i])->sampler;
@@ -4972,8 +5334,8 @@ namespace tempest::rhi::vk
                 .pTexelBufferView = nullptr,
             };
             // Track the samplers for the resource tracker
-            used_samplers[command_list].insert(used_samplers[command_list].end(), sampler.samplers.begin(),
-                                               sampler.samplers.end());
+            auto& tracked_samplers = state.used_samplers[command_list];
+            tracked_samplers.insert(tracked_samplers.end(), sampler.samplers.begin(), sampler.samplers.end());
         }
 
         _dispatch->cmdPushDescriptorSetKHR(cmds, to_vulkan(point), layout, set_index, write_count, writes);
@@ -4996,14 +5358,16 @@ namespace tempest::rhi::vk
                                              span<const typed_rhi_handle<rhi_handle_type::buffer>> buffers,
                                              span<const uint64_t> offsets) noexcept
     {
+        auto& state = _recording_state(command_list);
+
         TEMPEST_ASSERT(offsets.size() == buffers.size() && "Number of offsets must match number of descriptor buffers");
 
         auto cmds = _parent->get_command_buffer(command_list);
 
         // First, gather the used VkBuffer handles into a vector of unique handles
-        auto buffer_binding_infos = _allocator.allocate_typed<VkDescriptorBufferBindingInfoEXT>(buffers.size());
+        auto buffer_binding_infos = state.allocator.allocate_typed<VkDescriptorBufferBindingInfoEXT>(buffers.size());
         auto unique_buffer_count = 0u;
-        auto buffer_binding_indices = _allocator.allocate_typed<uint32_t>(buffers.size());
+        auto buffer_binding_indices = state.allocator.allocate_typed<uint32_t>(buffers.size());
         auto buffer_bindings_written = 0;
 
         for (auto buf : buffers)
@@ -5037,7 +5401,7 @@ namespace tempest::rhi::vk
             cmds, to_vulkan(point), _parent->get_pipeline_layout(pipeline_layout), first_set_index,
             static_cast<uint32_t>(buffers.size()), buffer_binding_indices, offsets.data());
 
-        _allocator.reset();
+        state.allocator.reset();
     }
 
     void work_queue::reset(uint64_t frame_in_flight)
@@ -5045,6 +5409,18 @@ namespace tempest::rhi::vk
         start_frame(static_cast<uint32_t>(frame_in_flight));
     }
 
+    work_queue::recording_state& work_queue::_recording_state(
+        typed_rhi_handle<rhi_handle_type::command_list> command_list) noexcept
+    {
+        auto state_it = _command_list_states.find(command_list);
+        if (state_it == _command_list_states.end())
+        {
+            return _recording_states[0];
+        }
+
+        return _recording_states[state_it->second];
+    }
+
     void work_queue::begin_debug_region(typed_rhi_handle<rhi_handle_type::command_list> command_list, string_view name)
     {
         if (!_parent->can_name_objects())
@@ -8,10 +8,12 @@
 #include <tempest/event_registry.hpp>
 #include <tempest/functional.hpp>
 #include <tempest/input.hpp>
+#include <tempest/job_system.hpp>
 #include <tempest/logger.hpp>
 #include <tempest/renderer.hpp>
 #include <tempest/rhi.hpp>
 #include <tempest/rhi_types.hpp>
+#include <tempest/transform_propagation.hpp>
 #include <tempest/tuple.hpp>
 #include <tempest/vector.hpp>
 
@@ -135,8 +137,20 @@ namespace tempest
 
         [[nodiscard]] virtual auto load_entity(ecs::entity src) -> ecs::entity = 0;
 
+        /// <summary>
+        /// Marks the world transform of an entity and its descendants as stale after its transform_component was edited
+        /// in place. The world transforms are recomputed before the next frame is rendered.
+        /// </summary>
+        virtual auto mark_transform_dirty(ecs::entity entity) -> void = 0;
+
         [[nodiscard]] virtual auto get_logger() -> logger& = 0;
         [[nodiscard]] virtual auto get_logger() const -> const logger& = 0;
+
+        /// <summary>
+        /// Fetches the job system shared by the engine. Systems may submit work to it from any thread.
+        /// </summary>
+        [[nodiscard]] virtual auto get_jobs() -> core::job_system& = 0;
+        [[nodiscard]] virtual auto get_jobs() const -> const core::job_system& = 0;
     };
 
     class TEMPEST_API standalone_engine_context : public engine_context
@@ -186,6 +200,11 @@ namespace tempest
 
         ecs::entity load_entity(ecs::entity src) override;
 
+        auto mark_transform_dirty(ecs::entity entity) -> void override
+        {
+            _transforms.mark_dirty(entity);
+        }
+
         [[nodiscard]] auto get_logger() -> logger& override
         {
             return _logger;
@@ -196,12 +215,24 @@ namespace tempest
             return _logger;
         }
 
+        [[nodiscard]] auto get_jobs() -> core::job_system& override
+        {
+            return _jobs;
+        }
+
+        [[nodiscard]] auto get_jobs() const -> const core::job_system& override
+        {
+            return _jobs;
+        }
+
       private:
         vector<unique_ptr<log_sink>> _log_sinks;
         logger _logger;
+        core::job_system _jobs;
 
         event::event_registry _event_registry;
         ecs::archetype_registry _entity_registry;
+        ecs::transform_propagation_system _transforms;
         core::material_registry _material_reg;
         core::mesh_registry _mesh_reg;
         core::texture_registry _texture_reg;
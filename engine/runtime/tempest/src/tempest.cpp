@@ -41,7 +41,8 @@ namespace tempest
 
     standalone_engine_context::standalone_engine_context()
         : _log_sinks(make_default_log_sinks()), _logger(make_default_logger(_log_sinks)),
-          _entity_registry(_event_registry), _asset_database(&_asset_type_reg),
+          _entity_registry(_event_registry), _transforms(_entity_registry, _event_registry),
+          _asset_database(&_asset_type_reg),
           _render(graphics::renderer::builder()
                       .set_pbr_frame_graph_config({
                           .render_target_width = 1920,
@@ -73,6 +74,7 @@ namespace tempest
                       })
                       .set_pbr_frame_graph_inputs({
                           .entity_registry = &_entity_registry,
+                          .jobs = &_jobs,
                       })
                       .build(_logger))
     {
@@ -343,6 +345,7 @@ namespace tempest
 
     void standalone_engine_context::_render_frame()
     {
+        _transforms.update();
         _render.render();
     }
 } // namespace tempest
\ No newline at end of file
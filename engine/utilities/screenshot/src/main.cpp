@@ -15,6 +15,7 @@
 #include <tempest/rhi_types.hpp>
 #include <tempest/traits.hpp>
 #include <tempest/transform_component.hpp>
+#include <tempest/transform_propagation.hpp>
 #include <tempest/vector.hpp>
 
 #include <cstdio>
@@ -181,6 +182,7 @@ auto main(int argc, char** argv) -> int
     // Registries
     auto event_registry    = tempest::event::event_registry();
     auto entity_registry   = tempest::ecs::archetype_registry(event_registry);
+    auto transforms        = tempest::ecs::transform_propagation_system(entity_registry, event_registry);
     auto mesh_registry     = tempest::core::mesh_registry();
     auto texture_registry  = tempest::core::texture_registry();
     auto material_registry = tempest::core::material_registry();
@@ -330,6 +332,7 @@ auto main(int argc, char** argv) -> int
 
     for (uint32_t i = 0; i < total_frames; ++i)
     {
+        transforms.update();
         pbr_fg.execute();
 
         if (i >= args.wait_frames)